@@ -0,0 +1,21 @@
+#ifndef BENCHMARK_UTILS_H_
+#define BENCHMARK_UTILS_H_
+
+#include <stdint.h>
+#include <time.h>
+
+static inline double timeDiffSeconds(const struct timespec *start, const struct timespec *end) {
+	return ((double) (end->tv_sec - start->tv_sec) + ((double) (end->tv_nsec - start->tv_nsec) / 1.0e9));
+}
+
+// Fast deterministic pseudo-random numbers, to generate test data.
+static inline uint32_t xorshift32(uint32_t *state) {
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return (x);
+}
+
+#endif /* BENCHMARK_UTILS_H_ */
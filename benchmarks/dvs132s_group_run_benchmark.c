@@ -0,0 +1,292 @@
+// Benchmark for the group run fast path of the DVS132S event translator.
+// Replays a DVS132S USB stream through a per-word switch with per-event
+// setters, as done by the general translator, and through
+// dvs132sGroupRunDecode(), for both XY orientations, and compares them.
+// The stream is either read from a raw USB capture file (little-endian 16-bit
+// words, as received from the device) given as first argument, or generated:
+// dense bursts of row addresses, each followed by column addresses and their
+// 2x2 pixel groups, interleaved with timestamps.
+// Uses internal libcaer headers, not part of the public API.
+#include <libcaer/events/polarity.h>
+
+#include "benchmark_utils.h"
+#include "dvs132s_group_run.h"
+
+#define DVS132S_SIZE_X 132
+#define DVS132S_SIZE_Y 104
+
+#define STREAM_WORDS   (8 * 1024 * 1024)
+#define BENCHMARK_RUNS 10
+
+static bool invertXY = false;
+
+static inline void writeEvent(
+	caerPolarityEventPacket packet, int32_t *position, int32_t timestamp, bool polarity, uint16_t x, uint16_t y) {
+	caerPolarityEvent currentPolarityEvent = caerPolarityEventPacketGetEvent(packet, *position);
+
+	caerPolarityEventSetTimestamp(currentPolarityEvent, timestamp);
+	caerPolarityEventSetPolarity(currentPolarityEvent, polarity);
+	if (invertXY) {
+		caerPolarityEventSetY(currentPolarityEvent, x);
+		caerPolarityEventSetX(currentPolarityEvent, y);
+	}
+	else {
+		caerPolarityEventSetY(currentPolarityEvent, y);
+		caerPolarityEventSetX(currentPolarityEvent, x);
+	}
+	caerPolarityEventValidate(currentPolarityEvent, packet);
+	(*position)++;
+}
+
+static int32_t decodeSwitch(caerPolarityEventPacket packet, const uint8_t *buffer, size_t bufferSize) {
+	int32_t position  = 0;
+	int32_t timestamp = 0;
+	uint16_t lastX    = 0;
+	uint16_t lastY    = 0;
+
+	for (size_t bufferPos = 0; bufferPos < bufferSize; bufferPos += 2) {
+		uint16_t event = le16toh(*((const uint16_t *) (&buffer[bufferPos])));
+
+		if ((event & 0x8000) != 0) {
+			// Only the 15 low bits, wraps are not relevant for the comparison.
+			timestamp = I32T(event & 0x7FFF);
+			continue;
+		}
+
+		uint8_t code  = U8T((event & 0x7000) >> 12);
+		uint16_t data = (event & 0x0FFF);
+
+		switch (code) {
+			case 1: // Y group address
+				if (data >= DVS132S_SIZE_Y) {
+					break;
+				}
+
+				lastY = data;
+				break;
+
+			case 2: // X group address
+				if (data >= DVS132S_SIZE_X) {
+					break;
+				}
+
+				lastX = data;
+				break;
+
+			case 3: { // 4-pixel group event presence and polarity.
+				if (data & 0x0010) {
+					writeEvent(packet, &position, timestamp, data & 0x0001, lastX, lastY);
+				}
+
+				if (data & 0x0020) {
+					writeEvent(packet, &position, timestamp, data & 0x0002, U16T(lastX + 1), lastY);
+				}
+
+				if (data & 0x0040) {
+					writeEvent(packet, &position, timestamp, data & 0x0004, lastX, U16T(lastY + 1));
+				}
+
+				if (data & 0x0080) {
+					writeEvent(packet, &position, timestamp, data & 0x0008, U16T(lastX + 1), U16T(lastY + 1));
+				}
+
+				break;
+			}
+
+			default:
+				// Special, misc and wrap events: not part of this benchmark.
+				break;
+		}
+	}
+
+	return (position);
+}
+
+static int32_t decodeRuns(caerPolarityEventPacket packet, const uint8_t *buffer, size_t bufferSize) {
+	int32_t position  = 0;
+	int32_t timestamp = 0;
+	uint16_t lastX    = 0;
+	uint16_t lastY    = 0;
+
+	for (size_t bufferPos = 0; bufferPos < bufferSize; bufferPos += 2) {
+		uint16_t event = le16toh(*((const uint16_t *) (&buffer[bufferPos])));
+
+		if ((event & 0x8000) != 0) {
+			// Only the 15 low bits, wraps are not relevant for the comparison.
+			timestamp = I32T(event & 0x7FFF);
+			continue;
+		}
+
+		if (dvs132sGroupRunStart(event)) {
+			size_t runPos = bufferPos;
+
+			int32_t runEventsNumber = dvs132sGroupRunDecode(caerPolarityEventPacketGetEvent(packet, position),
+				caerEventPacketHeaderGetEventCapacity(&packet->packetHeader) - position, INT32_MAX, buffer, bufferSize,
+				&runPos, &lastX, &lastY, DVS132S_SIZE_X, DVS132S_SIZE_Y, invertXY, timestamp);
+
+			polarityGroupCommit(packet, runEventsNumber);
+			position += runEventsNumber;
+
+			if (runPos != bufferPos) {
+				bufferPos = runPos - 2;
+			}
+		}
+
+		// Anything else (or an out-of-range address) would go to the general path.
+	}
+
+	return (position);
+}
+
+static double benchmark(const char *name, int32_t (*decoder)(caerPolarityEventPacket, const uint8_t *, size_t),
+	const uint8_t *buffer, size_t bufferSize, caerPolarityEventPacket *result) {
+	double bestTime = 1.0e9;
+	int32_t events  = 0;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		// Every word could be a group of four polarity events at most.
+		caerPolarityEventPacket packet = caerPolarityEventPacketAllocate(I32T((bufferSize / 2) * 4), 1, 0);
+		if (packet == NULL) {
+			fprintf(stderr, "Failed to allocate polarity packet.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		events = (*decoder)(packet, buffer, bufferSize);
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		double time = timeDiffSeconds(&start, &end);
+		if (time < bestTime) {
+			bestTime = time;
+		}
+
+		if (run == (BENCHMARK_RUNS - 1)) {
+			*result = packet;
+		}
+		else {
+			free(packet);
+		}
+	}
+
+	printf("%-8s: %d events in %.3f ms, %.1f Mev/s.\n", name, events, bestTime * 1000.0,
+		(double) events / bestTime / 1.0e6);
+
+	return (bestTime);
+}
+
+static uint8_t *loadCapture(const char *fileName, size_t *bufferSize) {
+	FILE *file = fopen(fileName, "rb");
+	if (file == NULL) {
+		fprintf(stderr, "Failed to open capture file '%s'.\n", fileName);
+		return (NULL);
+	}
+
+	fseek(file, 0, SEEK_END);
+	long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	if (fileSize < 2) {
+		fprintf(stderr, "Capture file '%s' is empty.\n", fileName);
+		fclose(file);
+		return (NULL);
+	}
+
+	*bufferSize     = (size_t) fileSize & ~((size_t) 0x01);
+	uint8_t *buffer = malloc(*bufferSize);
+
+	if ((buffer == NULL) || (fread(buffer, 1, *bufferSize, file) != *bufferSize)) {
+		fprintf(stderr, "Failed to read capture file '%s'.\n", fileName);
+		free(buffer);
+		buffer = NULL;
+	}
+
+	fclose(file);
+
+	return (buffer);
+}
+
+static uint8_t *generateStream(size_t *bufferSize) {
+	uint16_t *words = malloc(STREAM_WORDS * sizeof(uint16_t));
+	if (words == NULL) {
+		fprintf(stderr, "Failed to allocate stream.\n");
+		return (NULL);
+	}
+
+	uint32_t rng       = 0x12345678;
+	uint16_t timestamp = 0;
+	size_t i           = 0;
+
+	while (i < (STREAM_WORDS - 128)) {
+		// New timestamp every few rows.
+		if ((xorshift32(&rng) & 0x03) == 0) {
+			timestamp  = U16T((timestamp + 1) & 0x7FFF);
+			words[i++] = htole16(U16T(0x8000 | timestamp));
+		}
+
+		// A row group, followed by a burst of 1 to 32 column groups, each with
+		// one or more of its 2x2 pixels active.
+		words[i++] = htole16(U16T(0x1000 | ((xorshift32(&rng) % (DVS132S_SIZE_Y / 2)) * 2)));
+
+		size_t burstLength = 1 + (xorshift32(&rng) & 0x1F);
+
+		for (size_t b = 0; b < burstLength; b++) {
+			words[i++] = htole16(U16T(0x2000 | ((xorshift32(&rng) % (DVS132S_SIZE_X / 2)) * 2)));
+
+			uint32_t presence = ((xorshift32(&rng) | xorshift32(&rng)) & 0x0F) | 0x01;
+			uint32_t polarity = xorshift32(&rng) & 0x0F;
+
+			words[i++] = htole16(U16T(0x3000 | (presence << 4) | polarity));
+		}
+	}
+
+	*bufferSize = i * sizeof(uint16_t);
+
+	return ((uint8_t *) words);
+}
+
+int main(int argc, char *argv[]) {
+	size_t bufferSize = 0;
+	uint8_t *buffer   = (argc > 1) ? (loadCapture(argv[1], &bufferSize)) : (generateStream(&bufferSize));
+	if (buffer == NULL) {
+		return (EXIT_FAILURE);
+	}
+
+	printf("%s stream: %zu words.\n", (argc > 1) ? ("Captured") : ("Synthetic"), bufferSize / 2);
+
+	bool identical = true;
+
+	for (size_t orientation = 0; orientation < 2; orientation++) {
+		invertXY = (orientation == 1);
+
+		printf("Invert XY: %s.\n", (invertXY) ? ("yes") : ("no"));
+
+		caerPolarityEventPacket switchResult = NULL;
+		caerPolarityEventPacket runsResult   = NULL;
+
+		double switchTime = benchmark("switch", &decodeSwitch, buffer, bufferSize, &switchResult);
+		double runsTime   = benchmark("runs", &decodeRuns, buffer, bufferSize, &runsResult);
+
+		printf("Speed-up: %.2fx.\n", switchTime / runsTime);
+
+		// Both decoders must produce exactly the same packet.
+		size_t packetSize = sizeof(struct caer_event_packet_header)
+							+ ((size_t) caerEventPacketHeaderGetEventCapacity(&switchResult->packetHeader)
+								* sizeof(struct caer_polarity_event));
+
+		bool orientationIdentical = (memcmp(switchResult, runsResult, packetSize) == 0);
+
+		printf("Results identical: %s.\n", (orientationIdentical) ? ("yes") : ("NO"));
+
+		identical = identical && orientationIdentical;
+
+		free(switchResult);
+		free(runsResult);
+	}
+
+	free(buffer);
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
@@ -0,0 +1,124 @@
+/*
+ * Load a full network (all CAMs and SRAMs of all four chips) into a Dynap-se board,
+ * and report how long it takes. The same load is timed for a sample of single
+ * writes, to compare against the per-entry functions.
+ *
+ * compile with:  gcc -std=c11 -pedantic -Wall -Wextra -O2 -o dynapse_network_load dynapse_network_load.c
+ * -D_DEFAULT_SOURCE=1 -lcaer
+ */
+
+#include <libcaer/libcaer.h>
+
+#include <libcaer/devices/dynapse.h>
+
+#include "benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NETWORK_CAMS  (DYNAPSE_CONFIG_NUMNEURONS * DYNAPSE_CONFIG_NUMCAM_NEU)
+#define NETWORK_SRAMS (DYNAPSE_CONFIG_NUMNEURONS * DYNAPSE_CONFIG_NUMSRAM_NEU)
+
+// Number of single writes to time, the full network would take too long.
+#define SINGLE_SAMPLE 1024
+
+static const uint8_t chipIds[DYNAPSE_X4BOARD_NUMCHIPS] = {DYNAPSE_CONFIG_DYNAPSE_U0, DYNAPSE_CONFIG_DYNAPSE_U1,
+	DYNAPSE_CONFIG_DYNAPSE_U2, DYNAPSE_CONFIG_DYNAPSE_U3};
+
+// Some arbitrary, but complete, connectivity: every neuron listens to 64
+// neurons of the previous chip and projects to all cores of the next one.
+static void generateNetwork(struct caer_dynapse_cam *cams, struct caer_dynapse_sram *srams) {
+	for (uint16_t neuron = 0; neuron < DYNAPSE_CONFIG_NUMNEURONS; neuron++) {
+		for (uint8_t camId = 0; camId < DYNAPSE_CONFIG_NUMCAM_NEU; camId++) {
+			struct caer_dynapse_cam *cam = &cams[((size_t) neuron * DYNAPSE_CONFIG_NUMCAM_NEU) + camId];
+
+			cam->inputNeuronAddr = (uint16_t) ((neuron + (camId * 16U)) % DYNAPSE_CONFIG_NUMNEURONS);
+			cam->neuronAddr      = neuron;
+			cam->camId           = camId;
+			cam->synapseType     = (camId < 48) ? (DYNAPSE_CONFIG_CAMTYPE_F_EXC) : (DYNAPSE_CONFIG_CAMTYPE_F_INH);
+		}
+
+		for (uint8_t sramId = 0; sramId < DYNAPSE_CONFIG_NUMSRAM_NEU; sramId++) {
+			struct caer_dynapse_sram *sram = &srams[((size_t) neuron * DYNAPSE_CONFIG_NUMSRAM_NEU) + sramId];
+
+			sram->neuronAddr      = neuron;
+			sram->sramId          = sramId;
+			sram->virtualCoreId   = (uint8_t) (neuron / DYNAPSE_CONFIG_NUMNEURONS_CORE);
+			sram->sx              = DYNAPSE_CONFIG_SRAM_DIRECTION_X_EAST;
+			sram->dx              = (sramId == 0) ? (1) : (0);
+			sram->sy              = DYNAPSE_CONFIG_SRAM_DIRECTION_Y_NORTH;
+			sram->dy              = 0;
+			sram->destinationCore = (sramId == 0) ? (0x0F) : (0x00);
+		}
+	}
+}
+
+int main(void) {
+	struct caer_dynapse_cam *cams   = malloc(NETWORK_CAMS * sizeof(struct caer_dynapse_cam));
+	struct caer_dynapse_sram *srams = malloc(NETWORK_SRAMS * sizeof(struct caer_dynapse_sram));
+	if ((cams == NULL) || (srams == NULL)) {
+		free(cams);
+		free(srams);
+		return (EXIT_FAILURE);
+	}
+
+	generateNetwork(cams, srams);
+
+	// Open a DYNAPSE, give it a device ID of 1, and don't care about USB bus or SN restrictions.
+	caerDeviceHandle dynapse_handle = caerDeviceOpen(1, CAER_DEVICE_DYNAPSE, 0, 0, NULL);
+	if (dynapse_handle == NULL) {
+		free(cams);
+		free(srams);
+		return (EXIT_FAILURE);
+	}
+
+	caerDeviceSendDefaultConfig(dynapse_handle);
+
+	// Single writes, for comparison. Only a sample on the first chip, extrapolated.
+	struct timespec start, end;
+
+	caerDeviceConfigSet(dynapse_handle, DYNAPSE_CONFIG_CHIP, DYNAPSE_CONFIG_CHIP_ID, chipIds[0]);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (size_t i = 0; i < SINGLE_SAMPLE; i++) {
+		caerDynapseWriteCam(
+			dynapse_handle, cams[i].inputNeuronAddr, cams[i].neuronAddr, cams[i].camId, cams[i].synapseType);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	double singleTime = timeDiffSeconds(&start, &end);
+	double singleFull = singleTime * (double) ((NETWORK_CAMS + NETWORK_SRAMS) * DYNAPSE_X4BOARD_NUMCHIPS)
+						/ (double) SINGLE_SAMPLE;
+
+	printf("Single writes: %d entries in %.3f s, full network estimated at %.1f s.\n", SINGLE_SAMPLE, singleTime,
+		singleFull);
+
+	// Full network, with bulk writes.
+	bool success = true;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (size_t chip = 0; chip < DYNAPSE_X4BOARD_NUMCHIPS; chip++) {
+		caerDeviceConfigSet(dynapse_handle, DYNAPSE_CONFIG_CHIP, DYNAPSE_CONFIG_CHIP_ID, chipIds[chip]);
+
+		success = success && caerDynapseWriteCamMultiple(dynapse_handle, cams, NETWORK_CAMS);
+		success = success && caerDynapseWriteSramMultiple(dynapse_handle, srams, NETWORK_SRAMS);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	double multipleTime = timeDiffSeconds(&start, &end);
+
+	printf("Bulk writes: %d entries in %.3f s (%s), %.1fx faster.\n",
+		(NETWORK_CAMS + NETWORK_SRAMS) * DYNAPSE_X4BOARD_NUMCHIPS, multipleTime, (success) ? ("OK") : ("FAILED"),
+		singleFull / multipleTime);
+
+	caerDeviceClose(&dynapse_handle);
+
+	free(cams);
+	free(srams);
+
+	return ((success) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
@@ -0,0 +1,275 @@
+// Benchmark for AEDAT 3.x file reading. Writes a file of polarity and special
+// event packets, then reads it back once with a hand-rolled fread() per packet
+// and once with the memory-mapped file reader, building its index and loading
+// it again from the sidecar file. Checks that all packets are identical and
+// that seeking to a timestamp gives the same result as a linear search.
+#include <libcaer/io/file_reader.h>
+#include <libcaer/io/file_writer.h>
+
+#include <libcaer/events/polarity.h>
+#include <libcaer/events/special.h>
+
+#include "benchmark_utils.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CONTAINERS      1024
+#define POLARITY_EVENTS 8192
+#define SPECIAL_EVENTS  4
+#define SEEKS           10000
+
+static const char endOfHeader[] = "#!END-HEADER\r\n";
+
+static caerEventPacketContainer generateContainer(int32_t index, uint32_t *randomState) {
+	caerEventPacketContainer container = caerEventPacketContainerAllocate(2);
+	caerPolarityEventPacket polarity   = caerPolarityEventPacketAllocate(POLARITY_EVENTS, 1, 0);
+	caerSpecialEventPacket special     = caerSpecialEventPacketAllocate(SPECIAL_EVENTS, 1, 0);
+	if ((container == NULL) || (polarity == NULL) || (special == NULL)) {
+		free(container);
+		free(polarity);
+		free(special);
+		return (NULL);
+	}
+
+	int32_t timestamp = index * POLARITY_EVENTS;
+
+	for (int32_t i = 0; i < POLARITY_EVENTS; i++) {
+		uint32_t random = xorshift32(randomState);
+
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(polarity, i);
+		caerPolarityEventSetTimestamp(event, timestamp + i);
+		caerPolarityEventSetX(event, (uint16_t) (random % 346));
+		caerPolarityEventSetY(event, (uint16_t) ((random >> 16) % 260));
+		caerPolarityEventSetPolarity(event, (random >> 31) & 0x01);
+		caerPolarityEventValidate(event, polarity);
+	}
+
+	for (int32_t i = 0; i < SPECIAL_EVENTS; i++) {
+		caerSpecialEvent event = caerSpecialEventPacketGetEvent(special, i);
+		caerSpecialEventSetTimestamp(event, timestamp + (i * (POLARITY_EVENTS / SPECIAL_EVENTS)));
+		caerSpecialEventSetType(event, EXTERNAL_INPUT_RISING_EDGE);
+		caerSpecialEventValidate(event, special);
+	}
+
+	caerEventPacketContainerSetEventPacket(container, POLARITY_EVENT, (caerEventPacketHeader) polarity);
+	caerEventPacketContainerSetEventPacket(container, SPECIAL_EVENT, (caerEventPacketHeader) special);
+
+	return (container);
+}
+
+static bool writeFile(const char *fileName) {
+	int fd = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		return (false);
+	}
+
+	caerFileWriter writer = caerFileWriterOpen(fd, 1, "Benchmark", 0);
+	if (writer == NULL) {
+		close(fd);
+		return (false);
+	}
+
+	uint32_t randomState = 0x12345678;
+	bool success         = true;
+
+	for (int32_t c = 0; success && (c < CONTAINERS); c++) {
+		caerEventPacketContainer container = generateContainer(c, &randomState);
+
+		if (container == NULL) {
+			success = false;
+		}
+		else if (!caerFileWriterWrite(writer, container)) {
+			// The container was not taken over by the writer.
+			caerEventPacketContainerFree(container);
+			success = false;
+		}
+	}
+
+	success = caerFileWriterClose(writer) && success;
+
+	return ((close(fd) == 0) && success);
+}
+
+// What users do without the file reader: skip the header, then fread() each
+// packet header and its events into newly allocated memory.
+static caerEventPacketHeader *readFread(const char *fileName, size_t *packetsNumber) {
+	FILE *file = fopen(fileName, "rb");
+	if (file == NULL) {
+		return (NULL);
+	}
+
+	char line[1024];
+	while ((fgets(line, sizeof(line), file) != NULL) && (strcmp(line, endOfHeader) != 0)) {
+		;
+	}
+
+	size_t packetsCapacity        = 1024;
+	caerEventPacketHeader *packets = malloc(packetsCapacity * sizeof(caerEventPacketHeader));
+	*packetsNumber                 = 0;
+
+	struct caer_event_packet_header header;
+
+	while ((packets != NULL) && (fread(&header, CAER_EVENT_PACKET_HEADER_SIZE, 1, file) == 1)) {
+		size_t dataSize = (size_t) caerEventPacketGetDataSize(&header);
+
+		caerEventPacketHeader packet = malloc(CAER_EVENT_PACKET_HEADER_SIZE + dataSize);
+		if ((packet == NULL) || (fread((uint8_t *) packet + CAER_EVENT_PACKET_HEADER_SIZE, dataSize, 1, file) != 1)) {
+			free(packet);
+			break;
+		}
+
+		*packet = header;
+
+		if (*packetsNumber == packetsCapacity) {
+			packetsCapacity *= 2;
+			packets = realloc(packets, packetsCapacity * sizeof(caerEventPacketHeader));
+			if (packets == NULL) {
+				break;
+			}
+		}
+
+		packets[(*packetsNumber)++] = packet;
+	}
+
+	fclose(file);
+
+	return (packets);
+}
+
+static int64_t lastTimestamp64(caerEventPacketHeaderConst packet) {
+	int32_t number = caerEventPacketHeaderGetEventNumber(packet);
+
+	return (caerGenericEventGetTimestamp64(caerGenericEventGetEvent(packet, number - 1), packet));
+}
+
+static caerFileReader openReader(const char *fileName, const char *indexFileName, const char *name) {
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	caerFileReader reader = caerFileReaderOpen(fileName, indexFileName);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	if (reader != NULL) {
+		printf("%-28s %10.3f ms  (%zu packets)\n", name, timeDiffSeconds(&start, &end) * 1000.0,
+			caerFileReaderGetPacketsNumber(reader));
+	}
+
+	return (reader);
+}
+
+int main(void) {
+	char fileName[]      = "/tmp/caer_file_reader_benchmark.aedat";
+	char indexFileName[] = "/tmp/caer_file_reader_benchmark.aedat.idx";
+
+	unlink(indexFileName);
+
+	if (!writeFile(fileName)) {
+		fprintf(stderr, "Failed to write test file.\n");
+		return (EXIT_FAILURE);
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	size_t freadPacketsNumber           = 0;
+	caerEventPacketHeader *freadPackets = readFread(fileName, &freadPacketsNumber);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	if (freadPackets == NULL) {
+		fprintf(stderr, "Failed to read test file.\n");
+		return (EXIT_FAILURE);
+	}
+
+	printf("%-28s %10.3f ms  (%zu packets)\n", "fread() per packet", timeDiffSeconds(&start, &end) * 1000.0,
+		freadPacketsNumber);
+
+	caerFileReader readers[3];
+	readers[0] = openReader(fileName, NULL, "caerFileReader (no sidecar)");
+	readers[1] = openReader(fileName, indexFileName, "caerFileReader (build index)");
+	readers[2] = openReader(fileName, indexFileName, "caerFileReader (load index)");
+
+	bool identical = true;
+
+	for (size_t r = 0; r < 3; r++) {
+		if ((readers[r] == NULL) || (caerFileReaderGetPacketsNumber(readers[r]) != freadPacketsNumber)) {
+			identical = false;
+			continue;
+		}
+
+		for (size_t i = 0; i < freadPacketsNumber; i++) {
+			caerEventPacketHeaderConst packet = caerFileReaderGetPacket(readers[r], i);
+
+			if (!caerEventPacketEquals(packet, freadPackets[i])
+				|| (caerFileReaderGetIndexEntry(readers[r], i)->lastTimestamp != lastTimestamp64(freadPackets[i]))) {
+				identical = false;
+			}
+		}
+	}
+
+	printf("Packets: %s\n", (identical) ? ("IDENTICAL") : ("DIFFERENT"));
+
+	// Seek to random timestamps, then compare with a linear search over the packets.
+	bool seekCorrect = identical;
+
+	if (seekCorrect) {
+		int64_t maxTimestamp    = lastTimestamp64(freadPackets[freadPacketsNumber - 1]) + 2;
+		uint32_t randomState    = 0x87654321;
+		int64_t *seekTimestamps = malloc(SEEKS * sizeof(int64_t));
+		size_t *seekIndexes     = malloc(SEEKS * sizeof(size_t));
+		if ((seekTimestamps == NULL) || (seekIndexes == NULL)) {
+			return (EXIT_FAILURE);
+		}
+
+		for (size_t s = 0; s < SEEKS; s++) {
+			seekTimestamps[s] = (int64_t) (xorshift32(&randomState) % (uint32_t) maxTimestamp);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		for (size_t s = 0; s < SEEKS; s++) {
+			seekIndexes[s] = caerFileReaderSeekTimestamp(readers[0], seekTimestamps[s]);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		printf("%-28s %10.3f ms  (%d seeks)\n", "caerFileReaderSeekTimestamp", timeDiffSeconds(&start, &end) * 1000.0,
+			SEEKS);
+
+		for (size_t s = 0; s < SEEKS; s++) {
+			size_t expected = 0;
+			while ((expected < freadPacketsNumber) && (lastTimestamp64(freadPackets[expected]) < seekTimestamps[s])) {
+				expected++;
+			}
+
+			if (seekIndexes[s] != expected) {
+				seekCorrect = false;
+			}
+		}
+
+		free(seekTimestamps);
+		free(seekIndexes);
+	}
+
+	printf("Seek: %s\n", (seekCorrect) ? ("CORRECT") : ("WRONG"));
+
+	for (size_t r = 0; r < 3; r++) {
+		caerFileReaderClose(readers[r]);
+	}
+
+	for (size_t i = 0; i < freadPacketsNumber; i++) {
+		free(freadPackets[i]);
+	}
+
+	free(freadPackets);
+
+	unlink(indexFileName);
+	unlink(fileName);
+
+	return ((identical && seekCorrect) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
@@ -0,0 +1,217 @@
+// Benchmark for sustained AEDAT 3.1 file writing. Writes the same set of
+// packet containers (a large polarity packet and a few special events each)
+// once with a hand-rolled fwrite() per packet, once with the file writer in
+// synchronous mode and once with its background writer thread, then checks
+// that all three files hold exactly the same packet data.
+#include <libcaer/io/file_writer.h>
+
+#include <libcaer/events/polarity.h>
+#include <libcaer/events/special.h>
+
+#include "benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CONTAINERS        1024
+#define POLARITY_EVENTS   8192
+#define SPECIAL_EVENTS    4
+#define WRITER_QUEUE_SIZE 64
+
+static const char endOfHeader[] = "#!END-HEADER\r\n";
+
+static caerEventPacketContainer generateContainer(int32_t index, uint32_t *randomState) {
+	caerEventPacketContainer container = caerEventPacketContainerAllocate(2);
+	caerPolarityEventPacket polarity   = caerPolarityEventPacketAllocate(POLARITY_EVENTS, 1, 0);
+	caerSpecialEventPacket special     = caerSpecialEventPacketAllocate(SPECIAL_EVENTS, 1, 0);
+	if ((container == NULL) || (polarity == NULL) || (special == NULL)) {
+		free(container);
+		free(polarity);
+		free(special);
+		return (NULL);
+	}
+
+	int32_t timestamp = index * POLARITY_EVENTS;
+
+	for (int32_t i = 0; i < POLARITY_EVENTS; i++) {
+		uint32_t random = xorshift32(randomState);
+
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(polarity, i);
+		caerPolarityEventSetTimestamp(event, timestamp + i);
+		caerPolarityEventSetX(event, (uint16_t) (random % 346));
+		caerPolarityEventSetY(event, (uint16_t) ((random >> 16) % 260));
+		caerPolarityEventSetPolarity(event, (random >> 31) & 0x01);
+		caerPolarityEventValidate(event, polarity);
+	}
+
+	for (int32_t i = 0; i < SPECIAL_EVENTS; i++) {
+		caerSpecialEvent event = caerSpecialEventPacketGetEvent(special, i);
+		caerSpecialEventSetTimestamp(event, timestamp + (i * (POLARITY_EVENTS / SPECIAL_EVENTS)));
+		caerSpecialEventSetType(event, EXTERNAL_INPUT_RISING_EDGE);
+		caerSpecialEventValidate(event, special);
+	}
+
+	caerEventPacketContainerSetEventPacket(container, POLARITY_EVENT, (caerEventPacketHeader) polarity);
+	caerEventPacketContainerSetEventPacket(container, SPECIAL_EVENT, (caerEventPacketHeader) special);
+
+	return (container);
+}
+
+// What users do without the file writer: one fwrite() per header and per packet,
+// copying the header to fix up its capacity.
+static bool writeFwrite(int fd, caerEventPacketContainer *containers) {
+	FILE *file = fdopen(dup(fd), "wb");
+	if (file == NULL) {
+		return (false);
+	}
+
+	fprintf(file, "#!AER-DAT3.1\r\n#Format: RAW\r\n%s", endOfHeader);
+
+	for (size_t c = 0; c < CONTAINERS; c++) {
+		for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(containers[c]); i++) {
+			caerEventPacketHeaderConst packet = caerEventPacketContainerGetEventPacketConst(containers[c], i);
+			if ((packet == NULL) || (caerEventPacketHeaderGetEventNumber(packet) == 0)) {
+				continue;
+			}
+
+			struct caer_event_packet_header header = *packet;
+			caerEventPacketHeaderSetEventCapacity(&header, caerEventPacketHeaderGetEventNumber(packet));
+
+			fwrite(&header, CAER_EVENT_PACKET_HEADER_SIZE, 1, file);
+			fwrite((const uint8_t *) packet + CAER_EVENT_PACKET_HEADER_SIZE,
+				(size_t) caerEventPacketGetDataSizeEvents(packet), 1, file);
+		}
+	}
+
+	return (fclose(file) == 0);
+}
+
+static bool writeFileWriter(int fd, caerEventPacketContainer *containers, size_t queueSize) {
+	caerFileWriter writer = caerFileWriterOpen(fd, 1, "Benchmark", queueSize);
+	if (writer == NULL) {
+		return (false);
+	}
+
+	for (size_t c = 0; c < CONTAINERS; c++) {
+		// The containers are reused for every run, so keep their ownership.
+		if (!caerFileWriterWriteNotify(writer, containers[c], NULL, NULL)) {
+			caerFileWriterClose(writer);
+			return (false);
+		}
+	}
+
+	return (caerFileWriterClose(writer));
+}
+
+// Returns the packet data of the file, after the header.
+static uint8_t *readBody(int fd, size_t *bodySize) {
+	off_t fileSize = lseek(fd, 0, SEEK_END);
+	if (fileSize <= 0) {
+		return (NULL);
+	}
+
+	uint8_t *content = malloc((size_t) fileSize);
+	if ((content == NULL) || (pread(fd, content, (size_t) fileSize, 0) != fileSize)) {
+		free(content);
+		return (NULL);
+	}
+
+	for (size_t i = 0; (i + sizeof(endOfHeader) - 1) <= (size_t) fileSize; i++) {
+		if (memcmp(content + i, endOfHeader, sizeof(endOfHeader) - 1) == 0) {
+			size_t bodyStart = i + sizeof(endOfHeader) - 1;
+
+			*bodySize = (size_t) fileSize - bodyStart;
+			memmove(content, content + bodyStart, *bodySize);
+
+			return (content);
+		}
+	}
+
+	free(content);
+	return (NULL);
+}
+
+static int openTemporaryFile(void) {
+	char fileName[] = "/tmp/caer_file_writer_benchmark_XXXXXX";
+
+	int fd = mkstemp(fileName);
+	if (fd >= 0) {
+		unlink(fileName);
+	}
+
+	return (fd);
+}
+
+int main(void) {
+	caerEventPacketContainer *containers = calloc(CONTAINERS, sizeof(caerEventPacketContainer));
+	if (containers == NULL) {
+		return (EXIT_FAILURE);
+	}
+
+	uint32_t randomState = 0x12345678;
+	uint64_t totalEvents = 0;
+
+	for (size_t c = 0; c < CONTAINERS; c++) {
+		containers[c] = generateContainer((int32_t) c, &randomState);
+		if (containers[c] == NULL) {
+			return (EXIT_FAILURE);
+		}
+
+		totalEvents += (uint64_t) caerEventPacketContainerGetEventsNumber(containers[c]);
+	}
+
+	const char *names[3] = {"fwrite() per packet", "caerFileWriter (sync)", "caerFileWriter (thread)"};
+	uint8_t *bodies[3]   = {NULL, NULL, NULL};
+	size_t bodySizes[3]  = {0, 0, 0};
+
+	for (size_t run = 0; run < 3; run++) {
+		int fd = openTemporaryFile();
+		if (fd < 0) {
+			return (EXIT_FAILURE);
+		}
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		bool success = (run == 0) ? (writeFwrite(fd, containers))
+								  : (writeFileWriter(fd, containers, (run == 1) ? (0) : (WRITER_QUEUE_SIZE)));
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		bodies[run] = readBody(fd, &bodySizes[run]);
+		close(fd);
+
+		if ((!success) || (bodies[run] == NULL)) {
+			fprintf(stderr, "%s: write failed.\n", names[run]);
+			return (EXIT_FAILURE);
+		}
+
+		double seconds = timeDiffSeconds(&start, &end);
+
+		printf("%-24s %8.1f MB/s  %8.2f Mevents/s\n", names[run], ((double) bodySizes[run] / 1.0e6) / seconds,
+			((double) totalEvents / 1.0e6) / seconds);
+	}
+
+	bool identical = true;
+	for (size_t run = 1; run < 3; run++) {
+		if ((bodySizes[run] != bodySizes[0]) || (memcmp(bodies[run], bodies[0], bodySizes[0]) != 0)) {
+			identical = false;
+		}
+	}
+
+	printf("Packet data: %s (%zu bytes)\n", (identical) ? ("IDENTICAL") : ("DIFFERENT"), bodySizes[0]);
+
+	for (size_t run = 0; run < 3; run++) {
+		free(bodies[run]);
+	}
+
+	for (size_t c = 0; c < CONTAINERS; c++) {
+		caerEventPacketContainerFree(containers[c]);
+	}
+
+	free(containers);
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
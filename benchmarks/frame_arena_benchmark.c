@@ -0,0 +1,85 @@
+// Benchmark for the frame hugepage arena. Allocates, fills and frees frame
+// event packets over and over, like a device does at the frame rate, once
+// with the default allocator and once from the arena set up with
+// caerSetFrameHugepageArena(), and checks that both give the same pixels.
+#include <libcaer/events/frame.h>
+
+#include "benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FRAME_SIZE_X   640
+#define FRAME_SIZE_Y   480
+#define PACKET_FRAMES  4
+#define PACKETS_NUMBER 2000
+#define BENCHMARK_RUNS 5
+
+static double benchmark(uint64_t *checksum) {
+	double bestTime = 1.0e9;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		*checksum = 0;
+
+		for (int32_t p = 0; p < PACKETS_NUMBER; p++) {
+			caerFrameEventPacket packet
+				= caerFrameEventPacketAllocate(PACKET_FRAMES, 1, 0, FRAME_SIZE_X, FRAME_SIZE_Y, 1);
+			if (packet == NULL) {
+				fprintf(stderr, "Failed to allocate frame packet.\n");
+				exit(EXIT_FAILURE);
+			}
+
+			for (int32_t i = 0; i < PACKET_FRAMES; i++) {
+				caerFrameEvent frame = caerFrameEventPacketGetEvent(packet, i);
+
+				caerFrameEventSetLengthXLengthYChannelNumber(frame, FRAME_SIZE_X, FRAME_SIZE_Y, GRAYSCALE, packet);
+
+				uint16_t *pixels = caerFrameEventGetPixelArrayUnsafe(frame);
+
+				for (size_t px = 0; px < (FRAME_SIZE_X * FRAME_SIZE_Y); px++) {
+					pixels[px] = U16T((size_t) p + px);
+				}
+
+				caerFrameEventValidate(frame, packet);
+
+				*checksum += pixels[(size_t) (p + i) % (FRAME_SIZE_X * FRAME_SIZE_Y)];
+			}
+
+			caerEventPacketFree(&packet->packetHeader);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		double time = timeDiffSeconds(&start, &end);
+		if (time < bestTime) {
+			bestTime = time;
+		}
+	}
+
+	return (bestTime);
+}
+
+int main(void) {
+	uint64_t defaultChecksum, arenaChecksum;
+
+	double defaultTime = benchmark(&defaultChecksum);
+
+	if (!caerSetFrameHugepageArena(16 * 1024 * 1024)) {
+		fprintf(stderr, "Failed to set up frame hugepage arena.\n");
+		return (EXIT_FAILURE);
+	}
+
+	double arenaTime = benchmark(&arenaChecksum);
+
+	bool identical = (defaultChecksum == arenaChecksum);
+
+	printf("%d packets of %d frames of %dx%d pixels.\n", PACKETS_NUMBER, PACKET_FRAMES, FRAME_SIZE_X, FRAME_SIZE_Y);
+	printf("default: %7.1f packets/s, hugepage arena: %7.1f packets/s, speed-up %.2fx, %s.\n",
+		PACKETS_NUMBER / defaultTime, PACKETS_NUMBER / arenaTime, defaultTime / arenaTime,
+		(identical) ? ("IDENTICAL") : ("DIFFERENT"));
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
@@ -0,0 +1,348 @@
+// Loopback test and benchmark for AEDAT 3.x network streaming. A child process
+// sends packet containers with the network server, over TCP and UDP, and the
+// network client receives them, checking every packet against the original.
+// A last UDP run replays the datagrams with one dropped and two swapped, to
+// check that losses are detected, reordering undone and incomplete packets dropped.
+#include <libcaer/io/network_client.h>
+#include <libcaer/io/network_server.h>
+
+#include <libcaer/events/polarity.h>
+#include <libcaer/events/special.h>
+#include <libcaer/network.h>
+
+#include "benchmark_utils.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define CONTAINERS        256
+#define POLARITY_EVENTS   8192
+#define SPECIAL_EVENTS    4
+#define RECEIVE_TIMEOUT   2000
+#define REPLAY_CONTAINERS 16
+#define REPLAY_EVENTS     64
+#define REPLAY_DATAGRAM   256
+
+#define TCP_CLIENT_BUFFER_SIZE (64 * 1024 * 1024)
+
+static caerEventPacketContainer generateContainer(int32_t index, int32_t polarityEvents, uint32_t *randomState) {
+	caerEventPacketContainer container = caerEventPacketContainerAllocate(2);
+	caerPolarityEventPacket polarity   = caerPolarityEventPacketAllocate(polarityEvents, 1, 0);
+	caerSpecialEventPacket special     = caerSpecialEventPacketAllocate(SPECIAL_EVENTS, 1, 0);
+	if ((container == NULL) || (polarity == NULL) || (special == NULL)) {
+		free(container);
+		free(polarity);
+		free(special);
+		return (NULL);
+	}
+
+	int32_t timestamp = index * polarityEvents;
+
+	for (int32_t i = 0; i < polarityEvents; i++) {
+		uint32_t random = xorshift32(randomState);
+
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(polarity, i);
+		caerPolarityEventSetTimestamp(event, timestamp + i);
+		caerPolarityEventSetX(event, (uint16_t) (random % 346));
+		caerPolarityEventSetY(event, (uint16_t) ((random >> 16) % 260));
+		caerPolarityEventSetPolarity(event, (random >> 31) & 0x01);
+		caerPolarityEventValidate(event, polarity);
+	}
+
+	for (int32_t i = 0; i < SPECIAL_EVENTS; i++) {
+		caerSpecialEvent event = caerSpecialEventPacketGetEvent(special, i);
+		caerSpecialEventSetTimestamp(event, timestamp + (i * (polarityEvents / SPECIAL_EVENTS)));
+		caerSpecialEventSetType(event, EXTERNAL_INPUT_RISING_EDGE);
+		caerSpecialEventValidate(event, special);
+	}
+
+	caerEventPacketContainerSetEventPacket(container, POLARITY_EVENT, (caerEventPacketHeader) polarity);
+	caerEventPacketContainerSetEventPacket(container, SPECIAL_EVENT, (caerEventPacketHeader) special);
+
+	return (container);
+}
+
+static caerEventPacketContainer *generateContainers(size_t number, int32_t polarityEvents) {
+	caerEventPacketContainer *containers = calloc(number, sizeof(caerEventPacketContainer));
+	if (containers == NULL) {
+		return (NULL);
+	}
+
+	uint32_t randomState = 0x12345678;
+
+	for (size_t c = 0; c < number; c++) {
+		containers[c] = generateContainer((int32_t) c, polarityEvents, &randomState);
+		if (containers[c] == NULL) {
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	return (containers);
+}
+
+static void freeContainers(caerEventPacketContainer *containers, size_t number) {
+	for (size_t c = 0; c < number; c++) {
+		caerEventPacketContainerFree(containers[c]);
+	}
+
+	free(containers);
+}
+
+// Find the original packet with the same type and first timestamp, and compare.
+static bool packetMatches(caerEventPacketContainer *containers, size_t number, caerEventPacketHeaderConst packet) {
+	int64_t firstTimestamp = caerGenericEventGetTimestamp64(caerGenericEventGetEvent(packet, 0), packet);
+
+	for (size_t c = 0; c < number; c++) {
+		caerEventPacketHeaderConst original
+			= caerEventPacketContainerFindEventPacketByTypeConst(containers[c], caerEventPacketHeaderGetEventType(packet));
+
+		if ((original != NULL)
+			&& (caerGenericEventGetTimestamp64(caerGenericEventGetEvent(original, 0), original) == firstTimestamp)) {
+			return (caerEventPacketEquals(original, packet));
+		}
+	}
+
+	return (false);
+}
+
+// Receive until nothing arrives anymore, checking all packets, and return
+// the time the last container arrived in 'end'.
+// Returns the number of packets received, -1 on any mismatch.
+static int64_t receiveAll(
+	caerNetworkClient client, caerEventPacketContainer *containers, size_t number, struct timespec *end) {
+	int64_t packets = 0;
+	bool matches    = true;
+
+	caerEventPacketContainer container;
+	while ((container = caerNetworkClientReceive(client, RECEIVE_TIMEOUT)) != NULL) {
+		clock_gettime(CLOCK_MONOTONIC, end);
+
+		for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(container); i++) {
+			caerEventPacketHeaderConst packet = caerEventPacketContainerGetEventPacketConst(container, i);
+
+			if (!packetMatches(containers, number, packet)) {
+				matches = false;
+			}
+
+			packets++;
+		}
+
+		caerNetworkClientRecycle(client, container);
+	}
+
+	return ((matches) ? (packets) : (-1));
+}
+
+static void printStatistics(const char *name, caerNetworkClient client, double seconds) {
+	struct caer_network_client_statistics statistics = caerNetworkClientStatisticsGet(client);
+
+	printf("%-12s %8.1f MB/s  %8.2f Mevents/s  packets %" PRIu64 ", dropped %" PRIu64 ", lost %" PRIu64
+		   ", reordered %" PRIu64 "\n",
+		name, ((double) statistics.bytesReceived / 1.0e6) / seconds,
+		((double) statistics.eventsReceived / 1.0e6) / seconds, statistics.packetsReceived, statistics.packetsDropped,
+		statistics.messagesLost, statistics.messagesReordered);
+}
+
+static void sendContainers(caerNetworkServer server, caerEventPacketContainer *containers, size_t number) {
+	for (size_t c = 0; c < number; c++) {
+		caerNetworkServerSend(server, containers[c]);
+	}
+}
+
+static bool runTCP(caerEventPacketContainer *containers) {
+	// Buffer everything for the client, so that nothing is dropped.
+	caerNetworkServer server = caerNetworkServerOpenTCP("127.0.0.1", 0, 1, 1, TCP_CLIENT_BUFFER_SIZE, false);
+	if (server == NULL) {
+		return (false);
+	}
+
+	// The connection is queued until the server accepts it on its first send.
+	caerNetworkClient client = caerNetworkClientOpenTCP("127.0.0.1", caerNetworkServerGetPort(server));
+	if (client == NULL) {
+		return (false);
+	}
+
+	pid_t child = fork();
+	if (child == 0) {
+		sendContainers(server, containers, CONTAINERS);
+		caerNetworkServerClose(server);
+		_exit(EXIT_SUCCESS);
+	}
+
+	caerNetworkServerClose(server);
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	end = start;
+
+	int64_t packets = receiveAll(client, containers, CONTAINERS, &end);
+
+	waitpid(child, NULL, 0);
+
+	printStatistics("TCP", client, timeDiffSeconds(&start, &end));
+
+	bool success = (packets == (2 * CONTAINERS)) && (!caerNetworkClientIsConnected(client))
+				   && (caerNetworkClientGetSourceID(client) == 1);
+
+	caerNetworkClientClose(client);
+
+	return (success);
+}
+
+static bool runUDP(caerEventPacketContainer *containers) {
+	caerNetworkClient client = caerNetworkClientOpenUDP("127.0.0.1", 0);
+	if (client == NULL) {
+		return (false);
+	}
+
+	pid_t child = fork();
+	if (child == 0) {
+		caerNetworkServer server = caerNetworkServerOpenUDP("127.0.0.1", caerNetworkClientGetPort(client), 1, 0);
+		sendContainers(server, containers, CONTAINERS);
+		caerNetworkServerClose(server);
+		_exit(EXIT_SUCCESS);
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	end = start;
+
+	int64_t packets = receiveAll(client, containers, CONTAINERS, &end);
+
+	waitpid(child, NULL, 0);
+
+	printStatistics("UDP", client, timeDiffSeconds(&start, &end));
+
+	// A slow receiver may lose datagrams, but everything received must be
+	// correct and all losses accounted for.
+	struct caer_network_client_statistics statistics = caerNetworkClientStatisticsGet(client);
+
+	bool success = (packets >= 0) && (statistics.messagesReordered == 0) && (statistics.messagesLate == 0)
+				   && ((statistics.messagesLost > 0) || (packets == (2 * CONTAINERS)));
+
+	caerNetworkClientClose(client);
+
+	return (success);
+}
+
+static int openUDPSocket(uint16_t *port) {
+	int fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+	struct sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family      = AF_INET;
+	address.sin_port        = htons(*port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	socklen_t addressLength = sizeof(address);
+
+	if ((fd < 0) || (bind(fd, (struct sockaddr *) &address, sizeof(address)) != 0)
+		|| (getsockname(fd, (struct sockaddr *) &address, &addressLength) != 0)) {
+		return (-1);
+	}
+
+	*port = ntohs(address.sin_port);
+
+	return (fd);
+}
+
+static bool runReplay(void) {
+	caerEventPacketContainer *containers = generateContainers(REPLAY_CONTAINERS, REPLAY_EVENTS);
+
+	// Capture the server's datagrams.
+	uint16_t capturePort = 0;
+	int captureSocket    = openUDPSocket(&capturePort);
+
+	caerNetworkServer server = caerNetworkServerOpenUDP("127.0.0.1", capturePort, 1, REPLAY_DATAGRAM);
+	if ((captureSocket < 0) || (server == NULL)) {
+		return (false);
+	}
+
+	sendContainers(server, containers, REPLAY_CONTAINERS);
+
+	size_t datagramsNumber = (size_t) caerNetworkServerStatisticsGet(server).messagesSent;
+	caerNetworkServerClose(server);
+
+	uint8_t(*datagrams)[REPLAY_DATAGRAM] = calloc(datagramsNumber, REPLAY_DATAGRAM);
+	size_t *lengths                      = calloc(datagramsNumber, sizeof(size_t));
+
+	for (size_t i = 0; i < datagramsNumber; i++) {
+		ssize_t length = recv(captureSocket, datagrams[i], REPLAY_DATAGRAM, 0);
+		lengths[i]     = (length > 0) ? ((size_t) length) : (0);
+	}
+
+	close(captureSocket);
+
+	// Each container: a special packet in one datagram, then a polarity packet in
+	// three. Drop the middle datagram of the first polarity packet, and swap the
+	// last two of the third one: the first is incomplete then, the rest is fine.
+	size_t dropped = 2;
+	size_t swapped = 10;
+
+	caerNetworkClient client = caerNetworkClientOpenUDP("127.0.0.1", 0);
+
+	uint16_t sendPort = 0;
+	int sendSocket    = openUDPSocket(&sendPort);
+
+	struct sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family      = AF_INET;
+	address.sin_port        = htons(caerNetworkClientGetPort(client));
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	for (size_t i = 0; i < datagramsNumber; i++) {
+		size_t d = (i == swapped) ? (swapped + 1) : ((i == (swapped + 1)) ? (swapped) : (i));
+
+		if (d != dropped) {
+			sendto(sendSocket, datagrams[d], lengths[d], 0, (struct sockaddr *) &address, sizeof(address));
+		}
+	}
+
+	close(sendSocket);
+
+	struct timespec end;
+	int64_t packets = receiveAll(client, containers, REPLAY_CONTAINERS, &end);
+
+	struct caer_network_client_statistics statistics = caerNetworkClientStatisticsGet(client);
+
+	printf("UDP replay   %zu datagrams, packets %" PRIi64 ", dropped %" PRIu64 ", lost %" PRIu64
+		   ", reordered %" PRIu64 ", late %" PRIu64 "\n",
+		datagramsNumber, packets, statistics.packetsDropped, statistics.messagesLost, statistics.messagesReordered,
+		statistics.messagesLate);
+
+	bool success = (datagramsNumber == (4 * REPLAY_CONTAINERS)) && (packets == ((2 * REPLAY_CONTAINERS) - 1))
+				   && (statistics.packetsDropped == 1) && (statistics.messagesLost == 1)
+				   && (statistics.messagesReordered == 1) && (statistics.messagesLate == 0);
+
+	caerNetworkClientClose(client);
+
+	free(datagrams);
+	free(lengths);
+	freeContainers(containers, REPLAY_CONTAINERS);
+
+	return (success);
+}
+
+int main(void) {
+	caerEventPacketContainer *containers = generateContainers(CONTAINERS, POLARITY_EVENTS);
+	if (containers == NULL) {
+		return (EXIT_FAILURE);
+	}
+
+	bool tcp    = runTCP(containers);
+	bool udp    = runUDP(containers);
+	bool replay = runReplay();
+
+	printf("TCP: %s, UDP: %s, UDP replay: %s\n", (tcp) ? ("CORRECT") : ("WRONG"), (udp) ? ("CORRECT") : ("WRONG"),
+		(replay) ? ("CORRECT") : ("WRONG"));
+
+	freeContainers(containers, CONTAINERS);
+
+	return ((tcp && udp && replay) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
@@ -0,0 +1,348 @@
+// Loopback benchmark for AEDAT 3.x network streaming. Sends the same set of
+// packet containers (a large polarity packet and a few special events each)
+// over TCP, TCP with MSG_ZEROCOPY and UDP, to a receiver in a child process.
+// Reports events/s and the sender's CPU time per Gbit/s, up to the server
+// being closed, and checks that the received packet data is exactly what
+// was sent. The TCP client buffer fits all data, so nothing is dropped.
+#include <libcaer/io/network_server.h>
+
+#include <libcaer/events/polarity.h>
+#include <libcaer/events/special.h>
+#include <libcaer/network.h>
+
+#include "benchmark_utils.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define CONTAINERS      1024
+#define POLARITY_EVENTS 8192
+#define SPECIAL_EVENTS  4
+
+#define UDP_RECEIVE_BUFFER_SIZE (64 * 1024 * 1024)
+#define TCP_CLIENT_BUFFER_SIZE  (128 * 1024 * 1024)
+
+struct receiver_result {
+	uint64_t bytes;
+	uint64_t hash;
+	uint64_t messages;
+	uint64_t lost;
+};
+
+// FNV-1a, over the packet data as sent.
+static uint64_t hashUpdate(uint64_t hash, const uint8_t *data, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		hash = (hash ^ data[i]) * 0x100000001B3ULL;
+	}
+
+	return (hash);
+}
+
+#define HASH_INIT 0xCBF29CE484222325ULL
+
+static caerEventPacketContainer generateContainer(int32_t index, uint32_t *randomState) {
+	caerEventPacketContainer container = caerEventPacketContainerAllocate(2);
+	caerPolarityEventPacket polarity   = caerPolarityEventPacketAllocate(POLARITY_EVENTS, 1, 0);
+	caerSpecialEventPacket special     = caerSpecialEventPacketAllocate(SPECIAL_EVENTS, 1, 0);
+	if ((container == NULL) || (polarity == NULL) || (special == NULL)) {
+		free(container);
+		free(polarity);
+		free(special);
+		return (NULL);
+	}
+
+	int32_t timestamp = index * POLARITY_EVENTS;
+
+	for (int32_t i = 0; i < POLARITY_EVENTS; i++) {
+		uint32_t random = xorshift32(randomState);
+
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(polarity, i);
+		caerPolarityEventSetTimestamp(event, timestamp + i);
+		caerPolarityEventSetX(event, (uint16_t) (random % 346));
+		caerPolarityEventSetY(event, (uint16_t) ((random >> 16) % 260));
+		caerPolarityEventSetPolarity(event, (random >> 31) & 0x01);
+		caerPolarityEventValidate(event, polarity);
+	}
+
+	for (int32_t i = 0; i < SPECIAL_EVENTS; i++) {
+		caerSpecialEvent event = caerSpecialEventPacketGetEvent(special, i);
+		caerSpecialEventSetTimestamp(event, timestamp + (i * (POLARITY_EVENTS / SPECIAL_EVENTS)));
+		caerSpecialEventSetType(event, EXTERNAL_INPUT_RISING_EDGE);
+		caerSpecialEventValidate(event, special);
+	}
+
+	caerEventPacketContainerSetEventPacket(container, POLARITY_EVENT, (caerEventPacketHeader) polarity);
+	caerEventPacketContainerSetEventPacket(container, SPECIAL_EVENT, (caerEventPacketHeader) special);
+
+	return (container);
+}
+
+static uint64_t hashContainers(caerEventPacketContainer *containers, uint64_t *bytes) {
+	uint64_t hash = HASH_INIT;
+	*bytes        = 0;
+
+	for (size_t c = 0; c < CONTAINERS; c++) {
+		for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(containers[c]); i++) {
+			caerEventPacketHeaderConst packet = caerEventPacketContainerGetEventPacketConst(containers[c], i);
+			if ((packet == NULL) || (caerEventPacketHeaderGetEventNumber(packet) == 0)) {
+				continue;
+			}
+
+			struct caer_event_packet_header header = *packet;
+			caerEventPacketHeaderSetEventCapacity(&header, caerEventPacketHeaderGetEventNumber(packet));
+
+			size_t eventsSize = (size_t) caerEventPacketGetDataSizeEvents(packet);
+
+			hash = hashUpdate(hash, (const uint8_t *) &header, CAER_EVENT_PACKET_HEADER_SIZE);
+			hash = hashUpdate(hash, (const uint8_t *) packet + CAER_EVENT_PACKET_HEADER_SIZE, eventsSize);
+			*bytes += CAER_EVENT_PACKET_HEADER_SIZE + eventsSize;
+		}
+	}
+
+	return (hash);
+}
+
+// Child process: connect and read the stream until the server closes it.
+static struct receiver_result receiveTCP(uint16_t port) {
+	struct receiver_result result = {0, HASH_INIT, 0, 0};
+
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+	struct sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family      = AF_INET;
+	address.sin_port        = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if ((fd < 0) || (connect(fd, (struct sockaddr *) &address, sizeof(address)) != 0)) {
+		return (result);
+	}
+
+	static uint8_t buffer[256 * 1024];
+	size_t headerRemaining = AEDAT3_NETWORK_HEADER_LENGTH;
+
+	ssize_t received;
+	while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+		size_t skip = ((size_t) received < headerRemaining) ? ((size_t) received) : (headerRemaining);
+		headerRemaining -= skip;
+
+		result.hash = hashUpdate(result.hash, buffer + skip, (size_t) received - skip);
+		result.bytes += (size_t) received - skip;
+		result.messages++;
+	}
+
+	close(fd);
+
+	return (result);
+}
+
+// Child process: receive datagrams until none arrive for a while,
+// checking for gaps in the sequence numbers.
+static struct receiver_result receiveUDP(int fd) {
+	struct receiver_result result = {0, HASH_INIT, 0, 0};
+
+	struct timeval timeout = {.tv_sec = 1, .tv_usec = 0};
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+	static uint8_t buffer[65536];
+	int64_t nextSequenceNumber = 0;
+
+	ssize_t received;
+	while ((received = recv(fd, buffer, sizeof(buffer), 0)) >= AEDAT3_NETWORK_HEADER_LENGTH) {
+		struct aedat3_network_header header = caerParseNetworkHeader(buffer);
+
+		if (header.sequenceNumber != nextSequenceNumber) {
+			result.lost += (uint64_t) (header.sequenceNumber - nextSequenceNumber);
+		}
+
+		nextSequenceNumber = header.sequenceNumber + 1;
+
+		result.hash = hashUpdate(
+			result.hash, buffer + AEDAT3_NETWORK_HEADER_LENGTH, (size_t) received - AEDAT3_NETWORK_HEADER_LENGTH);
+		result.bytes += (size_t) received - AEDAT3_NETWORK_HEADER_LENGTH;
+		result.messages++;
+	}
+
+	close(fd);
+
+	return (result);
+}
+
+static int openUDPReceiver(uint16_t *port) {
+	int fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0) {
+		return (-1);
+	}
+
+	int receiveBufferSize = UDP_RECEIVE_BUFFER_SIZE;
+	setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize));
+
+	struct sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family      = AF_INET;
+	address.sin_port        = 0;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	socklen_t addressLength = sizeof(address);
+
+	if ((bind(fd, (struct sockaddr *) &address, sizeof(address)) != 0)
+		|| (getsockname(fd, (struct sockaddr *) &address, &addressLength) != 0)) {
+		close(fd);
+		return (-1);
+	}
+
+	*port = ntohs(address.sin_port);
+
+	return (fd);
+}
+
+static bool runBenchmark(const char *name, caerEventPacketContainer *containers, bool udp, bool zeroCopy,
+	uint64_t expectedBytes, uint64_t expectedHash, uint64_t totalEvents) {
+	int resultPipe[2];
+	if (pipe(resultPipe) != 0) {
+		return (false);
+	}
+
+	caerNetworkServer server = NULL;
+	int udpReceiver          = -1;
+	uint16_t port            = 0;
+
+	if (udp) {
+		udpReceiver = openUDPReceiver(&port);
+		if (udpReceiver >= 0) {
+			server = caerNetworkServerOpenUDP("127.0.0.1", port, 1, 0);
+		}
+	}
+	else {
+		server = caerNetworkServerOpenTCP("127.0.0.1", 0, 1, 1, TCP_CLIENT_BUFFER_SIZE, zeroCopy);
+		if (server != NULL) {
+			port = caerNetworkServerGetPort(server);
+		}
+	}
+
+	if (server == NULL) {
+		fprintf(stderr, "%s: failed to open server.\n", name);
+		return (false);
+	}
+
+	pid_t child = fork();
+	if (child == 0) {
+		close(resultPipe[0]);
+
+		struct receiver_result result = (udp) ? (receiveUDP(udpReceiver)) : (receiveTCP(port));
+
+		ssize_t written = write(resultPipe[1], &result, sizeof(result));
+
+		_exit(((size_t) written == sizeof(result)) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+	}
+
+	close(resultPipe[1]);
+
+	if (udp) {
+		close(udpReceiver);
+	}
+	else {
+		// Wait for the receiver to connect, sending empty containers accepts clients.
+		caerEventPacketContainer empty = caerEventPacketContainerAllocate(1);
+		struct timespec waitSleep      = {.tv_sec = 0, .tv_nsec = 1000000};
+
+		while (caerNetworkServerGetClientsNumber(server) == 0) {
+			caerNetworkServerSend(server, empty);
+			nanosleep(&waitSleep, NULL);
+		}
+
+		caerEventPacketContainerFree(empty);
+	}
+
+	struct timespec start, end, cpuStart, cpuEnd;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuStart);
+
+	bool success = true;
+
+	// The containers outlive the server, so they can be sent zero-copy.
+	for (size_t c = 0; success && (c < CONTAINERS); c++) {
+		success = caerNetworkServerSendNotify(server, containers[c], NULL, NULL);
+	}
+
+	struct caer_network_server_statistics statistics = caerNetworkServerStatisticsGet(server);
+
+	// Closing sends the data still buffered for the client.
+	caerNetworkServerClose(server);
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuEnd);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	struct receiver_result result = {0, 0, 0, 0};
+	ssize_t readBytes             = read(resultPipe[0], &result, sizeof(result));
+	close(resultPipe[0]);
+	waitpid(child, NULL, 0);
+
+	if ((!success) || ((size_t) readBytes != sizeof(result))) {
+		fprintf(stderr, "%s: send or receive failed.\n", name);
+		return (false);
+	}
+
+	double seconds    = timeDiffSeconds(&start, &end);
+	double cpuSeconds = timeDiffSeconds(&cpuStart, &cpuEnd);
+	double gbits      = ((double) result.bytes * 8.0) / 1.0e9;
+
+	printf("%-16s %8.1f MB/s  %8.2f Mevents/s  %6.3f CPU s per Gbit  %8" PRIu64 " packets dropped", name,
+		((double) result.bytes / 1.0e6) / seconds, ((double) totalEvents / 1.0e6) / seconds, cpuSeconds / gbits,
+		statistics.packetsDropped);
+
+	if (result.lost > 0) {
+		// UDP gives no guarantees, a slow receiver simply loses datagrams.
+		printf("  (%" PRIu64 " datagrams lost, data not compared)\n", result.lost);
+		return (true);
+	}
+
+	bool identical = (result.bytes == expectedBytes) && (result.hash == expectedHash);
+
+	printf("  %s\n", (identical) ? ("IDENTICAL") : ("DIFFERENT"));
+
+	return (identical);
+}
+
+int main(void) {
+	caerEventPacketContainer *containers = calloc(CONTAINERS, sizeof(caerEventPacketContainer));
+	if (containers == NULL) {
+		return (EXIT_FAILURE);
+	}
+
+	uint32_t randomState = 0x12345678;
+	uint64_t totalEvents = 0;
+
+	for (size_t c = 0; c < CONTAINERS; c++) {
+		containers[c] = generateContainer((int32_t) c, &randomState);
+		if (containers[c] == NULL) {
+			return (EXIT_FAILURE);
+		}
+
+		totalEvents += (uint64_t) caerEventPacketContainerGetEventsNumber(containers[c]);
+	}
+
+	uint64_t expectedBytes = 0;
+	uint64_t expectedHash  = hashContainers(containers, &expectedBytes);
+
+	bool success = true;
+
+	success = runBenchmark("TCP", containers, false, false, expectedBytes, expectedHash, totalEvents) && success;
+	success = runBenchmark("TCP (zero-copy)", containers, false, true, expectedBytes, expectedHash, totalEvents)
+			  && success;
+	success = runBenchmark("UDP", containers, true, false, expectedBytes, expectedHash, totalEvents) && success;
+
+	for (size_t c = 0; c < CONTAINERS; c++) {
+		caerEventPacketContainerFree(containers[c]);
+	}
+
+	free(containers);
+
+	return ((success) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
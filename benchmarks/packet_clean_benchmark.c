@@ -0,0 +1,163 @@
+// Benchmark for caerEventPacketClean() on polarity event packets, as left
+// by a noise filter invalidating a growing share of events. Cleans the same
+// packets once with a per-event copy loop, like the generic clean path, and
+// once with caerEventPacketClean(), which compacts 8 byte events (polarity,
+// special, spike) with SIMD where available, and compares the results.
+#include <libcaer/events/polarity.h>
+
+#include "benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACKET_EVENTS  8192
+#define PACKETS_NUMBER 256
+#define BENCHMARK_RUNS 10
+
+static size_t packetSize(const void *packet) {
+	const struct caer_event_packet_header *header = packet;
+
+	return (sizeof(struct caer_event_packet_header)
+			+ ((size_t) caerEventPacketHeaderGetEventCapacity(header)
+				* (size_t) caerEventPacketHeaderGetEventSize(header)));
+}
+
+static void cleanPerEvent(caerEventPacketHeader packet) {
+	int32_t eventValid  = caerEventPacketHeaderGetEventValid(packet);
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(packet);
+	int32_t eventSize   = caerEventPacketHeaderGetEventSize(packet);
+
+	if (eventValid == eventNumber) {
+		return;
+	}
+
+	size_t offset = CAER_EVENT_PACKET_HEADER_SIZE;
+
+	CAER_ITERATOR_VALID_START(packet, const void *)
+		void *dest = ((uint8_t *) packet) + offset;
+
+		if (dest != caerIteratorElement) {
+			memcpy(dest, caerIteratorElement, (size_t) eventSize);
+		}
+
+		offset += (size_t) eventSize;
+	CAER_ITERATOR_VALID_END
+
+	memset(((uint8_t *) packet) + offset, 0, (size_t) (eventNumber - eventValid) * (size_t) eventSize);
+
+	caerEventPacketHeaderSetEventNumber(packet, eventValid);
+}
+
+static double benchmark(void (*cleaner)(caerEventPacketHeader), caerPolarityEventPacket *templates,
+	caerPolarityEventPacket *packets) {
+	double bestTime = 1.0e9;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		for (size_t i = 0; i < PACKETS_NUMBER; i++) {
+			memcpy(packets[i], templates[i], packetSize(templates[i]));
+		}
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		for (size_t i = 0; i < PACKETS_NUMBER; i++) {
+			(*cleaner)(&packets[i]->packetHeader);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		double time = timeDiffSeconds(&start, &end);
+		if (time < bestTime) {
+			bestTime = time;
+		}
+	}
+
+	return (bestTime);
+}
+
+static bool allocatePackets(caerPolarityEventPacket *packets) {
+	for (size_t i = 0; i < PACKETS_NUMBER; i++) {
+		packets[i] = caerPolarityEventPacketAllocate(PACKET_EVENTS, 1, 0);
+		if (packets[i] == NULL) {
+			return (false);
+		}
+	}
+
+	return (true);
+}
+
+static void freePackets(caerPolarityEventPacket *packets) {
+	for (size_t i = 0; i < PACKETS_NUMBER; i++) {
+		free(packets[i]);
+	}
+}
+
+int main(void) {
+	static caerPolarityEventPacket templates[PACKETS_NUMBER];
+	static caerPolarityEventPacket perEvent[PACKETS_NUMBER];
+	static caerPolarityEventPacket library[PACKETS_NUMBER];
+
+	if (!allocatePackets(templates) || !allocatePackets(perEvent) || !allocatePackets(library)) {
+		fprintf(stderr, "Failed to allocate polarity packets.\n");
+		return (EXIT_FAILURE);
+	}
+
+	static const uint32_t invalidPercentages[] = {10, 30, 50, 70, 90};
+	bool identical                             = true;
+
+	printf("%d packets of %d events.\n", PACKETS_NUMBER, PACKET_EVENTS);
+
+	for (size_t r = 0; r < (sizeof(invalidPercentages) / sizeof(invalidPercentages[0])); r++) {
+		// Random addresses and polarities, increasing timestamps, and the
+		// given share of events invalidated at random.
+		uint32_t rng      = 0x12345678;
+		int32_t timestamp = 0;
+
+		for (size_t p = 0; p < PACKETS_NUMBER; p++) {
+			caerPolarityEventPacket packet = templates[p];
+
+			caerEventPacketClear(&packet->packetHeader);
+
+			for (int32_t i = 0; i < PACKET_EVENTS; i++) {
+				caerPolarityEvent event = caerPolarityEventPacketGetEvent(packet, i);
+
+				timestamp += I32T(xorshift32(&rng) % 4);
+
+				caerPolarityEventSetTimestamp(event, timestamp);
+				caerPolarityEventSetX(event, U16T(xorshift32(&rng) % 640));
+				caerPolarityEventSetY(event, U16T(xorshift32(&rng) % 480));
+				caerPolarityEventSetPolarity(event, xorshift32(&rng) & 0x01);
+				caerPolarityEventValidate(event, packet);
+
+				if ((xorshift32(&rng) % 100) < invalidPercentages[r]) {
+					caerPolarityEventInvalidate(event, packet);
+				}
+			}
+
+			caerEventPacketHeaderSetEventNumber(&packet->packetHeader, PACKET_EVENTS);
+		}
+
+		double perEventTime = benchmark(&cleanPerEvent, templates, perEvent);
+		double libraryTime  = benchmark(&caerEventPacketClean, templates, library);
+
+		bool same = true;
+
+		for (size_t p = 0; p < PACKETS_NUMBER; p++) {
+			same = same && (memcmp(perEvent[p], library[p], packetSize(perEvent[p])) == 0);
+		}
+
+		identical = identical && same;
+
+		printf("%2" PRIu32 "%% invalid: per-event %7.1f Mev/s, clean %7.1f Mev/s, speed-up %.2fx, %s.\n",
+			invalidPercentages[r], (double) (PACKETS_NUMBER * PACKET_EVENTS) / perEventTime / 1.0e6,
+			(double) (PACKETS_NUMBER * PACKET_EVENTS) / libraryTime / 1.0e6, perEventTime / libraryTime,
+			(same) ? ("IDENTICAL") : ("DIFFERENT"));
+	}
+
+	freePackets(templates);
+	freePackets(perEvent);
+	freePackets(library);
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
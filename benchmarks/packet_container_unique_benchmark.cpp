@@ -0,0 +1,169 @@
+// Benchmark for EventPacketContainerUnique. Takes over a stream of small
+// C packet containers, like the ones returned by dataGet() every few
+// milliseconds, and counts their valid polarity events, once wrapping them
+// into an EventPacketContainer of shared EventPackets, and once into an
+// EventPacketContainerUnique with typed views, and checks both count the same.
+#include <libcaercpp/events/imu6.hpp>
+#include <libcaercpp/events/packetContainer.hpp>
+#include <libcaercpp/events/polarity.hpp>
+#include <libcaercpp/events/special.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define CONTAINERS_NUMBER 100000
+#define POLARITY_EVENTS   64
+#define BENCHMARK_RUNS    5
+
+static caerEventPacketContainer generateContainer(int32_t start) {
+	caerEventPacketContainer container = caerEventPacketContainerAllocate(4);
+	if (container == nullptr) {
+		return (nullptr);
+	}
+
+	caerSpecialEventPacket special   = caerSpecialEventPacketAllocate(1, 1, 0);
+	caerPolarityEventPacket polarity = caerPolarityEventPacketAllocate(POLARITY_EVENTS, 1, 0);
+	caerIMU6EventPacket imu6         = caerIMU6EventPacketAllocate(1, 1, 0);
+	if ((special == nullptr) || (polarity == nullptr) || (imu6 == nullptr)) {
+		caerEventPacketFree(reinterpret_cast<caerEventPacketHeader>(special));
+		caerEventPacketFree(reinterpret_cast<caerEventPacketHeader>(polarity));
+		caerEventPacketFree(reinterpret_cast<caerEventPacketHeader>(imu6));
+		caerEventPacketContainerFree(container);
+		return (nullptr);
+	}
+
+	caerSpecialEventSetTimestamp(caerSpecialEventPacketGetEvent(special, 0), start);
+	caerSpecialEventValidate(caerSpecialEventPacketGetEvent(special, 0), special);
+	caerEventPacketHeaderSetEventNumber(&special->packetHeader, 1);
+
+	for (int32_t i = 0; i < POLARITY_EVENTS; i++) {
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(polarity, i);
+
+		caerPolarityEventSetTimestamp(event, start + i);
+		caerPolarityEventSetX(event, static_cast<uint16_t>(i));
+		caerPolarityEventValidate(event, polarity);
+
+		// Some events removed by a noise filter.
+		if ((i % 5) == 0) {
+			caerPolarityEventInvalidate(event, polarity);
+		}
+	}
+
+	caerEventPacketHeaderSetEventNumber(&polarity->packetHeader, POLARITY_EVENTS);
+
+	caerIMU6EventSetTimestamp(caerIMU6EventPacketGetEvent(imu6, 0), start);
+	caerIMU6EventValidate(caerIMU6EventPacketGetEvent(imu6, 0), imu6);
+	caerEventPacketHeaderSetEventNumber(&imu6->packetHeader, 1);
+
+	// Index 3 stays empty, like the frame packet of a container without frames.
+	caerEventPacketContainerSetEventPacket(container, 0, &special->packetHeader);
+	caerEventPacketContainerSetEventPacket(container, 1, &polarity->packetHeader);
+	caerEventPacketContainerSetEventPacket(container, 2, &imu6->packetHeader);
+
+	return (container);
+}
+
+// Same as what device::dataGet() does, then consume the container.
+static int64_t consumeShared(caerEventPacketContainer cContainer) {
+	std::unique_ptr<libcaer::events::EventPacketContainer> container
+		= std::unique_ptr<libcaer::events::EventPacketContainer>(
+			new libcaer::events::EventPacketContainer(cContainer));
+	caerFree(cContainer);
+
+	int64_t validEvents = 0;
+
+	for (const auto &packet : *container) {
+		if ((packet != nullptr) && (packet->getEventType() == POLARITY_EVENT)) {
+			auto polarity = std::static_pointer_cast<const libcaer::events::PolarityEventPacket>(packet);
+
+			for (const auto &event : *polarity) {
+				validEvents += event.isValid();
+			}
+		}
+	}
+
+	return (validEvents);
+}
+
+// Same as what device::dataGetUnique() does, then consume the container.
+static int64_t consumeUnique(caerEventPacketContainer cContainer) {
+	libcaer::events::EventPacketContainerUnique container(cContainer);
+
+	int64_t validEvents = 0;
+
+	for (libcaer::events::EventPacketContainerUnique::size_type i = 0; i < container.size(); i++) {
+		caerEventPacketHeader packet = container.getEventPacket(i);
+
+		if ((packet != nullptr) && (caerEventPacketHeaderGetEventType(packet) == POLARITY_EVENT)) {
+			const auto polarity = container.viewEventPacket<libcaer::events::PolarityEventPacket>(i);
+
+			for (const auto &event : polarity) {
+				validEvents += event.isValid();
+			}
+		}
+	}
+
+	return (validEvents);
+}
+
+static double benchmark(int64_t (*consumer)(caerEventPacketContainer), caerEventPacketContainer templateContainer,
+	std::vector<caerEventPacketContainer> &containers, int64_t *validEvents) {
+	double bestTime = 1.0e9;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		// Fresh containers every run, as they are consumed.
+		for (auto &container : containers) {
+			container = caerEventPacketContainerCopyAllEvents(templateContainer);
+			if (container == nullptr) {
+				fprintf(stderr, "Failed to copy packet container.\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		*validEvents = 0;
+
+		for (auto &container : containers) {
+			*validEvents += (*consumer)(container);
+		}
+
+		auto end = std::chrono::steady_clock::now();
+
+		double time = std::chrono::duration<double>(end - start).count();
+		if (time < bestTime) {
+			bestTime = time;
+		}
+	}
+
+	return (bestTime);
+}
+
+int main(void) {
+	caerEventPacketContainer templateContainer = generateContainer(0);
+	if (templateContainer == nullptr) {
+		fprintf(stderr, "Failed to allocate packet container.\n");
+		return (EXIT_FAILURE);
+	}
+
+	std::vector<caerEventPacketContainer> containers(CONTAINERS_NUMBER);
+
+	int64_t sharedEvents, uniqueEvents;
+
+	double sharedTime = benchmark(&consumeShared, templateContainer, containers, &sharedEvents);
+	double uniqueTime = benchmark(&consumeUnique, templateContainer, containers, &uniqueEvents);
+
+	bool identical = (sharedEvents == uniqueEvents);
+
+	printf("%d containers of 3 packets, %d polarity events each.\n", CONTAINERS_NUMBER, POLARITY_EVENTS);
+	printf("EventPacketContainer: %7.2f Mcontainers/s, EventPacketContainerUnique: %7.2f Mcontainers/s, speed-up "
+		   "%.2fx, %s.\n",
+		CONTAINERS_NUMBER / sharedTime / 1.0e6, CONTAINERS_NUMBER / uniqueTime / 1.0e6, sharedTime / uniqueTime,
+		(identical) ? ("IDENTICAL") : ("DIFFERENT"));
+
+	caerEventPacketContainerFree(templateContainer);
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
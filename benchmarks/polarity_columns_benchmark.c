@@ -0,0 +1,180 @@
+// Benchmark for the conversion between packed polarity event packets and
+// columnar (structure-of-arrays) polarity event packets. Converts a large
+// packet with a few invalid events, as left by a noise filter, once through
+// the per-event accessors and once through the library conversion functions
+// (SIMD where available), both ways, and compares the results.
+#include <libcaer/events/polarityColumns.h>
+
+#include "benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACKET_EVENTS  (8 * 1024 * 1024)
+#define BENCHMARK_RUNS 10
+
+static caerPolarityColumnsEventPacket toColumnsScalar(caerPolarityEventPacketConst packet) {
+	caerPolarityColumnsEventPacket columns = caerPolarityColumnsEventPacketAllocate(
+		caerEventPacketHeaderGetEventValid(&packet->packetHeader), 1, 0);
+	if (columns == NULL) {
+		return (NULL);
+	}
+
+	int32_t position = 0;
+
+	CAER_POLARITY_CONST_ITERATOR_VALID_START(packet)
+		caerPolarityColumnsEventPacketSetEvent(columns, position,
+			caerPolarityEventGetTimestamp(caerPolarityIteratorElement), caerPolarityEventGetX(caerPolarityIteratorElement),
+			caerPolarityEventGetY(caerPolarityIteratorElement), caerPolarityEventGetPolarity(caerPolarityIteratorElement));
+		position++;
+	CAER_POLARITY_ITERATOR_VALID_END
+
+	return (columns);
+}
+
+static caerPolarityEventPacket fromColumnsScalar(caerPolarityColumnsEventPacketConst columns) {
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(&columns->packetHeader);
+
+	caerPolarityEventPacket packet = caerPolarityEventPacketAllocate(eventNumber, 1, 0);
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	const uint16_t *xAddr     = caerPolarityColumnsEventPacketGetXConst(columns);
+	const uint16_t *yAddr     = caerPolarityColumnsEventPacketGetYConst(columns);
+	const uint8_t *polarities = caerPolarityColumnsEventPacketGetPolaritiesConst(columns);
+
+	for (int32_t i = 0; i < eventNumber; i++) {
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(packet, i);
+
+		caerPolarityEventSetTimestamp(event, caerPolarityColumnsEventPacketGetTimestamp(columns, i));
+		caerPolarityEventSetX(event, le16toh(xAddr[i]));
+		caerPolarityEventSetY(event, le16toh(yAddr[i]));
+		caerPolarityEventSetPolarity(event, polarities[i]);
+		caerPolarityEventValidate(event, packet);
+	}
+
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader, eventNumber);
+
+	return (packet);
+}
+
+static double benchmark(const char *name, void *(*converter)(const void *), const void *input, void **result) {
+	double bestTime = 1.0e9;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		void *output = (*converter)(input);
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		if (output == NULL) {
+			fprintf(stderr, "Failed to convert packet.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		double time = timeDiffSeconds(&start, &end);
+		if (time < bestTime) {
+			bestTime = time;
+		}
+
+		if (run == (BENCHMARK_RUNS - 1)) {
+			*result = output;
+		}
+		else {
+			free(output);
+		}
+	}
+
+	printf("%-16s: %d events in %.3f ms, %.1f Mev/s.\n", name, PACKET_EVENTS, bestTime * 1000.0,
+		(double) PACKET_EVENTS / bestTime / 1.0e6);
+
+	return (bestTime);
+}
+
+static void *toColumnsScalarWrapper(const void *packet) {
+	return (toColumnsScalar(packet));
+}
+
+static void *toColumnsWrapper(const void *packet) {
+	return (caerPolarityColumnsEventPacketFromPolarity(packet));
+}
+
+static void *fromColumnsScalarWrapper(const void *columns) {
+	return (fromColumnsScalar(columns));
+}
+
+static void *fromColumnsWrapper(const void *columns) {
+	return (caerPolarityEventPacketFromPolarityColumns(columns));
+}
+
+static size_t packetSize(const void *packet) {
+	const struct caer_event_packet_header *header = packet;
+
+	return (sizeof(struct caer_event_packet_header)
+			+ ((size_t) caerEventPacketHeaderGetEventCapacity(header)
+				* (size_t) caerEventPacketHeaderGetEventSize(header)));
+}
+
+int main(void) {
+	caerPolarityEventPacket packet = caerPolarityEventPacketAllocate(PACKET_EVENTS, 1, 0);
+	if (packet == NULL) {
+		fprintf(stderr, "Failed to allocate polarity packet.\n");
+		return (EXIT_FAILURE);
+	}
+
+	// Random addresses and polarities, increasing timestamps, and about
+	// one in a thousand events invalidated.
+	uint32_t rng      = 0x12345678;
+	int32_t timestamp = 0;
+
+	for (int32_t i = 0; i < PACKET_EVENTS; i++) {
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(packet, i);
+
+		timestamp += I32T(xorshift32(&rng) % 4);
+
+		caerPolarityEventSetTimestamp(event, timestamp);
+		caerPolarityEventSetX(event, U16T(xorshift32(&rng) % 640));
+		caerPolarityEventSetY(event, U16T(xorshift32(&rng) % 480));
+		caerPolarityEventSetPolarity(event, xorshift32(&rng) & 0x01);
+		caerPolarityEventValidate(event, packet);
+
+		if ((xorshift32(&rng) % 1000) == 0) {
+			caerPolarityEventInvalidate(event, packet);
+		}
+	}
+
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader, PACKET_EVENTS);
+
+	void *scalarColumns = NULL;
+	void *simdColumns   = NULL;
+	void *scalarPacket  = NULL;
+	void *simdPacket    = NULL;
+
+	printf("Packed to columns:\n");
+	double scalarTime = benchmark("accessors", &toColumnsScalarWrapper, packet, &scalarColumns);
+	double simdTime   = benchmark("conversion", &toColumnsWrapper, packet, &simdColumns);
+	printf("Speed-up: %.2fx.\n", scalarTime / simdTime);
+
+	printf("Columns to packed:\n");
+	scalarTime = benchmark("accessors", &fromColumnsScalarWrapper, scalarColumns, &scalarPacket);
+	simdTime   = benchmark("conversion", &fromColumnsWrapper, scalarColumns, &simdPacket);
+	printf("Speed-up: %.2fx.\n", scalarTime / simdTime);
+
+	// Both ways must produce exactly the same packets.
+	bool identical = (memcmp(scalarColumns, simdColumns, packetSize(scalarColumns)) == 0)
+					 && (memcmp(scalarPacket, simdPacket, packetSize(scalarPacket)) == 0);
+
+	printf("Results identical: %s.\n", (identical) ? ("yes") : ("NO"));
+
+	free(packet);
+	free(scalarColumns);
+	free(simdColumns);
+	free(scalarPacket);
+	free(simdPacket);
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
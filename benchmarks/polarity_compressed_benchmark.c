@@ -0,0 +1,277 @@
+// Benchmark for the compressed polarity event packets. Compresses a set
+// of polarity packets, with and without run-length coding of timestamps,
+// measures the size and the compression and decompression speed (SIMD
+// where available), and checks that decompression gives back exactly the
+// original events.
+// Without arguments, synthetic data is used: DAVIS-like (346x260, events
+// one by one with small timestamp steps) and DVXplorer-like (640x480, events
+// read out in row bursts sharing a timestamp). An AEDAT 3.x recording can be
+// given as argument, then its polarity packets are used as well.
+#include <libcaer/events/polarityCompressed.h>
+#include <libcaer/io/file_reader.h>
+
+#include "benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACKET_EVENTS  8192
+#define PACKETS_NUMBER 512
+#define BENCHMARK_RUNS 5
+
+struct dataset {
+	const char *name;
+	caerPolarityEventPacket *packets;
+	size_t packetsNumber;
+	size_t eventsNumber;
+};
+
+static size_t packetSize(const void *packet) {
+	const struct caer_event_packet_header *header = packet;
+
+	return (sizeof(struct caer_event_packet_header)
+			+ ((size_t) caerEventPacketHeaderGetEventCapacity(header)
+				* (size_t) caerEventPacketHeaderGetEventSize(header)));
+}
+
+static bool datasetAllocate(struct dataset *data, const char *name, size_t packetsNumber) {
+	data->name          = name;
+	data->packets       = calloc(packetsNumber, sizeof(caerPolarityEventPacket));
+	data->packetsNumber = 0;
+	data->eventsNumber  = 0;
+
+	return (data->packets != NULL);
+}
+
+static void datasetFree(struct dataset *data) {
+	for (size_t i = 0; i < data->packetsNumber; i++) {
+		free(data->packets[i]);
+	}
+
+	free(data->packets);
+}
+
+// DAVIS: events come one by one, timestamps increase by a few microseconds.
+static bool generateDavis(struct dataset *data) {
+	if (!datasetAllocate(data, "DAVIS 346x260", PACKETS_NUMBER)) {
+		return (false);
+	}
+
+	uint32_t rng      = 0x12345678;
+	int32_t timestamp = 0;
+
+	for (size_t p = 0; p < PACKETS_NUMBER; p++) {
+		caerPolarityEventPacket packet = caerPolarityEventPacketAllocate(PACKET_EVENTS, 1, 0);
+		if (packet == NULL) {
+			return (false);
+		}
+
+		for (int32_t i = 0; i < PACKET_EVENTS; i++) {
+			caerPolarityEvent event = caerPolarityEventPacketGetEvent(packet, i);
+
+			timestamp += I32T(xorshift32(&rng) % 4);
+
+			caerPolarityEventSetTimestamp(event, timestamp);
+			caerPolarityEventSetX(event, U16T(xorshift32(&rng) % 346));
+			caerPolarityEventSetY(event, U16T(xorshift32(&rng) % 260));
+			caerPolarityEventSetPolarity(event, xorshift32(&rng) & 0x01);
+			caerPolarityEventValidate(event, packet);
+		}
+
+		caerEventPacketHeaderSetEventNumber(&packet->packetHeader, PACKET_EVENTS);
+
+		data->packets[data->packetsNumber++] = packet;
+		data->eventsNumber += PACKET_EVENTS;
+	}
+
+	return (true);
+}
+
+// DVXplorer: a row is read out at once, so its events share a timestamp.
+static bool generateDvxplorer(struct dataset *data) {
+	if (!datasetAllocate(data, "DVXplorer 640x480", PACKETS_NUMBER)) {
+		return (false);
+	}
+
+	uint32_t rng      = 0x87654321;
+	int32_t timestamp = 0;
+
+	for (size_t p = 0; p < PACKETS_NUMBER; p++) {
+		caerPolarityEventPacket packet = caerPolarityEventPacketAllocate(PACKET_EVENTS, 1, 0);
+		if (packet == NULL) {
+			return (false);
+		}
+
+		int32_t i = 0;
+
+		while (i < PACKET_EVENTS) {
+			timestamp += I32T(1 + (xorshift32(&rng) % 10));
+
+			uint16_t y       = U16T(xorshift32(&rng) % 480);
+			uint16_t x       = U16T(xorshift32(&rng) % 64);
+			int32_t burstEnd = i + I32T(1 + (xorshift32(&rng) % 32));
+
+			for (; (i < burstEnd) && (i < PACKET_EVENTS); i++) {
+				caerPolarityEvent event = caerPolarityEventPacketGetEvent(packet, i);
+
+				x = U16T(x + 1 + (xorshift32(&rng) % 16));
+				if (x >= 640) {
+					x = U16T(x - 640);
+				}
+
+				caerPolarityEventSetTimestamp(event, timestamp);
+				caerPolarityEventSetX(event, x);
+				caerPolarityEventSetY(event, y);
+				caerPolarityEventSetPolarity(event, xorshift32(&rng) & 0x01);
+				caerPolarityEventValidate(event, packet);
+			}
+		}
+
+		caerEventPacketHeaderSetEventNumber(&packet->packetHeader, PACKET_EVENTS);
+
+		data->packets[data->packetsNumber++] = packet;
+		data->eventsNumber += PACKET_EVENTS;
+	}
+
+	return (true);
+}
+
+// Recording: all polarity packets of the file, with only their valid events.
+static bool loadRecording(struct dataset *data, const char *fileName) {
+	caerFileReader reader = caerFileReaderOpen(fileName, NULL);
+	if (reader == NULL) {
+		return (false);
+	}
+
+	size_t packetsNumber = caerFileReaderGetPacketsNumber(reader);
+
+	if (!datasetAllocate(data, fileName, packetsNumber)) {
+		caerFileReaderClose(reader);
+		return (false);
+	}
+
+	for (size_t i = 0; i < packetsNumber; i++) {
+		caerEventPacketHeaderConst header = caerFileReaderGetPacket(reader, i);
+
+		if ((caerEventPacketHeaderGetEventType(header) != POLARITY_EVENT)
+			|| (caerEventPacketHeaderGetEventValid(header) == 0)) {
+			continue;
+		}
+
+		caerPolarityEventPacket packet = (caerPolarityEventPacket) caerEventPacketCopyOnlyValidEvents(header);
+		if (packet == NULL) {
+			caerFileReaderClose(reader);
+			return (false);
+		}
+
+		data->packets[data->packetsNumber++] = packet;
+		data->eventsNumber += (size_t) caerEventPacketHeaderGetEventNumber(&packet->packetHeader);
+	}
+
+	caerFileReaderClose(reader);
+
+	return (data->packetsNumber > 0);
+}
+
+static bool benchmark(const struct dataset *data, bool runLength) {
+	caerPolarityCompressedEventPacket *compressed = calloc(data->packetsNumber, sizeof(*compressed));
+	caerPolarityEventPacket *decompressed         = calloc(data->packetsNumber, sizeof(*decompressed));
+	if ((compressed == NULL) || (decompressed == NULL)) {
+		free(compressed);
+		free(decompressed);
+		return (false);
+	}
+
+	double compressTime   = 1.0e9;
+	double decompressTime = 1.0e9;
+	bool identical        = true;
+	size_t inputBytes     = 0;
+	size_t outputBytes    = 0;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		struct timespec start, middle, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		for (size_t i = 0; i < data->packetsNumber; i++) {
+			compressed[i] = caerPolarityCompressedEventPacketFromPolarity(data->packets[i], runLength);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &middle);
+
+		for (size_t i = 0; i < data->packetsNumber; i++) {
+			decompressed[i] = caerPolarityEventPacketFromPolarityCompressed(compressed[i]);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		if (timeDiffSeconds(&start, &middle) < compressTime) {
+			compressTime = timeDiffSeconds(&start, &middle);
+		}
+
+		if (timeDiffSeconds(&middle, &end) < decompressTime) {
+			decompressTime = timeDiffSeconds(&middle, &end);
+		}
+
+		inputBytes  = 0;
+		outputBytes = 0;
+
+		for (size_t i = 0; i < data->packetsNumber; i++) {
+			if ((compressed[i] == NULL) || (decompressed[i] == NULL)
+				|| (packetSize(decompressed[i]) != packetSize(data->packets[i]))
+				|| (memcmp(decompressed[i], data->packets[i], packetSize(data->packets[i])) != 0)) {
+				identical = false;
+			}
+
+			inputBytes += packetSize(data->packets[i]);
+			outputBytes += (compressed[i] == NULL) ? (0) : (packetSize(compressed[i]));
+
+			free(compressed[i]);
+			free(decompressed[i]);
+		}
+	}
+
+	free(compressed);
+	free(decompressed);
+
+	printf("  %-11s: %5.2f bytes/event, ratio %5.2f, compress %7.1f Mev/s (%6.0f MB/s), decompress %7.1f Mev/s "
+		   "(%6.0f MB/s), %s.\n",
+		(runLength) ? ("run-length") : ("plain"), (double) outputBytes / (double) data->eventsNumber,
+		(double) inputBytes / (double) outputBytes, (double) data->eventsNumber / compressTime / 1.0e6,
+		(double) inputBytes / compressTime / 1.0e6, (double) data->eventsNumber / decompressTime / 1.0e6,
+		(double) inputBytes / decompressTime / 1.0e6, (identical) ? ("IDENTICAL") : ("DIFFERENT"));
+
+	return (identical);
+}
+
+int main(int argc, char *argv[]) {
+	struct dataset datasets[3];
+	size_t datasetsNumber = 0;
+	bool success          = true;
+
+	if (!generateDavis(&datasets[datasetsNumber++]) || !generateDvxplorer(&datasets[datasetsNumber++])) {
+		fprintf(stderr, "Failed to generate synthetic data.\n");
+		success = false;
+	}
+
+	if (success && (argc > 1)) {
+		if (!loadRecording(&datasets[datasetsNumber++], argv[1])) {
+			fprintf(stderr, "Failed to load polarity packets from '%s'.\n", argv[1]);
+			success = false;
+		}
+	}
+
+	for (size_t i = 0; success && (i < datasetsNumber); i++) {
+		printf("%s: %zu packets, %zu events.\n", datasets[i].name, datasets[i].packetsNumber,
+			datasets[i].eventsNumber);
+
+		success = benchmark(&datasets[i], false) && success;
+		success = benchmark(&datasets[i], true) && success;
+	}
+
+	for (size_t i = 0; i < datasetsNumber; i++) {
+		datasetFree(&datasets[i]);
+	}
+
+	return ((success) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
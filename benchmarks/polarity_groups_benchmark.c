@@ -0,0 +1,187 @@
+// Benchmark for the 8-pixel group expansion used by the DVXplorer MIPI CX3
+// and Samsung EVK event translators. Replays synthetic SGROUP/MGROUP words,
+// with the density of a saturated sensor (most group bits set), through the
+// per-bit setter loop and through polarityGroupExpand(), and compares them.
+// Both word formats are exercised: DVXplorer (little-endian, polarity 1 is ON)
+// and Samsung EVK (big-endian, polarity 0 is ON).
+// Uses internal libcaer headers, not part of the public API.
+#include <libcaer/events/polarity.h>
+
+#include "benchmark_utils.h"
+#include "polarity_groups.h"
+
+#define GROUP_WORDS   (4 * 1024 * 1024)
+#define BENCHMARK_RUNS 10
+
+static bool samsungEVKFormat = false;
+
+static inline uint32_t groupWord(const uint32_t *words, size_t w) {
+	return ((samsungEVKFormat) ? (be32toh(words[w])) : (le32toh(words[w])));
+}
+
+static inline bool groupPolarity(uint32_t event, int32_t group) {
+	bool polarity = (event >> (16 + group)) & 0x01;
+
+	return ((samsungEVKFormat) ? (!polarity) : (polarity));
+}
+
+static int32_t decodeScalar(caerPolarityEventPacket packet, const uint32_t *words, size_t wordsNumber) {
+	int32_t position = 0;
+
+	for (size_t w = 0; w < wordsNumber; w++) {
+		const uint32_t event = groupWord(words, w);
+
+		int32_t group1Address = ((event >> 18) & 0x003F) * 8;
+		int32_t group2Address = group1Address + (I32T((event >> 26) & 0x001F) * 8);
+
+		for (int32_t g = 0; g < 2; g++) {
+			uint8_t groupEvents = U8T(event >> (8 * g));
+			bool polarity       = groupPolarity(event, g);
+			int32_t groupAddr   = (g == 0) ? (group1Address) : (group2Address);
+
+			for (uint8_t i = 0, mask = 0x01; i < 8; i++, mask = U8T(mask << 1)) {
+				if ((groupEvents & mask) == 0) {
+					continue;
+				}
+
+				caerPolarityEvent currentPolarityEvent = caerPolarityEventPacketGetEvent(packet, position);
+
+				caerPolarityEventSetTimestamp(currentPolarityEvent, I32T(w));
+				caerPolarityEventSetPolarity(currentPolarityEvent, polarity);
+				caerPolarityEventSetX(currentPolarityEvent, 100);
+				caerPolarityEventSetY(currentPolarityEvent, U16T(groupAddr + i));
+				caerPolarityEventValidate(currentPolarityEvent, packet);
+				position++;
+			}
+		}
+	}
+
+	return (position);
+}
+
+static int32_t decodeGroups(caerPolarityEventPacket packet, const uint32_t *words, size_t wordsNumber) {
+	int32_t position = 0;
+
+	for (size_t w = 0; w < wordsNumber; w++) {
+		const uint32_t event = groupWord(words, w);
+
+		int32_t group1Address = ((event >> 18) & 0x003F) * 8;
+		int32_t group2Address = group1Address + (I32T((event >> 26) & 0x001F) * 8);
+
+		caerPolarityEvent groupEvents = caerPolarityEventPacketGetEvent(packet, position);
+
+		int32_t groupEventsNumber = polarityGroupExpand(groupEvents, U8T(event),
+			polarityGroupBaseData(100, U16T(group1Address), groupPolarity(event, 0)), POLARITY_Y_ADDR_SHIFT, I32T(w));
+
+		groupEventsNumber += polarityGroupExpand(&groupEvents[groupEventsNumber], U8T(event >> 8),
+			polarityGroupBaseData(100, U16T(group2Address), groupPolarity(event, 1)), POLARITY_Y_ADDR_SHIFT, I32T(w));
+
+		polarityGroupCommit(packet, groupEventsNumber);
+		position += groupEventsNumber;
+	}
+
+	return (position);
+}
+
+static double benchmark(const char *name, int32_t (*decoder)(caerPolarityEventPacket, const uint32_t *, size_t),
+	const uint32_t *words, size_t wordsNumber, caerPolarityEventPacket *result) {
+	double bestTime = 1.0e9;
+	int32_t events  = 0;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		// Packet sized like a translator would (16 events per group word), zeroed.
+		caerPolarityEventPacket packet = caerPolarityEventPacketAllocate(I32T(wordsNumber * 16), 1, 0);
+		if (packet == NULL) {
+			fprintf(stderr, "Failed to allocate polarity packet.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		events = (*decoder)(packet, words, wordsNumber);
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		double time = timeDiffSeconds(&start, &end);
+		if (time < bestTime) {
+			bestTime = time;
+		}
+
+		if (run == (BENCHMARK_RUNS - 1)) {
+			*result = packet;
+		}
+		else {
+			free(packet);
+		}
+	}
+
+	printf("%-8s: %d events in %.3f ms, %.1f Mev/s.\n", name, events, bestTime * 1000.0,
+		(double) events / bestTime / 1.0e6);
+
+	return (bestTime);
+}
+
+int main(void) {
+	uint32_t *values = malloc(GROUP_WORDS * sizeof(uint32_t));
+	uint32_t *words  = malloc(GROUP_WORDS * sizeof(uint32_t));
+	if ((values == NULL) || (words == NULL)) {
+		fprintf(stderr, "Failed to allocate group words.\n");
+		free(values);
+		free(words);
+		return (EXIT_FAILURE);
+	}
+
+	// Saturated sensor: each group has on average 6 out of 8 pixels active.
+	uint32_t rng = 0x12345678;
+
+	for (size_t i = 0; i < GROUP_WORDS; i++) {
+		uint32_t g1Events = (xorshift32(&rng) | xorshift32(&rng)) & 0xFF;
+		uint32_t g2Events = (xorshift32(&rng) | xorshift32(&rng)) & 0xFF;
+		uint32_t g1Addr   = xorshift32(&rng) % 40;
+		uint32_t g2Offset = xorshift32(&rng) % 20;
+		uint32_t pols     = xorshift32(&rng) & 0x03;
+
+		values[i] = 0x80000000U | (g2Offset << 26) | (g1Addr << 18) | (pols << 16) | (g2Events << 8) | g1Events;
+	}
+
+	bool identical = true;
+
+	for (size_t format = 0; format < 2; format++) {
+		samsungEVKFormat = (format == 1);
+
+		// Store the words in the byte order the device would send them in.
+		for (size_t i = 0; i < GROUP_WORDS; i++) {
+			words[i] = (samsungEVKFormat) ? (htobe32(values[i])) : (htole32(values[i]));
+		}
+
+		printf("%s format:\n", (samsungEVKFormat) ? ("Samsung EVK") : ("DVXplorer"));
+
+		caerPolarityEventPacket scalarResult = NULL;
+		caerPolarityEventPacket groupsResult = NULL;
+
+		double scalarTime = benchmark("scalar", &decodeScalar, words, GROUP_WORDS, &scalarResult);
+		double groupsTime = benchmark("groups", &decodeGroups, words, GROUP_WORDS, &groupsResult);
+
+		printf("Speed-up: %.2fx.\n", scalarTime / groupsTime);
+
+		// Both decoders must produce exactly the same packet.
+		size_t packetSize = sizeof(struct caer_event_packet_header)
+							+ ((size_t) caerEventPacketHeaderGetEventCapacity(&scalarResult->packetHeader)
+								* sizeof(struct caer_polarity_event));
+
+		bool formatIdentical = (memcmp(scalarResult, groupsResult, packetSize) == 0);
+
+		printf("Results identical: %s.\n", (formatIdentical) ? ("yes") : ("NO"));
+
+		identical = identical && formatIdentical;
+
+		free(scalarResult);
+		free(groupsResult);
+	}
+
+	free(values);
+	free(words);
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
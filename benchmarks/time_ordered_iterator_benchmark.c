@@ -0,0 +1,280 @@
+// Benchmark for the time-ordered iterator over event packet containers.
+// Goes through all events of a set of containers, each holding packets of
+// polarity events from two cameras, IMU6 and special events, in timestamp
+// order, once by merging the packets in place with the time-ordered iterator,
+// and once by collecting all events in an array and sorting it, and checks
+// that both give the same events in the same order.
+#include <libcaer/events/imu6.h>
+#include <libcaer/events/packetContainer.h>
+#include <libcaer/events/polarity.h>
+#include <libcaer/events/special.h>
+
+#include "benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONTAINERS_NUMBER 64
+#define POLARITY_EVENTS   8192
+#define BENCHMARK_RUNS    10
+
+struct sortedEvent {
+	int64_t timestamp;
+	int32_t order;
+	int32_t index;
+	int16_t type;
+	const void *event;
+};
+
+static caerPolarityEventPacket generatePolarity(int16_t source, int32_t start, uint32_t *rng) {
+	caerPolarityEventPacket packet = caerPolarityEventPacketAllocate(POLARITY_EVENTS, source, 0);
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	int32_t timestamp = start;
+
+	for (int32_t i = 0; i < POLARITY_EVENTS; i++) {
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(packet, i);
+
+		timestamp += I32T(xorshift32(rng) % 4);
+
+		caerPolarityEventSetTimestamp(event, timestamp);
+		caerPolarityEventSetX(event, U16T(xorshift32(rng) % 346));
+		caerPolarityEventSetY(event, U16T(xorshift32(rng) % 260));
+		caerPolarityEventSetPolarity(event, xorshift32(rng) & 0x01);
+		caerPolarityEventValidate(event, packet);
+
+		// Some events removed by a noise filter.
+		if ((xorshift32(rng) % 8) == 0) {
+			caerPolarityEventInvalidate(event, packet);
+		}
+	}
+
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader, POLARITY_EVENTS);
+
+	return (packet);
+}
+
+static caerIMU6EventPacket generateIMU6(int32_t start, int32_t end) {
+	int32_t eventsNumber       = ((end - start) / 1000) + 1;
+	caerIMU6EventPacket packet = caerIMU6EventPacketAllocate(eventsNumber, 1, 0);
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	for (int32_t i = 0; i < eventsNumber; i++) {
+		caerIMU6Event event = caerIMU6EventPacketGetEvent(packet, i);
+
+		caerIMU6EventSetTimestamp(event, start + (i * 1000));
+		caerIMU6EventValidate(event, packet);
+	}
+
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader, eventsNumber);
+
+	return (packet);
+}
+
+static caerSpecialEventPacket generateSpecial(int32_t start, int32_t end) {
+	int32_t eventsNumber          = ((end - start) / 2500) + 1;
+	caerSpecialEventPacket packet = caerSpecialEventPacketAllocate(eventsNumber, 1, 0);
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	for (int32_t i = 0; i < eventsNumber; i++) {
+		caerSpecialEvent event = caerSpecialEventPacketGetEvent(packet, i);
+
+		caerSpecialEventSetTimestamp(event, start + (i * 2500));
+		caerSpecialEventSetType(event, EXTERNAL_INPUT_RISING_EDGE);
+		caerSpecialEventValidate(event, packet);
+	}
+
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader, eventsNumber);
+
+	return (packet);
+}
+
+static caerEventPacketContainer generateContainer(int32_t start, uint32_t *rng) {
+	caerEventPacketContainer container = caerEventPacketContainerAllocate(4);
+	if (container == NULL) {
+		return (NULL);
+	}
+
+	caerPolarityEventPacket polarity1 = generatePolarity(1, start, rng);
+	caerPolarityEventPacket polarity2 = generatePolarity(2, start, rng);
+	if ((polarity1 == NULL) || (polarity2 == NULL)) {
+		free(polarity1);
+		free(polarity2);
+		caerEventPacketContainerFree(container);
+		return (NULL);
+	}
+
+	int32_t end = caerPolarityEventGetTimestamp(caerPolarityEventPacketGetEvent(polarity1, POLARITY_EVENTS - 1));
+
+	caerEventPacketContainerSetEventPacket(container, 0, (caerEventPacketHeader) generateSpecial(start, end));
+	caerEventPacketContainerSetEventPacket(container, 1, &polarity1->packetHeader);
+	caerEventPacketContainerSetEventPacket(container, 2, (caerEventPacketHeader) generateIMU6(start, end));
+	caerEventPacketContainerSetEventPacket(container, 3, &polarity2->packetHeader);
+
+	return (container);
+}
+
+static int compareSortedEvents(const void *a, const void *b) {
+	const struct sortedEvent *ea = a;
+	const struct sortedEvent *eb = b;
+
+	if (ea->timestamp != eb->timestamp) {
+		return ((ea->timestamp < eb->timestamp) ? (-1) : (1));
+	}
+
+	if (ea->order != eb->order) {
+		return ((ea->order < eb->order) ? (-1) : (1));
+	}
+
+	return ((ea->index < eb->index) ? (-1) : (ea->index > eb->index));
+}
+
+// Concatenate all valid events of the container and sort them.
+static size_t concatenateAndSort(caerEventPacketContainerConst container, struct sortedEvent *events) {
+	size_t eventsNumber = 0;
+
+	CAER_EVENT_PACKET_CONTAINER_CONST_ITERATOR_START(container)
+	caerEventPacketHeaderConst packet = caerEventPacketContainerIteratorElement;
+
+	CAER_ITERATOR_VALID_START(packet, const void *)
+	events[eventsNumber].timestamp = caerGenericEventGetTimestamp64(caerIteratorElement, packet);
+	events[eventsNumber].order     = caerEventPacketContainerIteratorCounter;
+	events[eventsNumber].index     = caerIteratorCounter;
+	events[eventsNumber].type      = caerEventPacketHeaderGetEventType(packet);
+	events[eventsNumber].event     = caerIteratorElement;
+	eventsNumber++;
+	CAER_ITERATOR_VALID_END
+	CAER_EVENT_PACKET_CONTAINER_ITERATOR_END
+
+	qsort(events, eventsNumber, sizeof(struct sortedEvent), &compareSortedEvents);
+
+	return (eventsNumber);
+}
+
+int main(void) {
+	static caerEventPacketContainer containers[CONTAINERS_NUMBER];
+
+	uint32_t rng  = 0x12345678;
+	int32_t start = 0;
+
+	for (size_t i = 0; i < CONTAINERS_NUMBER; i++) {
+		containers[i] = generateContainer(start, &rng);
+		if (containers[i] == NULL) {
+			fprintf(stderr, "Failed to allocate event packet containers.\n");
+			return (EXIT_FAILURE);
+		}
+
+		start = I32T(caerEventPacketContainerGetHighestEventTimestamp(containers[i]) + 1);
+	}
+
+	size_t maxEvents = 0;
+
+	for (size_t i = 0; i < CONTAINERS_NUMBER; i++) {
+		size_t events = (size_t) caerEventPacketContainerGetEventsValidNumber(containers[i]);
+		if (events > maxEvents) {
+			maxEvents = events;
+		}
+	}
+
+	struct sortedEvent *sorted = calloc(maxEvents, sizeof(struct sortedEvent));
+	const void **merged        = calloc(maxEvents, sizeof(const void *));
+	if ((sorted == NULL) || (merged == NULL)) {
+		fprintf(stderr, "Failed to allocate event arrays.\n");
+		return (EXIT_FAILURE);
+	}
+
+	double mergeTime   = 1.0e9;
+	double sortTime    = 1.0e9;
+	size_t totalEvents = 0;
+	int64_t mergeSum   = 0;
+	int64_t sortSum    = 0;
+	bool ordered       = true;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		struct timespec begin, end;
+
+		totalEvents = 0;
+		mergeSum    = 0;
+		clock_gettime(CLOCK_MONOTONIC, &begin);
+
+		for (size_t i = 0; i < CONTAINERS_NUMBER; i++) {
+			int64_t lastTimestamp = -1;
+
+			CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_ITERATOR_START(containers[i])
+			ordered = ordered && (caerEventPacketContainerTimeOrderedIteratorTimestamp >= lastTimestamp);
+			lastTimestamp = caerEventPacketContainerTimeOrderedIteratorTimestamp;
+
+			mergeSum += caerEventPacketContainerTimeOrderedIteratorTimestamp
+						+ caerEventPacketContainerTimeOrderedIteratorType;
+			totalEvents++;
+			CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_ITERATOR_END
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		if (timeDiffSeconds(&begin, &end) < mergeTime) {
+			mergeTime = timeDiffSeconds(&begin, &end);
+		}
+
+		sortSum = 0;
+		clock_gettime(CLOCK_MONOTONIC, &begin);
+
+		for (size_t i = 0; i < CONTAINERS_NUMBER; i++) {
+			size_t eventsNumber = concatenateAndSort(containers[i], sorted);
+
+			for (size_t j = 0; j < eventsNumber; j++) {
+				sortSum += sorted[j].timestamp + sorted[j].type;
+			}
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		if (timeDiffSeconds(&begin, &end) < sortTime) {
+			sortTime = timeDiffSeconds(&begin, &end);
+		}
+	}
+
+	// Both must return the very same events, in the same order.
+	bool identical = ordered && (mergeSum == sortSum);
+
+	for (size_t i = 0; identical && (i < CONTAINERS_NUMBER); i++) {
+		struct caer_event_packet_container_time_ordered_iterator it;
+		struct caer_event_packet_container_time_ordered_event event;
+		size_t mergedNumber = 0;
+
+		caerEventPacketContainerTimeOrderedIteratorInitContainer(&it, containers[i]);
+
+		while (caerEventPacketContainerTimeOrderedIteratorNext(&it, &event)) {
+			merged[mergedNumber++] = event.event;
+		}
+
+		size_t sortedNumber = concatenateAndSort(containers[i], sorted);
+
+		identical = (mergedNumber == sortedNumber);
+
+		for (size_t j = 0; identical && (j < sortedNumber); j++) {
+			identical = (merged[j] == sorted[j].event);
+		}
+	}
+
+	printf("%d containers, %zu valid events.\n", CONTAINERS_NUMBER, totalEvents);
+	printf("time-ordered iterator: %7.1f Mev/s, concatenate and sort: %7.1f Mev/s, speed-up %.2fx, %s.\n",
+		(double) totalEvents / mergeTime / 1.0e6, (double) totalEvents / sortTime / 1.0e6, sortTime / mergeTime,
+		(identical) ? ("IDENTICAL") : ("DIFFERENT"));
+
+	free(sorted);
+	free(merged);
+
+	for (size_t i = 0; i < CONTAINERS_NUMBER; i++) {
+		caerEventPacketContainerFree(containers[i]);
+	}
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
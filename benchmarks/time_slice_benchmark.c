@@ -0,0 +1,99 @@
+// Benchmark for caerEventPacketFindTimestamp(). Gets the events of a set of
+// sliding time windows from a large polarity event packet, once by scanning
+// the packet for each window, and once by looking up the window bounds with
+// binary search, and checks that both find the same events.
+#include <libcaer/events/polarity.h>
+
+#include "benchmark_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PACKET_EVENTS  (256 * 1024)
+#define WINDOW_SIZE    10000
+#define WINDOW_STEP    1000
+#define BENCHMARK_RUNS 5
+
+// First event at or after the timestamp, scanning from the start.
+static int32_t findTimestampScan(caerEventPacketHeaderConst packet, int64_t timestamp) {
+	CAER_ITERATOR_ALL_START(packet, const void *)
+	if (caerGenericEventGetTimestamp64(caerIteratorElement, packet) >= timestamp) {
+		return (caerIteratorCounter);
+	}
+	CAER_ITERATOR_ALL_END
+
+	return (caerEventPacketHeaderGetEventNumber(packet));
+}
+
+static double benchmark(int32_t (*finder)(caerEventPacketHeaderConst, int64_t), caerEventPacketHeaderConst packet,
+	int64_t *checksum, size_t *windows) {
+	int64_t lastTimestamp = caerGenericEventGetTimestamp64(
+		caerGenericEventGetEvent(packet, caerEventPacketHeaderGetEventNumber(packet) - 1), packet);
+	double bestTime = 1.0e9;
+
+	for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		*checksum = 0;
+		*windows  = 0;
+
+		for (int64_t t0 = 0; t0 <= lastTimestamp; t0 += WINDOW_STEP) {
+			int32_t first = (*finder)(packet, t0);
+			int32_t last  = (*finder)(packet, t0 + WINDOW_SIZE);
+
+			*checksum += first + last;
+			(*windows)++;
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		double time = timeDiffSeconds(&start, &end);
+		if (time < bestTime) {
+			bestTime = time;
+		}
+	}
+
+	return (bestTime);
+}
+
+int main(void) {
+	caerPolarityEventPacket packet = caerPolarityEventPacketAllocate(PACKET_EVENTS, 1, 0);
+	if (packet == NULL) {
+		fprintf(stderr, "Failed to allocate polarity packet.\n");
+		return (EXIT_FAILURE);
+	}
+
+	uint32_t rng      = 0x12345678;
+	int32_t timestamp = 0;
+
+	for (int32_t i = 0; i < PACKET_EVENTS; i++) {
+		caerPolarityEvent event = caerPolarityEventPacketGetEvent(packet, i);
+
+		timestamp += I32T(xorshift32(&rng) % 4);
+
+		caerPolarityEventSetTimestamp(event, timestamp);
+		caerPolarityEventSetX(event, U16T(xorshift32(&rng) % 346));
+		caerPolarityEventSetY(event, U16T(xorshift32(&rng) % 260));
+		caerPolarityEventSetPolarity(event, xorshift32(&rng) & 0x01);
+		caerPolarityEventValidate(event, packet);
+	}
+
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader, PACKET_EVENTS);
+
+	int64_t scanChecksum, searchChecksum;
+	size_t windows;
+
+	double scanTime   = benchmark(&findTimestampScan, &packet->packetHeader, &scanChecksum, &windows);
+	double searchTime = benchmark(&caerEventPacketFindTimestamp, &packet->packetHeader, &searchChecksum, &windows);
+
+	bool identical = (scanChecksum == searchChecksum);
+
+	printf("%d events, %zu windows of %d µs every %d µs.\n", PACKET_EVENTS, windows, WINDOW_SIZE, WINDOW_STEP);
+	printf("scan: %9.3f ms, binary search: %9.3f ms, speed-up %.0fx, %s.\n", scanTime * 1000.0, searchTime * 1000.0,
+		scanTime / searchTime, (identical) ? ("IDENTICAL") : ("DIFFERENT"));
+
+	free(packet);
+
+	return ((identical) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
@@ -0,0 +1,327 @@
+// Test for the offline translator state snapshots. Decodes a synthetic DAVIS
+// stream once sequentially, and once split into chunks at synchronization
+// points, each chunk decoded by its own translator after restoring the state
+// snapshot taken at its start, and checks that both give the same events.
+// The stream mixes DVS addresses, timestamps, wraps (also big ones), resets,
+// IMU samples and APS frames, so that chunks start in the middle of them.
+// Uses internal libcaer headers, not part of the public API.
+#include <libcaer/devices/device.h>
+
+#include "benchmark_utils.h"
+#include "davis.h"
+
+#define STREAM_WORDS    (1024 * 1024)
+#define CHUNKS_NUMBER   16
+#define PROCESS_SIZE    (64 * 1024)
+#define FRAME_ROI_SIZEX 8
+#define FRAME_ROI_SIZEY 4
+
+struct word_stream {
+	uint16_t *words;
+	size_t wordsNumber;
+	size_t capacity;
+};
+
+struct event_list {
+	uint8_t *data;
+	size_t size;
+	size_t capacity;
+};
+
+static void streamPut(struct word_stream *stream, uint16_t word) {
+	if (stream->wordsNumber < stream->capacity) {
+		stream->words[stream->wordsNumber++] = htole16(word);
+	}
+}
+
+// Pending words of a composite event (IMU sample or APS frame) being sent.
+static uint16_t composite[1024];
+static size_t compositeSize     = 0;
+static size_t compositePosition = 0;
+
+static void compositeIMU(uint32_t *rng) {
+	compositeSize     = 0;
+	compositePosition = 0;
+
+	composite[compositeSize++] = 0x0005;                // IMU start.
+	composite[compositeSize++] = 0x5300 | (0x07 << 5); // IMU scale config, accel+gyro+temp.
+
+	for (size_t i = 0; i < 14; i++) {
+		composite[compositeSize++] = U16T(0x5000 | (xorshift32(rng) & 0xFF));
+	}
+
+	composite[compositeSize++] = 0x0007; // IMU end.
+}
+
+static void compositeFrame(uint32_t *rng) {
+	compositeSize     = 0;
+	compositePosition = 0;
+
+	composite[compositeSize++] = 0x0008; // Global shutter frame start.
+
+	// ROI: start column, start row, end column, end row.
+	const uint16_t roi[4] = {0, 0, FRAME_ROI_SIZEX - 1, FRAME_ROI_SIZEY - 1};
+	for (size_t i = 0; i < 4; i++) {
+		composite[compositeSize++] = U16T(0x5100 | (roi[i] >> 8));
+		composite[compositeSize++] = U16T(0x5200 | (roi[i] & 0xFF));
+	}
+
+	composite[compositeSize++] = 0x000E; // Exposure start.
+
+	// Reset read, then signal read, column by column.
+	for (uint16_t readout = 0; readout < 2; readout++) {
+		for (size_t x = 0; x < FRAME_ROI_SIZEX; x++) {
+			composite[compositeSize++] = U16T(0x000B + readout);
+
+			for (size_t y = 0; y < FRAME_ROI_SIZEY; y++) {
+				composite[compositeSize++] = U16T(0x4000 | (xorshift32(rng) & 0x3FF));
+			}
+
+			composite[compositeSize++] = 0x000D;
+		}
+
+		if (readout == 0) {
+			composite[compositeSize++] = 0x000F; // Exposure end.
+		}
+	}
+
+	composite[compositeSize++] = 0x000A; // Frame end.
+}
+
+static void streamGenerate(struct word_stream *stream, uint32_t seed) {
+	uint32_t rng       = seed;
+	uint16_t timestamp = 0;
+
+	stream->wordsNumber = 0;
+	compositeSize       = 0;
+	compositePosition   = 0;
+
+	while (stream->wordsNumber < stream->capacity) {
+		uint32_t r = xorshift32(&rng) % 1000;
+
+		if (compositePosition < compositeSize) {
+			// Composite events are interleaved with the rest of the stream.
+			if (r < 500) {
+				streamPut(stream, composite[compositePosition++]);
+				continue;
+			}
+		}
+		else if (r < 3) {
+			compositeIMU(&rng);
+			continue;
+		}
+		else if (r < 4) {
+			compositeFrame(&rng);
+			continue;
+		}
+
+		if (r < 8) {
+			// Timestamp wrap, sometimes many at once, to also get big wraps.
+			uint16_t wraps = ((xorshift32(&rng) % 8) == 0) ? (U16T(1 + (xorshift32(&rng) % 4000))) : (1);
+			streamPut(stream, U16T(0x7000 | wraps));
+		}
+		else if ((r < 9) && ((xorshift32(&rng) % 200) == 0)) {
+			streamPut(stream, 0x0001); // Timestamp reset.
+		}
+		else if (r < 12) {
+			streamPut(stream, U16T(0x0002 + (xorshift32(&rng) % 3))); // External input.
+		}
+		else if (r < 150) {
+			timestamp = U16T((timestamp + 1 + (xorshift32(&rng) % 20)) & 0x7FFF);
+			streamPut(stream, U16T(0x8000 | timestamp));
+		}
+		else if (r < 300) {
+			streamPut(stream, U16T(0x1000 | (xorshift32(&rng) % 260)));
+		}
+		else {
+			streamPut(stream, U16T(((xorshift32(&rng) & 0x01) ? (0x3000) : (0x2000)) | (xorshift32(&rng) % 346)));
+		}
+	}
+}
+
+static void eventListPut(struct event_list *list, const void *data, size_t size) {
+	if ((list->size + size) > list->capacity) {
+		list->capacity = (list->capacity + size) * 2;
+		list->data     = realloc(list->data, list->capacity);
+		if (list->data == NULL) {
+			fprintf(stderr, "Failed to allocate event list.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	memcpy(list->data + list->size, data, size);
+	list->size += size;
+}
+
+// Append all valid events, with their full 64bit timestamp, one list per event type.
+static void eventsCollect(caerDeviceTranslator translator, struct event_list *lists) {
+	caerEventPacketContainer container;
+
+	while ((container = caerDeviceTranslatorDataGet(translator)) != NULL) {
+		CAER_EVENT_PACKET_CONTAINER_ITERATOR_START(container)
+			int16_t type = caerEventPacketHeaderGetEventType(caerEventPacketContainerIteratorElement);
+			int32_t size = caerEventPacketHeaderGetEventSize(caerEventPacketContainerIteratorElement);
+
+			CAER_ITERATOR_VALID_START(caerEventPacketContainerIteratorElement, const void *)
+				int64_t timestamp
+					= caerGenericEventGetTimestamp64(caerIteratorElement, caerEventPacketContainerIteratorElement);
+
+				eventListPut(&lists[type], &timestamp, sizeof(timestamp));
+				eventListPut(&lists[type], caerIteratorElement, (size_t) size);
+			CAER_ITERATOR_VALID_END
+		CAER_EVENT_PACKET_CONTAINER_ITERATOR_END
+
+		caerEventPacketContainerFree(container);
+	}
+}
+
+static void decode(caerDeviceHandle device, caerDeviceTranslatorStateConst state, const uint8_t *buffer,
+	size_t bufferSize, struct event_list *lists) {
+	caerDeviceTranslator translator = caerDeviceTranslatorOpen(device);
+	if (translator == NULL) {
+		fprintf(stderr, "Failed to open translator.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if ((state != NULL) && (!caerDeviceTranslatorStateSet(translator, state))) {
+		fprintf(stderr, "Failed to restore translator state.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (size_t offset = 0; offset < bufferSize; offset += PROCESS_SIZE) {
+		size_t size = ((bufferSize - offset) < PROCESS_SIZE) ? (bufferSize - offset) : (PROCESS_SIZE);
+
+		caerDeviceTranslatorProcess(translator, buffer + offset, size);
+		eventsCollect(translator, lists);
+	}
+
+	caerDeviceTranslatorFlush(translator);
+	eventsCollect(translator, lists);
+
+	caerDeviceTranslatorClose(&translator);
+}
+
+// A DAVIS346 handle, as far as the translators are concerned: no USB device.
+static char deviceString[] = "DAVIS346 test";
+
+static davisHandle deviceCreate(void) {
+	davisHandle handle = calloc(1, sizeof(struct davis_handle));
+	if (handle == NULL) {
+		return (NULL);
+	}
+
+	handle->cHandle.deviceType        = CAER_DEVICE_DAVIS;
+	handle->cHandle.info.deviceString = deviceString;
+	handle->cHandle.info.chipID       = DAVIS_CHIP_DAVIS346B;
+	handle->cHandle.info.dvsSizeX     = 346;
+	handle->cHandle.info.dvsSizeY     = 260;
+	handle->cHandle.info.apsSizeX     = 346;
+	handle->cHandle.info.apsSizeY     = 260;
+
+	davisCommonState state = &handle->cHandle.state;
+
+	atomic_store(&state->deviceLogLevel, CAER_LOG_EMERGENCY);
+
+	state->dvs.sizeX = 346;
+	state->dvs.sizeY = 260;
+	state->aps.sizeX = 346;
+	state->aps.sizeY = 260;
+
+	containerGenerationSettingsInit(&state->container);
+	dataExchangeSettingsInit(&state->dataExchange);
+	dvsROISettingsInit(&state->dvs.roi, 346, 260);
+	dvsRemapInit(&state->dvs.remap, 346, 260, false);
+	dvsAccumulateSettingsInit(&state->dvs.accumulate, 346, 260);
+
+	// Short container intervals, so chunks see many time based commits.
+	atomic_store(&state->container.maxPacketContainerInterval, 1000);
+
+	return (handle);
+}
+
+static bool streamTest(davisHandle device, const uint8_t *buffer, size_t bufferSize) {
+	struct event_list sequential[IMU9_EVENT + 1] = {{0}};
+	struct event_list chunked[IMU9_EVENT + 1]    = {{0}};
+
+	decode((caerDeviceHandle) device, NULL, buffer, bufferSize, sequential);
+
+	// Scan the whole stream once, taking a snapshot at every chunk start.
+	caerDeviceTranslator scanner = caerDeviceTranslatorOpen((caerDeviceHandle) device);
+	if (scanner == NULL) {
+		fprintf(stderr, "Failed to open translator.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	size_t chunkStart                         = 0;
+	caerDeviceTranslatorState chunkStartState = NULL;
+
+	for (size_t i = 1; i <= CHUNKS_NUMBER; i++) {
+		size_t chunkEnd = bufferSize;
+
+		if (i < CHUNKS_NUMBER) {
+			size_t splitPoint = ((bufferSize / CHUNKS_NUMBER) * i) & ~((size_t) 0x01);
+
+			caerDeviceTranslatorScan(scanner, buffer + chunkStart, splitPoint - chunkStart);
+			chunkEnd = splitPoint + caerDeviceTranslatorResync(scanner, buffer + splitPoint, bufferSize - splitPoint);
+		}
+
+		decode((caerDeviceHandle) device, chunkStartState, buffer + chunkStart, chunkEnd - chunkStart, chunked);
+
+		free(chunkStartState);
+		chunkStartState = (i < CHUNKS_NUMBER) ? (caerDeviceTranslatorStateGet(scanner)) : (NULL);
+		chunkStart      = chunkEnd;
+	}
+
+	caerDeviceTranslatorClose(&scanner);
+
+	bool identical = true;
+
+	for (size_t type = 0; type <= IMU9_EVENT; type++) {
+		if ((sequential[type].size != chunked[type].size)
+			|| ((sequential[type].size > 0)
+				&& (memcmp(sequential[type].data, chunked[type].data, sequential[type].size) != 0))) {
+			printf("Event type %zu: sequential and chunked decoding differ (%zu vs %zu bytes).\n", type,
+				sequential[type].size, chunked[type].size);
+			identical = false;
+		}
+		else {
+			printf("Event type %zu: %zu bytes identical.\n", type, sequential[type].size);
+		}
+
+		free(sequential[type].data);
+		free(chunked[type].data);
+	}
+
+	return (identical);
+}
+
+int main(void) {
+	struct word_stream stream = {.words = malloc(STREAM_WORDS * sizeof(uint16_t)), .capacity = STREAM_WORDS};
+	davisHandle device        = deviceCreate();
+
+	if ((stream.words == NULL) || (device == NULL)) {
+		fprintf(stderr, "Failed to allocate test data.\n");
+		return (EXIT_FAILURE);
+	}
+
+	// Different streams put the chunk starts in different places.
+	const uint32_t seeds[] = {0x00000001, 0x12345678, 0x0000BEEF, 0x0000CAFE};
+
+	int result = EXIT_SUCCESS;
+
+	for (size_t i = 0; i < (sizeof(seeds) / sizeof(seeds[0])); i++) {
+		printf("Stream with seed 0x%08" PRIX32 ":\n", seeds[i]);
+
+		streamGenerate(&stream, seeds[i]);
+
+		if (!streamTest(device, (const uint8_t *) stream.words, stream.wordsNumber * sizeof(uint16_t))) {
+			result = EXIT_FAILURE;
+		}
+	}
+
+	dvsRemapDestroy(&device->cHandle.state.dvs.remap);
+	free(device);
+	free(stream.words);
+
+	return (result);
+}
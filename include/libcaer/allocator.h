@@ -0,0 +1,145 @@
+/**
+ * @file allocator.h
+ *
+ * Memory allocation hooks for event packets and event packet containers.
+ * By default, libcaer uses malloc()/realloc()/free(). A different allocator,
+ * such as a NUMA-aware or hugepage-backed arena, can be set process-wide with
+ * caerSetAllocator(). All event packets and event packet containers, whether
+ * allocated by the event headers, the C++ wrappers, the devices or the input
+ * modules, then come from it, and are given back to it.
+ * Memory must always be freed by the allocator that allocated it: set the
+ * allocator once at startup, before any packet is allocated, and free
+ * packets and containers with caerEventPacketFree(),
+ * caerEventPacketContainerFree() or caerFree(), not free().
+ */
+
+#ifndef LIBCAER_ALLOCATOR_H_
+#define LIBCAER_ALLOCATOR_H_
+
+#ifdef __cplusplus
+
+#	include <cstddef>
+#	include <cstdint>
+
+#else
+
+#	include <stdbool.h>
+#	include <stddef.h>
+#	include <stdint.h>
+
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocate memory, like malloc(). Must return NULL on failure.
+ * Memory must be aligned for any type, like malloc().
+ */
+typedef void *(*caerAllocatorAlloc)(size_t size, void *user);
+
+/**
+ * Change the size of an allocation, like realloc(). Must return NULL on
+ * failure, leaving the original allocation untouched. Never called with
+ * a NULL pointer.
+ */
+typedef void *(*caerAllocatorRealloc)(void *ptr, size_t size, void *user);
+
+/**
+ * Free memory, like free(). Never called with a NULL pointer.
+ */
+typedef void (*caerAllocatorFree)(void *ptr, void *user);
+
+/**
+ * Set the process-wide allocator for event packets and event packet
+ * containers. See the file description for when this can be called.
+ * The new allocator is installed atomically, so threads allocating or
+ * freeing at the same time use either the old or the new one, never a mix.
+ * Each call keeps a few bytes of memory for the lifetime of the process.
+ * Memory that must be zeroed is cleared by libcaer itself.
+ *
+ * @param allocFunc allocation function. NULL restores the default allocator.
+ * @param reallocFunc reallocation function. Can only be NULL if allocFunc is.
+ * @param freeFunc free function. Can only be NULL if allocFunc is.
+ * @param user user pointer passed to all three functions.
+ *
+ * @return true on success, false if only some of the functions are NULL,
+ *         or on allocation failure.
+ */
+bool caerSetAllocator(
+	caerAllocatorAlloc allocFunc, caerAllocatorRealloc reallocFunc, caerAllocatorFree freeFunc, void *user);
+
+/**
+ * Reserve a 2 MB hugepage-backed arena for frame event packets.
+ * Frame packets are big and allocated over and over at the frame rate,
+ * so keeping them in hugepages saves on TLB misses and page faults.
+ * Frame packets are then allocated from the arena, in 2 MB steps, and
+ * fall back to the current allocator when it is full. Explicit hugepages
+ * (MAP_HUGETLB) are used if the system has them reserved, else the arena
+ * is marked for transparent hugepages. Can only be enabled once, the
+ * arena then stays for the lifetime of the process.
+ * Only supported on Linux.
+ *
+ * @param size arena size in bytes, rounded up to a multiple of 2 MB.
+ *
+ * @return true on success, false if not supported, already enabled,
+ *         or the memory could not be reserved.
+ */
+bool caerSetFrameHugepageArena(size_t size);
+
+/**
+ * Allocate memory from the current allocator.
+ *
+ * @param size number of bytes to allocate.
+ *
+ * @return a pointer to the new memory, or NULL on failure.
+ */
+void *caerMalloc(size_t size);
+
+/**
+ * Allocate zeroed memory for an array from the current allocator.
+ *
+ * @param nmemb number of array elements.
+ * @param size size of one array element.
+ *
+ * @return a pointer to the new zeroed memory, or NULL on failure.
+ */
+void *caerCalloc(size_t nmemb, size_t size);
+
+/**
+ * Change the size of memory allocated by libcaer.
+ *
+ * @param ptr memory from caerMalloc(), caerCalloc(), caerRealloc()
+ *            or caerEventPacketMemoryAllocate(). If NULL, acts like caerMalloc().
+ * @param size new size in bytes.
+ *
+ * @return a pointer to the resized memory, or NULL on failure,
+ *         in which case the original memory is untouched.
+ */
+void *caerRealloc(void *ptr, size_t size);
+
+/**
+ * Free memory allocated by libcaer.
+ *
+ * @param ptr memory to free. If NULL, nothing happens.
+ */
+void caerFree(void *ptr);
+
+/**
+ * Allocate zeroed memory for an event packet of the given type.
+ * Frame event packets come from the hugepage arena, if enabled
+ * and not full, all others from the current allocator.
+ *
+ * @param eventType type of the event packet.
+ * @param size size of the event packet, header included.
+ *
+ * @return a pointer to the new zeroed memory, or NULL on failure.
+ */
+void *caerEventPacketMemoryAllocate(int16_t eventType, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_ALLOCATOR_H_ */
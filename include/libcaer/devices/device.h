@@ -49,6 +49,17 @@ typedef struct caer_device_handle *caerDeviceHandle;
  * Module address: host-side logging configuration.
  */
 #define CAER_HOST_CONFIG_LOG -4
+/**
+ * Module address: host-side DVS region of interest and decimation.
+ * Supported by DAVIS, DVS128, eDVS and Samsung EVK devices.
+ */
+#define CAER_HOST_CONFIG_DVS_ROI -5
+/**
+ * Module address: host-side DVS event accumulation into count
+ * images or time surfaces.
+ * Supported by DAVIS and DVXplorer devices.
+ */
+#define CAER_HOST_CONFIG_DVS_ACCUMULATE -6
 
 /**
  * Parameter address for module CAER_HOST_CONFIG_DATAEXCHANGE:
@@ -89,6 +100,17 @@ typedef struct caer_device_handle *caerDeviceHandle;
  * need precise control over which ones are running at any time.
  */
 #define CAER_HOST_CONFIG_DATAEXCHANGE_STOP_PRODUCERS 3
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DATAEXCHANGE:
+ * deliver the raw data buffers as received from the device,
+ * tagged with a host timestamp and a sequence number, instead of
+ * decoded event packet containers. No decoding happens on the host,
+ * get the buffers with caerDeviceDataGetRaw() and decode them later
+ * (or never) with a caerDeviceTranslator.
+ * Only takes effect on caerDeviceDataStart() calls.
+ * Supported by DAVIS (FX2/FX3) and DVXplorer devices.
+ */
+#define CAER_HOST_CONFIG_DATAEXCHANGE_RAW_CAPTURE 4
 
 /**
  * Parameter address for module CAER_HOST_CONFIG_PACKETS:
@@ -107,6 +129,15 @@ typedef struct caer_device_handle *caerDeviceHandle;
  * types of events contained in the EventPacketContainer.
  */
 #define CAER_HOST_CONFIG_PACKETS_MAX_CONTAINER_INTERVAL 1
+/**
+ * Parameter address for module CAER_HOST_CONFIG_PACKETS:
+ * deliver polarity events in columnar layout, as POLARITY_COLUMNS_EVENT
+ * packets (see libcaer/events/polarityColumns.h), instead of the
+ * usual POLARITY_EVENT packets. Only valid events are delivered.
+ * The conversion happens once per packet, right before a packet
+ * container is made available to the user.
+ */
+#define CAER_HOST_CONFIG_PACKETS_POLARITY_COLUMNS 2
 
 /**
  * Parameter address for module CAER_HOST_CONFIG_LOG:
@@ -116,6 +147,102 @@ typedef struct caer_device_handle *caerDeviceHandle;
  */
 #define CAER_HOST_CONFIG_LOG_LEVEL 0
 
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ROI:
+ * start column (X) of the region of interest, in output orientation.
+ * Polarity events outside the region are dropped by the host while
+ * decoding, before they are written into a packet. Event addresses
+ * are not changed. Defaults to 0.
+ */
+#define CAER_HOST_CONFIG_DVS_ROI_START_COLUMN 0
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ROI:
+ * start row (Y) of the region of interest, in output orientation.
+ * Defaults to 0.
+ */
+#define CAER_HOST_CONFIG_DVS_ROI_START_ROW 1
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ROI:
+ * end column (X) of the region of interest, inclusive.
+ * Defaults to the last column of the array.
+ */
+#define CAER_HOST_CONFIG_DVS_ROI_END_COLUMN 2
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ROI:
+ * end row (Y) of the region of interest, inclusive.
+ * Defaults to the last row of the array.
+ */
+#define CAER_HOST_CONFIG_DVS_ROI_END_ROW 3
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ROI:
+ * spatial decimation factor N, must be at least 1. Only pixels
+ * whose column and row are a multiple of N away from the start
+ * of the region of interest are kept, so N=2 keeps one pixel in
+ * four. Defaults to 1 (all pixels).
+ */
+#define CAER_HOST_CONFIG_DVS_ROI_DECIMATION 4
+
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ACCUMULATE:
+ * accumulation mode, one of the CAER_DVS_ACCUMULATE_* values below.
+ * When enabled, the host keeps a per-pixel map, updated directly by
+ * the translator for every polarity event (after region of interest
+ * and remapping), and delivers it as a frame every time window.
+ * Each frame is a FRAME_EVENT packet with one grayscale frame of the
+ * full DVS array size, with CAER_DVS_ACCUMULATE_FRAME_ROI_ID as its
+ * ROI identifier, sent in its own packet container as soon as an
+ * event past the end of its window arrives. Its start/end of frame
+ * and exposure timestamps are the window bounds.
+ * Windows follow the event timestamps: windows without any events
+ * produce no frame. Defaults to CAER_DVS_ACCUMULATE_OFF.
+ */
+#define CAER_HOST_CONFIG_DVS_ACCUMULATE_MODE 0
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ACCUMULATE:
+ * length of the time window of each frame, in microseconds.
+ * Must be at least 1. Defaults to 10000 (10 ms).
+ */
+#define CAER_HOST_CONFIG_DVS_ACCUMULATE_WINDOW 1
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ACCUMULATE:
+ * time constant of the exponential decay of time surfaces, in
+ * microseconds. Must be at least 1. Defaults to 5000 (5 ms).
+ */
+#define CAER_HOST_CONFIG_DVS_ACCUMULATE_DECAY 2
+/**
+ * Parameter address for module CAER_HOST_CONFIG_DVS_ACCUMULATE:
+ * whether polarity events are still delivered in polarity packets
+ * while accumulating. Disable this if only the frames are needed,
+ * accumulated events then never leave the translator. Defaults to
+ * true (events are delivered).
+ */
+#define CAER_HOST_CONFIG_DVS_ACCUMULATE_DELIVER_EVENTS 3
+
+/**
+ * Accumulation mode for CAER_HOST_CONFIG_DVS_ACCUMULATE_MODE:
+ * disabled, no frames are generated.
+ */
+#define CAER_DVS_ACCUMULATE_OFF 0
+/**
+ * Accumulation mode for CAER_HOST_CONFIG_DVS_ACCUMULATE_MODE:
+ * count image, each pixel holds the number of events (of both
+ * polarities) of that pixel in the window, saturating at 65535.
+ */
+#define CAER_DVS_ACCUMULATE_COUNT 1
+/**
+ * Accumulation mode for CAER_HOST_CONFIG_DVS_ACCUMULATE_MODE:
+ * exponentially decayed time surface, each pixel holds
+ * 65535 * exp(-(windowEnd - lastEventTimestamp) / decay), where
+ * lastEventTimestamp is that of the pixel's most recent event of
+ * either polarity (in any past window); pixels without events are 0.
+ */
+#define CAER_DVS_ACCUMULATE_TIME_SURFACE 2
+/**
+ * ROI identifier of the frames generated by event accumulation,
+ * to tell them apart from APS frames.
+ */
+#define CAER_DVS_ACCUMULATE_FRAME_ROI_ID 127
+
 /**
  * Close a previously opened device and invalidate its handle.
  *
@@ -238,7 +365,7 @@ bool caerDeviceDataStop(caerDeviceHandle handle);
  * the device, for further processing.
  * The returned data structures are allocated in memory and will need to be freed.
  * The caerEventPacketContainerFree() function can be used to correctly free the full
- * container memory. For single caerEventPackets, just use free().
+ * container memory. For single caerEventPackets, use caerEventPacketFree().
  * This function can be made blocking with the CAER_HOST_CONFIG_DATAEXCHANGE_BLOCKING
  * configuration parameter. By default it is non-blocking.
  *
@@ -250,6 +377,252 @@ bool caerDeviceDataStop(caerDeviceHandle handle);
  */
 caerEventPacketContainer caerDeviceDataGet(caerDeviceHandle handle);
 
+/**
+ * Raw data buffer, as received from a device in raw capture mode
+ * (see CAER_HOST_CONFIG_DATAEXCHANGE_RAW_CAPTURE).
+ * The structure and its data are one single memory allocation,
+ * free it with free().
+ */
+struct caer_device_raw_buffer {
+	/// Sequence number, starts at zero on caerDeviceDataStart() and increases by one
+	/// for every buffer received. Gaps mean buffers were dropped, because the FIFO
+	/// buffer was full (see CAER_HOST_CONFIG_DATAEXCHANGE_BUFFER_SIZE).
+	uint64_t sequenceNumber;
+	/// Host monotonic time at which the buffer was received, in nanoseconds.
+	uint64_t hostTimestamp;
+	/// Size of the raw data in bytes.
+	size_t dataSize;
+	/// Raw data, exactly as sent by the device.
+	uint8_t *data;
+};
+
+/**
+ * Type for pointer to raw data buffer.
+ */
+typedef struct caer_device_raw_buffer *caerDeviceRawBuffer;
+
+/**
+ * Type for pointer to raw data buffer (read-only).
+ */
+typedef const struct caer_device_raw_buffer *caerDeviceRawBufferConst;
+
+/**
+ * Get a raw data buffer, when the device is in raw capture mode (see
+ * CAER_HOST_CONFIG_DATAEXCHANGE_RAW_CAPTURE). In that mode, this replaces
+ * caerDeviceDataGet(), which will always return NULL.
+ * The returned buffer is allocated in memory and will need to be freed with free().
+ * This function follows CAER_HOST_CONFIG_DATAEXCHANGE_BLOCKING, just like
+ * caerDeviceDataGet() does.
+ *
+ * @param handle a valid device handle.
+ *
+ * @return a valid raw data buffer. NULL will be returned on errors, such as
+ *         exceptional device shutdown, when not in raw capture mode, or when
+ *         there is no buffer available in non-blocking mode.
+ */
+caerDeviceRawBuffer caerDeviceDataGetRaw(caerDeviceHandle handle);
+
+/**
+ * Set a per-pixel remapping table for DVS addresses, see libcaer/dvs_remap.h
+ * for its format and caerDVSRemapBuild() to generate one. Every polarity
+ * event is then moved to the address given by the table entry for its
+ * original address (after the host-side region of interest is applied),
+ * or dropped. The table is copied, so it can be freed right after this call.
+ * The new table is used starting with the next data buffer from the device,
+ * so this can be called while data is flowing.
+ * Supported for DAVIS and DVXplorer devices.
+ *
+ * @param handle a valid device handle.
+ * @param remapTable table with dvsSizeX * dvsSizeY entries, or NULL to
+ *                   disable remapping again.
+ *
+ * @return true on success, false on unsupported device, invalid address
+ *         in the table or memory allocation failure.
+ */
+bool caerDeviceDVSRemapSet(caerDeviceHandle handle, const uint32_t *remapTable);
+
+/**
+ * Pointer to an offline translator, which decodes raw data buffers
+ * (see caerDeviceDataGetRaw()) into event packet containers, using the
+ * same decoding logic a device uses on live data.
+ */
+typedef struct caer_device_translator *caerDeviceTranslator;
+
+/**
+ * Create an offline translator for raw data buffers coming from a device.
+ * The translator takes a copy of the device's current decoding settings
+ * (sensor sizes and orientation, APS and IMU configuration, packet
+ * container limits, ...), and is from then on fully independent of the
+ * device, which can keep running or be closed. Its decoding state starts
+ * out fresh, as on caerDeviceDataStart(), so it decodes raw buffers from
+ * the start of a capture. Create it from the configured device whose raw
+ * buffers it shall decode. Nothing is ever sent to the device, so
+ * features that need to (APS auto-exposure, pixel filter auto-training)
+ * are disabled in the translator.
+ * Supported for DAVIS (FX2/FX3) and DVXplorer devices.
+ *
+ * @param handle a valid device handle.
+ *
+ * @return a valid translator, or NULL on errors.
+ */
+caerDeviceTranslator caerDeviceTranslatorOpen(caerDeviceHandle handle);
+
+/**
+ * Destroy an offline translator and free all its memory, including any
+ * event packet containers not yet retrieved.
+ *
+ * @param translator pointer to a valid translator. Will set translator to NULL
+ *                   if destruction is successful.
+ *
+ * @return true if destruction was successful, false on errors.
+ */
+bool caerDeviceTranslatorClose(caerDeviceTranslator *translator);
+
+/**
+ * Set a host-side configuration parameter of an offline translator.
+ * Supported are CAER_HOST_CONFIG_PACKETS and CAER_HOST_CONFIG_LOG.
+ *
+ * @param translator a valid translator.
+ * @param modAddr a host-side module address.
+ * @param paramAddr a parameter address for that module.
+ * @param param a configuration parameter's new value.
+ *
+ * @return true if setting the configuration was successful, false on errors.
+ */
+bool caerDeviceTranslatorConfigSet(caerDeviceTranslator translator, int8_t modAddr, uint8_t paramAddr, uint32_t param);
+
+/**
+ * Get the value of a host-side configuration parameter of an offline translator.
+ * Supported are CAER_HOST_CONFIG_PACKETS and CAER_HOST_CONFIG_LOG.
+ *
+ * @param translator a valid translator.
+ * @param modAddr a host-side module address.
+ * @param paramAddr a parameter address for that module.
+ * @param param a pointer to an integer, in which to store the configuration
+ *              parameter's current value.
+ *
+ * @return true if getting the configuration was successful, false on errors.
+ */
+bool caerDeviceTranslatorConfigGet(
+	caerDeviceTranslator translator, int8_t modAddr, uint8_t paramAddr, uint32_t *param);
+
+/**
+ * Decode a raw data buffer. Buffers must be passed in the same order they
+ * were received in (by increasing sequence number). Any resulting event
+ * packet containers are queued, without limit, and can be retrieved with
+ * caerDeviceTranslatorDataGet(). Just like on a live device, the last
+ * events are only made available once a following buffer completes their
+ * packet container, or when caerDeviceTranslatorFlush() is called.
+ *
+ * @param translator a valid translator.
+ * @param buffer the raw data, as received from the device.
+ * @param bufferSize size of the raw data in bytes.
+ *
+ * @return true if decoding was successful, false on errors.
+ */
+bool caerDeviceTranslatorProcess(caerDeviceTranslator translator, const uint8_t *buffer, size_t bufferSize);
+
+/**
+ * Get the next decoded event packet container, in order, from an offline translator.
+ * The returned data structures are allocated in memory and will need to be freed.
+ * The caerEventPacketContainerFree() function can be used to correctly free the full
+ * container memory. For single caerEventPackets, use caerEventPacketFree().
+ * This function never blocks.
+ *
+ * @param translator a valid translator.
+ *
+ * @return a valid event packet container, or NULL if there are none left.
+ */
+caerEventPacketContainer caerDeviceTranslatorDataGet(caerDeviceTranslator translator);
+
+/**
+ * Make all events decoded so far available via caerDeviceTranslatorDataGet(),
+ * without waiting for their packet container to be completed. Use at the
+ * end of a capture, or of a chunk of it (see caerDeviceTranslatorStateGet()).
+ *
+ * @param translator a valid translator.
+ *
+ * @return true on success, false on errors.
+ */
+bool caerDeviceTranslatorFlush(caerDeviceTranslator translator);
+
+/**
+ * Follow raw data buffers like caerDeviceTranslatorProcess() does, updating
+ * all decoding state (timestamps, addresses, partial IMU samples and APS
+ * frames), but without generating any events. This is much cheaper than
+ * decoding. Any events pending from earlier buffers are flushed first
+ * (see caerDeviceTranslatorFlush()).
+ *
+ * @param translator a valid translator.
+ * @param buffer the raw data, as received from the device.
+ * @param bufferSize size of the raw data in bytes.
+ *
+ * @return true if scanning was successful, false on errors.
+ */
+bool caerDeviceTranslatorScan(caerDeviceTranslator translator, const uint8_t *buffer, size_t bufferSize);
+
+/**
+ * Scan (see caerDeviceTranslatorScan()) raw data up to and including the next
+ * synchronization point: a timestamp wrap event for DAVIS and DVXplorer, a
+ * timestamp reference event for DVXplorer MIPI devices. The returned offset
+ * is always on an event word boundary, so it is a safe place to split raw
+ * data at, even if it is stored as one contiguous stream.
+ *
+ * @param translator a valid translator.
+ * @param buffer the raw data, as received from the device.
+ * @param bufferSize size of the raw data in bytes.
+ *
+ * @return offset in bytes right after the synchronization point, or
+ *         bufferSize if there is none (the whole buffer is then scanned).
+ */
+size_t caerDeviceTranslatorResync(caerDeviceTranslator translator, const uint8_t *buffer, size_t bufferSize);
+
+/**
+ * Snapshot of the decoding state of an offline translator.
+ * Single allocation, free it with free().
+ */
+typedef struct caer_device_translator_state *caerDeviceTranslatorState;
+typedef const struct caer_device_translator_state *caerDeviceTranslatorStateConst;
+
+/**
+ * Take a snapshot of the full decoding state of an offline translator, that is
+ * everything carried over from one raw data buffer to the next, including
+ * partially decoded IMU samples and APS frames.
+ *
+ * Together with caerDeviceTranslatorStateSet(), this allows decoding a long
+ * capture in parallel, with the same result as decoding it in one go:
+ * - a first translator goes once over the whole capture with
+ *   caerDeviceTranslatorScan(), and at every desired split point uses
+ *   caerDeviceTranslatorResync() to reach the next synchronization point,
+ *   where it takes a state snapshot;
+ * - each chunk between split points is then decoded by its own translator,
+ *   in parallel, after restoring the snapshot taken at the chunk's start,
+ *   and ends with caerDeviceTranslatorFlush();
+ * - concatenating the events of all chunks, in order, gives exactly the events
+ *   of a sequential decoding. Only the packet container boundaries around the
+ *   chunk ends may differ, as each chunk ends with a flush.
+ * All translators must be opened from the same device, with the same
+ * configuration.
+ *
+ * @param translator a valid translator.
+ *
+ * @return a state snapshot, free it with free(). NULL on errors.
+ */
+caerDeviceTranslatorState caerDeviceTranslatorStateGet(caerDeviceTranslator translator);
+
+/**
+ * Restore the decoding state of an offline translator from a snapshot
+ * taken with caerDeviceTranslatorStateGet(). Any events pending from earlier
+ * buffers are flushed first (see caerDeviceTranslatorFlush()).
+ *
+ * @param translator a valid translator.
+ * @param state a state snapshot, from a translator of the same device type
+ *              and configuration.
+ *
+ * @return true if restoring was successful, false on errors or mismatching state.
+ */
+bool caerDeviceTranslatorStateSet(caerDeviceTranslator translator, caerDeviceTranslatorStateConst state);
+
 #ifdef __cplusplus
 }
 #endif
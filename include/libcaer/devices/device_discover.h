@@ -57,6 +57,10 @@ typedef struct caer_device_discovery_result *caerDeviceDiscoveryResult;
  * Discover all supported devices that are accessible on this system.
  * Use -1 as 'deviceType' to search for any device, or an actual
  * device type ID to only search for matches of that specific type.
+ * When searching for any device, the different device types are
+ * searched for in parallel; devices of the same type are also queried
+ * in parallel. The order of the results is the same as with a sequential
+ * search: grouped by device type, in device type ID order.
  *
  * @param deviceType type of device to search for, use -1 for any.
  * @param discoveredDevices pointer to array of results, memory will be
@@ -69,6 +73,60 @@ typedef struct caer_device_discovery_result *caerDeviceDiscoveryResult;
  */
 ssize_t caerDeviceDiscover(int16_t deviceType, caerDeviceDiscoveryResult *discoveredDevices);
 
+/**
+ * Enable or disable the USB device discovery cache. When enabled, the
+ * information read from a USB device during caerDeviceDiscover() (serial
+ * number, firmware/logic versions, device capabilities) is remembered,
+ * keyed by VID/PID, bus number, port path and device address.
+ * Later discoveries of the same still-attached device return the cached
+ * result without opening the device again, which makes repeated discoveries
+ * much faster. Devices that could not be opened are never cached.
+ * Disabling the cache also clears it. The cache is disabled by default.
+ *
+ * Please note that the 'deviceErrorOpen' flag of cached results is not
+ * re-checked, so a device opened by another program in the meantime will
+ * still be reported as available.
+ *
+ * @param enable true to enable the discovery cache, false to disable it.
+ */
+void caerDeviceDiscoverCacheEnable(bool enable);
+
+/**
+ * Clear all content from the USB device discovery cache, so that the
+ * next call to caerDeviceDiscover() queries all devices again.
+ * See caerDeviceDiscoverCacheEnable() for more details.
+ */
+void caerDeviceDiscoverCacheClear(void);
+
+/**
+ * Register a callback to be notified when supported USB devices are
+ * attached to or detached from the system, without having to poll
+ * caerDeviceDiscover(). Devices already attached at the time of
+ * registration are reported as arrivals right away.
+ * The callback runs on a separate thread managed by libcaer and receives
+ * the same information caerDeviceDiscover() would return for the device;
+ * for departures, the information reported at arrival is passed again.
+ * The 'device' pointer is only valid for the duration of the callback.
+ * Only one callback can be registered at any time. Requires libusb
+ * hotplug support (not available on Windows).
+ *
+ * @param hotplugCallback function to call on device arrival (arrived = true)
+ *                        or departure (arrived = false).
+ * @param hotplugCallbackPtr pointer to be passed back to the callback.
+ *
+ * @return true on success, false if a callback is already registered,
+ *         hotplug is not supported or an error occurred.
+ */
+bool caerDeviceHotplugRegister(
+	void (*hotplugCallback)(caerDeviceDiscoveryResult device, bool arrived, void *hotplugCallbackPtr),
+	void *hotplugCallbackPtr);
+
+/**
+ * Unregister the hotplug callback set with caerDeviceHotplugRegister()
+ * and stop its thread. Must not be called from within the callback itself.
+ */
+void caerDeviceHotplugUnregister(void);
+
 /**
  * Open a specific device based on information returned by caerDeviceDiscover(),
  * then assign an ID to it and return a handle for further usage.
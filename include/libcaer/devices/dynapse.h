@@ -26,6 +26,18 @@ extern "C" {
  */
 #define DYNAPSE_CHIP_DYNAPSE 64
 
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB (Dynap-se only):
+ * maximum number of USB transfers kept in flight by the bulk upload
+ * functions, such as caerDynapseSendDataToUSB(), caerDynapseWriteCamMultiple(),
+ * caerDynapseWriteSramMultiple() and caerDynapseWriteSramWords().
+ * With more than one transfer in flight, chip configuration uploads are
+ * verified only once, at the end, instead of after every chunk; this makes
+ * large uploads run at USB bandwidth instead of at round-trip latency.
+ * Set to 1 to send and verify every chunk synchronously. Defaults to 8.
+ */
+#define CAER_HOST_CONFIG_USB_DYNAPSE_PIPELINE 2
+
 /**
  * Module address: device-side Multiplexer configuration.
  * The Multiplexer is responsible for mixing, timestamping and outputting
@@ -738,6 +750,44 @@ struct caer_dynapse_info {
 	bool muxHasStatistics;
 };
 
+/**
+ * One CAM to program, for caerDynapseWriteCamMultiple().
+ * See caerDynapseWriteCam() for the meaning and range of each field.
+ */
+struct caer_dynapse_cam {
+	/// Neuron address that should be let in as input to this neuron, range [0,1023].
+	uint16_t inputNeuronAddr;
+	/// Neuron address whose CAM should be programmed, range [0,1023].
+	uint16_t neuronAddr;
+	/// CAM address (synapse), range [0,63].
+	uint8_t camId;
+	/// Synaptic weight, one of the DYNAPSE_CONFIG_CAMTYPE_* values.
+	uint8_t synapseType;
+};
+
+/**
+ * One SRAM to program, for caerDynapseWriteSramMultiple().
+ * See caerDynapseWriteSramN() for the meaning and range of each field.
+ */
+struct caer_dynapse_sram {
+	/// Neuron to program, range [0,1023].
+	uint16_t neuronAddr;
+	/// SRAM address (one of four cells), range [0,3].
+	uint8_t sramId;
+	/// Fake source core ID, range [0,3].
+	uint8_t virtualCoreId;
+	/// X direction, one of the DYNAPSE_CONFIG_SRAM_DIRECTION_X_* values.
+	bool sx;
+	/// X delta, range [0,3].
+	uint8_t dx;
+	/// Y direction, one of the DYNAPSE_CONFIG_SRAM_DIRECTION_Y_* values.
+	bool sy;
+	/// Y delta, range [0,3].
+	uint8_t dy;
+	/// Spike destination cores, one-hot coded, range [0,15].
+	uint8_t destinationCore;
+};
+
 /**
  * Return basic information on the device, such as its ID, the logic
  * version, and so on. See the 'struct caer_dynapse_info' documentation
@@ -885,6 +935,36 @@ bool caerDynapseWriteSramN(caerDeviceHandle handle, uint16_t neuronAddr, uint8_t
 bool caerDynapseWriteCam(
 	caerDeviceHandle handle, uint16_t inputNeuronAddr, uint16_t neuronAddr, uint8_t camId, uint8_t synapseType);
 
+/**
+ * Write many CAMs at once. This is equivalent to calling caerDynapseWriteCam()
+ * for each element of the array, but the configuration is sent to the device
+ * in bulk, which is much faster, especially when loading whole networks.
+ *
+ * Remember to select the chip you want to configure before calling this function!
+ *
+ * @param handle a valid device handle.
+ * @param cams array of CAMs to program.
+ * @param camsNumber number of elements in the 'cams' array.
+ *
+ * @return true on success, false otherwise.
+ */
+bool caerDynapseWriteCamMultiple(caerDeviceHandle handle, const struct caer_dynapse_cam *cams, size_t camsNumber);
+
+/**
+ * Write many SRAMs at once. This is equivalent to calling caerDynapseWriteSramN()
+ * for each element of the array, but the configuration is sent to the device
+ * in bulk, which is much faster, especially when loading whole networks.
+ *
+ * Remember to select the chip you want to configure before calling this function!
+ *
+ * @param handle a valid device handle.
+ * @param srams array of SRAMs to program.
+ * @param sramsNumber number of elements in the 'srams' array.
+ *
+ * @return true on success, false otherwise.
+ */
+bool caerDynapseWriteSramMultiple(caerDeviceHandle handle, const struct caer_dynapse_sram *srams, size_t sramsNumber);
+
 /**
  * Send array of configuration parameters to the device via USB.
  *
@@ -41,6 +41,26 @@ extern "C" {
  * configuration switch and will reset itself right away.
  */
 #define EDVS_CONFIG_DVS_TIMESTAMP_RESET 1
+/**
+ * Parameter address for module EDVS_CONFIG_DVS:
+ * format of the timestamps the device attaches to each event,
+ * see the EDVS_TIMESTAMP_FORMAT_* values. Default is 16 bit.
+ */
+#define EDVS_CONFIG_DVS_TIMESTAMP_FORMAT 2
+
+/**
+ * Parameter values for EDVS_CONFIG_DVS_TIMESTAMP_FORMAT:
+ * timestamp attached to each event. DELTA is the time since the previous
+ * event, in 1 to 4 bytes of 7 bits each (smallest serial bandwidth); the
+ * others are absolute timestamps of the given width (fewest wraps).
+ * All timestamps have a resolution of 1µs.
+ */
+//@{
+#define EDVS_TIMESTAMP_FORMAT_DELTA 1
+#define EDVS_TIMESTAMP_FORMAT_16BIT 2
+#define EDVS_TIMESTAMP_FORMAT_24BIT 3
+#define EDVS_TIMESTAMP_FORMAT_32BIT 4
+//@}
 
 /**
  * Parameter address for module EDVS_CONFIG_BIAS:
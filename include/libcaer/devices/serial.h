@@ -25,6 +25,19 @@ extern "C" {
  * read size for serial port communication.
  */
 #define CAER_HOST_CONFIG_SERIAL_READ_SIZE 0
+/**
+ * Parameter address for module CAER_HOST_CONFIG_SERIAL:
+ * minimum number of bytes to wait for before decoding data.
+ * Reads block until this much data is available, or the timeout
+ * set with CAER_HOST_CONFIG_SERIAL_READ_TIMEOUT expires.
+ */
+#define CAER_HOST_CONFIG_SERIAL_READ_MIN_SIZE 1
+/**
+ * Parameter address for module CAER_HOST_CONFIG_SERIAL:
+ * maximum time in milliseconds to wait for the minimum read
+ * size to be available, before decoding what is there.
+ */
+#define CAER_HOST_CONFIG_SERIAL_READ_TIMEOUT 2
 
 /**
  * Parameter values for module CAER_HOST_CONFIG_SERIAL:
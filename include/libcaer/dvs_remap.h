@@ -0,0 +1,96 @@
+/**
+ * @file dvs_remap.h
+ *
+ * Per-pixel DVS address remapping tables, to be set on a device with
+ * caerDeviceDVSRemapSet(). A table has one entry per pixel, indexed by
+ * the address an event would have without remapping (in output
+ * orientation, index = y * dvsSizeX + x), and holds the address the
+ * event gets instead, or CAER_DVS_REMAP_DROP to drop it.
+ * This way orientation changes, lens undistortion and pixel masking all
+ * happen in the translator with one lookup per event.
+ */
+
+#ifndef LIBCAER_DVS_REMAP_H_
+#define LIBCAER_DVS_REMAP_H_
+
+#include "libcaer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Remapping table entry: drop events from this pixel.
+ */
+#define CAER_DVS_REMAP_DROP UINT32_MAX
+/**
+ * Remapping table entry: move events from this pixel to address (X, Y).
+ * Both addresses must be smaller than 32768.
+ */
+#define CAER_DVS_REMAP_ADDRESS(X, Y) ((U32T(Y) << 16) | U32T(X))
+/**
+ * Get the X address from a remapping table entry.
+ */
+#define CAER_DVS_REMAP_GET_X(ENTRY) U16T((ENTRY) & 0xFFFF)
+/**
+ * Get the Y address from a remapping table entry.
+ */
+#define CAER_DVS_REMAP_GET_Y(ENTRY) U16T((ENTRY) >> 16)
+
+/**
+ * Orientation flags for caerDVSRemapBuild().
+ * They are applied after undistortion, in this order: flip X, flip Y,
+ * then exchange X and Y. As the output addresses must stay inside the
+ * same array, exchanging X and Y is only possible on square arrays.
+ */
+enum caer_dvs_remap_orientation {
+	CAER_DVS_REMAP_FLIP_X    = 0x01,
+	CAER_DVS_REMAP_FLIP_Y    = 0x02,
+	CAER_DVS_REMAP_INVERT_XY = 0x04,
+};
+
+/**
+ * Lens distortion model for caerDVSRemapBuild(), with radial (k1, k2, k3)
+ * and tangential (p1, p2) coefficients, the same as used by OpenCV.
+ * The camera matrix is used both to normalize the distorted addresses
+ * and to project the undistorted ones back to the pixel array.
+ */
+struct caer_dvs_remap_distortion {
+	/// Focal lengths in pixels.
+	float fx;
+	float fy;
+	/// Principal point in pixels.
+	float cx;
+	float cy;
+	/// Radial distortion coefficients.
+	float k1;
+	float k2;
+	float k3;
+	/// Tangential distortion coefficients.
+	float p1;
+	float p2;
+};
+
+/**
+ * Fill a remapping table for a pixel array of 'sizeX' by 'sizeY' pixels,
+ * first undistorting every address (if 'distortion' is not NULL), then
+ * applying the orientation flags. Pixels that end up outside the array
+ * are dropped.
+ *
+ * @param remapTable table to fill, must hold sizeX * sizeY entries.
+ * @param sizeX array width, usually the device's dvsSizeX.
+ * @param sizeY array height, usually the device's dvsSizeY.
+ * @param orientation OR of caer_dvs_remap_orientation flags, or 0.
+ * @param distortion lens distortion model, or NULL for none.
+ *
+ * @return true on success, false on invalid arguments, such as
+ *         CAER_DVS_REMAP_INVERT_XY with sizeX different from sizeY.
+ */
+bool caerDVSRemapBuild(uint32_t *remapTable, uint16_t sizeX, uint16_t sizeY, uint8_t orientation,
+	const struct caer_dvs_remap_distortion *distortion);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_DVS_REMAP_H_ */
@@ -18,8 +18,20 @@ extern "C" {
 #endif
 
 #ifndef CAER_EVENTS_HEADER_ONLY
-#	define caerLogEHO caerLog
+#	define caerLogEHO                       caerLog
+#	define caerMallocEHO                    caerMalloc
+#	define caerCallocEHO                    caerCalloc
+#	define caerReallocEHO                   caerRealloc
+#	define caerFreeEHO                      caerFree
+#	define caerEventPacketMemoryAllocateEHO caerEventPacketMemoryAllocate
 #else
+// Without the library, memory comes from the standard allocator.
+#	define caerMallocEHO                                      malloc
+#	define caerCallocEHO                                      calloc
+#	define caerReallocEHO                                     realloc
+#	define caerFreeEHO                                        free
+#	define caerEventPacketMemoryAllocateEHO(EVENT_TYPE, SIZE) calloc(1, (SIZE))
+
 static inline void caerLogEHO(enum caer_log_level logLevel, const char *subSystem, const char *format, ...) {
 	// Ignore logLevel, all event packet messages are critical.
 	(void) (logLevel);
@@ -70,20 +82,22 @@ static inline void caerLogEHO(enum caer_log_level logLevel, const char *subSyste
  * DO NOT USE THEM FOR YOUR OWN EVENT TYPES!
  */
 enum caer_default_event_types {
-	SPECIAL_EVENT   = 0,  //!< Special events.
-	POLARITY_EVENT  = 1,  //!< Polarity (change, DVS) events.
-	FRAME_EVENT     = 2,  //!< Frame (intensity, APS) events.
-	IMU6_EVENT      = 3,  //!< 6 axes IMU events.
-	IMU9_EVENT      = 4,  //!< 9 axes IMU events.
-	SAMPLE_EVENT    = 5,  //!< ADC sample events (deprecated).
-	EAR_EVENT       = 6,  //!< Ear (cochlea) events (deprecated).
-	CONFIG_EVENT    = 7,  //!< Device configuration events (deprecated).
-	POINT1D_EVENT   = 8,  //!< 1D measurement events (deprecated).
-	POINT2D_EVENT   = 9,  //!< 2D measurement events (deprecated).
-	POINT3D_EVENT   = 10, //!< 3D measurement events (deprecated).
-	POINT4D_EVENT   = 11, //!< 4D measurement events (deprecated).
-	SPIKE_EVENT     = 12, //!< Spike events.
-	MATRIX4x4_EVENT = 13, //!< 4D matrix events (deprecated).
+	SPECIAL_EVENT             = 0,  //!< Special events.
+	POLARITY_EVENT            = 1,  //!< Polarity (change, DVS) events.
+	FRAME_EVENT               = 2,  //!< Frame (intensity, APS) events.
+	IMU6_EVENT                = 3,  //!< 6 axes IMU events.
+	IMU9_EVENT                = 4,  //!< 9 axes IMU events.
+	SAMPLE_EVENT              = 5,  //!< ADC sample events (deprecated).
+	EAR_EVENT                 = 6,  //!< Ear (cochlea) events (deprecated).
+	CONFIG_EVENT              = 7,  //!< Device configuration events (deprecated).
+	POINT1D_EVENT             = 8,  //!< 1D measurement events (deprecated).
+	POINT2D_EVENT             = 9,  //!< 2D measurement events (deprecated).
+	POINT3D_EVENT             = 10, //!< 3D measurement events (deprecated).
+	POINT4D_EVENT             = 11, //!< 4D measurement events (deprecated).
+	SPIKE_EVENT               = 12, //!< Spike events.
+	MATRIX4x4_EVENT           = 13, //!< 4D matrix events (deprecated).
+	POLARITY_COLUMNS_EVENT    = 14, //!< Polarity (change, DVS) events, columnar layout.
+	POLARITY_COMPRESSED_EVENT = 15, //!< Polarity (change, DVS) events, compressed.
 };
 
 /**
@@ -91,7 +105,7 @@ enum caer_default_event_types {
  * Corresponds to the count of definitions inside the
  * 'enum caer_default_event_types' enumeration.
  */
-#define CAER_DEFAULT_EVENT_TYPES_COUNT 14
+#define CAER_DEFAULT_EVENT_TYPES_COUNT 16
 
 /**
  * Size of the EventPacket header.
@@ -494,6 +508,71 @@ static inline bool caerGenericEventCopy(void *eventPtrDestination, const void *e
 	return (true);
 }
 
+/**
+ * Find the first event in a packet whose main 64 bit timestamp is equal to
+ * or greater than the given one (lower bound), using binary search.
+ * The events must be ordered by timestamp, as is always the case for packets
+ * coming from devices and input modules. Invalid events are searched too, so
+ * the result can be used directly as an index into the packet.
+ * Packets whose layout does not hold individual events (POLARITY_COLUMNS_EVENT,
+ * POLARITY_COMPRESSED_EVENT) are not supported.
+ *
+ * @param headerPtr a valid EventPacket header pointer. If NULL, returns -1.
+ * @param timestamp the 64 bit timestamp to search for.
+ *
+ * @return the index of the first event at or after the timestamp, within
+ *         [0,eventNumber]: eventNumber if all events are earlier. -1 on error.
+ */
+static inline int32_t caerEventPacketFindTimestamp(caerEventPacketHeaderConst headerPtr, int64_t timestamp) {
+	if (headerPtr == NULL) {
+		return (-1);
+	}
+
+	int16_t eventType = caerEventPacketHeaderGetEventType(headerPtr);
+	if ((eventType == POLARITY_COLUMNS_EVENT) || (eventType == POLARITY_COMPRESSED_EVENT)) {
+		caerLogEHO(CAER_LOG_CRITICAL, "Event Packet",
+			"Called caerEventPacketFindTimestamp() on a packet of type %" PRIi16 ", which holds no individual events.",
+			eventType);
+		return (-1);
+	}
+
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(headerPtr);
+
+	// All events share the packet's timestamp overflow, so only the
+	// 32 bit timestamps need to be compared.
+	int64_t overflowBase = I64T(U64T(caerEventPacketHeaderGetEventTSOverflow(headerPtr)) << TS_OVERFLOW_SHIFT);
+
+	if (timestamp <= overflowBase) {
+		return (0);
+	}
+
+	if ((timestamp - overflowBase) > INT32_MAX) {
+		return (eventNumber);
+	}
+
+	int32_t timestamp32   = I32T(timestamp - overflowBase);
+	const uint8_t *events = ((const uint8_t *) headerPtr) + CAER_EVENT_PACKET_HEADER_SIZE;
+	size_t eventSize      = (size_t) caerEventPacketHeaderGetEventSize(headerPtr);
+
+	int32_t first = 0;
+	int32_t count = eventNumber;
+
+	while (count > 0) {
+		int32_t half      = count / 2;
+		const void *event = events + ((size_t) (first + half) * eventSize);
+
+		if (caerGenericEventGetTimestamp(event, headerPtr) < timestamp32) {
+			first += half + 1;
+			count -= half + 1;
+		}
+		else {
+			count = half;
+		}
+	}
+
+	return (first);
+}
+
 /**
  * Generic iterator over all events in a packet.
  * Returns the current index in the 'caerIteratorCounter' variable of type
@@ -650,6 +729,18 @@ static inline void caerEventPacketClear(caerEventPacketHeader packet) {
 	caerEventPacketHeaderSetEventNumber(packet, 0);
 }
 
+#ifndef CAER_EVENTS_HEADER_ONLY
+/**
+ * Move all valid events of a packet with 8 byte events (polarity,
+ * special, spike...) to its start, keeping their order. Used by
+ * caerEventPacketClean(), which also updates the header and zeroes
+ * the rest; uses SIMD instructions where available.
+ *
+ * @param packet an event packet with an event size of 8 bytes. Cannot be NULL.
+ */
+void caerEventPacketCompact8(caerEventPacketHeader packet);
+#endif
+
 /**
  * Clean a packet by removing all invalid events, so that
  * the total number of events is the number of valid events.
@@ -672,23 +763,34 @@ static inline void caerEventPacketClean(caerEventPacketHeader packet) {
 		return;
 	}
 
-	int32_t eventSize     = caerEventPacketHeaderGetEventSize(packet);
-	int32_t eventCapacity = caerEventPacketHeaderGetEventCapacity(packet);
+	int32_t eventSize = caerEventPacketHeaderGetEventSize(packet);
 
 	// Move all valid events close together. Must check every event for validity!
-	size_t offset = CAER_EVENT_PACKET_HEADER_SIZE;
+#ifndef CAER_EVENTS_HEADER_ONLY
+	if (eventSize == 8) {
+		// Most common case, vectorized in the library.
+		caerEventPacketCompact8(packet);
+	}
+	else
+#endif
+	{
+		size_t offset = CAER_EVENT_PACKET_HEADER_SIZE;
 
-	CAER_ITERATOR_VALID_START(packet, const void *)
-	void *dest = ((uint8_t *) packet) + offset;
+		CAER_ITERATOR_VALID_START(packet, const void *)
+		void *dest = ((uint8_t *) packet) + offset;
+
+		if (dest != caerIteratorElement) {
+			memcpy(dest, caerIteratorElement, (size_t) eventSize);
+		}
 
-	if (dest != caerIteratorElement) {
-		memcpy(dest, caerIteratorElement, (size_t) eventSize);
 		offset += (size_t) eventSize;
+		CAER_ITERATOR_VALID_END
 	}
-}
 
-// Reset remaining memory, up to capacity, to zero (all events invalid).
-memset(((uint8_t *) packet) + offset, 0, (size_t) ((eventCapacity - eventValid) * eventSize));
+	// Reset remaining memory, up to event number, to zero (all events invalid).
+	// The events after it, up to capacity, are by definition already zeroed out.
+	memset(((uint8_t *) packet) + CAER_EVENT_PACKET_HEADER_SIZE + ((size_t) eventValid * (size_t) eventSize), 0,
+		(size_t) (eventNumber - eventValid) * (size_t) eventSize);
 
 // Event capacity remains unchanged, event number shrunk to event valid number.
 caerEventPacketHeaderSetEventNumber(packet, eventValid);
@@ -701,7 +803,7 @@ caerEventPacketHeaderSetEventNumber(packet, eventValid);
  * - If the new capacity is bigger, the packet is enlarged and the new events
  *   are initialized to all zeros (invalid).
  * - If the new capacity is smaller, the packet is truncated at the given point.
- * Use free() to reclaim this memory afterwards.
+ * Use caerEventPacketFree() to reclaim this memory afterwards.
  *
  * @param packet the current event packet.
  * @param newEventCapacity the new maximum number of events this packet can hold.
@@ -717,6 +819,12 @@ static inline caerEventPacketHeader caerEventPacketResize(caerEventPacketHeader
 		return (NULL);
 	}
 
+	// Columnar and compressed layouts depend on the capacity, they cannot be resized.
+	if ((caerEventPacketHeaderGetEventType(packet) == POLARITY_COLUMNS_EVENT)
+		|| (caerEventPacketHeaderGetEventType(packet) == POLARITY_COMPRESSED_EVENT)) {
+		return (NULL);
+	}
+
 	// Always clean for consistency with shrink case (side-effects guarantee).
 	caerEventPacketClean(packet);
 
@@ -731,7 +839,7 @@ static inline caerEventPacketHeader caerEventPacketResize(caerEventPacketHeader
 	size_t newEventPacketSize = CAER_EVENT_PACKET_HEADER_SIZE + (size_t) (newEventCapacity * eventSize);
 
 	// Reallocate memory used to hold events.
-	packet = (caerEventPacketHeader) realloc(packet, newEventPacketSize);
+	packet = (caerEventPacketHeader) caerReallocEHO(packet, newEventPacketSize);
 	if (packet == NULL) {
 		caerLogEHO(CAER_LOG_CRITICAL, "Event Packet",
 			"Failed to reallocate %zu bytes of memory for resizing Event Packet of capacity %" PRIi32
@@ -770,7 +878,7 @@ static inline caerEventPacketHeader caerEventPacketResize(caerEventPacketHeader
  * Grows an event packet.
  * This only supports strictly increasing the size of a packet.
  * For a more flexible resize operation, see caerEventPacketResize().
- * Use free() to reclaim this memory afterwards.
+ * Use caerEventPacketFree() to reclaim this memory afterwards.
  *
  * @param packet the current event packet.
  * @param newEventCapacity the new maximum number of events this packet can hold.
@@ -785,6 +893,12 @@ static inline caerEventPacketHeader caerEventPacketGrow(caerEventPacketHeader pa
 		return (NULL);
 	}
 
+	// Columnar and compressed layouts depend on the capacity, they cannot be grown.
+	if ((caerEventPacketHeaderGetEventType(packet) == POLARITY_COLUMNS_EVENT)
+		|| (caerEventPacketHeaderGetEventType(packet) == POLARITY_COMPRESSED_EVENT)) {
+		return (NULL);
+	}
+
 	int32_t oldEventCapacity = caerEventPacketHeaderGetEventCapacity(packet);
 
 	if (newEventCapacity <= oldEventCapacity) {
@@ -800,7 +914,7 @@ static inline caerEventPacketHeader caerEventPacketGrow(caerEventPacketHeader pa
 	size_t newEventPacketSize = CAER_EVENT_PACKET_HEADER_SIZE + (size_t) (newEventCapacity * eventSize);
 
 	// Grow memory used to hold events.
-	packet = (caerEventPacketHeader) realloc(packet, newEventPacketSize);
+	packet = (caerEventPacketHeader) caerReallocEHO(packet, newEventPacketSize);
 	if (packet == NULL) {
 		caerLogEHO(CAER_LOG_CRITICAL, "Event Packet",
 			"Failed to reallocate %zu bytes of memory for growing Event Packet of capacity %" PRIi32
@@ -824,7 +938,7 @@ static inline caerEventPacketHeader caerEventPacketGrow(caerEventPacketHeader pa
  * Appends an event packet to another.
  * This is a simple append operation, no timestamp reordering is done.
  * Please ensure time is monotonically increasing over the two packets!
- * Use free() to reclaim this memory afterwards.
+ * Use caerEventPacketFree() to reclaim this memory afterwards.
  *
  * @param packet the main events packet.
  * @param appendPacket the events packet to append on the main one.
@@ -845,6 +959,12 @@ static inline caerEventPacketHeader caerEventPacketAppend(
 		return (packet);
 	}
 
+	// Columnar and compressed layouts depend on the capacity, they cannot be appended to.
+	if ((caerEventPacketHeaderGetEventType(packet) == POLARITY_COLUMNS_EVENT)
+		|| (caerEventPacketHeaderGetEventType(packet) == POLARITY_COMPRESSED_EVENT)) {
+		return (NULL);
+	}
+
 	// Check that the two packets are of the same type and size, and have the same TSOverflow epoch.
 	if ((caerEventPacketHeaderGetEventType(packet) != caerEventPacketHeaderGetEventType(appendPacket))
 		|| (caerEventPacketHeaderGetEventSize(packet) != caerEventPacketHeaderGetEventSize(appendPacket))
@@ -865,7 +985,7 @@ static inline caerEventPacketHeader caerEventPacketAppend(
 		= CAER_EVENT_PACKET_HEADER_SIZE + (size_t) ((packetEventCapacity + appendPacketEventCapacity) * eventSize);
 
 	// Grow memory used to hold events.
-	packet = (caerEventPacketHeader) realloc(packet, newEventPacketSize);
+	packet = (caerEventPacketHeader) caerReallocEHO(packet, newEventPacketSize);
 	if (packet == NULL) {
 		caerLogEHO(CAER_LOG_CRITICAL, "Event Packet",
 			"Failed to reallocate %zu bytes of memory for appending Event Packet of capacity %" PRIi32
@@ -914,7 +1034,7 @@ static inline caerEventPacketHeader caerEventPacketCopy(caerEventPacketHeaderCon
 	size_t dataMem        = CAER_EVENT_PACKET_HEADER_SIZE + (size_t) (eventSize * eventNumber);
 
 	// Allocate memory for new event packet.
-	caerEventPacketHeader packetCopy = (caerEventPacketHeader) malloc(packetMem);
+	caerEventPacketHeader packetCopy = (caerEventPacketHeader) caerMallocEHO(packetMem);
 	if (packetCopy == NULL) {
 		// Failed to allocate memory.
 		return (NULL);
@@ -956,7 +1076,7 @@ static inline caerEventPacketHeader caerEventPacketCopyOnlyEvents(caerEventPacke
 	size_t packetMem = CAER_EVENT_PACKET_HEADER_SIZE + (size_t) (eventSize * eventNumber);
 
 	// Allocate memory for new event packet.
-	caerEventPacketHeader packetCopy = (caerEventPacketHeader) malloc(packetMem);
+	caerEventPacketHeader packetCopy = (caerEventPacketHeader) caerMallocEHO(packetMem);
 	if (packetCopy == NULL) {
 		// Failed to allocate memory.
 		return (NULL);
@@ -995,10 +1115,15 @@ static inline caerEventPacketHeader caerEventPacketCopyOnlyValidEvents(caerEvent
 		return (NULL);
 	}
 
+	// Without invalid events, there is nothing to skip.
+	if (eventValid == caerEventPacketHeaderGetEventNumber(packet)) {
+		return (caerEventPacketCopyOnlyEvents(packet));
+	}
+
 	size_t packetMem = CAER_EVENT_PACKET_HEADER_SIZE + (size_t) (eventSize * eventValid);
 
 	// Allocate memory for new event packet.
-	caerEventPacketHeader packetCopy = (caerEventPacketHeader) malloc(packetMem);
+	caerEventPacketHeader packetCopy = (caerEventPacketHeader) caerMallocEHO(packetMem);
 	if (packetCopy == NULL) {
 		// Failed to allocate memory.
 		return (NULL);
@@ -1041,7 +1166,7 @@ static inline caerEventPacketHeader caerEventPacketAllocate(int32_t eventCapacit
 	size_t eventPacketSize = CAER_EVENT_PACKET_HEADER_SIZE + ((size_t) eventCapacity * (size_t) eventSize);
 
 	// Zero out event memory (all events invalid).
-	caerEventPacketHeader packet = (caerEventPacketHeader) calloc(1, eventPacketSize);
+	caerEventPacketHeader packet = (caerEventPacketHeader) caerEventPacketMemoryAllocateEHO(eventType, eventPacketSize);
 	if (packet == NULL) {
 		caerLogEHO(CAER_LOG_CRITICAL, "Event Packet",
 			"Failed to allocate %zu bytes of memory for Event Packet of type %" PRIi16 ", capacity %" PRIi32
@@ -1061,6 +1186,17 @@ static inline caerEventPacketHeader caerEventPacketAllocate(int32_t eventCapacit
 	return (packet);
 }
 
+/**
+ * Free the memory of an event packet, giving it back to the allocator
+ * it came from, see allocator.h. Always use this instead of free()
+ * when a custom allocator or the frame hugepage arena is in use.
+ *
+ * @param packet an event packet to free. If NULL, nothing happens.
+ */
+static inline void caerEventPacketFree(caerEventPacketHeader packet) {
+	caerFreeEHO(packet);
+}
+
 #ifdef __cplusplus
 }
 #endif
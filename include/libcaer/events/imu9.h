@@ -85,7 +85,7 @@ typedef const struct caer_imu9_event_packet *caerIMU9EventPacketConst;
 
 /**
  * Allocate a new IMU 9-axes events packet.
- * Use free() to reclaim this memory.
+ * Use caerEventPacketFree() to reclaim this memory.
  *
  * @param eventCapacity the maximum number of events this packet will hold.
  * @param eventSource the unique ID representing the source/generator of this packet.
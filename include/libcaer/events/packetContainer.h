@@ -98,7 +98,7 @@ static inline caerEventPacketContainer caerEventPacketContainerAllocate(int32_t
 	size_t eventPacketContainerSize
 		= sizeof(struct caer_event_packet_container) + ((size_t) eventPacketsNumber * sizeof(caerEventPacketHeader));
 
-	caerEventPacketContainer packetContainer = (caerEventPacketContainer) calloc(1, eventPacketContainerSize);
+	caerEventPacketContainer packetContainer = (caerEventPacketContainer) caerCallocEHO(1, eventPacketContainerSize);
 	if (packetContainer == NULL) {
 		caerLogEHO(CAER_LOG_CRITICAL, "EventPacket Container",
 			"Failed to allocate %zu bytes of memory for Event Packet Container, containing %" PRIi32
@@ -274,11 +274,11 @@ static inline void caerEventPacketContainerFree(caerEventPacketContainer contain
 		caerEventPacketHeader packetHeader = caerEventPacketContainerGetEventPacket(container, i);
 
 		if (packetHeader != NULL) {
-			free(packetHeader);
+			caerEventPacketFree(packetHeader);
 		}
 	}
 
-	free(container);
+	caerFreeEHO(container);
 }
 
 /**
@@ -425,6 +425,19 @@ static inline void caerEventPacketContainerUpdateStatistics(caerEventPacketConta
 
 	const void *lastEvent = caerGenericEventGetEvent(caerEventPacketContainerIteratorElement,
 		caerEventPacketHeaderGetEventNumber(caerEventPacketContainerIteratorElement) - 1);
+
+	// Columnar packets start with the timestamps column, see polarityColumns.h.
+	if (caerEventPacketHeaderGetEventType(caerEventPacketContainerIteratorElement) == POLARITY_COLUMNS_EVENT) {
+		lastEvent = ((const uint8_t *) firstEvent)
+					+ ((size_t) (caerEventPacketHeaderGetEventNumber(caerEventPacketContainerIteratorElement) - 1)
+						* sizeof(int32_t));
+	}
+
+	// Compressed packets have the last timestamp in their second word, see polarityCompressed.h.
+	if (caerEventPacketHeaderGetEventType(caerEventPacketContainerIteratorElement) == POLARITY_COMPRESSED_EVENT) {
+		lastEvent = ((const uint8_t *) firstEvent) + sizeof(int32_t);
+	}
+
 	int64_t currHighestEventTimestamp
 		= caerGenericEventGetTimestamp64(lastEvent, caerEventPacketContainerIteratorElement);
 
@@ -561,6 +574,291 @@ static inline caerEventPacketContainer caerEventPacketContainerCopyValidEvents(
 	return (newContainer);
 }
 
+/**
+ * Maximum number of event packets a time-ordered iterator can merge.
+ * Containers produced by the device drivers and the input modules hold
+ * one packet per event type, which is far less than this.
+ */
+#define CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_MAX_PACKETS 32
+
+/**
+ * Current position inside one event packet of a time-ordered iterator.
+ * Internal, use the caerEventPacketContainerTimeOrderedIterator*() functions.
+ */
+struct caer_event_packet_container_time_ordered_entry {
+	/// Event packet being merged.
+	caerEventPacketHeaderConst packet;
+	/// Order in which the packet was added, breaks ties between equal timestamps.
+	int32_t order;
+	/// Index of the current event inside the packet.
+	int32_t eventIndex;
+	/// 64bit timestamp of the current event.
+	int64_t timestamp;
+};
+
+/**
+ * Time-ordered iterator state: a binary min-heap holding the current
+ * event of each merged packet, ordered by timestamp. It only holds
+ * pointers to the events, nothing is copied, so the packets must not
+ * be changed or freed while iterating.
+ */
+struct caer_event_packet_container_time_ordered_iterator {
+	/// Number of packets still having events to return.
+	int32_t size;
+	/// Number of packets added so far.
+	int32_t added;
+	/// Heap of the current event of each packet.
+	struct caer_event_packet_container_time_ordered_entry heap[CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_MAX_PACKETS];
+};
+
+/**
+ * One event returned by a time-ordered iterator.
+ */
+struct caer_event_packet_container_time_ordered_event {
+	/// Type of the event, from its packet header.
+	int16_t type;
+	/// Packet the event belongs to.
+	caerEventPacketHeaderConst packet;
+	/// Pointer to the event inside its packet.
+	const void *event;
+	/// 64bit timestamp of the event.
+	int64_t timestamp;
+};
+
+static inline bool caerEventPacketContainerTimeOrderedEntryBefore(
+	const struct caer_event_packet_container_time_ordered_entry *a,
+	const struct caer_event_packet_container_time_ordered_entry *b) {
+	return ((a->timestamp < b->timestamp) || ((a->timestamp == b->timestamp) && (a->order < b->order)));
+}
+
+static inline const void *caerEventPacketContainerTimeOrderedEntryEvent(
+	const struct caer_event_packet_container_time_ordered_entry *entry) {
+	return (((const uint8_t *) entry->packet) + CAER_EVENT_PACKET_HEADER_SIZE
+			+ ((size_t) entry->eventIndex * (size_t) caerEventPacketHeaderGetEventSize(entry->packet)));
+}
+
+// Move the entry to the next valid event of its packet, starting at the
+// given index. Returns false if the packet has no more valid events.
+static inline bool caerEventPacketContainerTimeOrderedEntrySeek(
+	struct caer_event_packet_container_time_ordered_entry *entry, int32_t eventIndex) {
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(entry->packet);
+
+	for (; eventIndex < eventNumber; eventIndex++) {
+		entry->eventIndex = eventIndex;
+
+		const void *event = caerEventPacketContainerTimeOrderedEntryEvent(entry);
+
+		if (caerGenericEventIsValid(event)) {
+			entry->timestamp = caerGenericEventGetTimestamp64(event, entry->packet);
+			return (true);
+		}
+	}
+
+	return (false);
+}
+
+static inline void caerEventPacketContainerTimeOrderedIteratorSiftDown(
+	struct caer_event_packet_container_time_ordered_iterator *it, int32_t pos) {
+	struct caer_event_packet_container_time_ordered_entry entry = it->heap[pos];
+
+	for (;;) {
+		int32_t child = (2 * pos) + 1;
+
+		if (child >= it->size) {
+			break;
+		}
+
+		if (((child + 1) < it->size)
+			&& caerEventPacketContainerTimeOrderedEntryBefore(&it->heap[child + 1], &it->heap[child])) {
+			child++;
+		}
+
+		if (!caerEventPacketContainerTimeOrderedEntryBefore(&it->heap[child], &entry)) {
+			break;
+		}
+
+		it->heap[pos] = it->heap[child];
+		pos           = child;
+	}
+
+	it->heap[pos] = entry;
+}
+
+/**
+ * Initialize an empty time-ordered iterator.
+ * Packets are then added with caerEventPacketContainerTimeOrderedIteratorAddPacket().
+ *
+ * @param it a time-ordered iterator to initialize. Cannot be NULL.
+ */
+static inline void caerEventPacketContainerTimeOrderedIteratorInit(
+	struct caer_event_packet_container_time_ordered_iterator *it) {
+	it->size  = 0;
+	it->added = 0;
+}
+
+/**
+ * Add an event packet to a time-ordered iterator. Its valid events will be
+ * returned merged with those of the other packets, by timestamp.
+ * The events of a packet must already be ordered by timestamp, as is
+ * always the case for packets coming from devices and input modules.
+ * Packets without valid events, and packets whose layout does not hold
+ * individual events (POLARITY_COLUMNS_EVENT, POLARITY_COMPRESSED_EVENT),
+ * are skipped. Packets can only be added before iteration starts.
+ *
+ * @param it an initialized time-ordered iterator. Cannot be NULL.
+ * @param packet an event packet to merge. If NULL, it is skipped.
+ *
+ * @return true on success, false if too many packets were added.
+ */
+static inline bool caerEventPacketContainerTimeOrderedIteratorAddPacket(
+	struct caer_event_packet_container_time_ordered_iterator *it, caerEventPacketHeaderConst packet) {
+	if (packet == NULL) {
+		return (true);
+	}
+
+	int16_t type = caerEventPacketHeaderGetEventType(packet);
+	if ((type == POLARITY_COLUMNS_EVENT) || (type == POLARITY_COMPRESSED_EVENT)) {
+		return (true);
+	}
+
+	if (it->size >= CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_MAX_PACKETS) {
+		caerLogEHO(CAER_LOG_CRITICAL, "EventPacket Container",
+			"Called caerEventPacketContainerTimeOrderedIteratorAddPacket() with more than %d non-empty packets.",
+			CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_MAX_PACKETS);
+		return (false);
+	}
+
+	struct caer_event_packet_container_time_ordered_entry entry;
+	entry.packet = packet;
+	entry.order  = it->added++;
+
+	if (!caerEventPacketContainerTimeOrderedEntrySeek(&entry, 0)) {
+		return (true);
+	}
+
+	// Sift up into place.
+	int32_t pos = it->size++;
+
+	while (pos > 0) {
+		int32_t parent = (pos - 1) / 2;
+
+		if (!caerEventPacketContainerTimeOrderedEntryBefore(&entry, &it->heap[parent])) {
+			break;
+		}
+
+		it->heap[pos] = it->heap[parent];
+		pos           = parent;
+	}
+
+	it->heap[pos] = entry;
+
+	return (true);
+}
+
+/**
+ * Initialize a time-ordered iterator over all the valid events in all the
+ * event packets of an event packet container. See
+ * caerEventPacketContainerTimeOrderedIteratorAddPacket() for which packets
+ * are merged.
+ *
+ * @param it a time-ordered iterator to initialize. Cannot be NULL.
+ * @param container an event packet container. If NULL, no events are returned.
+ *
+ * @return true on success, false if the container has more than
+ *         CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_MAX_PACKETS non-empty packets.
+ */
+static inline bool caerEventPacketContainerTimeOrderedIteratorInitContainer(
+	struct caer_event_packet_container_time_ordered_iterator *it, caerEventPacketContainerConst container) {
+	caerEventPacketContainerTimeOrderedIteratorInit(it);
+
+	CAER_EVENT_PACKET_CONTAINER_CONST_ITERATOR_START(container)
+	if (!caerEventPacketContainerTimeOrderedIteratorAddPacket(it, caerEventPacketContainerIteratorElement)) {
+		return (false);
+	}
+	CAER_EVENT_PACKET_CONTAINER_ITERATOR_END
+
+	return (true);
+}
+
+/**
+ * Get the next event, in timestamp order, from a time-ordered iterator.
+ * Events with the same timestamp are returned in the order their packets
+ * were added, so in container order.
+ *
+ * @param it an initialized time-ordered iterator. Cannot be NULL.
+ * @param event where to store the next event. Cannot be NULL.
+ *
+ * @return true if an event was returned, false if there are no more events.
+ */
+static inline bool caerEventPacketContainerTimeOrderedIteratorNext(
+	struct caer_event_packet_container_time_ordered_iterator *it,
+	struct caer_event_packet_container_time_ordered_event *event) {
+	if (it->size == 0) {
+		return (false);
+	}
+
+	struct caer_event_packet_container_time_ordered_entry *top = &it->heap[0];
+
+	event->type      = caerEventPacketHeaderGetEventType(top->packet);
+	event->packet    = top->packet;
+	event->event     = caerEventPacketContainerTimeOrderedEntryEvent(top);
+	event->timestamp = top->timestamp;
+
+	// Advance the packet the event came from, or drop it if it is done.
+	if (!caerEventPacketContainerTimeOrderedEntrySeek(top, top->eventIndex + 1)) {
+		it->size--;
+		it->heap[0] = it->heap[it->size];
+	}
+
+	if (it->size > 1) {
+		caerEventPacketContainerTimeOrderedIteratorSiftDown(it, 0);
+	}
+
+	return (true);
+}
+
+/**
+ * Time-ordered iterator over all valid events in all event packets of an
+ * event packet container, across event types. Returns the current event in
+ * the 'caerEventPacketContainerTimeOrderedIteratorElement' variable of type
+ * 'const void *', its type in 'caerEventPacketContainerTimeOrderedIteratorType'
+ * of type 'int16_t', its 64bit timestamp in 'caerEventPacketContainerTimeOrderedIteratorTimestamp'
+ * of type 'int64_t' and its packet in 'caerEventPacketContainerTimeOrderedIteratorPacket'
+ * of type caerEventPacketHeaderConst. The events are not copied, the packets
+ * are merged in place.
+ *
+ * PACKET_CONTAINER: a valid EventPacketContainer handle. If NULL, or if it holds
+ * too many packets, no iteration is performed.
+ */
+#define CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_ITERATOR_START(PACKET_CONTAINER)                                        \
+	{                                                                                                                    \
+		struct caer_event_packet_container_time_ordered_iterator caerEventPacketContainerTimeOrderedIteratorState;       \
+		struct caer_event_packet_container_time_ordered_event caerEventPacketContainerTimeOrderedIteratorEvent;          \
+		if (caerEventPacketContainerTimeOrderedIteratorInitContainer(                                                    \
+				&caerEventPacketContainerTimeOrderedIteratorState, PACKET_CONTAINER)) {                                  \
+			while (caerEventPacketContainerTimeOrderedIteratorNext(                                                      \
+				&caerEventPacketContainerTimeOrderedIteratorState, &caerEventPacketContainerTimeOrderedIteratorEvent)) { \
+				const void *caerEventPacketContainerTimeOrderedIteratorElement                                           \
+					= caerEventPacketContainerTimeOrderedIteratorEvent.event;                                            \
+				int16_t caerEventPacketContainerTimeOrderedIteratorType                                                  \
+					= caerEventPacketContainerTimeOrderedIteratorEvent.type;                                             \
+				int64_t caerEventPacketContainerTimeOrderedIteratorTimestamp                                             \
+					= caerEventPacketContainerTimeOrderedIteratorEvent.timestamp;                                        \
+				caerEventPacketHeaderConst caerEventPacketContainerTimeOrderedIteratorPacket                             \
+					= caerEventPacketContainerTimeOrderedIteratorEvent.packet;                                           \
+				(void) caerEventPacketContainerTimeOrderedIteratorElement;                                               \
+				(void) caerEventPacketContainerTimeOrderedIteratorType;                                                  \
+				(void) caerEventPacketContainerTimeOrderedIteratorTimestamp;                                             \
+				(void) caerEventPacketContainerTimeOrderedIteratorPacket;
+
+/**
+ * Time-ordered iterator close statement.
+ */
+#define CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_ITERATOR_END \
+	}                                                         \
+	}                                                         \
+	}
+
 #ifdef __cplusplus
 }
 #endif
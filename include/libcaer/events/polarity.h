@@ -76,7 +76,7 @@ typedef const struct caer_polarity_event_packet *caerPolarityEventPacketConst;
 
 /**
  * Allocate a new polarity events packet.
- * Use free() to reclaim this memory.
+ * Use caerEventPacketFree() to reclaim this memory.
  *
  * @param eventCapacity the maximum number of events this packet will hold.
  * @param eventSource the unique ID representing the source/generator of this packet.
@@ -0,0 +1,266 @@
+/**
+ * @file polarityColumns.h
+ *
+ * Polarity Events in columnar (structure-of-arrays) layout.
+ * This holds the same information as a normal polarity event packet
+ * (see polarity.h), but instead of packing the X/Y addresses and the
+ * polarity into one 32 bit word per event, every field is stored in
+ * its own array, so it can be processed directly and in bulk,
+ * for example with SIMD instructions.
+ * The (0, 0) address is in the upper left corner of the screen,
+ * like in OpenCV/computer graphics.
+ */
+
+#ifndef LIBCAER_EVENTS_POLARITY_COLUMNS_H_
+#define LIBCAER_EVENTS_POLARITY_COLUMNS_H_
+
+#include "polarity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Size of one columnar polarity event, summed over all columns:
+ * 32 bit timestamp, 16 bit X and Y addresses, 8 bit polarity.
+ */
+#define POLARITY_COLUMNS_EVENT_SIZE 9
+
+/**
+ * Polarity columns event packet data structure definition.
+ * The common packet header is followed by four arrays of 'eventCapacity'
+ * elements each, in this order: timestamps (int32_t), X addresses
+ * (uint16_t), Y addresses (uint16_t) and polarities (uint8_t, 1 is ON,
+ * 0 is OFF). Like all event data, values are stored little-endian, so on
+ * little-endian systems the arrays can be used directly.
+ * There is no valid mark: all events are always valid, and packets are
+ * always full, so eventNumber, eventValid and eventCapacity are the same.
+ * Use the functions below to access the arrays; the generic event access
+ * functions and iterators from common.h do not apply to this layout, and
+ * packets cannot be resized, grown or appended to.
+ */
+PACKED_STRUCT(struct caer_polarity_columns_event_packet {
+	/// The common event packet header.
+	struct caer_event_packet_header packetHeader;
+	/// The columns, see above.
+	uint8_t columns[];
+});
+
+/**
+ * Type for pointer to polarity columns event packet data structure.
+ */
+typedef struct caer_polarity_columns_event_packet *caerPolarityColumnsEventPacket;
+typedef const struct caer_polarity_columns_event_packet *caerPolarityColumnsEventPacketConst;
+
+/**
+ * Allocate a new polarity columns events packet, holding exactly
+ * 'eventNumber' events, all initialized to zero.
+ * Use caerEventPacketFree() to reclaim this memory.
+ *
+ * @param eventNumber the number of events this packet will hold.
+ * @param eventSource the unique ID representing the source/generator of this packet.
+ * @param tsOverflow the current timestamp overflow counter value for this packet.
+ *
+ * @return a valid PolarityColumnsEventPacket handle or NULL on error.
+ */
+static inline caerPolarityColumnsEventPacket caerPolarityColumnsEventPacketAllocate(
+	int32_t eventNumber, int16_t eventSource, int32_t tsOverflow) {
+	caerEventPacketHeader packet = caerEventPacketAllocate(
+		eventNumber, eventSource, tsOverflow, POLARITY_COLUMNS_EVENT, POLARITY_COLUMNS_EVENT_SIZE, 0);
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	// Packets are always full.
+	caerEventPacketHeaderSetEventNumber(packet, eventNumber);
+	caerEventPacketHeaderSetEventValid(packet, eventNumber);
+
+	return ((caerPolarityColumnsEventPacket) packet);
+}
+
+/**
+ * Transform a generic event packet header into a Polarity columns event packet.
+ * This takes care of proper casting and checks that the packet type really matches
+ * the intended conversion type.
+ *
+ * @param header a valid event packet header pointer. Cannot be NULL.
+ * @return a properly converted, typed event packet pointer.
+ */
+static inline caerPolarityColumnsEventPacket caerPolarityColumnsEventPacketFromPacketHeader(
+	caerEventPacketHeader header) {
+	if (caerEventPacketHeaderGetEventType(header) != POLARITY_COLUMNS_EVENT) {
+		return (NULL);
+	}
+
+	return ((caerPolarityColumnsEventPacket) header);
+}
+
+/**
+ * Transform a generic read-only event packet header into a read-only Polarity columns
+ * event packet.
+ * This takes care of proper casting and checks that the packet type really matches
+ * the intended conversion type.
+ *
+ * @param header a valid read-only event packet header pointer. Cannot be NULL.
+ * @return a properly converted, read-only typed event packet pointer.
+ */
+static inline caerPolarityColumnsEventPacketConst caerPolarityColumnsEventPacketFromPacketHeaderConst(
+	caerEventPacketHeaderConst header) {
+	if (caerEventPacketHeaderGetEventType(header) != POLARITY_COLUMNS_EVENT) {
+		return (NULL);
+	}
+
+	return ((caerPolarityColumnsEventPacketConst) header);
+}
+
+/**
+ * Get the timestamps array (32bit, in microseconds) of the event packet.
+ * See 'caerEventPacketHeaderGetEventTSOverflow()' documentation for
+ * how to get the 64bit timestamp.
+ *
+ * @param packet a valid PolarityColumnsEventPacket pointer. Cannot be NULL.
+ *
+ * @return the timestamps array, with eventNumber elements.
+ */
+static inline int32_t *caerPolarityColumnsEventPacketGetTimestamps(caerPolarityColumnsEventPacket packet) {
+	return ((int32_t *) packet->columns);
+}
+
+static inline const int32_t *caerPolarityColumnsEventPacketGetTimestampsConst(
+	caerPolarityColumnsEventPacketConst packet) {
+	return ((const int32_t *) packet->columns);
+}
+
+/**
+ * Get the X (column) addresses array of the event packet.
+ *
+ * @param packet a valid PolarityColumnsEventPacket pointer. Cannot be NULL.
+ *
+ * @return the X addresses array, with eventNumber elements.
+ */
+static inline uint16_t *caerPolarityColumnsEventPacketGetX(caerPolarityColumnsEventPacket packet) {
+	return ((uint16_t *) (packet->columns
+						  + ((size_t) caerEventPacketHeaderGetEventCapacity(&packet->packetHeader) * sizeof(int32_t))));
+}
+
+static inline const uint16_t *caerPolarityColumnsEventPacketGetXConst(caerPolarityColumnsEventPacketConst packet) {
+	return ((const uint16_t *) (packet->columns
+								+ ((size_t) caerEventPacketHeaderGetEventCapacity(&packet->packetHeader)
+									* sizeof(int32_t))));
+}
+
+/**
+ * Get the Y (row) addresses array of the event packet.
+ *
+ * @param packet a valid PolarityColumnsEventPacket pointer. Cannot be NULL.
+ *
+ * @return the Y addresses array, with eventNumber elements.
+ */
+static inline uint16_t *caerPolarityColumnsEventPacketGetY(caerPolarityColumnsEventPacket packet) {
+	return ((uint16_t *) (packet->columns
+						  + ((size_t) caerEventPacketHeaderGetEventCapacity(&packet->packetHeader)
+							  * (sizeof(int32_t) + sizeof(uint16_t)))));
+}
+
+static inline const uint16_t *caerPolarityColumnsEventPacketGetYConst(caerPolarityColumnsEventPacketConst packet) {
+	return ((const uint16_t *) (packet->columns
+								+ ((size_t) caerEventPacketHeaderGetEventCapacity(&packet->packetHeader)
+									* (sizeof(int32_t) + sizeof(uint16_t)))));
+}
+
+/**
+ * Get the polarities array of the event packet. 1 is ON, 0 is OFF.
+ *
+ * @param packet a valid PolarityColumnsEventPacket pointer. Cannot be NULL.
+ *
+ * @return the polarities array, with eventNumber elements.
+ */
+static inline uint8_t *caerPolarityColumnsEventPacketGetPolarities(caerPolarityColumnsEventPacket packet) {
+	return (packet->columns
+			+ ((size_t) caerEventPacketHeaderGetEventCapacity(&packet->packetHeader)
+				* (sizeof(int32_t) + (2 * sizeof(uint16_t)))));
+}
+
+static inline const uint8_t *caerPolarityColumnsEventPacketGetPolaritiesConst(
+	caerPolarityColumnsEventPacketConst packet) {
+	return (packet->columns
+			+ ((size_t) caerEventPacketHeaderGetEventCapacity(&packet->packetHeader)
+				* (sizeof(int32_t) + (2 * sizeof(uint16_t)))));
+}
+
+/**
+ * Get the 32bit timestamp of the event at the given index, in microseconds.
+ *
+ * @param packet a valid PolarityColumnsEventPacket pointer. Cannot be NULL.
+ * @param n the index of the event. Must be within [0,eventNumber[ bounds.
+ *
+ * @return the event's 32bit microsecond timestamp.
+ */
+static inline int32_t caerPolarityColumnsEventPacketGetTimestamp(
+	caerPolarityColumnsEventPacketConst packet, int32_t n) {
+	return (I32T(le32toh(U32T(caerPolarityColumnsEventPacketGetTimestampsConst(packet)[n]))));
+}
+
+/**
+ * Get the 64bit timestamp of the event at the given index, in microseconds.
+ * See 'caerEventPacketHeaderGetEventTSOverflow()' documentation
+ * for more details on the 64bit timestamp.
+ *
+ * @param packet a valid PolarityColumnsEventPacket pointer. Cannot be NULL.
+ * @param n the index of the event. Must be within [0,eventNumber[ bounds.
+ *
+ * @return the event's 64bit microsecond timestamp.
+ */
+static inline int64_t caerPolarityColumnsEventPacketGetTimestamp64(
+	caerPolarityColumnsEventPacketConst packet, int32_t n) {
+	return (I64T((U64T(caerEventPacketHeaderGetEventTSOverflow(&packet->packetHeader)) << TS_OVERFLOW_SHIFT)
+				 | U64T(caerPolarityColumnsEventPacketGetTimestamp(packet, n))));
+}
+
+/**
+ * Set all fields of the event at the given index.
+ *
+ * @param packet a valid PolarityColumnsEventPacket pointer. Cannot be NULL.
+ * @param n the index of the event. Must be within [0,eventNumber[ bounds.
+ * @param timestamp a positive 32bit microsecond timestamp.
+ * @param xAddress the event X address.
+ * @param yAddress the event Y address.
+ * @param polarity event polarity value.
+ */
+static inline void caerPolarityColumnsEventPacketSetEvent(caerPolarityColumnsEventPacket packet, int32_t n,
+	int32_t timestamp, uint16_t xAddress, uint16_t yAddress, bool polarity) {
+	caerPolarityColumnsEventPacketGetTimestamps(packet)[n] = I32T(htole32(U32T(timestamp)));
+	caerPolarityColumnsEventPacketGetX(packet)[n]          = htole16(xAddress);
+	caerPolarityColumnsEventPacketGetY(packet)[n]          = htole16(yAddress);
+	caerPolarityColumnsEventPacketGetPolarities(packet)[n] = polarity;
+}
+
+/**
+ * Convert a polarity event packet into a new polarity columns event packet.
+ * Only valid events are converted. Uses SIMD instructions where available.
+ * Use caerEventPacketFree() to reclaim the returned packet's memory.
+ *
+ * @param packet a valid PolarityEventPacket pointer. Cannot be NULL.
+ *
+ * @return a new PolarityColumnsEventPacket with the packet's valid events,
+ *         or NULL on error or if there are no valid events.
+ */
+caerPolarityColumnsEventPacket caerPolarityColumnsEventPacketFromPolarity(caerPolarityEventPacketConst packet);
+
+/**
+ * Convert a polarity columns event packet into a new polarity event packet.
+ * Uses SIMD instructions where available.
+ * Use caerEventPacketFree() to reclaim the returned packet's memory.
+ *
+ * @param packet a valid PolarityColumnsEventPacket pointer. Cannot be NULL.
+ *
+ * @return a new PolarityEventPacket with the same events, all valid,
+ *         or NULL on error or if the packet is empty.
+ */
+caerPolarityEventPacket caerPolarityEventPacketFromPolarityColumns(caerPolarityColumnsEventPacketConst packet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_EVENTS_POLARITY_COLUMNS_H_ */
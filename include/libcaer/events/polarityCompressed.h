@@ -0,0 +1,204 @@
+/**
+ * @file polarityCompressed.h
+ *
+ * Polarity Events in compressed form.
+ * This holds the same information as a normal polarity event packet
+ * (see polarity.h), but instead of 8 bytes per event, the addresses are
+ * bit-packed with just as many bits as the packet's largest X and Y
+ * addresses need, and the timestamps are stored as variable-length
+ * differences to the previous one, optionally with runs of events
+ * having the same timestamp counted instead of repeated.
+ * Typical DVS data needs 2.5 to 3.5 bytes per event this way.
+ * The packet is a regular AEDAT 3.x event packet, so it can be written
+ * to files and sent over the network like any other, and it can be
+ * skipped by readers not knowing this event type.
+ * The events cannot be accessed directly, convert the packet back to
+ * a polarity event packet with caerPolarityEventPacketFromPolarityCompressed()
+ * to use them.
+ */
+
+#ifndef LIBCAER_EVENTS_POLARITY_COMPRESSED_H_
+#define LIBCAER_EVENTS_POLARITY_COMPRESSED_H_
+
+#include "polarity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Size of the units the compressed data is stored in: the packet is
+ * made of 32 bit words, and its event number, valid and capacity
+ * values count these words, not the compressed events.
+ */
+#define POLARITY_COMPRESSED_EVENT_SIZE 4
+
+/**
+ * Flag for runs of events with the same timestamp being stored
+ * once with their length, instead of once per event.
+ */
+#define POLARITY_COMPRESSED_RUN_LENGTH 0x01
+
+/**
+ * Polarity compressed event packet data structure definition.
+ * The common packet header is followed by a small header with the
+ * packet's first and last timestamps, the number of events and the
+ * bit widths used for the addresses, and then by the data itself:
+ * - the addresses, one value of (xAddrBits + yAddrBits + 1) bits per
+ *   event, holding X in the lowest bits, then Y, then the polarity,
+ *   packed into a little-endian bit stream and padded to a full byte.
+ * - the timestamps, as LEB128 variable-length integers, each holding
+ *   the zig-zag encoded difference to the previous timestamp (the first
+ *   one is relative to 'firstTimestamp'). If the POLARITY_COMPRESSED_RUN_LENGTH
+ *   flag is set, the difference is shifted up by one bit and the lowest
+ *   bit tells if a second integer follows, with the number of events
+ *   having that same timestamp, minus two.
+ * - zero padding up to a full 32 bit word.
+ * The first word of the packet is the first timestamp, so the generic
+ * timestamp functions from common.h work on event zero, and the last
+ * timestamp is the second word. All values are little-endian.
+ * The packet is always full, so eventNumber, eventValid and eventCapacity
+ * are the same, and it cannot be resized, grown or appended to.
+ */
+PACKED_STRUCT(struct caer_polarity_compressed_event_packet {
+	/// The common event packet header.
+	struct caer_event_packet_header packetHeader;
+	/// Timestamp of the first event, in microseconds.
+	int32_t firstTimestamp;
+	/// Timestamp of the last event, in microseconds.
+	int32_t lastTimestamp;
+	/// Number of compressed events.
+	int32_t eventsNumber;
+	/// Number of bits used for each X address.
+	uint8_t xAddrBits;
+	/// Number of bits used for each Y address.
+	uint8_t yAddrBits;
+	/// Encoding flags, see POLARITY_COMPRESSED_RUN_LENGTH.
+	uint8_t flags;
+	/// Reserved, always zero.
+	uint8_t reserved;
+	/// The compressed addresses and timestamps, see above.
+	uint8_t data[];
+});
+
+/**
+ * Type for pointer to polarity compressed event packet data structure.
+ */
+typedef struct caer_polarity_compressed_event_packet *caerPolarityCompressedEventPacket;
+typedef const struct caer_polarity_compressed_event_packet *caerPolarityCompressedEventPacketConst;
+
+/**
+ * Transform a generic event packet header into a Polarity compressed event packet.
+ * This takes care of proper casting and checks that the packet type really matches
+ * the intended conversion type.
+ *
+ * @param header a valid event packet header pointer. Cannot be NULL.
+ * @return a properly converted, typed event packet pointer.
+ */
+static inline caerPolarityCompressedEventPacket caerPolarityCompressedEventPacketFromPacketHeader(
+	caerEventPacketHeader header) {
+	if (caerEventPacketHeaderGetEventType(header) != POLARITY_COMPRESSED_EVENT) {
+		return (NULL);
+	}
+
+	return ((caerPolarityCompressedEventPacket) header);
+}
+
+/**
+ * Transform a generic read-only event packet header into a read-only Polarity compressed
+ * event packet.
+ * This takes care of proper casting and checks that the packet type really matches
+ * the intended conversion type.
+ *
+ * @param header a valid read-only event packet header pointer. Cannot be NULL.
+ * @return a properly converted, read-only typed event packet pointer.
+ */
+static inline caerPolarityCompressedEventPacketConst caerPolarityCompressedEventPacketFromPacketHeaderConst(
+	caerEventPacketHeaderConst header) {
+	if (caerEventPacketHeaderGetEventType(header) != POLARITY_COMPRESSED_EVENT) {
+		return (NULL);
+	}
+
+	return ((caerPolarityCompressedEventPacketConst) header);
+}
+
+/**
+ * Get the number of events compressed in the packet.
+ *
+ * @param packet a valid PolarityCompressedEventPacket pointer. Cannot be NULL.
+ *
+ * @return the number of events.
+ */
+static inline int32_t caerPolarityCompressedEventPacketGetEventsNumber(
+	caerPolarityCompressedEventPacketConst packet) {
+	return (I32T(le32toh(U32T(packet->eventsNumber))));
+}
+
+/**
+ * Get the 64bit timestamp of the first event, in microseconds.
+ * See 'caerEventPacketHeaderGetEventTSOverflow()' documentation
+ * for more details on the 64bit timestamp.
+ *
+ * @param packet a valid PolarityCompressedEventPacket pointer. Cannot be NULL.
+ *
+ * @return the first event's 64bit microsecond timestamp.
+ */
+static inline int64_t caerPolarityCompressedEventPacketGetFirstTimestamp64(
+	caerPolarityCompressedEventPacketConst packet) {
+	return (I64T((U64T(caerEventPacketHeaderGetEventTSOverflow(&packet->packetHeader)) << TS_OVERFLOW_SHIFT)
+				 | U64T(I32T(le32toh(U32T(packet->firstTimestamp))))));
+}
+
+/**
+ * Get the 64bit timestamp of the last event, in microseconds.
+ * See 'caerEventPacketHeaderGetEventTSOverflow()' documentation
+ * for more details on the 64bit timestamp.
+ *
+ * @param packet a valid PolarityCompressedEventPacket pointer. Cannot be NULL.
+ *
+ * @return the last event's 64bit microsecond timestamp.
+ */
+static inline int64_t caerPolarityCompressedEventPacketGetLastTimestamp64(
+	caerPolarityCompressedEventPacketConst packet) {
+	return (I64T((U64T(caerEventPacketHeaderGetEventTSOverflow(&packet->packetHeader)) << TS_OVERFLOW_SHIFT)
+				 | U64T(I32T(le32toh(U32T(packet->lastTimestamp))))));
+}
+
+/**
+ * Compress a polarity event packet into a new polarity compressed event packet.
+ * Only valid events are compressed, and their timestamps should be
+ * monotonically increasing, as usual, else more space is needed.
+ * Uses SIMD instructions where available.
+ * Use caerEventPacketFree() to reclaim the returned packet's memory.
+ *
+ * @param packet a valid PolarityEventPacket pointer. Cannot be NULL.
+ * @param runLength whether to count runs of events with the same timestamp,
+ *                  instead of storing a difference of zero for each event.
+ *                  This helps a lot with sensors that read out whole rows
+ *                  at once, like DVXplorer, and costs a little with others.
+ *
+ * @return a new PolarityCompressedEventPacket with the packet's valid events,
+ *         or NULL on error or if there are no valid events.
+ */
+caerPolarityCompressedEventPacket caerPolarityCompressedEventPacketFromPolarity(
+	caerPolarityEventPacketConst packet, bool runLength);
+
+/**
+ * Decompress a polarity compressed event packet into a new polarity event packet.
+ * The compressed data is fully checked, so packets coming from files or
+ * the network can be safely passed in.
+ * Uses SIMD instructions where available.
+ * Use caerEventPacketFree() to reclaim the returned packet's memory.
+ *
+ * @param packet a valid PolarityCompressedEventPacket pointer. Cannot be NULL.
+ *
+ * @return a new PolarityEventPacket with the same events, all valid,
+ *         or NULL on error, if the packet is empty or its data is corrupted.
+ */
+caerPolarityEventPacket caerPolarityEventPacketFromPolarityCompressed(caerPolarityCompressedEventPacketConst packet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_EVENTS_POLARITY_COMPRESSED_H_ */
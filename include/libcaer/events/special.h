@@ -95,7 +95,7 @@ typedef const struct caer_special_event_packet *caerSpecialEventPacketConst;
 
 /**
  * Allocate a new special events packet.
- * Use free() to reclaim this memory.
+ * Use caerEventPacketFree() to reclaim this memory.
  *
  * @param eventCapacity the maximum number of events this packet will hold.
  * @param eventSource the unique ID representing the source/generator of this packet.
@@ -72,7 +72,7 @@ typedef const struct caer_spike_event_packet *caerSpikeEventPacketConst;
 
 /**
  * Allocate a new Spike events packet.
- * Use free() to reclaim this memory.
+ * Use caerEventPacketFree() to reclaim this memory.
  *
  * @param eventCapacity the maximum number of events this packet will hold.
  * @param eventSource the unique ID representing the source/generator of this packet.
@@ -0,0 +1,127 @@
+/**
+ * @file file_reader.h
+ *
+ * Read AEDAT 3.x files, such as written by caerFileWriter (see file_writer.h).
+ * The file is memory-mapped, and event packets are returned as read-only
+ * views directly into the mapping, without any copies. On opening, an index
+ * of all packets, with their offsets and timestamp ranges, is built, so
+ * that packets can be accessed randomly and seeking to a timestamp takes
+ * O(log n). The index can be saved to, and loaded again from, a sidecar file,
+ * to avoid scanning big files again every time they are opened.
+ * Please note that packets inside the mapping are not aligned in memory.
+ * All event structures are packed, so their accessor functions work fine;
+ * do not take pointers to multi-byte fields inside events though.
+ */
+
+#ifndef LIBCAER_IO_FILE_READER_H_
+#define LIBCAER_IO_FILE_READER_H_
+
+#include "../events/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pointer to AEDAT 3.x file reader structure (private).
+ */
+typedef struct caer_file_reader *caerFileReader;
+
+/**
+ * Packet index entry. Timestamps are 64bit, in microseconds.
+ */
+struct caer_file_reader_index_entry {
+	/// Offset of the packet in the file, in bytes.
+	uint64_t offset;
+	/// Timestamp of the first event in the packet.
+	int64_t firstTimestamp;
+	/// Timestamp of the last event in the packet.
+	int64_t lastTimestamp;
+};
+
+/**
+ * Open an AEDAT 3.x file and index its packets. Packets without any events
+ * are skipped and not part of the index. If the file ends with a truncated
+ * packet, such as when a recording was interrupted, all packets up to it
+ * are available.
+ *
+ * @param fileName path of the file to open.
+ * @param indexFileName path of the sidecar index file. If it exists and
+ *                      matches the file (same size and modification time),
+ *                      the index is loaded from it; else the index is built
+ *                      and saved to it. Can be NULL, then the index is always
+ *                      built and kept only in memory.
+ *
+ * @return file reader instance, NULL on error.
+ */
+caerFileReader caerFileReaderOpen(const char *fileName, const char *indexFileName);
+
+/**
+ * Unmap the file and free the reader's memory. All packets returned by
+ * this reader become invalid.
+ *
+ * @param reader a valid file reader instance.
+ */
+void caerFileReaderClose(caerFileReader reader);
+
+/**
+ * Get the AEDAT format version of the file, as the minor version number
+ * after '3.' (for example 1 for AEDAT 3.1).
+ *
+ * @param reader a valid file reader instance.
+ *
+ * @return the minor format version.
+ */
+int8_t caerFileReaderGetVersion(caerFileReader reader);
+
+/**
+ * Get the number of (non-empty) packets in the file.
+ *
+ * @param reader a valid file reader instance.
+ *
+ * @return number of packets.
+ */
+size_t caerFileReaderGetPacketsNumber(caerFileReader reader);
+
+/**
+ * Get a read-only view of a packet. The memory belongs to the reader
+ * and is valid until caerFileReaderClose() is called.
+ * The packet's capacity equals its number of events.
+ *
+ * @param reader a valid file reader instance.
+ * @param index index of the packet, range [0,packetsNumber[.
+ *
+ * @return packet view, NULL if the index is out of range.
+ */
+caerEventPacketHeaderConst caerFileReaderGetPacket(caerFileReader reader, size_t index);
+
+/**
+ * Get the index entry of a packet.
+ *
+ * @param reader a valid file reader instance.
+ * @param index index of the packet, range [0,packetsNumber[.
+ *
+ * @return index entry, NULL if the index is out of range.
+ */
+const struct caer_file_reader_index_entry *caerFileReaderGetIndexEntry(caerFileReader reader, size_t index);
+
+/**
+ * Find where to start reading to get all events with a timestamp equal or
+ * bigger than the given one. This is the first packet that has any such
+ * events; all packets before it only have events with smaller timestamps.
+ * Packets after it may still have some smaller timestamps, as packets of
+ * different types overlap in time. Uses binary search.
+ *
+ * @param reader a valid file reader instance.
+ * @param timestamp 64bit timestamp to seek to, in microseconds.
+ *
+ * @return index of the packet, or the number of packets if all
+ *         events in the file are older than the timestamp.
+ */
+size_t caerFileReaderSeekTimestamp(caerFileReader reader, int64_t timestamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_IO_FILE_READER_H_ */
@@ -0,0 +1,127 @@
+/**
+ * @file file_writer.h
+ *
+ * Write event packet containers to AEDAT 3.1 files.
+ * Packets are written exactly as they are in memory (the event packet
+ * layout is the on-disk format), using vectored I/O directly from the
+ * packet memory, without intermediate copies.
+ * Writing can happen either synchronously, in caerFileWriterWrite(),
+ * or on a background thread, fed through a bounded queue.
+ * Please note that the writer is not thread-safe, all writes
+ * should happen on the same thread, unless you take care that they
+ * never overlap.
+ */
+
+#ifndef LIBCAER_IO_FILE_WRITER_H_
+#define LIBCAER_IO_FILE_WRITER_H_
+
+#include "../events/packetContainer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pointer to AEDAT 3.1 file writer structure (private).
+ */
+typedef struct caer_file_writer *caerFileWriter;
+
+/**
+ * File writer statistics. All counters start at zero when
+ * the writer is opened, and only count data actually written.
+ */
+struct caer_file_writer_statistics {
+	/// Bytes written, including the file header.
+	uint64_t bytesWritten;
+	/// Event packets written.
+	uint64_t packetsWritten;
+	/// Events written (valid and invalid).
+	uint64_t eventsWritten;
+};
+
+/**
+ * Start writing an AEDAT 3.1 file to the given file descriptor.
+ * The file header is written right away.
+ *
+ * @param fileDescriptor an open, writable file descriptor. It is not
+ *                       closed by caerFileWriterClose(), that stays
+ *                       the caller's responsibility.
+ * @param sourceID the ID of the data source, usually the device ID.
+ * @param sourceDescription description of the data source, such as the
+ *                          device string, written to the file header.
+ *                          Can be NULL, then no source is written.
+ * @param queueSize if zero, containers are written synchronously by
+ *                  caerFileWriterWrite(). Else a background thread
+ *                  writes them, and up to this many containers can be
+ *                  queued (rounded up to the next power of two).
+ *
+ * @return file writer instance, NULL on error.
+ */
+caerFileWriter caerFileWriterOpen(int fileDescriptor, int16_t sourceID, const char *sourceDescription, size_t queueSize);
+
+/**
+ * Write any remaining queued containers, stop the background thread,
+ * if any, and free the writer's memory.
+ *
+ * @param writer a valid file writer instance.
+ *
+ * @return true if all data was written successfully, false otherwise.
+ */
+bool caerFileWriterClose(caerFileWriter writer);
+
+/**
+ * Write a packet container. All non-empty packets are written, including
+ * any invalid events they contain. Polarity columns packets are written
+ * as normal polarity packets, since the former are not an AEDAT format.
+ * The writer takes ownership of the container and frees it with
+ * caerEventPacketContainerFree() once written, also on write errors.
+ * If a background thread is used and its queue is full, this waits
+ * until there is space, or until a write fails.
+ *
+ * @param writer a valid file writer instance.
+ * @param container the packet container to write.
+ *
+ * @return true if the container was accepted, false if a previous write
+ *         failed or the container could not be queued. In synchronous
+ *         mode, also false if writing this container failed. On false,
+ *         the ownership of the container stays with the caller. Errors
+ *         writing an accepted container on the background thread are
+ *         reported by later calls and by caerFileWriterClose().
+ */
+bool caerFileWriterWrite(caerFileWriter writer, caerEventPacketContainer container);
+
+/**
+ * Write a packet container, like caerFileWriterWrite(), but leave its
+ * ownership with the caller: the container and its packets must not
+ * be modified or freed until 'containerDone' is called. This happens
+ * once the container has been written, or has failed to be written,
+ * possibly on the background thread.
+ *
+ * @param writer a valid file writer instance.
+ * @param container the packet container to write.
+ * @param containerDone function to call once the container is not used by
+ *                      the writer anymore. Can be NULL.
+ * @param containerDonePtr pointer passed to 'containerDone'.
+ *
+ * @return true if the container was accepted, false if a previous write
+ *         failed or the container could not be queued. In synchronous
+ *         mode, also false if writing this container failed. On false,
+ *         'containerDone' is not called.
+ */
+bool caerFileWriterWriteNotify(caerFileWriter writer, caerEventPacketContainerConst container,
+	void (*containerDone)(void *containerDonePtr), void *containerDonePtr);
+
+/**
+ * Get the current file writer statistics.
+ *
+ * @param writer a valid file writer instance.
+ *
+ * @return the data written so far.
+ */
+struct caer_file_writer_statistics caerFileWriterStatisticsGet(caerFileWriter writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_IO_FILE_WRITER_H_ */
@@ -0,0 +1,166 @@
+/**
+ * @file network_client.h
+ *
+ * Receive event packet containers from an AEDAT 3.x network stream,
+ * such as sent by caerNetworkServer (see network_server.h).
+ * TCP: connects to a server and reads its stream in large buffered reads.
+ * UDP: listens for datagrams, received in batches to reduce the number
+ * of system calls. Datagrams are put back in sequence: those arriving ahead
+ * of a missing one are held back, for at most 16 sequence numbers and 10 ms,
+ * after which the missing one is counted as lost. Event packets split over
+ * multiple datagrams are reassembled, and packets missing any part are dropped.
+ * In both cases the network headers are validated, and the received packets
+ * are grouped into containers again: a container ends right before a packet
+ * of an event type it already has, or when no more data is available.
+ * Packet memory can be given back to the client for reuse, to avoid
+ * allocating new memory for every packet.
+ * Only available on POSIX systems.
+ * Please note that the client is not thread-safe, all receives
+ * should happen on the same thread, unless you take care that they
+ * never overlap.
+ */
+
+#ifndef LIBCAER_IO_NETWORK_CLIENT_H_
+#define LIBCAER_IO_NETWORK_CLIENT_H_
+
+#include "../events/packetContainer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pointer to AEDAT 3.x network client structure (private).
+ */
+typedef struct caer_network_client *caerNetworkClient;
+
+/**
+ * Network client statistics. All counters start at zero when
+ * the client is opened.
+ */
+struct caer_network_client_statistics {
+	/// Bytes received, including network headers.
+	uint64_t bytesReceived;
+	/// Messages received: datagrams for UDP, reads for TCP.
+	uint64_t messagesReceived;
+	/// Complete event packets received.
+	uint64_t packetsReceived;
+	/// Events received (valid and invalid), in complete packets.
+	uint64_t eventsReceived;
+	/// UDP only: datagrams missing from the sequence, that never arrived.
+	uint64_t messagesLost;
+	/// UDP only: datagrams that arrived after one with a higher sequence
+	/// number, but in time to be put back in sequence.
+	uint64_t messagesReordered;
+	/// UDP only: duplicate datagrams, and datagrams that arrived after they
+	/// were already counted as lost. Their data is discarded.
+	uint64_t messagesLate;
+	/// Event packets discarded, because they were incomplete due to
+	/// lost datagrams, or their header was invalid.
+	uint64_t packetsDropped;
+};
+
+/**
+ * Connect to a TCP server and start receiving its stream.
+ *
+ * @param remoteAddress the server's IP address.
+ * @param remotePort the server's port.
+ *
+ * @return network client instance, NULL on error.
+ */
+caerNetworkClient caerNetworkClientOpenTCP(const char *remoteAddress, uint16_t remotePort);
+
+/**
+ * Start receiving UDP datagrams.
+ *
+ * @param localAddress the local IP address to listen on.
+ *                     Can be NULL, then all addresses are used.
+ * @param localPort the local port to listen on. If zero, any free port
+ *                  is used, see caerNetworkClientGetPort().
+ *
+ * @return network client instance, NULL on error.
+ */
+caerNetworkClient caerNetworkClientOpenUDP(const char *localAddress, uint16_t localPort);
+
+/**
+ * Close the connection and free the client's memory, including
+ * any packet memory given back with caerNetworkClientRecycle().
+ * Containers received before stay valid.
+ *
+ * @param client a valid network client instance.
+ */
+void caerNetworkClientClose(caerNetworkClient client);
+
+/**
+ * Get the port of the client: for TCP the remote port it is connected to,
+ * for UDP the local port it listens on.
+ *
+ * @param client a valid network client instance.
+ *
+ * @return the port number.
+ */
+uint16_t caerNetworkClientGetPort(caerNetworkClient client);
+
+/**
+ * Get the source ID from the last valid network header received.
+ *
+ * @param client a valid network client instance.
+ *
+ * @return the source ID, -1 if no header was received yet.
+ */
+int16_t caerNetworkClientGetSourceID(caerNetworkClient client);
+
+/**
+ * Check if the client can still receive data. For TCP this becomes false
+ * once the server closed the connection, or the stream was found invalid.
+ * For UDP only on errors of the socket itself.
+ * Containers already received can still be returned afterwards.
+ *
+ * @param client a valid network client instance.
+ *
+ * @return true if more data can be received.
+ */
+bool caerNetworkClientIsConnected(caerNetworkClient client);
+
+/**
+ * Get the next container of received event packets, waiting for data
+ * if none is available.
+ *
+ * @param client a valid network client instance.
+ * @param timeoutMs maximum time to wait for data, in milliseconds.
+ *                  Zero means not to wait, negative values wait forever.
+ *
+ * @return a packet container, owned by the caller, or NULL if no complete
+ *         packet arrived in time, or the client is not connected anymore.
+ *         The container can be freed with caerEventPacketContainerFree(),
+ *         or with caerNetworkClientRecycle() to reuse its memory.
+ */
+caerEventPacketContainer caerNetworkClientReceive(caerNetworkClient client, int32_t timeoutMs);
+
+/**
+ * Give a container, and all its packets, back to the client, which
+ * keeps some packet memory around to reuse for later packets.
+ * The container must not be used anymore afterwards. It can be any
+ * container whose packets were allocated by libcaer, and could thus be
+ * freed with caerEventPacketFree(), not only one returned by
+ * caerNetworkClientReceive().
+ *
+ * @param client a valid network client instance.
+ * @param container the packet container to give back. Can be NULL.
+ */
+void caerNetworkClientRecycle(caerNetworkClient client, caerEventPacketContainer container);
+
+/**
+ * Get the current network client statistics.
+ *
+ * @param client a valid network client instance.
+ *
+ * @return the data received so far.
+ */
+struct caer_network_client_statistics caerNetworkClientStatisticsGet(caerNetworkClient client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_IO_NETWORK_CLIENT_H_ */
@@ -0,0 +1,182 @@
+/**
+ * @file network_server.h
+ *
+ * Stream event packet containers over the network, using the AEDAT 3.x
+ * network protocol (see network.h).
+ * TCP: the server listens for clients, each new client first gets
+ * the network header, followed by the event packets as they are sent.
+ * Sends never wait for clients: data a client's socket cannot take yet
+ * is buffered for it, up to a limit, beyond which whole packets are
+ * dropped for that client. Clients that accept no data at all for
+ * five seconds are disconnected.
+ * UDP: datagrams are sent to one remote address (which can also be a
+ * broadcast or multicast address). Each datagram starts with the network
+ * header, with a sequence number incremented for every datagram, so that
+ * receivers can detect loss. Event packets that do not fit into one datagram
+ * are split over multiple ones, see AEDAT3_NETWORK_FORMAT_UDP_CONTINUATION.
+ * As with the file writer, packets are sent directly from their memory,
+ * and datagrams are sent in batches to reduce the number of system calls.
+ * Only available on POSIX systems.
+ * Please note that the server is not thread-safe, all sends
+ * should happen on the same thread, unless you take care that they
+ * never overlap.
+ */
+
+#ifndef LIBCAER_IO_NETWORK_SERVER_H_
+#define LIBCAER_IO_NETWORK_SERVER_H_
+
+#include "../events/packetContainer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pointer to AEDAT 3.x network server structure (private).
+ */
+typedef struct caer_network_server *caerNetworkServer;
+
+/**
+ * Network server statistics. All counters start at zero when
+ * the server is opened, and only count data actually sent.
+ */
+struct caer_network_server_statistics {
+	/// Bytes sent, including network headers. For TCP, summed over all clients.
+	uint64_t bytesSent;
+	/// Event packets sent, counted once per caerNetworkServerSend() call.
+	uint64_t packetsSent;
+	/// Events sent (valid and invalid), counted once per caerNetworkServerSend() call.
+	uint64_t eventsSent;
+	/// Messages sent: datagrams for UDP, send system calls for TCP.
+	uint64_t messagesSent;
+	/// Event packets dropped for TCP clients that could not keep up, summed over all clients.
+	uint64_t packetsDropped;
+};
+
+/**
+ * Start a TCP server, listening for clients.
+ *
+ * @param localAddress the local IP address to listen on.
+ *                     Can be NULL, then all addresses are used.
+ * @param localPort the local port to listen on. If zero, any free port
+ *                  is used, see caerNetworkServerGetPort().
+ * @param sourceID the ID of the data source, usually the device ID.
+ * @param maxClients the maximum number of connected clients, new clients
+ *                   beyond this are refused.
+ * @param clientBufferSize the maximum data, in bytes, buffered for a client
+ *                         whose socket does not accept it right away. Once
+ *                         full, packets are dropped for that client. Zero
+ *                         selects the default, 4 MB.
+ * @param zeroCopy send with MSG_ZEROCOPY, where available (Linux 4.14+).
+ *                 This avoids copying the event data into the kernel,
+ *                 which is mostly worth it for large packets and fast
+ *                 links. As the kernel then keeps using the packets'
+ *                 memory after the send, this only applies to
+ *                 caerNetworkServerSendNotify(), and only to sends of at
+ *                 least 64 KB, smaller ones are copied.
+ *
+ * @return network server instance, NULL on error.
+ */
+caerNetworkServer caerNetworkServerOpenTCP(const char *localAddress, uint16_t localPort, int16_t sourceID,
+	size_t maxClients, size_t clientBufferSize, bool zeroCopy);
+
+/**
+ * Start sending UDP datagrams to a remote address.
+ *
+ * @param remoteAddress the remote IP address to send to.
+ * @param remotePort the remote port to send to.
+ * @param sourceID the ID of the data source, usually the device ID.
+ * @param maxDatagramSize the maximum size of a datagram's data (without
+ *                        IP and UDP headers), including the network header.
+ *                        Zero selects the default, which fits a standard
+ *                        1500 bytes MTU (AEDAT3_MAX_UDP_SIZE +
+ *                        AEDAT3_NETWORK_HEADER_LENGTH).
+ *
+ * @return network server instance, NULL on error.
+ */
+caerNetworkServer caerNetworkServerOpenUDP(
+	const char *remoteAddress, uint16_t remotePort, int16_t sourceID, size_t maxDatagramSize);
+
+/**
+ * Close all connections and free the server's memory. TCP clients first
+ * get their buffered data, as long as they keep accepting it, and all
+ * containers passed to caerNetworkServerSendNotify() are released.
+ *
+ * @param server a valid network server instance.
+ */
+void caerNetworkServerClose(caerNetworkServer server);
+
+/**
+ * Get the port of the server: for TCP the local port it listens on,
+ * for UDP the remote port it sends to.
+ *
+ * @param server a valid network server instance.
+ *
+ * @return the port number.
+ */
+uint16_t caerNetworkServerGetPort(caerNetworkServer server);
+
+/**
+ * Get the number of connected TCP clients. New clients are only
+ * accepted during caerNetworkServerSend(), so this may not include
+ * clients that connected since the last send.
+ * Always zero for UDP.
+ *
+ * @param server a valid network server instance.
+ *
+ * @return number of clients.
+ */
+size_t caerNetworkServerGetClientsNumber(caerNetworkServer server);
+
+/**
+ * Send all non-empty event packets of a container. The container is only
+ * used during this call, ownership stays with the caller.
+ * For TCP, new clients are accepted first, then the packets are sent to
+ * all clients; clients that disconnected or fail are dropped, which is
+ * not an error. With no clients, nothing is sent.
+ *
+ * @param server a valid network server instance.
+ * @param container the packet container to send.
+ *
+ * @return true on success, false if sending UDP datagrams failed or
+ *         memory could not be allocated.
+ */
+bool caerNetworkServerSend(caerNetworkServer server, caerEventPacketContainerConst container);
+
+/**
+ * Send all non-empty event packets of a container, like
+ * caerNetworkServerSend(), but allowing the kernel to keep using the
+ * packets' memory afterwards, as zero-copy sends do: the container and
+ * its packets must not be modified or freed until 'containerDone' is
+ * called. This happens once the kernel is done with them for all clients,
+ * which is noticed during later sends or at the latest on
+ * caerNetworkServerClose(). Without zero-copy sends, it happens before
+ * this call returns.
+ *
+ * @param server a valid network server instance.
+ * @param container the packet container to send.
+ * @param containerDone function to call once the container is not used by
+ *                      the server anymore. Can be NULL.
+ * @param containerDonePtr pointer passed to 'containerDone'.
+ *
+ * @return true on success, false if sending UDP datagrams failed or
+ *         memory could not be allocated. On false, 'containerDone'
+ *         is not called.
+ */
+bool caerNetworkServerSendNotify(caerNetworkServer server, caerEventPacketContainerConst container,
+	void (*containerDone)(void *containerDonePtr), void *containerDonePtr);
+
+/**
+ * Get the current network server statistics.
+ *
+ * @param server a valid network server instance.
+ *
+ * @return the data sent so far.
+ */
+struct caer_network_server_statistics caerNetworkServerStatisticsGet(caerNetworkServer server);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_IO_NETWORK_SERVER_H_ */
@@ -21,6 +21,12 @@ extern "C" {
 // Standard MTU 1500 - 20 IP header - 8 UDP header => 1472 bytes
 #define AEDAT3_MAX_UDP_SIZE (1472 - AEDAT3_NETWORK_HEADER_LENGTH)
 
+// Event packets are split over multiple UDP datagrams if needed, each packet
+// starting in a new datagram. This flag is set in the header's format number
+// of all datagrams that continue the event packet of the preceding one, so
+// that receivers can find the start of the next packet after losing data.
+#define AEDAT3_NETWORK_FORMAT_UDP_CONTINUATION 0x40
+
 PACKED_STRUCT(struct aedat3_network_header {
 	int64_t magicNumber;
 	int64_t sequenceNumber;
@@ -37,9 +43,9 @@ static inline struct aedat3_network_header caerParseNetworkHeader(const uint8_t
 	memcpy(&networkHeader, dataBuffer, AEDAT3_NETWORK_HEADER_LENGTH);
 
 	// Ensure endianness conversion is done if needed.
-	networkHeader.magicNumber    = le64toh(networkHeader.magicNumber);
-	networkHeader.sequenceNumber = le64toh(networkHeader.sequenceNumber);
-	networkHeader.sourceID       = le16toh(networkHeader.sourceID);
+	networkHeader.magicNumber    = I64T(le64toh(U64T(networkHeader.magicNumber)));
+	networkHeader.sequenceNumber = I64T(le64toh(U64T(networkHeader.sequenceNumber)));
+	networkHeader.sourceID       = I16T(le16toh(U16T(networkHeader.sourceID)));
 
 	return (networkHeader);
 }
@@ -14,7 +14,27 @@
 namespace libcaer {
 namespace devices {
 
+struct rawBufferDeleter {
+	void operator()(struct caer_device_raw_buffer *rawBuffer) const noexcept {
+		free(rawBuffer);
+	}
+};
+
+using rawBuffer = std::unique_ptr<struct caer_device_raw_buffer, rawBufferDeleter>;
+
+struct translatorStateDeleter {
+	void operator()(struct caer_device_translator_state *state) const noexcept {
+		free(state);
+	}
+};
+
+using translatorState = std::unique_ptr<struct caer_device_translator_state, translatorStateDeleter>;
+
+class translator;
+
 class device {
+	friend class translator;
+
 protected:
 	std::shared_ptr<struct caer_device_handle> handle;
 
@@ -103,10 +123,148 @@ public:
 
 		// Free original C container. The event packet memory is now managed by
 		// the EventPacket classes inside the new C++ EventPacketContainer.
-		free(cContainer);
+		caerFree(cContainer);
+
+		return (cppContainer);
+	}
+
+	/**
+	 * Get the next container of event packets, like dataGet(), but
+	 * without wrapping each packet into a shared EventPacket.
+	 *
+	 * @return a packet container, converting to false if no data is available.
+	 */
+	libcaer::events::EventPacketContainerUnique dataGetUnique() const {
+		// NULL return means no data, forward that as an empty container.
+		return (libcaer::events::EventPacketContainerUnique(caerDeviceDataGet(handle.get())));
+	}
+
+	rawBuffer dataGetRaw() const {
+		// NULL return means no data, forward that.
+		return (rawBuffer(caerDeviceDataGetRaw(handle.get())));
+	}
+
+	void dvsRemapSet(const uint32_t *remapTable) const {
+		bool success = caerDeviceDVSRemapSet(handle.get(), remapTable);
+		if (!success) {
+			std::string exc = toString() + ": failed to set DVS remapping table.";
+			throw std::runtime_error(exc);
+		}
+	}
+};
+
+class translator {
+private:
+	std::unique_ptr<struct caer_device_translator, bool (*)(caerDeviceTranslator)> handle;
+
+	static bool translatorClose(caerDeviceTranslator cTranslator) {
+		return (caerDeviceTranslatorClose(&cTranslator));
+	}
+
+public:
+	translator(const device &dev) : handle(caerDeviceTranslatorOpen(dev.handle.get()), &translatorClose) {
+		// Handle construction failure.
+		if (!handle) {
+			std::string exc = dev.toString() + ": failed to open translator.";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	void configSet(int8_t modAddr, uint8_t paramAddr, uint32_t param) const {
+		bool success = caerDeviceTranslatorConfigSet(handle.get(), modAddr, paramAddr, param);
+		if (!success) {
+			std::string exc = "Translator: failed to set configuration parameter, modAddr=" + std::to_string(modAddr)
+							  + ", paramAddr=" + std::to_string(paramAddr) + ", param=" + std::to_string(param) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	uint32_t configGet(int8_t modAddr, uint8_t paramAddr) const {
+		uint32_t param = 0;
+
+		bool success = caerDeviceTranslatorConfigGet(handle.get(), modAddr, paramAddr, &param);
+		if (!success) {
+			std::string exc = "Translator: failed to get configuration parameter, modAddr=" + std::to_string(modAddr)
+							  + ", paramAddr=" + std::to_string(paramAddr) + ".";
+			throw std::runtime_error(exc);
+		}
+
+		return (param);
+	}
+
+	void process(const uint8_t *buffer, size_t bufferSize) const {
+		bool success = caerDeviceTranslatorProcess(handle.get(), buffer, bufferSize);
+		if (!success) {
+			throw std::runtime_error("Translator: failed to process raw data buffer.");
+		}
+	}
+
+	void process(const struct caer_device_raw_buffer &rawBuf) const {
+		process(rawBuf.data, rawBuf.dataSize);
+	}
+
+	void flush() const {
+		bool success = caerDeviceTranslatorFlush(handle.get());
+		if (!success) {
+			throw std::runtime_error("Translator: failed to flush pending events.");
+		}
+	}
+
+	void scan(const uint8_t *buffer, size_t bufferSize) const {
+		bool success = caerDeviceTranslatorScan(handle.get(), buffer, bufferSize);
+		if (!success) {
+			throw std::runtime_error("Translator: failed to scan raw data buffer.");
+		}
+	}
+
+	size_t resync(const uint8_t *buffer, size_t bufferSize) const noexcept {
+		return (caerDeviceTranslatorResync(handle.get(), buffer, bufferSize));
+	}
+
+	translatorState stateGet() const {
+		translatorState state(caerDeviceTranslatorStateGet(handle.get()));
+		if (!state) {
+			throw std::runtime_error("Translator: failed to get decoding state.");
+		}
+
+		return (state);
+	}
+
+	void stateSet(const translatorState &state) const {
+		bool success = caerDeviceTranslatorStateSet(handle.get(), state.get());
+		if (!success) {
+			throw std::runtime_error("Translator: failed to set decoding state.");
+		}
+	}
+
+	std::unique_ptr<libcaer::events::EventPacketContainer> dataGet() const {
+		caerEventPacketContainer cContainer = caerDeviceTranslatorDataGet(handle.get());
+		if (cContainer == nullptr) {
+			// NULL return means no data, forward that.
+			return (nullptr);
+		}
+
+		std::unique_ptr<libcaer::events::EventPacketContainer> cppContainer
+			= std::unique_ptr<libcaer::events::EventPacketContainer>(
+				new libcaer::events::EventPacketContainer(cContainer));
+
+		// Free original C container. The event packet memory is now managed by
+		// the EventPacket classes inside the new C++ EventPacketContainer.
+		caerFree(cContainer);
 
 		return (cppContainer);
 	}
+
+	/**
+	 * Get the next container of event packets, like dataGet(), but
+	 * without wrapping each packet into a shared EventPacket.
+	 *
+	 * @return a packet container, converting to false if no data is available.
+	 */
+	libcaer::events::EventPacketContainerUnique dataGetUnique() const {
+		// NULL return means no data, forward that as an empty container.
+		return (libcaer::events::EventPacketContainerUnique(caerDeviceTranslatorDataGet(handle.get())));
+	}
 };
 } // namespace devices
 } // namespace libcaer
@@ -45,6 +45,26 @@ public:
 		return (device(CAER_DEVICE_DISCOVER_ALL));
 	}
 
+	static void cacheEnable(bool enable) noexcept {
+		caerDeviceDiscoverCacheEnable(enable);
+	}
+
+	static void cacheClear() noexcept {
+		caerDeviceDiscoverCacheClear();
+	}
+
+	static void hotplugRegister(
+		void (*hotplugCallback)(caerDeviceDiscoveryResult device, bool arrived, void *hotplugCallbackPtr),
+		void *hotplugCallbackPtr) {
+		if (!caerDeviceHotplugRegister(hotplugCallback, hotplugCallbackPtr)) {
+			throw std::runtime_error("Device Discovery: failed to register hotplug callback.");
+		}
+	}
+
+	static void hotplugUnregister() noexcept {
+		caerDeviceHotplugUnregister();
+	}
+
 	static std::unique_ptr<libcaer::devices::device> open(
 		uint16_t deviceID, const struct caer_device_discovery_result &discoveredDevice) {
 		switch (discoveredDevice.deviceType) {
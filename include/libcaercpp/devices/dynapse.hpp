@@ -8,6 +8,8 @@
 
 #include "usb.hpp"
 
+#include <vector>
+
 namespace libcaer {
 namespace devices {
 
@@ -94,6 +96,32 @@ public:
 		}
 	}
 
+	void writeCamMultiple(const struct caer_dynapse_cam *cams, size_t camsNumber) const {
+		bool success = caerDynapseWriteCamMultiple(handle.get(), cams, camsNumber);
+		if (!success) {
+			std::string exc
+				= toString() + ": failed to write on-chip CAMs, camsNumber=" + std::to_string(camsNumber) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	void writeCamMultiple(const std::vector<struct caer_dynapse_cam> &cams) const {
+		writeCamMultiple(cams.data(), cams.size());
+	}
+
+	void writeSramMultiple(const struct caer_dynapse_sram *srams, size_t sramsNumber) const {
+		bool success = caerDynapseWriteSramMultiple(handle.get(), srams, sramsNumber);
+		if (!success) {
+			std::string exc
+				= toString() + ": failed to write on-chip SRAMs, sramsNumber=" + std::to_string(sramsNumber) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	void writeSramMultiple(const std::vector<struct caer_dynapse_sram> &srams) const {
+		writeSramMultiple(srams.data(), srams.size());
+	}
+
 	// STATIC.
 	static uint32_t biasDynapseGenerate(const struct caer_bias_dynapse dynapseBias) noexcept {
 		return (caerBiasDynapseGenerate(dynapseBias));
@@ -6,6 +6,7 @@
 #include <libcaer/events/common.h>
 
 #include <cassert>
+#include <iterator>
 #include <memory>
 #include <utility>
 
@@ -142,6 +143,8 @@ public:
 	}
 };
 
+class EventPacketGenericSlice;
+
 class EventPacket {
 protected:
 	caerEventPacketHeader header;
@@ -170,9 +173,10 @@ public:
 	virtual ~EventPacket() {
 		// Support not freeing memory, when this packet doesn't own the memory.
 		if (isMemoryOwner) {
-			// All EventPackets must have been allocated somewhere on the heap,
-			// and can thus always be passed to free(). free(nullptr) does nothing.
-			free(header);
+			// All EventPackets must have been allocated by the libcaer allocator,
+			// and can thus always be passed to caerEventPacketFree(), which does
+			// nothing on nullptr.
+			caerEventPacketFree(header);
 		}
 	}
 
@@ -198,7 +202,7 @@ public:
 
 			// Destroy current data, only if actually owned.
 			if (isMemoryOwner) {
-				free(header);
+				caerEventPacketFree(header);
 			}
 
 			header        = copy;
@@ -237,7 +241,7 @@ public:
 
 		// Destroy current data, only if actually owned.
 		if (isMemoryOwner) {
-			free(header);
+			caerEventPacketFree(header);
 		}
 
 		// Move data here.
@@ -422,6 +426,20 @@ public:
 		return (GenericEvent{evt, header});
 	}
 
+	// Timestamp lookup and time slices, events must be ordered by timestamp.
+	size_type findTimestamp(int64_t timestamp) const {
+		int32_t index = caerEventPacketFindTimestamp(header, timestamp);
+		if (index < 0) {
+			throw std::invalid_argument("Event packet holds no individual events, timestamp lookup not supported.");
+		}
+
+		return (index);
+	}
+
+	// Non-owning view of the events in [t0, t1[, valid or not, sharing this
+	// packet's memory: it must not be resized or freed while the view is used.
+	EventPacketGenericSlice timeSlice(int64_t t0, int64_t t1) const;
+
 	// Generic Event Packet methods.
 	int64_t getDataSize() const noexcept {
 		return (caerEventPacketGetDataSize(header));
@@ -630,6 +648,142 @@ protected:
 	}
 };
 
+// Non-owning view of a range of events of a packet, for generic access.
+class EventPacketGenericSlice {
+private:
+	caerEventPacketHeaderConst header;
+	int32_t firstIndex;
+	int32_t eventsNumber;
+
+public:
+	// Container traits.
+	using value_type       = EventPacket::GenericEvent;
+	using const_value_type = const EventPacket::GenericEvent;
+	using size_type        = int32_t;
+	using difference_type  = ptrdiff_t;
+
+	// Constructors.
+	EventPacketGenericSlice(caerEventPacketHeaderConst _header, int32_t _firstIndex, int32_t _eventsNumber) noexcept :
+		header(_header),
+		firstIndex(_firstIndex),
+		eventsNumber(_eventsNumber) {
+	}
+
+	// Generic Event access methods.
+	const_value_type genericGetEvent(size_type index) const {
+		// Support negative indexes to go from the end of the slice.
+		if (index < 0) {
+			index = size() + index;
+		}
+
+		if (index < 0 || index >= size()) {
+			throw std::out_of_range("Index out of range.");
+		}
+
+		return (EventPacket::GenericEvent{caerGenericEventGetEvent(header, firstIndex + index), header});
+	}
+
+	// Index of the first event of the slice in its packet.
+	size_type getFirstIndex() const noexcept {
+		return (firstIndex);
+	}
+
+	size_type size() const noexcept {
+		return (eventsNumber);
+	}
+
+	bool empty() const noexcept {
+		return (eventsNumber == 0);
+	}
+};
+
+inline EventPacketGenericSlice EventPacket::timeSlice(int64_t t0, int64_t t1) const {
+	size_type first = findTimestamp(t0);
+	size_type last  = (t1 > t0) ? (findTimestamp(t1)) : (first);
+
+	return (EventPacketGenericSlice(header, first, last - first));
+}
+
+// Non-owning view of a range of events of a typed packet.
+template<class T>
+class EventPacketSlice {
+private:
+	// Select proper pointer type (const or not) depending on template type.
+	using eventPtrType = typename std::conditional<std::is_const<T>::value, const uint8_t *, uint8_t *>::type;
+
+	eventPtrType firstEvent;
+	size_t eventSize;
+	int32_t firstIndex;
+	int32_t eventsNumber;
+
+public:
+	// Container traits.
+	using value_type      = typename std::remove_cv<T>::type;
+	using pointer         = T *;
+	using reference       = T &;
+	using size_type       = int32_t;
+	using difference_type = ptrdiff_t;
+
+	// Constructors.
+	EventPacketSlice(eventPtrType _firstEvent, size_t _eventSize, int32_t _firstIndex, int32_t _eventsNumber) noexcept :
+		firstEvent(_firstEvent),
+		eventSize(_eventSize),
+		firstIndex(_firstIndex),
+		eventsNumber(_eventsNumber) {
+	}
+
+	// Event access methods.
+	reference getEvent(size_type index) const {
+		// Support negative indexes to go from the end of the slice.
+		if (index < 0) {
+			index = size() + index;
+		}
+
+		if (index < 0 || index >= size()) {
+			throw std::out_of_range("Index out of range.");
+		}
+
+		return (*reinterpret_cast<pointer>(firstEvent + (static_cast<size_t>(index) * eventSize)));
+	}
+
+	reference operator[](size_type index) const {
+		return (getEvent(index));
+	}
+
+	// Index of the first event of the slice in its packet.
+	size_type getFirstIndex() const noexcept {
+		return (firstIndex);
+	}
+
+	size_type size() const noexcept {
+		return (eventsNumber);
+	}
+
+	bool empty() const noexcept {
+		return (eventsNumber == 0);
+	}
+
+	// Iterator support.
+	using iterator         = EventPacketIterator<T>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+
+	iterator begin() const noexcept {
+		return (iterator(firstEvent, eventSize));
+	}
+
+	iterator end() const noexcept {
+		return (iterator(firstEvent + (static_cast<size_t>(eventsNumber) * eventSize), eventSize));
+	}
+
+	reverse_iterator rbegin() const noexcept {
+		return (reverse_iterator(end()));
+	}
+
+	reverse_iterator rend() const noexcept {
+		return (reverse_iterator(begin()));
+	}
+};
+
 template<class PKT, class EVT>
 class EventPacketCommon : public EventPacket {
 public:
@@ -694,6 +848,29 @@ public:
 		return (std::unique_ptr<PKT>(static_cast<PKT *>(virtualCopy(ct).release())));
 	}
 
+	// Time slice support: non-owning views of the events in [t0, t1[,
+	// valid or not, sharing this packet's memory.
+	using slice       = EventPacketSlice<value_type>;
+	using const_slice = EventPacketSlice<const_value_type>;
+
+	slice timeSlice(int64_t t0, int64_t t1) {
+		size_type first = findTimestamp(t0);
+		size_type last  = (t1 > t0) ? (findTimestamp(t1)) : (first);
+
+		return (slice(reinterpret_cast<uint8_t *>(header) + CAER_EVENT_PACKET_HEADER_SIZE
+						  + (static_cast<size_t>(first) * static_cast<size_t>(getEventSize())),
+			static_cast<size_t>(getEventSize()), first, last - first));
+	}
+
+	const_slice timeSlice(int64_t t0, int64_t t1) const {
+		size_type first = findTimestamp(t0);
+		size_type last  = (t1 > t0) ? (findTimestamp(t1)) : (first);
+
+		return (const_slice(reinterpret_cast<const uint8_t *>(header) + CAER_EVENT_PACKET_HEADER_SIZE
+								+ (static_cast<size_t>(first) * static_cast<size_t>(getEventSize())),
+			static_cast<size_t>(getEventSize()), first, last - first));
+	}
+
 	// Iterator support.
 	using iterator               = EventPacketIterator<value_type>;
 	using const_iterator         = EventPacketIterator<const_value_type>;
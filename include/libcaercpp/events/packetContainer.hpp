@@ -6,7 +6,9 @@
 #include "common.hpp"
 #include "utils.hpp"
 
+#include <iterator>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -157,6 +159,92 @@ public:
 	}
 };
 
+// Input iterator returning all valid events of a packet container in timestamp
+// order, across event types, by merging its packets in place. See the C
+// caerEventPacketContainerTimeOrderedIterator*() functions for details.
+class EventPacketContainerTimeOrderedIterator {
+private:
+	struct caer_event_packet_container_time_ordered_iterator state;
+	struct caer_event_packet_container_time_ordered_event currElement;
+	bool atEnd;
+
+public:
+	// Iterator traits.
+	using iterator_category = std::input_iterator_tag;
+	using value_type        = struct caer_event_packet_container_time_ordered_event;
+	using pointer           = const value_type *;
+	using reference         = const value_type &;
+	using difference_type   = ptrdiff_t;
+
+	// Constructors.
+	EventPacketContainerTimeOrderedIterator() noexcept : currElement(), atEnd(true) {
+		// End iterator.
+		caerEventPacketContainerTimeOrderedIteratorInit(&state);
+	}
+
+	EventPacketContainerTimeOrderedIterator(
+		const struct caer_event_packet_container_time_ordered_iterator &_state) noexcept :
+		state(_state),
+		currElement() {
+		atEnd = !caerEventPacketContainerTimeOrderedIteratorNext(&state, &currElement);
+	}
+
+	// Data access operators.
+	reference operator*() const noexcept {
+		return (currElement);
+	}
+
+	pointer operator->() const noexcept {
+		return (&currElement);
+	}
+
+	// Comparison operators.
+	bool operator==(const EventPacketContainerTimeOrderedIterator &rhs) const noexcept {
+		if (atEnd || rhs.atEnd) {
+			return (atEnd == rhs.atEnd);
+		}
+
+		return (currElement.event == rhs.currElement.event);
+	}
+
+	bool operator!=(const EventPacketContainerTimeOrderedIterator &rhs) const noexcept {
+		return (!(*this == rhs));
+	}
+
+	// Prefix increment.
+	EventPacketContainerTimeOrderedIterator &operator++() noexcept {
+		atEnd = !caerEventPacketContainerTimeOrderedIteratorNext(&state, &currElement);
+		return (*this);
+	}
+
+	// Postfix increment.
+	EventPacketContainerTimeOrderedIterator operator++(int) noexcept {
+		EventPacketContainerTimeOrderedIterator currIterator = *this;
+		++(*this);
+		return (currIterator);
+	}
+};
+
+// Range over a time-ordered iterator, for use in range-based for loops.
+class EventPacketContainerTimeOrderedRange {
+private:
+	struct caer_event_packet_container_time_ordered_iterator state;
+
+public:
+	EventPacketContainerTimeOrderedRange(
+		const struct caer_event_packet_container_time_ordered_iterator &_state) noexcept :
+		state(_state) {
+	}
+
+	EventPacketContainerTimeOrderedIterator begin() const noexcept {
+		return (EventPacketContainerTimeOrderedIterator(state));
+	}
+
+	EventPacketContainerTimeOrderedIterator end() const noexcept {
+		return (EventPacketContainerTimeOrderedIterator());
+	}
+};
+
 class EventPacketContainer {
 private:
 	/// Smallest event timestamp contained in this packet container.
@@ -660,6 +748,39 @@ public:
 		return (newContainer);
 	}
 
+	/**
+	 * Get a range over all valid events in all event packets of this
+	 * container, returned in timestamp order across event types.
+	 * The events are not copied: the packets are merged in place, so
+	 * they must not be changed, and this container must stay alive,
+	 * while iterating.
+	 * Events with the same timestamp are returned in container order.
+	 * Packets with no individual events (polarity columns and compressed
+	 * polarity) are skipped.
+	 *
+	 * @return a range of time-ordered events.
+	 *
+	 * @exception std::length_error more than CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_MAX_PACKETS
+	 *            non-empty packets in this container.
+	 */
+	EventPacketContainerTimeOrderedRange timeOrdered() const {
+		struct caer_event_packet_container_time_ordered_iterator state;
+
+		caerEventPacketContainerTimeOrderedIteratorInit(&state);
+
+		for (const auto &packet : eventPackets) {
+			if (packet == nullptr) {
+				continue;
+			}
+
+			if (!caerEventPacketContainerTimeOrderedIteratorAddPacket(&state, packet->getHeaderPointer())) {
+				throw std::length_error("Too many event packets for time-ordered iteration.");
+			}
+		}
+
+		return (EventPacketContainerTimeOrderedRange(state));
+	}
+
 	// Iterator support (the returned shared_ptr are always read-only copies, so actual modifications to
 	// what is pointed to can only happen through setEventPacket() and addEventPacket()).
 	using iterator         = EventPacketContainerCopyIterator<std::vector<std::shared_ptr<EventPacket>>::iterator,
@@ -717,6 +838,441 @@ public:
 		return (const_reverse_iterator(cbegin()));
 	}
 };
+
+// Forward iterator over the event packets of an EventPacketContainerUnique.
+// Returns the C packet pointers (possibly nullptr) stored in the container,
+// which keeps ownership of them.
+template<class ContainerType, class PacketType>
+class EventPacketContainerUniqueIterator {
+private:
+	ContainerType container;
+	int32_t index;
+
+public:
+	// Iterator traits.
+	using iterator_category = std::forward_iterator_tag;
+	using value_type        = PacketType;
+	using pointer           = const PacketType *;
+	using reference         = PacketType;
+	using difference_type   = ptrdiff_t;
+
+	// Constructors.
+	EventPacketContainerUniqueIterator() noexcept : container(nullptr), index(0) {
+	}
+
+	EventPacketContainerUniqueIterator(ContainerType _container, int32_t _index) noexcept :
+		container(_container),
+		index(_index) {
+	}
+
+	// Data access operators.
+	reference operator*() const noexcept {
+		return (caerEventPacketContainerGetEventPacket(container, index));
+	}
+
+	// Comparison operators.
+	bool operator==(const EventPacketContainerUniqueIterator &rhs) const noexcept {
+		return ((container == rhs.container) && (index == rhs.index));
+	}
+
+	bool operator!=(const EventPacketContainerUniqueIterator &rhs) const noexcept {
+		return (!(*this == rhs));
+	}
+
+	// Prefix increment.
+	EventPacketContainerUniqueIterator &operator++() noexcept {
+		index++;
+		return (*this);
+	}
+
+	// Postfix increment.
+	EventPacketContainerUniqueIterator operator++(int) noexcept {
+		EventPacketContainerUniqueIterator currIterator = *this;
+		index++;
+		return (currIterator);
+	}
+};
+
+/**
+ * Move-only event packet container that directly owns a C-style
+ * caerEventPacketContainer and its packets. Unlike EventPacketContainer,
+ * packets are not wrapped into individually allocated, reference-counted
+ * EventPacket objects: they stay plain C packets, accessed in place through
+ * non-owning typed views, or taken out of the container one at a time as
+ * std::unique_ptr. Use this when packets are not shared between consumers,
+ * such as when processing the containers returned by dataGetUnique().
+ * A default-constructed or moved-from container holds nothing and
+ * converts to false.
+ */
+class EventPacketContainerUnique {
+private:
+	caerEventPacketContainer container;
+
+	int32_t getPacketIndex(int32_t index) const {
+		// Support negative indexes to go from the end of the event packet container.
+		if (index < 0) {
+			index = size() + index;
+		}
+
+		if (index < 0 || index >= size()) {
+			throw std::out_of_range("Index out of range.");
+		}
+
+		return (index);
+	}
+
+public:
+	// Container traits (not really STL compatible).
+	using value_type       = caerEventPacketHeader;
+	using const_value_type = caerEventPacketHeaderConst;
+	using size_type        = int32_t;
+	using difference_type  = ptrdiff_t;
+
+	/**
+	 * Construct a new, empty EventPacketContainerUnique.
+	 */
+	EventPacketContainerUnique() noexcept : container(nullptr) {
+	}
+
+	/**
+	 * Construct a new EventPacketContainerUnique with space for the
+	 * given number of event packets, all initialized to nullptr.
+	 *
+	 * @param eventPacketsNumber the number of event packets that can be
+	 *                           stored in this container. Must be equal
+	 *                           to one or higher.
+	 */
+	EventPacketContainerUnique(size_type eventPacketsNumber) {
+		if (eventPacketsNumber <= 0) {
+			throw std::invalid_argument("Negative or zero capacity not allowed on explicit construction.");
+		}
+
+		container = caerEventPacketContainerAllocate(eventPacketsNumber);
+		if (container == nullptr) {
+			throw std::bad_alloc();
+		}
+	}
+
+	/**
+	 * Construct a new EventPacketContainerUnique taking over ownership
+	 * of a C-style caerEventPacketContainer and all of its packets.
+	 *
+	 * @param packetContainer C-style caerEventPacketContainer to take over.
+	 *                        If nullptr, the new container holds nothing.
+	 */
+	explicit EventPacketContainerUnique(caerEventPacketContainer packetContainer) noexcept :
+		container(packetContainer) {
+	}
+
+	~EventPacketContainerUnique() {
+		caerEventPacketContainerFree(container);
+	}
+
+	// The container owns its packets, so it can only be moved.
+	EventPacketContainerUnique(const EventPacketContainerUnique &rhs)            = delete;
+	EventPacketContainerUnique &operator=(const EventPacketContainerUnique &rhs) = delete;
+
+	EventPacketContainerUnique(EventPacketContainerUnique &&rhs) noexcept : container(rhs.container) {
+		rhs.container = nullptr;
+	}
+
+	EventPacketContainerUnique &operator=(EventPacketContainerUnique &&rhs) noexcept {
+		if (this != &rhs) {
+			caerEventPacketContainerFree(container);
+
+			container     = rhs.container;
+			rhs.container = nullptr;
+		}
+
+		return (*this);
+	}
+
+	explicit operator bool() const noexcept {
+		return (container != nullptr);
+	}
+
+	// Direct underlying pointer access.
+	caerEventPacketContainer get() noexcept {
+		return (container);
+	}
+
+	caerEventPacketContainerConst get() const noexcept {
+		return (container);
+	}
+
+	/**
+	 * Give up ownership of the C-style container and its packets,
+	 * for example to pass them on to C code. This container then
+	 * holds nothing.
+	 *
+	 * @return the C-style container, to be freed with caerEventPacketContainerFree().
+	 */
+	caerEventPacketContainer release() noexcept {
+		caerEventPacketContainer cContainer = container;
+		container                           = nullptr;
+		return (cContainer);
+	}
+
+	size_type size() const noexcept {
+		return (caerEventPacketContainerGetEventPacketsNumber(container));
+	}
+
+	bool empty() const noexcept {
+		return (size() == 0);
+	}
+
+	/**
+	 * Get the event packet stored in this container at the given index.
+	 * The container keeps ownership of it.
+	 *
+	 * @param index the index of the event packet to get.
+	 *
+	 * @return a pointer to an event packet, can be nullptr.
+	 *
+	 * @exception std:out_of_range no packet exists at given index.
+	 */
+	value_type getEventPacket(size_type index) {
+		return (caerEventPacketContainerGetEventPacket(container, getPacketIndex(index)));
+	}
+
+	value_type operator[](size_type index) {
+		return (getEventPacket(index));
+	}
+
+	/**
+	 * Get the event packet stored in this container at the given index.
+	 * This is a read-only event packet, do not change its contents in any way!
+	 *
+	 * @param index the index of the event packet to get.
+	 *
+	 * @return a pointer to a read-only event packet, can be nullptr.
+	 *
+	 * @exception std:out_of_range no packet exists at given index.
+	 */
+	const_value_type getEventPacket(size_type index) const {
+		return (caerEventPacketContainerGetEventPacket(container, getPacketIndex(index)));
+	}
+
+	const_value_type operator[](size_type index) const {
+		return (getEventPacket(index));
+	}
+
+	/**
+	 * Get a typed view of the event packet stored in this container at the
+	 * given index, such as a PolarityEventPacket. The view does not own the
+	 * packet memory, so no allocation happens and it must not outlive this
+	 * container, or the packet being replaced or taken out of it.
+	 *
+	 * @param index the index of the event packet to get.
+	 *
+	 * @return a non-owning event packet of the given type.
+	 *
+	 * @exception std:out_of_range no packet exists at given index.
+	 * @exception std::runtime_error the packet is nullptr or of a different type.
+	 */
+	template<class PacketType>
+	PacketType viewEventPacket(size_type index) {
+		return (PacketType(getEventPacket(index), false));
+	}
+
+	/**
+	 * Take the event packet stored in this container at the given index out
+	 * of it. Its place in the container is set to nullptr, and ownership
+	 * passes to the returned EventPacket.
+	 *
+	 * @param index the index of the event packet to take.
+	 *
+	 * @return an owning event packet of the right type, or nullptr if none.
+	 *
+	 * @exception std:out_of_range no packet exists at given index.
+	 */
+	std::unique_ptr<EventPacket> takeEventPacket(size_type index) {
+		index = getPacketIndex(index);
+
+		caerEventPacketHeader packet = caerEventPacketContainerGetEventPacket(container, index);
+		if (packet == nullptr) {
+			return (nullptr);
+		}
+
+		std::unique_ptr<EventPacket> cppPacket = libcaer::events::utils::makeUniqueFromCStruct(packet, true);
+
+		caerEventPacketContainerSetEventPacket(container, index, nullptr);
+
+		return (cppPacket);
+	}
+
+	/**
+	 * Set the event packet stored in this container at the given index,
+	 * freeing the packet that was there before. The container takes over
+	 * ownership of the packet memory. The index must be valid already,
+	 * this does not change the container size.
+	 *
+	 * @param index the index of the event packet to set.
+	 * @param packet an event packet. Can be nullptr.
+	 *
+	 * @exception std:out_of_range no packet exists at given index.
+	 */
+	void setEventPacket(size_type index, std::unique_ptr<EventPacket> packet) {
+		index = getPacketIndex(index);
+
+		caerEventPacketHeader newPacket = (packet == nullptr) ? (nullptr) : (packet->getHeaderPointerForCOutput());
+		caerEventPacketHeader oldPacket = caerEventPacketContainerGetEventPacket(container, index);
+
+		caerEventPacketContainerSetEventPacket(container, index, newPacket);
+
+		if (oldPacket != newPacket) {
+			caerEventPacketFree(oldPacket);
+		}
+	}
+
+	/**
+	 * Get the lowest timestamp contained in this event packet container.
+	 *
+	 * @return the lowest timestamp (in µs) or -1 if not initialized.
+	 */
+	int64_t getLowestEventTimestamp() const noexcept {
+		return (caerEventPacketContainerGetLowestEventTimestamp(container));
+	}
+
+	/**
+	 * Get the highest timestamp contained in this event packet container.
+	 *
+	 * @return the highest timestamp (in µs) or -1 if not initialized.
+	 */
+	int64_t getHighestEventTimestamp() const noexcept {
+		return (caerEventPacketContainerGetHighestEventTimestamp(container));
+	}
+
+	/**
+	 * Get the number of events contained in this event packet container.
+	 *
+	 * @return the number of events in this container.
+	 */
+	int32_t getEventsNumber() const noexcept {
+		return (caerEventPacketContainerGetEventsNumber(container));
+	}
+
+	/**
+	 * Get the number of valid events contained in this event packet container.
+	 *
+	 * @return the number of valid events in this container.
+	 */
+	int32_t getEventsValidNumber() const noexcept {
+		return (caerEventPacketContainerGetEventsValidNumber(container));
+	}
+
+	/**
+	 * Recalculates and updates all the packet-container level statistics (event
+	 * counts and timestamps), after the events of its packets were changed.
+	 */
+	void updateStatistics() noexcept {
+		caerEventPacketContainerUpdateStatistics(container);
+	}
+
+	/**
+	 * Get the event packet stored in this container with the given event
+	 * type. This returns the first found event packet with that type ID,
+	 * or nullptr if we get to the end without finding any such event packet.
+	 *
+	 * @param typeID the event type to search for.
+	 *
+	 * @return a pointer to an event packet with a certain type or nullptr if none found.
+	 */
+	value_type findEventPacketByType(int16_t typeID) noexcept {
+		return (caerEventPacketContainerFindEventPacketByType(container, typeID));
+	}
+
+	const_value_type findEventPacketByType(int16_t typeID) const noexcept {
+		return (caerEventPacketContainerFindEventPacketByTypeConst(container, typeID));
+	}
+
+	/**
+	 * Make a deep copy of this event packet container and all of its
+	 * event packets and their current events.
+	 *
+	 * @return a deep copy of this event packet container, containing all events.
+	 */
+	EventPacketContainerUnique copyAllEvents() const {
+		if (container == nullptr) {
+			return (EventPacketContainerUnique());
+		}
+
+		caerEventPacketContainer copy = caerEventPacketContainerCopyAllEvents(container);
+		if (copy == nullptr) {
+			throw std::bad_alloc();
+		}
+
+		return (EventPacketContainerUnique(copy));
+	}
+
+	/**
+	 * Make a deep copy of this event packet container, with its event packets
+	 * sized down to only include the currently valid events (eventValid),
+	 * and discarding everything else.
+	 *
+	 * @return a deep copy of this event packet container, containing only valid events.
+	 */
+	EventPacketContainerUnique copyValidEvents() const {
+		if (container == nullptr) {
+			return (EventPacketContainerUnique());
+		}
+
+		caerEventPacketContainer copy = caerEventPacketContainerCopyValidEvents(container);
+		if (copy == nullptr) {
+			throw std::bad_alloc();
+		}
+
+		return (EventPacketContainerUnique(copy));
+	}
+
+	/**
+	 * Get a range over all valid events in all event packets of this
+	 * container, returned in timestamp order across event types.
+	 * See EventPacketContainer::timeOrdered() for details.
+	 *
+	 * @return a range of time-ordered events.
+	 *
+	 * @exception std::length_error more than CAER_EVENT_PACKET_CONTAINER_TIME_ORDERED_MAX_PACKETS
+	 *            non-empty packets in this container.
+	 */
+	EventPacketContainerTimeOrderedRange timeOrdered() const {
+		struct caer_event_packet_container_time_ordered_iterator state;
+
+		if (!caerEventPacketContainerTimeOrderedIteratorInitContainer(&state, container)) {
+			throw std::length_error("Too many event packets for time-ordered iteration.");
+		}
+
+		return (EventPacketContainerTimeOrderedRange(state));
+	}
+
+	// Iterator support (returns the C packet pointers, possibly nullptr).
+	using iterator       = EventPacketContainerUniqueIterator<caerEventPacketContainer, caerEventPacketHeader>;
+	using const_iterator = EventPacketContainerUniqueIterator<caerEventPacketContainerConst, caerEventPacketHeaderConst>;
+
+	iterator begin() noexcept {
+		return (iterator(container, 0));
+	}
+
+	iterator end() noexcept {
+		return (iterator(container, size()));
+	}
+
+	const_iterator begin() const noexcept {
+		return (cbegin());
+	}
+
+	const_iterator end() const noexcept {
+		return (cend());
+	}
+
+	const_iterator cbegin() const noexcept {
+		return (const_iterator(container, 0));
+	}
+
+	const_iterator cend() const noexcept {
+		return (const_iterator(container, size()));
+	}
+};
 } // namespace events
 } // namespace libcaer
 
@@ -0,0 +1,132 @@
+#ifndef LIBCAER_EVENTS_POLARITY_COLUMNS_HPP_
+#define LIBCAER_EVENTS_POLARITY_COLUMNS_HPP_
+
+#include <libcaer/events/polarityColumns.h>
+
+#include "common.hpp"
+#include "polarity.hpp"
+
+namespace libcaer {
+namespace events {
+
+// Columnar polarity events: there are no event structs to access, use the
+// column arrays instead. Generic event access (genericGetEvent()) does not
+// apply to this layout. Columns are little-endian, like all event data.
+class PolarityColumnsEventPacket : public EventPacket {
+public:
+	// Constructors.
+	PolarityColumnsEventPacket(size_type eventNumber, int16_t eventSource, int32_t tsOverflow) {
+		constructorCheckCapacitySourceTSOverflow(eventNumber, eventSource, tsOverflow);
+
+		caerPolarityColumnsEventPacket packet
+			= caerPolarityColumnsEventPacketAllocate(eventNumber, eventSource, tsOverflow);
+		constructorCheckNullptr(packet);
+
+		header        = &packet->packetHeader;
+		isMemoryOwner = true; // Always owner on new allocation!
+	}
+
+	PolarityColumnsEventPacket(caerPolarityColumnsEventPacket packet, bool takeMemoryOwnership = true) {
+		constructorCheckNullptr(packet);
+
+		constructorCheckEventType(&packet->packetHeader, POLARITY_COLUMNS_EVENT);
+
+		header        = &packet->packetHeader;
+		isMemoryOwner = takeMemoryOwnership;
+	}
+
+	PolarityColumnsEventPacket(caerEventPacketHeader packetHeader, bool takeMemoryOwnership = true) {
+		constructorCheckNullptr(packetHeader);
+
+		constructorCheckEventType(packetHeader, POLARITY_COLUMNS_EVENT);
+
+		header        = packetHeader;
+		isMemoryOwner = takeMemoryOwnership;
+	}
+
+	// Conversion from/to packed polarity events.
+	static PolarityColumnsEventPacket fromPolarity(const PolarityEventPacket &packet) {
+		caerPolarityColumnsEventPacket columns = caerPolarityColumnsEventPacketFromPolarity(
+			reinterpret_cast<caerPolarityEventPacketConst>(packet.getHeaderPointer()));
+		if (columns == nullptr) {
+			throw std::runtime_error("Failed to convert to polarity columns: no valid events or allocation failure.");
+		}
+
+		return (PolarityColumnsEventPacket(columns));
+	}
+
+	PolarityEventPacket toPolarity() const {
+		caerPolarityEventPacket packet = caerPolarityEventPacketFromPolarityColumns(
+			reinterpret_cast<caerPolarityColumnsEventPacketConst>(header));
+		if (packet == nullptr) {
+			throw std::runtime_error("Failed to convert from polarity columns: empty packet or allocation failure.");
+		}
+
+		return (PolarityEventPacket(packet));
+	}
+
+	// Column access.
+	int32_t *timestamps() noexcept {
+		return (caerPolarityColumnsEventPacketGetTimestamps(reinterpret_cast<caerPolarityColumnsEventPacket>(header)));
+	}
+
+	const int32_t *timestamps() const noexcept {
+		return (caerPolarityColumnsEventPacketGetTimestampsConst(
+			reinterpret_cast<caerPolarityColumnsEventPacketConst>(header)));
+	}
+
+	uint16_t *x() noexcept {
+		return (caerPolarityColumnsEventPacketGetX(reinterpret_cast<caerPolarityColumnsEventPacket>(header)));
+	}
+
+	const uint16_t *x() const noexcept {
+		return (caerPolarityColumnsEventPacketGetXConst(reinterpret_cast<caerPolarityColumnsEventPacketConst>(header)));
+	}
+
+	uint16_t *y() noexcept {
+		return (caerPolarityColumnsEventPacketGetY(reinterpret_cast<caerPolarityColumnsEventPacket>(header)));
+	}
+
+	const uint16_t *y() const noexcept {
+		return (caerPolarityColumnsEventPacketGetYConst(reinterpret_cast<caerPolarityColumnsEventPacketConst>(header)));
+	}
+
+	uint8_t *polarities() noexcept {
+		return (caerPolarityColumnsEventPacketGetPolarities(reinterpret_cast<caerPolarityColumnsEventPacket>(header)));
+	}
+
+	const uint8_t *polarities() const noexcept {
+		return (caerPolarityColumnsEventPacketGetPolaritiesConst(
+			reinterpret_cast<caerPolarityColumnsEventPacketConst>(header)));
+	}
+
+	// Single event access.
+	int32_t getTimestamp(size_type index) const {
+		return (caerPolarityColumnsEventPacketGetTimestamp(
+			reinterpret_cast<caerPolarityColumnsEventPacketConst>(header), getEventIndex(index, false)));
+	}
+
+	int64_t getTimestamp64(size_type index) const {
+		return (caerPolarityColumnsEventPacketGetTimestamp64(
+			reinterpret_cast<caerPolarityColumnsEventPacketConst>(header), getEventIndex(index, false)));
+	}
+
+	void setEvent(size_type index, int32_t ts, uint16_t xAddr, uint16_t yAddr, bool polarity) {
+		if (ts < 0) {
+			throw std::invalid_argument("Negative timestamp not allowed.");
+		}
+
+		caerPolarityColumnsEventPacketSetEvent(reinterpret_cast<caerPolarityColumnsEventPacket>(header),
+			getEventIndex(index, false), ts, xAddr, yAddr, polarity);
+	}
+
+protected:
+	std::unique_ptr<EventPacket> virtualCopy(copyTypes ct) const override {
+		// All events are always valid, so all copy types are the same.
+		return (std::unique_ptr<PolarityColumnsEventPacket>(new PolarityColumnsEventPacket(internalCopy(header, ct))));
+	}
+};
+} // namespace events
+} // namespace libcaer
+
+#endif /* LIBCAER_EVENTS_POLARITY_COLUMNS_HPP_ */
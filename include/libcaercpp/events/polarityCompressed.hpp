@@ -0,0 +1,84 @@
+#ifndef LIBCAER_EVENTS_POLARITY_COMPRESSED_HPP_
+#define LIBCAER_EVENTS_POLARITY_COMPRESSED_HPP_
+
+#include <libcaer/events/polarityCompressed.h>
+
+#include "common.hpp"
+#include "polarity.hpp"
+
+namespace libcaer {
+namespace events {
+
+// Compressed polarity events: there are no events to access, decompress
+// the packet with toPolarity() to use them. The packet's size and event
+// counts are in 32 bit words of compressed data, see polarityCompressed.h.
+class PolarityCompressedEventPacket : public EventPacket {
+public:
+	// Constructors.
+	PolarityCompressedEventPacket(caerPolarityCompressedEventPacket packet, bool takeMemoryOwnership = true) {
+		constructorCheckNullptr(packet);
+
+		constructorCheckEventType(&packet->packetHeader, POLARITY_COMPRESSED_EVENT);
+
+		header        = &packet->packetHeader;
+		isMemoryOwner = takeMemoryOwnership;
+	}
+
+	PolarityCompressedEventPacket(caerEventPacketHeader packetHeader, bool takeMemoryOwnership = true) {
+		constructorCheckNullptr(packetHeader);
+
+		constructorCheckEventType(packetHeader, POLARITY_COMPRESSED_EVENT);
+
+		header        = packetHeader;
+		isMemoryOwner = takeMemoryOwnership;
+	}
+
+	// Conversion from/to packed polarity events.
+	static PolarityCompressedEventPacket fromPolarity(const PolarityEventPacket &packet, bool runLength = true) {
+		caerPolarityCompressedEventPacket compressed = caerPolarityCompressedEventPacketFromPolarity(
+			reinterpret_cast<caerPolarityEventPacketConst>(packet.getHeaderPointer()), runLength);
+		if (compressed == nullptr) {
+			throw std::runtime_error("Failed to compress polarity events: no valid events or allocation failure.");
+		}
+
+		return (PolarityCompressedEventPacket(compressed));
+	}
+
+	PolarityEventPacket toPolarity() const {
+		caerPolarityEventPacket packet = caerPolarityEventPacketFromPolarityCompressed(
+			reinterpret_cast<caerPolarityCompressedEventPacketConst>(header));
+		if (packet == nullptr) {
+			throw std::runtime_error(
+				"Failed to decompress polarity events: empty packet, corrupted data or allocation failure.");
+		}
+
+		return (PolarityEventPacket(packet));
+	}
+
+	// Compressed data information.
+	int32_t getCompressedEventsNumber() const noexcept {
+		return (caerPolarityCompressedEventPacketGetEventsNumber(
+			reinterpret_cast<caerPolarityCompressedEventPacketConst>(header)));
+	}
+
+	int64_t getFirstTimestamp64() const noexcept {
+		return (caerPolarityCompressedEventPacketGetFirstTimestamp64(
+			reinterpret_cast<caerPolarityCompressedEventPacketConst>(header)));
+	}
+
+	int64_t getLastTimestamp64() const noexcept {
+		return (caerPolarityCompressedEventPacketGetLastTimestamp64(
+			reinterpret_cast<caerPolarityCompressedEventPacketConst>(header)));
+	}
+
+protected:
+	std::unique_ptr<EventPacket> virtualCopy(copyTypes ct) const override {
+		// All words are always valid, so all copy types are the same.
+		return (std::unique_ptr<PolarityCompressedEventPacket>(
+			new PolarityCompressedEventPacket(internalCopy(header, ct))));
+	}
+};
+} // namespace events
+} // namespace libcaer
+
+#endif /* LIBCAER_EVENTS_POLARITY_COMPRESSED_HPP_ */
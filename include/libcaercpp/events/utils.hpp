@@ -6,6 +6,8 @@
 #include "imu6.hpp"
 #include "imu9.hpp"
 #include "polarity.hpp"
+#include "polarityColumns.hpp"
+#include "polarityCompressed.hpp"
 #include "special.hpp"
 #include "spike.hpp"
 
@@ -49,6 +51,16 @@ inline std::unique_ptr<EventPacket> makeUniqueFromCStruct(
 			return (std::unique_ptr<SpikeEventPacket>(new SpikeEventPacket(packet, takeMemoryOwnership)));
 			break;
 
+		case POLARITY_COLUMNS_EVENT:
+			return (std::unique_ptr<PolarityColumnsEventPacket>(
+				new PolarityColumnsEventPacket(packet, takeMemoryOwnership)));
+			break;
+
+		case POLARITY_COMPRESSED_EVENT:
+			return (std::unique_ptr<PolarityCompressedEventPacket>(
+				new PolarityCompressedEventPacket(packet, takeMemoryOwnership)));
+			break;
+
 		default:
 			return (std::unique_ptr<EventPacket>(new EventPacket(packet, takeMemoryOwnership)));
 			break;
@@ -82,6 +94,14 @@ inline std::shared_ptr<EventPacket> makeSharedFromCStruct(
 			return (std::make_shared<SpikeEventPacket>(packet, takeMemoryOwnership));
 			break;
 
+		case POLARITY_COLUMNS_EVENT:
+			return (std::make_shared<PolarityColumnsEventPacket>(packet, takeMemoryOwnership));
+			break;
+
+		case POLARITY_COMPRESSED_EVENT:
+			return (std::make_shared<PolarityCompressedEventPacket>(packet, takeMemoryOwnership));
+			break;
+
 		default:
 			return (std::make_shared<EventPacket>(packet, takeMemoryOwnership));
 			break;
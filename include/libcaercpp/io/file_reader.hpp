@@ -0,0 +1,100 @@
+#ifndef LIBCAER_IO_FILE_READER_HPP_
+#define LIBCAER_IO_FILE_READER_HPP_
+
+#include "../events/utils.hpp"
+
+#include <libcaer/io/file_reader.h>
+
+#include <memory>
+#include <string>
+
+namespace libcaer {
+namespace io {
+
+class FileReader {
+private:
+	struct ReaderDeleter {
+		void operator()(caerFileReader r) const noexcept {
+			caerFileReaderClose(r);
+		}
+	};
+
+	std::unique_ptr<struct caer_file_reader, ReaderDeleter> handle;
+
+	void checkIndex(size_t index) const {
+		if (index >= packetsNumber()) {
+			throw std::out_of_range(toString() + ": packet index out of range.");
+		}
+	}
+
+public:
+	FileReader(const std::string &fileName, const std::string &indexFileName = std::string()) {
+		caerFileReader r = caerFileReaderOpen(
+			fileName.c_str(), (indexFileName.empty()) ? (nullptr) : (indexFileName.c_str()));
+
+		// Handle constructor failure.
+		if (r == nullptr) {
+			std::string exc = "Failed to open AEDAT file reader, fileName=" + fileName + ".";
+			throw std::runtime_error(exc);
+		}
+
+		handle = std::unique_ptr<struct caer_file_reader, ReaderDeleter>(r);
+	}
+
+	~FileReader() = default;
+
+	// The reader owns the file mapping all packets point into, so it can only be moved.
+	FileReader(const FileReader &rhs)            = delete;
+	FileReader &operator=(const FileReader &rhs) = delete;
+	FileReader(FileReader &&rhs)                 = default;
+	FileReader &operator=(FileReader &&rhs)      = default;
+
+	std::string toString() const noexcept {
+		return ("AEDAT File Reader");
+	}
+
+	int8_t version() const noexcept {
+		return (caerFileReaderGetVersion(handle.get()));
+	}
+
+	size_t packetsNumber() const noexcept {
+		return (caerFileReaderGetPacketsNumber(handle.get()));
+	}
+
+	/**
+	 * Get a read-only view of a packet, of the right packet type.
+	 * It does not own its memory, which is only valid as long as
+	 * this reader exists.
+	 *
+	 * @param index index of the packet, range [0,packetsNumber()[.
+	 *
+	 * @return non-owning packet view.
+	 */
+	std::shared_ptr<const libcaer::events::EventPacket> packet(size_t index) const {
+		checkIndex(index);
+
+		return (libcaer::events::utils::makeSharedFromCStruct(
+			const_cast<caerEventPacketHeader>(caerFileReaderGetPacket(handle.get(), index)), false));
+	}
+
+	caerEventPacketHeaderConst packetHeader(size_t index) const {
+		checkIndex(index);
+
+		return (caerFileReaderGetPacket(handle.get(), index));
+	}
+
+	const struct caer_file_reader_index_entry &indexEntry(size_t index) const {
+		checkIndex(index);
+
+		return (*caerFileReaderGetIndexEntry(handle.get(), index));
+	}
+
+	size_t seekTimestamp(int64_t timestamp) const noexcept {
+		return (caerFileReaderSeekTimestamp(handle.get(), timestamp));
+	}
+};
+
+} // namespace io
+} // namespace libcaer
+
+#endif /* LIBCAER_IO_FILE_READER_HPP_ */
@@ -0,0 +1,145 @@
+#ifndef LIBCAER_IO_FILE_WRITER_HPP_
+#define LIBCAER_IO_FILE_WRITER_HPP_
+
+#include "../events/packetContainer.hpp"
+
+#include <libcaer/io/file_writer.h>
+
+#include <memory>
+#include <string>
+
+namespace libcaer {
+namespace io {
+
+class FileWriter {
+private:
+	struct WriterDeleter {
+		void operator()(caerFileWriter w) const noexcept {
+			// Write remaining data and free all memory. Errors cannot
+			// be reported from here, use close() to check for them.
+			caerFileWriterClose(w);
+		}
+	};
+
+	std::unique_ptr<struct caer_file_writer, WriterDeleter> handle;
+
+	// Keeps the written container alive until the writer is done with it.
+	// The C container only references its packets, so only its own memory
+	// is freed afterwards, not the packets'.
+	struct WriteContext {
+		std::shared_ptr<const libcaer::events::EventPacketContainer> container;
+		caerEventPacketContainer cContainer;
+	};
+
+	static void writeContextDone(void *writeContextPtr) {
+		WriteContext *context = static_cast<WriteContext *>(writeContextPtr);
+
+		caerFree(context->cContainer);
+		delete context;
+	}
+
+public:
+	FileWriter(int fileDescriptor, int16_t sourceID = 1, const std::string &sourceDescription = std::string(),
+		size_t queueSize = 0) {
+		caerFileWriter w = caerFileWriterOpen(fileDescriptor, sourceID,
+			(sourceDescription.empty()) ? (nullptr) : (sourceDescription.c_str()), queueSize);
+
+		// Handle constructor failure.
+		if (w == nullptr) {
+			std::string exc = "Failed to open AEDAT file writer, fileDescriptor=" + std::to_string(fileDescriptor)
+							  + ", queueSize=" + std::to_string(queueSize) + ".";
+			throw std::runtime_error(exc);
+		}
+
+		handle = std::unique_ptr<struct caer_file_writer, WriterDeleter>(w);
+	}
+
+	~FileWriter() = default;
+
+	// The writer owns its queue and thread, so it can only be moved.
+	FileWriter(const FileWriter &rhs)            = delete;
+	FileWriter &operator=(const FileWriter &rhs) = delete;
+	FileWriter(FileWriter &&rhs)                 = default;
+	FileWriter &operator=(FileWriter &&rhs)      = default;
+
+	std::string toString() const noexcept {
+		return ("AEDAT File Writer");
+	}
+
+	/**
+	 * Write a packet container. The container is kept alive until it has
+	 * been written, so with a background writer thread this returns right
+	 * away, but the container's packets must not be modified in the meantime.
+	 *
+	 * @param container the packet container to write.
+	 */
+	void write(std::shared_ptr<const libcaer::events::EventPacketContainer> container) const {
+		if ((container == nullptr) || container->empty()) {
+			return;
+		}
+
+		caerEventPacketContainer cContainer = caerEventPacketContainerAllocate(container->size());
+		if (cContainer == nullptr) {
+			throw std::runtime_error(toString() + ": failed to allocate packet container.");
+		}
+
+		for (libcaer::events::EventPacketContainer::size_type i = 0; i < container->size(); i++) {
+			auto packet = container->getEventPacket(i);
+
+			if (packet != nullptr) {
+				caerEventPacketContainerSetEventPacket(
+					cContainer, i, const_cast<caerEventPacketHeader>(packet->getHeaderPointer()));
+			}
+		}
+
+		WriteContext *context = new WriteContext{container, cContainer};
+
+		bool success = caerFileWriterWriteNotify(handle.get(), cContainer, &writeContextDone, context);
+		if (!success) {
+			writeContextDone(context);
+
+			throw std::runtime_error(toString() + ": failed to write packet container.");
+		}
+	}
+
+	/**
+	 * Write a packet container, handing it over to the writer, which frees
+	 * it once written. No copies or references are needed, so this is the
+	 * cheapest way to write containers that are not used afterwards.
+	 * If writing fails, the container is left untouched.
+	 *
+	 * @param container the packet container to write.
+	 */
+	void write(libcaer::events::EventPacketContainerUnique &&container) const {
+		if (!container || container.empty()) {
+			return;
+		}
+
+		bool success = caerFileWriterWrite(handle.get(), container.get());
+		if (!success) {
+			throw std::runtime_error(toString() + ": failed to write packet container.");
+		}
+
+		// Ownership went to the writer.
+		container.release();
+	}
+
+	struct caer_file_writer_statistics statistics() const noexcept {
+		return (caerFileWriterStatisticsGet(handle.get()));
+	}
+
+	/**
+	 * Write any remaining queued data and close the writer.
+	 * No further writes are possible afterwards.
+	 */
+	void close() {
+		if (!caerFileWriterClose(handle.release())) {
+			throw std::runtime_error(toString() + ": failed to write all data.");
+		}
+	}
+};
+
+} // namespace io
+} // namespace libcaer
+
+#endif /* LIBCAER_IO_FILE_WRITER_HPP_ */
@@ -0,0 +1,125 @@
+#ifndef LIBCAER_IO_NETWORK_CLIENT_HPP_
+#define LIBCAER_IO_NETWORK_CLIENT_HPP_
+
+#include "../events/packetContainer.hpp"
+
+#include <libcaer/io/network_client.h>
+
+#include <memory>
+#include <string>
+
+namespace libcaer {
+namespace io {
+
+class NetworkClient {
+private:
+	struct ClientDeleter {
+		void operator()(caerNetworkClient c) const noexcept {
+			caerNetworkClientClose(c);
+		}
+	};
+
+	std::unique_ptr<struct caer_network_client, ClientDeleter> handle;
+
+	NetworkClient(caerNetworkClient c, const std::string &description) {
+		// Handle constructor failure.
+		if (c == nullptr) {
+			std::string exc = "Failed to open AEDAT network client, " + description + ".";
+			throw std::runtime_error(exc);
+		}
+
+		handle = std::unique_ptr<struct caer_network_client, ClientDeleter>(c);
+	}
+
+public:
+	/**
+	 * Connect to a TCP server.
+	 * See caerNetworkClientOpenTCP() for details.
+	 */
+	static NetworkClient openTCP(const std::string &remoteAddress, uint16_t remotePort) {
+		return (NetworkClient(caerNetworkClientOpenTCP(remoteAddress.c_str(), remotePort),
+			"TCP, remoteAddress=" + remoteAddress + ", remotePort=" + std::to_string(remotePort)));
+	}
+
+	/**
+	 * Start receiving UDP datagrams.
+	 * See caerNetworkClientOpenUDP() for details.
+	 */
+	static NetworkClient openUDP(const std::string &localAddress, uint16_t localPort) {
+		return (NetworkClient(
+			caerNetworkClientOpenUDP((localAddress.empty()) ? (nullptr) : (localAddress.c_str()), localPort),
+			"UDP, localAddress=" + localAddress + ", localPort=" + std::to_string(localPort)));
+	}
+
+	~NetworkClient() = default;
+
+	// The client owns its socket and buffers, so it can only be moved.
+	NetworkClient(const NetworkClient &rhs)            = delete;
+	NetworkClient &operator=(const NetworkClient &rhs) = delete;
+	NetworkClient(NetworkClient &&rhs)                 = default;
+	NetworkClient &operator=(NetworkClient &&rhs)      = default;
+
+	std::string toString() const noexcept {
+		return ("AEDAT Network Client");
+	}
+
+	uint16_t port() const noexcept {
+		return (caerNetworkClientGetPort(handle.get()));
+	}
+
+	int16_t sourceID() const noexcept {
+		return (caerNetworkClientGetSourceID(handle.get()));
+	}
+
+	bool isConnected() const noexcept {
+		return (caerNetworkClientIsConnected(handle.get()));
+	}
+
+	/**
+	 * Get the next container of received event packets.
+	 * See caerNetworkClientReceive() for details.
+	 *
+	 * @param timeoutMs maximum time to wait for data, in milliseconds.
+	 *
+	 * @return a packet container, or nullptr if none is available.
+	 */
+	std::unique_ptr<libcaer::events::EventPacketContainer> receive(int32_t timeoutMs) const {
+		caerEventPacketContainer cContainer = caerNetworkClientReceive(handle.get(), timeoutMs);
+		if (cContainer == nullptr) {
+			// NULL return means no data, forward that.
+			return (nullptr);
+		}
+
+		std::unique_ptr<libcaer::events::EventPacketContainer> cppContainer
+			= std::unique_ptr<libcaer::events::EventPacketContainer>(
+				new libcaer::events::EventPacketContainer(cContainer));
+
+		// Free original C container. The event packet memory is now managed by
+		// the EventPacket classes inside the new C++ EventPacketContainer.
+		caerFree(cContainer);
+
+		return (cppContainer);
+	}
+
+	/**
+	 * Get the next container of received event packets, like receive(),
+	 * but without wrapping each packet into a shared EventPacket.
+	 *
+	 * @param timeoutMs maximum time to wait for data, in milliseconds.
+	 *
+	 * @return a packet container, converting to false if none is available.
+	 */
+	libcaer::events::EventPacketContainerUnique receiveUnique(int32_t timeoutMs) const {
+		// NULL return means no data, forward that as an empty container.
+		return (libcaer::events::EventPacketContainerUnique(caerNetworkClientReceive(handle.get(), timeoutMs)));
+	}
+
+	struct caer_network_client_statistics statistics() const noexcept {
+		return (caerNetworkClientStatisticsGet(handle.get()));
+	}
+};
+
+} // namespace io
+} // namespace libcaer
+
+#endif /* LIBCAER_IO_NETWORK_CLIENT_HPP_ */
@@ -0,0 +1,168 @@
+#ifndef LIBCAER_IO_NETWORK_SERVER_HPP_
+#define LIBCAER_IO_NETWORK_SERVER_HPP_
+
+#include "../events/packetContainer.hpp"
+
+#include <libcaer/io/network_server.h>
+
+#include <memory>
+#include <string>
+
+namespace libcaer {
+namespace io {
+
+class NetworkServer {
+private:
+	struct ServerDeleter {
+		void operator()(caerNetworkServer s) const noexcept {
+			caerNetworkServerClose(s);
+		}
+	};
+
+	std::unique_ptr<struct caer_network_server, ServerDeleter> handle;
+
+	// Keeps the sent container alive until the server is done with it.
+	// The C container only references its packets, so only its own memory
+	// is freed afterwards, not the packets'.
+	struct SendContext {
+		std::shared_ptr<const libcaer::events::EventPacketContainer> container;
+		caerEventPacketContainer cContainer;
+	};
+
+	static void sendContextDone(void *sendContextPtr) {
+		SendContext *context = static_cast<SendContext *>(sendContextPtr);
+
+		caerFree(context->cContainer);
+		delete context;
+	}
+
+	NetworkServer(caerNetworkServer s, const std::string &description) {
+		// Handle constructor failure.
+		if (s == nullptr) {
+			std::string exc = "Failed to open AEDAT network server, " + description + ".";
+			throw std::runtime_error(exc);
+		}
+
+		handle = std::unique_ptr<struct caer_network_server, ServerDeleter>(s);
+	}
+
+public:
+	/**
+	 * Start a TCP server, listening for clients.
+	 * See caerNetworkServerOpenTCP() for details.
+	 */
+	static NetworkServer openTCP(const std::string &localAddress, uint16_t localPort, int16_t sourceID = 1,
+		size_t maxClients = 8, size_t clientBufferSize = 0, bool zeroCopy = false) {
+		return (NetworkServer(caerNetworkServerOpenTCP((localAddress.empty()) ? (nullptr) : (localAddress.c_str()),
+								  localPort, sourceID, maxClients, clientBufferSize, zeroCopy),
+			"TCP, localAddress=" + localAddress + ", localPort=" + std::to_string(localPort)));
+	}
+
+	/**
+	 * Start sending UDP datagrams to a remote address.
+	 * See caerNetworkServerOpenUDP() for details.
+	 */
+	static NetworkServer openUDP(
+		const std::string &remoteAddress, uint16_t remotePort, int16_t sourceID = 1, size_t maxDatagramSize = 0) {
+		return (NetworkServer(
+			caerNetworkServerOpenUDP(remoteAddress.c_str(), remotePort, sourceID, maxDatagramSize),
+			"UDP, remoteAddress=" + remoteAddress + ", remotePort=" + std::to_string(remotePort)));
+	}
+
+	~NetworkServer() = default;
+
+	// The server owns its sockets, so it can only be moved.
+	NetworkServer(const NetworkServer &rhs)            = delete;
+	NetworkServer &operator=(const NetworkServer &rhs) = delete;
+	NetworkServer(NetworkServer &&rhs)                 = default;
+	NetworkServer &operator=(NetworkServer &&rhs)      = default;
+
+	std::string toString() const noexcept {
+		return ("AEDAT Network Server");
+	}
+
+	uint16_t port() const noexcept {
+		return (caerNetworkServerGetPort(handle.get()));
+	}
+
+	size_t clientsNumber() const noexcept {
+		return (caerNetworkServerGetClientsNumber(handle.get()));
+	}
+
+	/**
+	 * Send all non-empty event packets of a container.
+	 * See caerNetworkServerSend() for details.
+	 *
+	 * @param container the packet container to send.
+	 */
+	void send(const libcaer::events::EventPacketContainer &container) const {
+		if (container.empty()) {
+			return;
+		}
+
+		// Temporary C container only referencing the packets.
+		std::unique_ptr<struct caer_event_packet_container, decltype(&caerFree)> cContainer(
+			caerEventPacketContainerAllocate(container.size()), &caerFree);
+		if (cContainer == nullptr) {
+			throw std::runtime_error(toString() + ": failed to allocate packet container.");
+		}
+
+		for (libcaer::events::EventPacketContainer::size_type i = 0; i < container.size(); i++) {
+			auto packet = container.getEventPacket(i);
+
+			if (packet != nullptr) {
+				caerEventPacketContainerSetEventPacket(
+					cContainer.get(), i, const_cast<caerEventPacketHeader>(packet->getHeaderPointer()));
+			}
+		}
+
+		if (!caerNetworkServerSend(handle.get(), cContainer.get())) {
+			throw std::runtime_error(toString() + ": failed to send packet container.");
+		}
+	}
+
+	/**
+	 * Send all non-empty event packets of a container, keeping it alive
+	 * until the server is done with it, which allows zero-copy sends.
+	 * The container's packets must not be modified in the meantime.
+	 * See caerNetworkServerSendNotify() for details.
+	 *
+	 * @param container the packet container to send.
+	 */
+	void send(std::shared_ptr<const libcaer::events::EventPacketContainer> container) const {
+		if ((container == nullptr) || container->empty()) {
+			return;
+		}
+
+		caerEventPacketContainer cContainer = caerEventPacketContainerAllocate(container->size());
+		if (cContainer == nullptr) {
+			throw std::runtime_error(toString() + ": failed to allocate packet container.");
+		}
+
+		for (libcaer::events::EventPacketContainer::size_type i = 0; i < container->size(); i++) {
+			auto packet = container->getEventPacket(i);
+
+			if (packet != nullptr) {
+				caerEventPacketContainerSetEventPacket(
+					cContainer, i, const_cast<caerEventPacketHeader>(packet->getHeaderPointer()));
+			}
+		}
+
+		SendContext *context = new SendContext{container, cContainer};
+
+		if (!caerNetworkServerSendNotify(handle.get(), cContainer, &sendContextDone, context)) {
+			sendContextDone(context);
+
+			throw std::runtime_error(toString() + ": failed to send packet container.");
+		}
+	}
+
+	struct caer_network_server_statistics statistics() const noexcept {
+		return (caerNetworkServerStatisticsGet(handle.get()));
+	}
+};
+
+} // namespace io
+} // namespace libcaer
+
+#endif /* LIBCAER_IO_NETWORK_SERVER_HPP_ */
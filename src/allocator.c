@@ -0,0 +1,329 @@
+#include "libcaer/libcaer.h"
+
+#include "libcaer/events/common.h"
+
+#include <stdatomic.h>
+
+#if defined(__linux__)
+#	include <sys/mman.h>
+#endif
+
+#define ALLOCATOR_NAME "Allocator"
+
+#define HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+struct caer_allocator {
+	caerAllocatorAlloc alloc;
+	caerAllocatorRealloc realloc;
+	caerAllocatorFree free;
+	void *user;
+};
+
+// Custom allocator, if any. NULL means malloc()/realloc()/free().
+// Set allocators are never changed nor freed, as other threads may still be
+// calling through them: a new one is installed by swapping the pointer.
+static atomic_uintptr_t currentAllocator = ATOMIC_VAR_INIT(0);
+
+// Frame packet arena: 2 MB chunks, each allocation takes a run of
+// consecutive chunks. Runs are only searched under the lock, the
+// memory itself is published last and never changes afterwards.
+static struct {
+	uint8_t *memory;
+	size_t chunksNumber;
+	// Number of chunks of the allocation starting at each chunk, 0 if none.
+	uint32_t *runs;
+	// Whether each chunk is part of an allocation.
+	bool *used;
+	atomic_flag lock;
+} frameArena = {NULL, 0, NULL, NULL, ATOMIC_FLAG_INIT};
+
+static atomic_uintptr_t frameArenaMemory = ATOMIC_VAR_INIT(0);
+static atomic_bool frameArenaSetup      = ATOMIC_VAR_INIT(false);
+
+static inline const struct caer_allocator *allocatorGet(void) {
+	return ((const struct caer_allocator *) atomic_load_explicit(&currentAllocator, memory_order_acquire));
+}
+
+bool caerSetAllocator(
+	caerAllocatorAlloc allocFunc, caerAllocatorRealloc reallocFunc, caerAllocatorFree freeFunc, void *user) {
+	if ((allocFunc == NULL) && (reallocFunc == NULL) && (freeFunc == NULL)) {
+		atomic_store_explicit(&currentAllocator, (uintptr_t) NULL, memory_order_release);
+		return (true);
+	}
+
+	if ((allocFunc == NULL) || (reallocFunc == NULL) || (freeFunc == NULL)) {
+		caerLog(CAER_LOG_ERROR, ALLOCATOR_NAME, "Allocator functions must be either all set or all NULL.");
+		return (false);
+	}
+
+	struct caer_allocator *allocator = malloc(sizeof(struct caer_allocator));
+	if (allocator == NULL) {
+		caerLog(CAER_LOG_ERROR, ALLOCATOR_NAME, "Failed to allocate memory for allocator.");
+		return (false);
+	}
+
+	allocator->alloc   = allocFunc;
+	allocator->realloc = reallocFunc;
+	allocator->free    = freeFunc;
+	allocator->user    = user;
+
+	atomic_store_explicit(&currentAllocator, (uintptr_t) allocator, memory_order_release);
+
+	return (true);
+}
+
+void *caerMalloc(size_t size) {
+	const struct caer_allocator *allocator = allocatorGet();
+
+	if (allocator == NULL) {
+		return (malloc(size));
+	}
+
+	return ((*allocator->alloc)(size, allocator->user));
+}
+
+void *caerCalloc(size_t nmemb, size_t size) {
+	const struct caer_allocator *allocator = allocatorGet();
+
+	if (allocator == NULL) {
+		return (calloc(nmemb, size));
+	}
+
+	if ((nmemb != 0) && (size > (SIZE_MAX / nmemb))) {
+		return (NULL);
+	}
+
+	void *memory = (*allocator->alloc)(nmemb * size, allocator->user);
+	if (memory != NULL) {
+		memset(memory, 0, nmemb * size);
+	}
+
+	return (memory);
+}
+
+static inline void frameArenaLock(void) {
+	while (atomic_flag_test_and_set_explicit(&frameArena.lock, memory_order_acquire)) {
+		;
+	}
+}
+
+static inline void frameArenaUnlock(void) {
+	atomic_flag_clear_explicit(&frameArena.lock, memory_order_release);
+}
+
+static inline bool frameArenaContains(const void *ptr) {
+	const uint8_t *memory = (const uint8_t *) atomic_load_explicit(&frameArenaMemory, memory_order_acquire);
+
+	return ((memory != NULL) && ((const uint8_t *) ptr >= memory)
+			&& ((const uint8_t *) ptr < (memory + (frameArena.chunksNumber * HUGEPAGE_SIZE))));
+}
+
+// Take a run of free chunks big enough for size, first-fit. Not zeroed.
+static void *frameArenaAlloc(size_t size) {
+	if (atomic_load_explicit(&frameArenaMemory, memory_order_acquire) == 0) {
+		return (NULL);
+	}
+
+	size_t chunks = (size + HUGEPAGE_SIZE - 1) / HUGEPAGE_SIZE;
+	if ((chunks == 0) || (chunks > frameArena.chunksNumber)) {
+		return (NULL);
+	}
+
+	void *memory = NULL;
+
+	frameArenaLock();
+
+	size_t freeRun = 0;
+
+	for (size_t i = 0; i < frameArena.chunksNumber; i++) {
+		freeRun = (frameArena.used[i]) ? (0) : (freeRun + 1);
+
+		if (freeRun == chunks) {
+			size_t start = i + 1 - chunks;
+
+			memset(&frameArena.used[start], true, chunks * sizeof(bool));
+			frameArena.runs[start] = (uint32_t) chunks;
+
+			memory = frameArena.memory + (start * HUGEPAGE_SIZE);
+			break;
+		}
+	}
+
+	frameArenaUnlock();
+
+	return (memory);
+}
+
+static void frameArenaFree(void *ptr) {
+	size_t start = (size_t) ((uint8_t *) ptr - frameArena.memory) / HUGEPAGE_SIZE;
+
+	frameArenaLock();
+
+	memset(&frameArena.used[start], false, frameArena.runs[start] * sizeof(bool));
+	frameArena.runs[start] = 0;
+
+	frameArenaUnlock();
+}
+
+static void *frameArenaRealloc(void *ptr, size_t size) {
+	size_t start = (size_t) ((uint8_t *) ptr - frameArena.memory) / HUGEPAGE_SIZE;
+
+	frameArenaLock();
+	size_t oldSize = frameArena.runs[start] * (size_t) HUGEPAGE_SIZE;
+	frameArenaUnlock();
+
+	// Shrinking, or growing within the last chunk, keeps the memory.
+	if (size <= oldSize) {
+		return (ptr);
+	}
+
+	void *memory = frameArenaAlloc(size);
+	if (memory == NULL) {
+		memory = caerMalloc(size);
+		if (memory == NULL) {
+			return (NULL);
+		}
+	}
+
+	memcpy(memory, ptr, oldSize);
+	frameArenaFree(ptr);
+
+	return (memory);
+}
+
+void *caerRealloc(void *ptr, size_t size) {
+	if (ptr == NULL) {
+		return (caerMalloc(size));
+	}
+
+	if (frameArenaContains(ptr)) {
+		return (frameArenaRealloc(ptr, size));
+	}
+
+	const struct caer_allocator *allocator = allocatorGet();
+
+	if (allocator == NULL) {
+		return (realloc(ptr, size));
+	}
+
+	return ((*allocator->realloc)(ptr, size, allocator->user));
+}
+
+void caerFree(void *ptr) {
+	if (ptr == NULL) {
+		return;
+	}
+
+	if (frameArenaContains(ptr)) {
+		frameArenaFree(ptr);
+		return;
+	}
+
+	const struct caer_allocator *allocator = allocatorGet();
+
+	if (allocator == NULL) {
+		free(ptr);
+		return;
+	}
+
+	(*allocator->free)(ptr, allocator->user);
+}
+
+void *caerEventPacketMemoryAllocate(int16_t eventType, size_t size) {
+	if (eventType == FRAME_EVENT) {
+		void *memory = frameArenaAlloc(size);
+
+		if (memory != NULL) {
+			// Chunks are reused, clear them like calloc() would.
+			memset(memory, 0, size);
+			return (memory);
+		}
+	}
+
+	return (caerCalloc(1, size));
+}
+
+bool caerSetFrameHugepageArena(size_t size) {
+#if defined(__linux__)
+	if ((size == 0) || (size > (SIZE_MAX - (2 * HUGEPAGE_SIZE)))) {
+		caerLog(CAER_LOG_ERROR, ALLOCATOR_NAME, "Invalid frame hugepage arena size %zu.", size);
+		return (false);
+	}
+
+	if (atomic_exchange(&frameArenaSetup, true)) {
+		caerLog(CAER_LOG_ERROR, ALLOCATOR_NAME, "Frame hugepage arena already enabled.");
+		return (false);
+	}
+
+	size_t chunksNumber = (size + HUGEPAGE_SIZE - 1) / HUGEPAGE_SIZE;
+	size_t arenaSize    = chunksNumber * HUGEPAGE_SIZE;
+
+	uint32_t *runs = calloc(chunksNumber, sizeof(uint32_t));
+	bool *used     = calloc(chunksNumber, sizeof(bool));
+	if ((runs == NULL) || (used == NULL)) {
+		free(runs);
+		free(used);
+		atomic_store(&frameArenaSetup, false);
+
+		caerLog(CAER_LOG_ERROR, ALLOCATOR_NAME, "Failed to allocate frame hugepage arena metadata.");
+		return (false);
+	}
+
+	// Explicit hugepages, if the system has enough of them reserved.
+	uint8_t *memory = mmap(NULL, arenaSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+	if (memory == MAP_FAILED) {
+		// Else transparent hugepages: map more to align the arena to 2 MB,
+		// and give back what is not needed.
+		uint8_t *mapping
+			= mmap(NULL, arenaSize + HUGEPAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapping == MAP_FAILED) {
+			free(runs);
+			free(used);
+			atomic_store(&frameArenaSetup, false);
+
+			caerLog(CAER_LOG_ERROR, ALLOCATOR_NAME, "Failed to map %zu bytes for frame hugepage arena. Error: %d.",
+				arenaSize, errno);
+			return (false);
+		}
+
+		memory = (uint8_t *) (((uintptr_t) mapping + HUGEPAGE_SIZE - 1) & ~((uintptr_t) HUGEPAGE_SIZE - 1));
+
+		size_t head = (size_t) (memory - mapping);
+
+		if (head > 0) {
+			munmap(mapping, head);
+		}
+
+		if (head < HUGEPAGE_SIZE) {
+			munmap(memory + arenaSize, HUGEPAGE_SIZE - head);
+		}
+
+		if (madvise(memory, arenaSize, MADV_HUGEPAGE) != 0) {
+			caerLog(CAER_LOG_WARNING, ALLOCATOR_NAME,
+				"Failed to enable transparent hugepages for frame hugepage arena. Error: %d.", errno);
+		}
+
+		caerLog(CAER_LOG_INFO, ALLOCATOR_NAME, "Frame hugepage arena of %zu bytes uses transparent hugepages.",
+			arenaSize);
+	}
+	else {
+		caerLog(CAER_LOG_INFO, ALLOCATOR_NAME, "Frame hugepage arena of %zu bytes uses explicit hugepages.",
+			arenaSize);
+	}
+
+	frameArena.memory       = memory;
+	frameArena.chunksNumber = chunksNumber;
+	frameArena.runs         = runs;
+	frameArena.used         = used;
+
+	atomic_store_explicit(&frameArenaMemory, (uintptr_t) memory, memory_order_release);
+
+	return (true);
+#else
+	(void) (size);
+
+	caerLog(CAER_LOG_ERROR, ALLOCATOR_NAME, "Frame hugepage arena is only supported on Linux.");
+	return (false);
+#endif
+}
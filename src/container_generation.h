@@ -3,6 +3,7 @@
 
 #include "libcaer/libcaer.h"
 
+#include "libcaer/events/polarityColumns.h"
 #include "libcaer/events/special.h"
 
 #include "data_exchange.h"
@@ -12,6 +13,7 @@ struct container_generation {
 	caerEventPacketContainer currentPacketContainer;
 	atomic_uint_fast32_t maxPacketContainerPacketSize;
 	atomic_uint_fast32_t maxPacketContainerInterval;
+	atomic_bool polarityColumns;
 	int64_t currentPacketContainerCommitTimestamp;
 };
 
@@ -22,6 +24,16 @@ static inline void containerGenerationSettingsInit(containerGeneration state) {
 	// By default governed by time only, set at 10 milliseconds.
 	atomic_store(&state->maxPacketContainerPacketSize, 0);
 	atomic_store(&state->maxPacketContainerInterval, 10000);
+
+	// Polarity events in the usual packed layout.
+	atomic_store(&state->polarityColumns, false);
+}
+
+// Take over the packet settings of 'state', for an offline translator.
+static inline void containerGenerationSettingsCopy(containerGeneration copy, containerGeneration state) {
+	atomic_store(&copy->maxPacketContainerPacketSize, atomic_load(&state->maxPacketContainerPacketSize));
+	atomic_store(&copy->maxPacketContainerInterval, atomic_load(&state->maxPacketContainerInterval));
+	atomic_store(&copy->polarityColumns, atomic_load(&state->polarityColumns));
 }
 
 static inline void containerGenerationDestroy(containerGeneration state) {
@@ -74,6 +86,42 @@ static inline void containerGenerationCommitTimestampInit(containerGeneration st
 	}
 }
 
+// Move the time related commit limit past the current timestamp. Done on every
+// commit, and by offline translator scans, which follow commits without doing them.
+static inline void containerGenerationCommitTimestampAdvance(
+	containerGeneration state, int32_t tsWrapOverflow, int32_t tsCurrent) {
+	while (containerGenerationIsCommitTimestampElapsed(state, tsWrapOverflow, tsCurrent)) {
+		state->currentPacketContainerCommitTimestamp += containerGenerationGetMaxInterval(state);
+	}
+}
+
+// Replace all polarity packets in the container with columnar ones.
+static inline void containerGenerationPolarityColumns(
+	containerGeneration state, const char *deviceString, uint8_t deviceLogLevel) {
+	for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(state->currentPacketContainer); i++) {
+		caerEventPacketHeader packet = caerEventPacketContainerGetEventPacket(state->currentPacketContainer, i);
+
+		if ((packet == NULL) || (caerEventPacketHeaderGetEventType(packet) != POLARITY_EVENT)) {
+			continue;
+		}
+
+		caerPolarityColumnsEventPacket columns = NULL;
+
+		if (caerEventPacketHeaderGetEventValid(packet) > 0) {
+			columns = caerPolarityColumnsEventPacketFromPolarity((caerPolarityEventPacketConst) packet);
+			if (columns == NULL) {
+				// Keep the packed layout then, no data is lost.
+				commonLog(CAER_LOG_ERROR, deviceString, deviceLogLevel,
+					"Failed to allocate polarity columns event packet.");
+				continue;
+			}
+		}
+
+		caerEventPacketContainerSetEventPacket(state->currentPacketContainer, i, (caerEventPacketHeader) columns);
+		caerEventPacketFree(packet);
+	}
+}
+
 static inline void containerGenerationExecute(containerGeneration state, bool emptyContainerCommit, bool tsReset,
 	int32_t tsWrapOverflow, int32_t tsCurrent, dataExchange dataState, atomic_uint_fast32_t *transfersRunning,
 	int16_t deviceId, const char *deviceString, atomic_uint_fast8_t *deviceLogLevelAtomic) {
@@ -82,11 +130,7 @@ static inline void containerGenerationExecute(containerGeneration state, bool em
 	// If the commit was triggered by a packet container limit being reached, we always
 	// update the time related limit. The size related one is updated implicitly by size
 	// being reset to zero after commit (new packets are empty).
-	if (containerGenerationIsCommitTimestampElapsed(state, tsWrapOverflow, tsCurrent)) {
-		while (containerGenerationIsCommitTimestampElapsed(state, tsWrapOverflow, tsCurrent)) {
-			state->currentPacketContainerCommitTimestamp += containerGenerationGetMaxInterval(state);
-		}
-	}
+	containerGenerationCommitTimestampAdvance(state, tsWrapOverflow, tsCurrent);
 
 	// Filter out completely empty commits. This can happen when data is turned off,
 	// but the timestamps are still going forward.
@@ -95,6 +139,10 @@ static inline void containerGenerationExecute(containerGeneration state, bool em
 		state->currentPacketContainer = NULL;
 	}
 	else {
+		if (atomic_load_explicit(&state->polarityColumns, memory_order_relaxed)) {
+			containerGenerationPolarityColumns(state, deviceString, deviceLogLevel);
+		}
+
 		if (!dataExchangePut(dataState, state->currentPacketContainer)) {
 			// Failed to forward packet container, just drop it, it doesn't contain
 			// any critical information anyway.
@@ -157,6 +205,10 @@ static inline bool containerGenerationConfigSet(containerGeneration state, uint8
 			atomic_store(&state->maxPacketContainerInterval, param);
 			break;
 
+		case CAER_HOST_CONFIG_PACKETS_POLARITY_COLUMNS:
+			atomic_store(&state->polarityColumns, param);
+			break;
+
 		default:
 			return (false);
 			break;
@@ -175,6 +227,10 @@ static inline bool containerGenerationConfigGet(containerGeneration state, uint8
 			*param = U32T(atomic_load(&state->maxPacketContainerInterval));
 			break;
 
+		case CAER_HOST_CONFIG_PACKETS_POLARITY_COLUMNS:
+			*param = atomic_load(&state->polarityColumns);
+			break;
+
 		default:
 			return (false);
 			break;
@@ -6,6 +6,8 @@
 
 #include "libcaer/devices/device.h"
 
+#include "timestamps.h"
+
 #include <stdatomic.h>
 
 #if defined(HAVE_PTHREADS)
@@ -20,6 +22,11 @@ struct data_exchange {
 	atomic_bool blocking;
 	atomic_bool startProducers;
 	atomic_bool stopProducers;
+	// Raw capture mode (caer_device_raw_buffer elements instead of containers).
+	bool rawCaptureSupported;
+	atomic_bool rawCapture; // Only takes effect on DataStart() calls!
+	bool rawCaptureRunning;
+	uint64_t rawSequenceNumber;
 	void (*notifyDataIncrease)(void *ptr);
 	void (*notifyDataDecrease)(void *ptr);
 	void *notifyDataUserPtr;
@@ -32,6 +39,11 @@ static inline void dataExchangeSettingsInit(dataExchange state) {
 	atomic_store(&state->blocking, false);
 	atomic_store(&state->startProducers, true);
 	atomic_store(&state->stopProducers, true);
+	atomic_store(&state->rawCapture, false);
+}
+
+static inline void dataExchangeSetRawCaptureSupported(dataExchange state) {
+	state->rawCaptureSupported = true;
 }
 
 static inline bool dataExchangeBufferInit(dataExchange state) {
@@ -41,6 +53,10 @@ static inline bool dataExchangeBufferInit(dataExchange state) {
 		return (false);
 	}
 
+	// Raw capture mode is fixed for the duration of a data start/stop cycle.
+	state->rawCaptureRunning = atomic_load(&state->rawCapture);
+	state->rawSequenceNumber = 0;
+
 	return (true);
 }
 
@@ -51,21 +67,21 @@ static inline void dataExchangeDestroy(dataExchange state) {
 	}
 }
 
-static inline caerEventPacketContainer dataExchangeGet(dataExchange state, atomic_uint_fast32_t *transfersRunning) {
-	caerEventPacketContainer container = NULL;
-	uint32_t sleepCounter              = 0;
+static inline void *dataExchangeGetElement(dataExchange state, atomic_uint_fast32_t *transfersRunning) {
+	void *element         = NULL;
+	uint32_t sleepCounter = 0;
 
 retry:
-	container = caerRingBufferGet(state->buffer);
+	element = caerRingBufferGet(state->buffer);
 
-	if (container != NULL) {
-		// Found an event container, return it and signal this piece of data
-		// is no longer available for later acquisition.
+	if (element != NULL) {
+		// Found an event container (or raw buffer), return it and signal this
+		// piece of data is no longer available for later acquisition.
 		if (state->notifyDataDecrease != NULL) {
 			state->notifyDataDecrease(state->notifyDataUserPtr);
 		}
 
-		return (container);
+		return (element);
 	}
 
 	// Didn't find any event container, either report this or retry, depending
@@ -86,6 +102,23 @@ retry:
 	return (NULL);
 }
 
+static inline caerEventPacketContainer dataExchangeGet(dataExchange state, atomic_uint_fast32_t *transfersRunning) {
+	// No containers in raw capture mode, only raw buffers.
+	if (state->rawCaptureRunning) {
+		return (NULL);
+	}
+
+	return (dataExchangeGetElement(state, transfersRunning));
+}
+
+static inline caerDeviceRawBuffer dataExchangeGetRaw(dataExchange state, atomic_uint_fast32_t *transfersRunning) {
+	if (!state->rawCaptureRunning) {
+		return (NULL);
+	}
+
+	return (dataExchangeGetElement(state, transfersRunning));
+}
+
 static inline bool dataExchangePut(dataExchange state, caerEventPacketContainer container) {
 	if (!caerRingBufferPut(state->buffer, container)) {
 		return (false);
@@ -118,15 +151,63 @@ static inline void dataExchangePutForce(
 
 static inline void dataExchangeBufferEmpty(dataExchange state) {
 	// Empty ringbuffer.
-	caerEventPacketContainer container;
-	while ((container = caerRingBufferGet(state->buffer)) != NULL) {
+	void *element;
+	while ((element = caerRingBufferGet(state->buffer)) != NULL) {
 		// Notify data-not-available call-back.
 		if (state->notifyDataDecrease != NULL) {
 			state->notifyDataDecrease(state->notifyDataUserPtr);
 		}
 
-		// Free container, which will free its subordinate packets too.
-		caerEventPacketContainerFree(container);
+		if (state->rawCaptureRunning) {
+			// Raw buffers are one single allocation.
+			free(element);
+		}
+		else {
+			// Free container, which will free its subordinate packets too.
+			caerEventPacketContainerFree(element);
+		}
+	}
+}
+
+/**
+ * Copy a raw data buffer, tag it with the current host time and the next
+ * sequence number, and forward it. If the ring-buffer is full, the buffer
+ * is dropped, which shows up as a gap in the sequence numbers.
+ */
+static inline void dataExchangePutRaw(dataExchange state, const uint8_t *buffer, size_t bufferSize,
+	const char *deviceString, atomic_uint_fast8_t *deviceLogLevelAtomic) {
+	uint8_t deviceLogLevel = atomic_load_explicit(deviceLogLevelAtomic, memory_order_relaxed);
+
+	uint64_t sequenceNumber = state->rawSequenceNumber++;
+
+	struct timespec receiveTime;
+	portable_clock_gettime_monotonic(&receiveTime);
+
+	caerDeviceRawBuffer rawBuffer = malloc(sizeof(struct caer_device_raw_buffer) + bufferSize);
+	if (rawBuffer == NULL) {
+		commonLog(CAER_LOG_CRITICAL, deviceString, deviceLogLevel, "Failed to allocate raw data buffer.");
+		return;
+	}
+
+	rawBuffer->sequenceNumber = sequenceNumber;
+	rawBuffer->hostTimestamp  = (U64T(receiveTime.tv_sec) * 1000000000ULL) + U64T(receiveTime.tv_nsec);
+	rawBuffer->dataSize       = bufferSize;
+	rawBuffer->data           = (uint8_t *) (rawBuffer + 1);
+
+	memcpy(rawBuffer->data, buffer, bufferSize);
+
+	if (!caerRingBufferPut(state->buffer, rawBuffer)) {
+		commonLog(CAER_LOG_NOTICE, deviceString, deviceLogLevel,
+			"Dropped raw data buffer %" PRIu64 " because ring-buffer full! This means your processing loop is not "
+			"keeping up with new data ready to be read from caerDeviceDataGetRaw().",
+			sequenceNumber);
+
+		free(rawBuffer);
+		return;
+	}
+
+	if (state->notifyDataIncrease != NULL) {
+		state->notifyDataIncrease(state->notifyDataUserPtr);
 	}
 }
 
@@ -163,6 +244,14 @@ static inline bool dataExchangeConfigSet(dataExchange state, uint8_t paramAddr,
 			atomic_store(&state->stopProducers, param);
 			break;
 
+		case CAER_HOST_CONFIG_DATAEXCHANGE_RAW_CAPTURE:
+			if (!state->rawCaptureSupported) {
+				return (false);
+			}
+
+			atomic_store(&state->rawCapture, param);
+			break;
+
 		default:
 			return (false);
 			break;
@@ -189,6 +278,14 @@ static inline bool dataExchangeConfigGet(dataExchange state, uint8_t paramAddr,
 			*param = atomic_load(&state->stopProducers);
 			break;
 
+		case CAER_HOST_CONFIG_DATAEXCHANGE_RAW_CAPTURE:
+			if (!state->rawCaptureSupported) {
+				return (false);
+			}
+
+			*param = atomic_load(&state->rawCapture);
+			break;
+
 		default:
 			return (false);
 			break;
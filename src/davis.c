@@ -118,6 +118,16 @@ ssize_t davisFindFX3(caerDeviceDiscoveryResult *discoveredDevices) {
 	return (davisFindInternal(CAER_DEVICE_DAVIS_FX3, discoveredDevices));
 }
 
+bool davisFindSingleFX2(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice) {
+	return (usbDeviceFindSingle(device, DAVIS_FX2_REQUIRED_LOGIC_VERSION, DAVIS_FX2_REQUIRED_LOGIC_PATCH_LEVEL,
+		DAVIS_FX2_REQUIRED_FIRMWARE_VERSION, discoveredDevice, &populateDeviceInfo));
+}
+
+bool davisFindSingleFX3(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice) {
+	return (usbDeviceFindSingle(device, DAVIS_FX3_REQUIRED_LOGIC_VERSION, DAVIS_FX3_REQUIRED_LOGIC_PATCH_LEVEL,
+		DAVIS_FX3_REQUIRED_FIRMWARE_VERSION, discoveredDevice, &populateDeviceInfo));
+}
+
 static ssize_t davisFindInternal(uint16_t deviceType, caerDeviceDiscoveryResult *discoveredDevices) {
 	// Set to NULL initially (for error return).
 	*discoveredDevices = NULL;
@@ -228,6 +238,7 @@ static caerDeviceHandle davisOpenInternal(uint16_t deviceType, uint16_t deviceID
 
 	// Initialize state variables to default values (if not zero, taken care of by calloc above).
 	dataExchangeSettingsInit(&state->dataExchange);
+	dataExchangeSetRawCaptureSupported(&state->dataExchange);
 
 	// Packet settings (size (in events) and time interval (in µs)).
 	containerGenerationSettingsInit(&state->container);
@@ -355,6 +366,8 @@ bool davisClose(caerDeviceHandle cdh) {
 	davisLog(CAER_LOG_DEBUG, &handle->cHandle, "Shutdown successful.");
 
 	// Free memory.
+	dvsRemapDestroy(&handle->cHandle.state.dvs.remap);
+	dvsAccumulateDestroy(&handle->cHandle.state.dvs.accumulate);
 	free(handle->cHandle.info.deviceString);
 	free(handle);
 
@@ -454,6 +467,12 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 	return (davisCommonConfigGet(&handle->cHandle, modAddr, paramAddr, param));
 }
 
+bool davisDVSRemapSet(caerDeviceHandle cdh, const uint32_t *remapTable) {
+	davisHandle handle = (davisHandle) cdh;
+
+	return (davisCommonDVSRemapSet(&handle->cHandle, remapTable));
+}
+
 bool davisDataStart(caerDeviceHandle cdh, void (*dataNotifyIncrease)(void *ptr), void (*dataNotifyDecrease)(void *ptr),
 	void *dataNotifyUserPtr, void (*dataShutdownNotify)(void *ptr), void *dataShutdownUserPtr) {
 	davisHandle handle     = (davisHandle) cdh;
@@ -565,9 +584,254 @@ static void davisEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesS
 		return;
 	}
 
+	// Raw capture: forward the buffer as-is, decoding happens later, if ever.
+	if (handle->cHandle.state.dataExchange.rawCaptureRunning) {
+		dataExchangePutRaw(&handle->cHandle.state.dataExchange, buffer, bytesSent, handle->cHandle.info.deviceString,
+			&handle->cHandle.state.deviceLogLevel);
+		return;
+	}
+
 	davisCommonEventTranslator(&handle->cHandle, buffer, bytesSent, &handle->usbState.dataTransfersRun);
 }
 
+caerDeviceRawBuffer davisDataGetRaw(caerDeviceHandle cdh) {
+	davisHandle handle = (davisHandle) cdh;
+
+	return (dataExchangeGetRaw(&handle->cHandle.state.dataExchange, &handle->usbState.dataTransfersRun));
+}
+
+void *davisTranslatorOpen(caerDeviceHandle cdh, dataExchange *translatorDataExchange,
+	containerGeneration *translatorContainer, atomic_uint_fast8_t **translatorLogLevel) {
+	davisHandle handle = (davisHandle) cdh;
+
+	// Everything not set below starts out zeroed, like on a newly opened device.
+	davisHandle translator = calloc(1, sizeof(struct davis_handle));
+	if (translator == NULL) {
+		davisLog(CAER_LOG_CRITICAL, &handle->cHandle, "Failed to allocate offline translator.");
+		return (NULL);
+	}
+
+	char *translatorString = malloc(USB_INFO_STRING_SIZE);
+	if (translatorString == NULL) {
+		free(translator);
+
+		davisLog(CAER_LOG_CRITICAL, &handle->cHandle, "Failed to generate offline translator information string.");
+		return (NULL);
+	}
+
+	snprintf(translatorString, USB_INFO_STRING_SIZE, "%s (offline)", handle->cHandle.info.deviceString);
+
+	translator->cHandle.deviceType        = handle->cHandle.deviceType;
+	translator->cHandle.info              = handle->cHandle.info;
+	translator->cHandle.info.deviceString = translatorString;
+
+	// There is no device behind a translator: no USB transfers, the data
+	// path is always running, and control transfers fail (no device handle).
+	atomic_store(&translator->usbState.dataTransfersRun, TRANS_RUNNING);
+	translator->cHandle.spiConfigPtr = &translator->usbState;
+
+	// Only take over the decoding settings from the device, which may still
+	// be running. The decoding state starts out fresh, as on data start.
+	// Nothing can be sent back to the device, so APS auto-exposure and pixel
+	// filter auto-training stay disabled.
+	davisCommonState state       = &translator->cHandle.state;
+	davisCommonState deviceState = &handle->cHandle.state;
+
+	atomic_store(&state->deviceLogLevel, atomic_load(&deviceState->deviceLogLevel));
+
+	dataExchangeSettingsInit(&state->dataExchange);
+	containerGenerationSettingsCopy(&state->container, &deviceState->container);
+
+	state->dvs.sizeX    = deviceState->dvs.sizeX;
+	state->dvs.sizeY    = deviceState->dvs.sizeY;
+	state->dvs.invertXY = deviceState->dvs.invertXY;
+	dvsROISettingsCopy(&state->dvs.roi, &deviceState->dvs.roi);
+
+	// Shares the last remapping table set on the device.
+	dvsRemapCopy(&state->dvs.remap, &deviceState->dvs.remap);
+
+	// Own accumulation map, allocated on first use.
+	dvsAccumulateCopy(&state->dvs.accumulate, &deviceState->dvs.accumulate);
+
+	state->aps.sizeX    = deviceState->aps.sizeX;
+	state->aps.sizeY    = deviceState->aps.sizeY;
+	state->aps.invertXY = deviceState->aps.invertXY;
+	state->aps.flipX    = deviceState->aps.flipX;
+	state->aps.flipY    = deviceState->aps.flipY;
+	atomic_store(&state->aps.frame.mode, atomic_load(&deviceState->aps.frame.mode));
+
+	state->imu.flipX = deviceState->imu.flipX;
+	state->imu.flipY = deviceState->imu.flipY;
+	state->imu.flipZ = deviceState->imu.flipZ;
+
+	state->deviceClocks = deviceState->deviceClocks;
+
+	if (!davisCommonDataStart(&translator->cHandle, NULL, NULL, NULL)) {
+		dvsRemapDestroy(&state->dvs.remap);
+		free(translatorString);
+		free(translator);
+
+		davisLog(CAER_LOG_CRITICAL, &handle->cHandle, "Failed to initialize offline translator.");
+		return (NULL);
+	}
+
+	*translatorDataExchange = &state->dataExchange;
+	*translatorContainer    = &state->container;
+	*translatorLogLevel     = &state->deviceLogLevel;
+
+	return (translator);
+}
+
+void davisTranslatorProcess(void *translatorPtr, const uint8_t *buffer, size_t bufferSize) {
+	davisHandle translator = translatorPtr;
+
+	davisCommonEventTranslator(&translator->cHandle, buffer, bufferSize, &translator->usbState.dataTransfersRun);
+}
+
+void davisTranslatorScan(void *translatorPtr, const uint8_t *buffer, size_t bufferSize) {
+	davisHandle translator = translatorPtr;
+	davisCommonState state = &translator->cHandle.state;
+
+	// Hand out what was decoded so far, scanning generates no events.
+	davisCommonPacketsFlush(&translator->cHandle, &translator->usbState.dataTransfersRun);
+
+	state->scanOnly = true;
+	davisCommonEventTranslator(&translator->cHandle, buffer, bufferSize, &translator->usbState.dataTransfersRun);
+	state->scanOnly = false;
+}
+
+size_t davisTranslatorResync(void *translatorPtr, const uint8_t *buffer, size_t bufferSize) {
+	size_t syncPos = bufferSize;
+
+	// Stop right after the next timestamp wrap event (code 7).
+	for (size_t bufferPos = 0; (bufferPos + 1) < bufferSize; bufferPos += 2) {
+		uint16_t event = le16toh(*((const uint16_t *) (&buffer[bufferPos])));
+
+		if ((event & 0xF000) == 0x7000) {
+			syncPos = bufferPos + 2;
+			break;
+		}
+	}
+
+	davisTranslatorScan(translatorPtr, buffer, syncPos);
+
+	return (syncPos);
+}
+
+void davisTranslatorFlush(void *translatorPtr) {
+	davisHandle translator = translatorPtr;
+
+	davisCommonPacketsFlush(&translator->cHandle, &translator->usbState.dataTransfersRun);
+}
+
+size_t davisTranslatorStateSize(void *translatorPtr) {
+	davisHandle translator = translatorPtr;
+
+	return (sizeof(struct davis_translator_state) + apsFrameEventSize(&translator->cHandle.state));
+}
+
+void davisTranslatorStateGet(void *translatorPtr, uint8_t *stateBuffer) {
+	davisHandle translator = translatorPtr;
+	davisCommonState state = &translator->cHandle.state;
+
+	// Only what the event translator carries from one buffer to the next.
+	// Configuration, packets and data exchange are not part of the snapshot.
+	struct davis_translator_state saved;
+	memset(&saved, 0, sizeof(saved));
+
+	saved.timestampsWrapOverflow   = state->timestamps.wrapOverflow;
+	saved.timestampsWrapAdd        = state->timestamps.wrapAdd;
+	saved.timestampsLast           = state->timestamps.last;
+	saved.timestampsCurrent        = state->timestamps.current;
+	saved.containerCommitTimestamp = state->container.currentPacketContainerCommitTimestamp;
+
+	saved.dvsLastY = state->dvs.lastY;
+
+	saved.apsIgnoreEvents       = state->aps.ignoreEvents;
+	saved.apsGlobalShutter      = state->aps.globalShutter;
+	saved.apsCurrentReadoutType = state->aps.currentReadoutType;
+	memcpy(saved.apsCountX, state->aps.countX, sizeof(saved.apsCountX));
+	memcpy(saved.apsCountY, state->aps.countY, sizeof(saved.apsCountY));
+	saved.apsExpectedCountX                   = state->aps.expectedCountX;
+	saved.apsExpectedCountY                   = state->aps.expectedCountY;
+	saved.apsROITmpData                       = state->aps.roi.tmpData;
+	saved.apsROIUpdate                        = state->aps.roi.update;
+	saved.apsROIPositionX                     = state->aps.roi.positionX;
+	saved.apsROIPositionY                     = state->aps.roi.positionY;
+	saved.apsROISizeX                         = state->aps.roi.sizeX;
+	saved.apsROISizeY                         = state->aps.roi.sizeY;
+	saved.apsCDavisOffsetDirection            = state->aps.cDavisSupport.offsetDirection;
+	saved.apsCDavisOffset                     = state->aps.cDavisSupport.offset;
+	saved.apsAutoExposureTmpData              = state->aps.autoExposure.tmpData;
+	saved.apsAutoExposureCurrentFrameExposure = state->aps.autoExposure.currentFrameExposure;
+
+	saved.imuIgnoreEvents = state->imu.ignoreEvents;
+	saved.imuType         = state->imu.type;
+	saved.imuCount        = state->imu.count;
+	saved.imuTmpData      = state->imu.tmpData;
+	saved.imuAccelScale   = state->imu.accelScale;
+	saved.imuGyroScale    = state->imu.gyroScale;
+	saved.imuCurrentEvent = state->imu.currentEvent;
+
+	memcpy(stateBuffer, &saved, sizeof(saved));
+	memcpy(stateBuffer + sizeof(saved), state->aps.frame.currentEvent, apsFrameEventSize(state));
+}
+
+void davisTranslatorStateSet(void *translatorPtr, const uint8_t *stateBuffer) {
+	davisHandle translator = translatorPtr;
+	davisCommonState state = &translator->cHandle.state;
+
+	// The buffer may not be suitably aligned for the struct.
+	struct davis_translator_state saved;
+	memcpy(&saved, stateBuffer, sizeof(saved));
+
+	state->timestamps.wrapOverflow                         = saved.timestampsWrapOverflow;
+	state->timestamps.wrapAdd                              = saved.timestampsWrapAdd;
+	state->timestamps.last                                 = saved.timestampsLast;
+	state->timestamps.current                              = saved.timestampsCurrent;
+	state->container.currentPacketContainerCommitTimestamp = saved.containerCommitTimestamp;
+
+	state->dvs.lastY = saved.dvsLastY;
+
+	state->aps.ignoreEvents       = saved.apsIgnoreEvents;
+	state->aps.globalShutter      = saved.apsGlobalShutter;
+	state->aps.currentReadoutType = saved.apsCurrentReadoutType;
+	memcpy(state->aps.countX, saved.apsCountX, sizeof(state->aps.countX));
+	memcpy(state->aps.countY, saved.apsCountY, sizeof(state->aps.countY));
+	state->aps.expectedCountX                    = saved.apsExpectedCountX;
+	state->aps.expectedCountY                    = saved.apsExpectedCountY;
+	state->aps.roi.tmpData                       = saved.apsROITmpData;
+	state->aps.roi.update                        = saved.apsROIUpdate;
+	state->aps.roi.positionX                     = saved.apsROIPositionX;
+	state->aps.roi.positionY                     = saved.apsROIPositionY;
+	state->aps.roi.sizeX                         = saved.apsROISizeX;
+	state->aps.roi.sizeY                         = saved.apsROISizeY;
+	state->aps.cDavisSupport.offsetDirection     = saved.apsCDavisOffsetDirection;
+	state->aps.cDavisSupport.offset              = saved.apsCDavisOffset;
+	state->aps.autoExposure.tmpData              = saved.apsAutoExposureTmpData;
+	state->aps.autoExposure.currentFrameExposure = saved.apsAutoExposureCurrentFrameExposure;
+	memcpy(state->aps.frame.currentEvent, stateBuffer + sizeof(saved), apsFrameEventSize(state));
+
+	state->imu.ignoreEvents = saved.imuIgnoreEvents;
+	state->imu.type         = saved.imuType;
+	state->imu.count        = saved.imuCount;
+	state->imu.tmpData      = saved.imuTmpData;
+	state->imu.accelScale   = saved.imuAccelScale;
+	state->imu.gyroScale    = saved.imuGyroScale;
+	state->imu.currentEvent = saved.imuCurrentEvent;
+}
+
+void davisTranslatorClose(void *translatorPtr) {
+	davisHandle translator = translatorPtr;
+
+	davisCommonDataStop(&translator->cHandle);
+
+	dvsRemapDestroy(&translator->cHandle.state.dvs.remap);
+	dvsAccumulateDestroy(&translator->cHandle.state.dvs.accumulate);
+	free(translator->cHandle.info.deviceString);
+	free(translator);
+}
+
 //////////////////////////////////
 /// FX3 Debug Transfer Support ///
 //////////////////////////////////
@@ -34,9 +34,46 @@ struct davis_handle {
 
 typedef struct davis_handle *davisHandle;
 
+// Offline translator decoding state snapshot: plain data only, followed by
+// the APS frame currently being read out.
+struct davis_translator_state {
+	int32_t timestampsWrapOverflow;
+	int32_t timestampsWrapAdd;
+	int32_t timestampsLast;
+	int32_t timestampsCurrent;
+	int64_t containerCommitTimestamp;
+	uint16_t dvsLastY;
+	bool apsIgnoreEvents;
+	bool apsGlobalShutter;
+	uint16_t apsCurrentReadoutType;
+	uint16_t apsCountX[APS_READOUT_TYPES_NUM];
+	uint16_t apsCountY[APS_READOUT_TYPES_NUM];
+	uint16_t apsExpectedCountX;
+	uint16_t apsExpectedCountY;
+	uint16_t apsROITmpData;
+	uint16_t apsROIUpdate;
+	uint16_t apsROIPositionX;
+	uint16_t apsROIPositionY;
+	uint16_t apsROISizeX;
+	uint16_t apsROISizeY;
+	bool apsCDavisOffsetDirection;
+	int16_t apsCDavisOffset;
+	uint8_t apsAutoExposureTmpData;
+	uint32_t apsAutoExposureCurrentFrameExposure;
+	bool imuIgnoreEvents;
+	uint8_t imuType;
+	uint8_t imuCount;
+	uint8_t imuTmpData;
+	float imuAccelScale;
+	float imuGyroScale;
+	struct caer_imu6_event imuCurrentEvent;
+};
+
 ssize_t davisFindAll(caerDeviceDiscoveryResult *discoveredDevices);
 ssize_t davisFindFX2(caerDeviceDiscoveryResult *discoveredDevices);
 ssize_t davisFindFX3(caerDeviceDiscoveryResult *discoveredDevices);
+bool davisFindSingleFX2(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice);
+bool davisFindSingleFX3(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice);
 
 caerDeviceHandle davisOpenAll(
 	uint16_t deviceID, uint8_t busNumberRestrict, uint8_t devAddressRestrict, const char *serialNumberRestrict);
@@ -58,5 +95,18 @@ bool davisDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void *pt
 	void *dataShutdownUserPtr);
 bool davisDataStop(caerDeviceHandle handle);
 caerEventPacketContainer davisDataGet(caerDeviceHandle handle);
+caerDeviceRawBuffer davisDataGetRaw(caerDeviceHandle handle);
+bool davisDVSRemapSet(caerDeviceHandle handle, const uint32_t *remapTable);
+
+void *davisTranslatorOpen(caerDeviceHandle handle, dataExchange *translatorDataExchange,
+	containerGeneration *translatorContainer, atomic_uint_fast8_t **translatorLogLevel);
+void davisTranslatorProcess(void *translator, const uint8_t *buffer, size_t bufferSize);
+void davisTranslatorScan(void *translator, const uint8_t *buffer, size_t bufferSize);
+size_t davisTranslatorResync(void *translator, const uint8_t *buffer, size_t bufferSize);
+void davisTranslatorFlush(void *translator);
+size_t davisTranslatorStateSize(void *translator);
+void davisTranslatorStateGet(void *translator, uint8_t *stateBuffer);
+void davisTranslatorStateSet(void *translator, const uint8_t *stateBuffer);
+void davisTranslatorClose(void *translator);
 
 #endif /* LIBCAER_SRC_DAVIS_H_ */
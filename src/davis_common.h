@@ -9,6 +9,9 @@
 #include "autoexposure.h"
 #include "container_generation.h"
 #include "data_exchange.h"
+#include "dvs_accumulate.h"
+#include "dvs_remap.h"
+#include "dvs_roi.h"
 #include "libcaer/frame_utils.h"
 #include "spi_config_interface.h"
 
@@ -51,6 +54,8 @@ struct davis_common_state {
 	atomic_uint_fast8_t deviceLogLevel;
 	// Data Acquisition Thread -> Mainloop Exchange
 	struct data_exchange dataExchange;
+	// Offline translator scan: only follow the decoding state, generate no events.
+	bool scanOnly;
 	// Timestamp fields
 	struct timestamps_state_new_logic timestamps;
 	struct {
@@ -59,6 +64,12 @@ struct davis_common_state {
 		uint16_t sizeX;
 		uint16_t sizeY;
 		bool invertXY;
+		// Host-side region of interest, in output orientation.
+		struct dvs_roi roi;
+		// Per-pixel address remapping, in output orientation.
+		struct dvs_remap remap;
+		// Accumulation into count images or time surfaces, in output orientation.
+		struct dvs_accumulate accumulate;
 		struct {
 			atomic_bool autoTrainRunning;
 			caerFilterDVSNoise noiseFilter;
@@ -171,6 +182,7 @@ static bool davisCommonSendDefaultFPGAConfig(davisCommonHandle handle);
 static bool davisCommonSendDefaultChipConfig(davisCommonHandle handle);
 static bool davisCommonConfigSet(davisCommonHandle handle, int8_t modAddr, uint8_t paramAddr, uint32_t param);
 static bool davisCommonConfigGet(davisCommonHandle handle, int8_t modAddr, uint8_t paramAddr, uint32_t *param);
+static bool davisCommonDVSRemapSet(davisCommonHandle handle, const uint32_t *remapTable);
 static bool davisCommonDataStart(davisCommonHandle handle, void (*dataNotifyIncrease)(void *ptr),
 	void (*dataNotifyDecrease)(void *ptr), void *dataNotifyUserPtr);
 static void davisCommonDataStop(davisCommonHandle handle);
@@ -199,28 +211,28 @@ static inline void freeAllDataMemory(davisCommonState state) {
 	// already assigned to the current packet container, we
 	// free them separately from it.
 	if (state->currentPackets.polarity != NULL) {
-		free(&state->currentPackets.polarity->packetHeader);
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
 		state->currentPackets.polarity = NULL;
 
 		containerGenerationSetPacket(&state->container, POLARITY_EVENT, NULL);
 	}
 
 	if (state->currentPackets.special != NULL) {
-		free(&state->currentPackets.special->packetHeader);
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
 		state->currentPackets.special = NULL;
 
 		containerGenerationSetPacket(&state->container, SPECIAL_EVENT, NULL);
 	}
 
 	if (state->currentPackets.frame != NULL) {
-		free(&state->currentPackets.frame->packetHeader);
+		caerEventPacketFree(&state->currentPackets.frame->packetHeader);
 		state->currentPackets.frame = NULL;
 
 		containerGenerationSetPacket(&state->container, FRAME_EVENT, NULL);
 	}
 
 	if (state->currentPackets.imu6 != NULL) {
-		free(&state->currentPackets.imu6->packetHeader);
+		caerEventPacketFree(&state->currentPackets.imu6->packetHeader);
 		state->currentPackets.imu6 = NULL;
 
 		containerGenerationSetPacket(&state->container, IMU6_EVENT, NULL);
@@ -246,8 +258,20 @@ static inline void freeAllDataMemory(davisCommonState state) {
 #endif
 }
 
+static inline size_t apsFrameEventSize(davisCommonState state) {
+	size_t pixelsSize = sizeof(uint16_t) * (size_t) state->aps.sizeX * (size_t) state->aps.sizeY;
+
+	// '- sizeof(uint16_t)' to compensate for pixels[1] at end of struct for C++ compatibility.
+	return ((sizeof(struct caer_frame_event) - sizeof(uint16_t)) + pixelsSize);
+}
+
 static inline bool ensureSpaceForEvents(
 	caerEventPacketHeader *packet, size_t position, size_t numEvents, davisCommonHandle handle) {
+	// No packet while scanning, events are skipped.
+	if (*packet == NULL) {
+		return (false);
+	}
+
 	if ((position + numEvents) <= (size_t) caerEventPacketHeaderGetEventCapacity(*packet)) {
 		return (true);
 	}
@@ -548,6 +572,17 @@ static void davisCommonInit(davisCommonHandle handle) {
 	davisLog(CAER_LOG_DEBUG, handle, "DVS Size X: %d, Size Y: %d, Invert: %d.", state->dvs.sizeX, state->dvs.sizeY,
 		state->dvs.invertXY);
 
+	if (state->dvs.invertXY) {
+		dvsROISettingsInit(&state->dvs.roi, state->dvs.sizeY, state->dvs.sizeX);
+		dvsRemapInit(&state->dvs.remap, state->dvs.sizeY, state->dvs.sizeX, true);
+		dvsAccumulateSettingsInit(&state->dvs.accumulate, state->dvs.sizeY, state->dvs.sizeX);
+	}
+	else {
+		dvsROISettingsInit(&state->dvs.roi, state->dvs.sizeX, state->dvs.sizeY);
+		dvsRemapInit(&state->dvs.remap, state->dvs.sizeX, state->dvs.sizeY, false);
+		dvsAccumulateSettingsInit(&state->dvs.accumulate, state->dvs.sizeX, state->dvs.sizeY);
+	}
+
 	spiConfigReceive(handle->spiConfigPtr, DAVIS_CONFIG_APS, DAVIS_CONFIG_APS_SIZE_COLUMNS, &param32);
 	state->aps.sizeX = U16T(param32);
 	spiConfigReceive(handle->spiConfigPtr, DAVIS_CONFIG_APS, DAVIS_CONFIG_APS_SIZE_ROWS, &param32);
@@ -1026,6 +1061,14 @@ static bool davisCommonConfigSet(davisCommonHandle handle, int8_t modAddr, uint8
 			}
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ROI:
+			return (dvsROIConfigSet(&state->dvs.roi, paramAddr, param));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE:
+			return (dvsAccumulateConfigSet(&state->dvs.accumulate, paramAddr, param));
+			break;
+
 		case DAVIS_CONFIG_MUX:
 			switch (paramAddr) {
 				case DAVIS_CONFIG_MUX_RUN:
@@ -1560,6 +1603,14 @@ static bool davisCommonConfigGet(davisCommonHandle handle, int8_t modAddr, uint8
 			}
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ROI:
+			return (dvsROIConfigGet(&state->dvs.roi, paramAddr, param));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE:
+			return (dvsAccumulateConfigGet(&state->dvs.accumulate, paramAddr, param));
+			break;
+
 		case DAVIS_CONFIG_MUX:
 			switch (paramAddr) {
 				case DAVIS_CONFIG_MUX_RUN:
@@ -2088,6 +2139,15 @@ static bool davisCommonConfigGet(davisCommonHandle handle, int8_t modAddr, uint8
 	return (true);
 }
 
+static bool davisCommonDVSRemapSet(davisCommonHandle handle, const uint32_t *remapTable) {
+	if (!dvsRemapSet(&handle->state.dvs.remap, remapTable)) {
+		davisLog(CAER_LOG_ERROR, handle, "Failed to set DVS remapping table (invalid address or out of memory).");
+		return (false);
+	}
+
+	return (true);
+}
+
 static bool davisCommonDataStart(davisCommonHandle handle, void (*dataNotifyIncrease)(void *ptr),
 	void (*dataNotifyDecrease)(void *ptr), void *dataNotifyUserPtr) {
 	davisCommonState state = &handle->state;
@@ -2145,11 +2205,7 @@ static bool davisCommonDataStart(davisCommonHandle handle, void (*dataNotifyIncr
 		return (false);
 	}
 
-	size_t pixelsSize = sizeof(uint16_t) * (size_t) state->aps.sizeX * (size_t) state->aps.sizeY;
-	// '- sizeof(uint16_t)' to compensate for pixels[1] at end of struct for C++ compatibility.
-	size_t frameSize = (sizeof(struct caer_frame_event) - sizeof(uint16_t)) + pixelsSize;
-
-	state->aps.frame.currentEvent = calloc(1, frameSize);
+	state->aps.frame.currentEvent = calloc(1, apsFrameEventSize(state));
 	if (state->aps.frame.currentEvent == NULL) {
 		freeAllDataMemory(state);
 
@@ -2208,58 +2264,152 @@ static void davisCommonDataStop(davisCommonHandle handle) {
 
 #define TS_WRAP_ADD 0x8000
 
-static void davisCommonEventTranslator(
-	davisCommonHandle handle, const uint8_t *buffer, size_t bufferSize, atomic_uint_fast32_t *transfersRunning) {
+static inline bool davisCommonPacketsAllocate(davisCommonHandle handle) {
 	davisCommonState state = &handle->state;
 
-	// Truncate off any extra partial event.
-	if ((bufferSize & 0x01) != 0) {
-		davisLog(CAER_LOG_ALERT, handle, "%zu bytes received, which is not a multiple of two.", bufferSize);
-		bufferSize &= ~((size_t) 0x01);
+	if (!containerGenerationAllocate(&state->container, DAVIS_EVENT_TYPES)) {
+		davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
+		return (false);
 	}
 
-	for (size_t bufferPos = 0; bufferPos < bufferSize; bufferPos += 2) {
-		// Allocate new packets for next iteration as needed.
-		if (!containerGenerationAllocate(&state->container, DAVIS_EVENT_TYPES)) {
-			davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
-			return;
-		}
-
+	if (state->currentPackets.special == NULL) {
+		state->currentPackets.special = caerSpecialEventPacketAllocate(
+			DAVIS_SPECIAL_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
 		if (state->currentPackets.special == NULL) {
-			state->currentPackets.special = caerSpecialEventPacketAllocate(
-				DAVIS_SPECIAL_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.special == NULL) {
-				davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate special event packet.");
-				return;
-			}
+			davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate special event packet.");
+			return (false);
 		}
+	}
 
+	if (state->currentPackets.polarity == NULL) {
+		state->currentPackets.polarity = caerPolarityEventPacketAllocate(
+			DAVIS_POLARITY_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
 		if (state->currentPackets.polarity == NULL) {
-			state->currentPackets.polarity = caerPolarityEventPacketAllocate(
-				DAVIS_POLARITY_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.polarity == NULL) {
-				davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate polarity event packet.");
-				return;
-			}
+			davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate polarity event packet.");
+			return (false);
 		}
+	}
 
+	if (state->currentPackets.frame == NULL) {
+		state->currentPackets.frame = caerFrameEventPacketAllocate(DAVIS_FRAME_DEFAULT_SIZE,
+			I16T(handle->info.deviceID), state->timestamps.wrapOverflow, handle->info.apsSizeX, handle->info.apsSizeY,
+			(handle->info.apsColorFilter == MONO) ? (GRAYSCALE) : (RGB));
 		if (state->currentPackets.frame == NULL) {
-			state->currentPackets.frame = caerFrameEventPacketAllocate(DAVIS_FRAME_DEFAULT_SIZE,
-				I16T(handle->info.deviceID), state->timestamps.wrapOverflow, handle->info.apsSizeX,
-				handle->info.apsSizeY, (handle->info.apsColorFilter == MONO) ? (GRAYSCALE) : (RGB));
-			if (state->currentPackets.frame == NULL) {
-				davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate frame event packet.");
-				return;
-			}
+			davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate frame event packet.");
+			return (false);
 		}
+	}
 
+	if (state->currentPackets.imu6 == NULL) {
+		state->currentPackets.imu6 = caerIMU6EventPacketAllocate(
+			DAVIS_IMU_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
 		if (state->currentPackets.imu6 == NULL) {
-			state->currentPackets.imu6 = caerIMU6EventPacketAllocate(
-				DAVIS_IMU_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.imu6 == NULL) {
-				davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate IMU6 event packet.");
-				return;
-			}
+			davisLog(CAER_LOG_CRITICAL, handle, "Failed to allocate IMU6 event packet.");
+			return (false);
+		}
+	}
+
+	return (true);
+}
+
+/**
+ * Commit all events decoded so far, without waiting for any of the usual
+ * container commit triggers. Packets that are left empty are freed, so that
+ * nothing is generated while scanning; they are allocated again as needed.
+ */
+// Free the packets left after a commit, which are all empty. They carry the
+// timestamp overflow from when they were allocated, and must not be reused
+// once it changed (timestamp reset or big wrap).
+static inline void davisCommonPacketsFreeEmpty(davisCommonState state) {
+	if (state->currentPackets.polarity != NULL) {
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
+		state->currentPackets.polarity = NULL;
+	}
+
+	if (state->currentPackets.special != NULL) {
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
+		state->currentPackets.special = NULL;
+	}
+
+	if (state->currentPackets.frame != NULL) {
+		caerEventPacketFree(&state->currentPackets.frame->packetHeader);
+		state->currentPackets.frame = NULL;
+	}
+
+	if (state->currentPackets.imu6 != NULL) {
+		caerEventPacketFree(&state->currentPackets.imu6->packetHeader);
+		state->currentPackets.imu6 = NULL;
+	}
+}
+
+static inline void davisCommonPacketsFlush(davisCommonHandle handle, atomic_uint_fast32_t *transfersRunning) {
+	davisCommonState state = &handle->state;
+
+	bool emptyContainerCommit = true;
+
+	if (state->currentPackets.polarityPosition > 0) {
+		containerGenerationSetPacket(
+			&state->container, POLARITY_EVENT, (caerEventPacketHeader) state->currentPackets.polarity);
+
+		state->currentPackets.polarity         = NULL;
+		state->currentPackets.polarityPosition = 0;
+		emptyContainerCommit                   = false;
+	}
+
+	if (state->currentPackets.specialPosition > 0) {
+		containerGenerationSetPacket(
+			&state->container, SPECIAL_EVENT, (caerEventPacketHeader) state->currentPackets.special);
+
+		state->currentPackets.special         = NULL;
+		state->currentPackets.specialPosition = 0;
+		emptyContainerCommit                  = false;
+	}
+
+	if (state->currentPackets.framePosition > 0) {
+		containerGenerationSetPacket(&state->container, FRAME_EVENT, (caerEventPacketHeader) state->currentPackets.frame);
+
+		state->currentPackets.frame         = NULL;
+		state->currentPackets.framePosition = 0;
+		emptyContainerCommit                = false;
+	}
+
+	if (state->currentPackets.imu6Position > 0) {
+		containerGenerationSetPacket(&state->container, IMU6_EVENT, (caerEventPacketHeader) state->currentPackets.imu6);
+
+		state->currentPackets.imu6         = NULL;
+		state->currentPackets.imu6Position = 0;
+		emptyContainerCommit               = false;
+	}
+
+	containerGenerationExecute(&state->container, emptyContainerCommit, false, state->timestamps.wrapOverflow,
+		state->timestamps.current, &state->dataExchange, transfersRunning, handle->info.deviceID,
+		handle->info.deviceString, &state->deviceLogLevel);
+
+	dvsAccumulateFlush(&state->dvs.accumulate);
+
+	davisCommonPacketsFreeEmpty(state);
+}
+
+static void davisCommonEventTranslator(
+	davisCommonHandle handle, const uint8_t *buffer, size_t bufferSize, atomic_uint_fast32_t *transfersRunning) {
+	davisCommonState state = &handle->state;
+
+	// Truncate off any extra partial event.
+	if ((bufferSize & 0x01) != 0) {
+		davisLog(CAER_LOG_ALERT, handle, "%zu bytes received, which is not a multiple of two.", bufferSize);
+		bufferSize &= ~((size_t) 0x01);
+	}
+
+	// Region of interest, remapping and accumulation settings stay the same for the whole buffer.
+	dvsROIUpdate(&state->dvs.roi);
+	dvsRemapUpdate(&state->dvs.remap);
+	dvsAccumulateUpdate(&state->dvs.accumulate, &state->dataExchange, I16T(handle->info.deviceID),
+		handle->info.deviceString, &state->deviceLogLevel);
+
+	for (size_t bufferPos = 0; bufferPos < bufferSize; bufferPos += 2) {
+		// Allocate new packets for next iteration as needed. Scanning uses none.
+		if ((!state->scanOnly) && (!davisCommonPacketsAllocate(handle))) {
+			return;
 		}
 
 		bool tsReset   = false;
@@ -2375,8 +2525,6 @@ static void davisCommonEventTranslator(
 								// Timestamp at event-stream insertion point.
 								caerIMU6EventSetTimestamp(&state->imu.currentEvent, state->timestamps.current);
 
-								caerIMU6EventValidate(&state->imu.currentEvent, state->currentPackets.imu6);
-
 								// IMU6 and APS operate on an internal event and copy that to the actual output
 								// packet here, in the END state, for a reason: if a packetContainer, with all its
 								// packets, is committed due to hitting any of the triggers that are not TS reset
@@ -2389,6 +2537,8 @@ static void davisCommonEventTranslator(
 								// the whole event is ready and cannot be broken/corrupted in any way anymore.
 								if (ensureSpaceForEvents((caerEventPacketHeader *) &state->currentPackets.imu6,
 										(size_t) state->currentPackets.imu6Position, 1, handle)) {
+									caerIMU6EventValidate(&state->imu.currentEvent, state->currentPackets.imu6);
+
 									caerIMU6Event imuCurrentEvent = caerIMU6EventPacketGetEvent(
 										state->currentPackets.imu6, state->currentPackets.imu6Position);
 									memcpy(imuCurrentEvent, &state->imu.currentEvent, sizeof(struct caer_imu6_event));
@@ -2761,24 +2911,65 @@ static void davisCommonEventTranslator(
 					// pre-amplifier. uint8_t polarity = ((IS_DAVIS208(handle->info.chipID)) && (data < 192)) ?
 					// U8T(~code) : (code);
 
-					if (ensureSpaceForEvents((caerEventPacketHeader *) &state->currentPackets.polarity,
+					uint16_t xAddr = data;
+					uint16_t yAddr = state->dvs.lastY;
+
+					// Remapping replaces the address, or drops the event. Its table
+					// is indexed by sensor address, the orientation is folded in.
+					uint32_t remapData = 0;
+
+					if (state->dvs.remap.current != NULL) {
+						remapData = dvsRemapLookup(&state->dvs.remap, xAddr, yAddr);
+
+						if (remapData == CAER_DVS_REMAP_DROP) {
+							break;
+						}
+					}
+
+					// Drop events outside the host-side region of interest, which
+					// is in output orientation.
+					if ((state->dvs.remap.current == NULL) || (!state->dvs.roi.current.fullArray)) {
+						if (state->dvs.invertXY) {
+							SWAP_VAR(uint16_t, xAddr, yAddr);
+						}
+
+						if (!dvsROIAccept(&state->dvs.roi, xAddr, yAddr)) {
+							break;
+						}
+					}
+
+					// Events that are only accumulated are not written to the packet.
+					bool discardEvent                        = dvsAccumulateDiscards(&state->dvs.accumulate);
+					struct caer_polarity_event discardedEvent = {0, 0};
+
+					if (discardEvent
+						|| ensureSpaceForEvents((caerEventPacketHeader *) &state->currentPackets.polarity,
 							(size_t) state->currentPackets.polarityPosition, 1, handle)) {
-						caerPolarityEvent currentPolarityEvent = caerPolarityEventPacketGetEvent(
-							state->currentPackets.polarity, state->currentPackets.polarityPosition);
+						caerPolarityEvent currentPolarityEvent = &discardedEvent;
+
+						if (!discardEvent) {
+							currentPolarityEvent = caerPolarityEventPacketGetEvent(
+								state->currentPackets.polarity, state->currentPackets.polarityPosition);
+						}
 
 						// Timestamp at event-stream insertion point.
 						caerPolarityEventSetTimestamp(currentPolarityEvent, state->timestamps.current);
-						caerPolarityEventSetPolarity(currentPolarityEvent, (code & 0x01));
-						if (state->dvs.invertXY) {
-							caerPolarityEventSetY(currentPolarityEvent, data);
-							caerPolarityEventSetX(currentPolarityEvent, state->dvs.lastY);
+						if (state->dvs.remap.current != NULL) {
+							currentPolarityEvent->data = htole32(remapData);
 						}
 						else {
-							caerPolarityEventSetY(currentPolarityEvent, state->dvs.lastY);
-							caerPolarityEventSetX(currentPolarityEvent, data);
+							caerPolarityEventSetY(currentPolarityEvent, yAddr);
+							caerPolarityEventSetX(currentPolarityEvent, xAddr);
 						}
-						caerPolarityEventValidate(currentPolarityEvent, state->currentPackets.polarity);
-						state->currentPackets.polarityPosition++;
+						caerPolarityEventSetPolarity(currentPolarityEvent, (code & 0x01));
+
+						if (!discardEvent) {
+							caerPolarityEventValidate(currentPolarityEvent, state->currentPackets.polarity);
+							state->currentPackets.polarityPosition++;
+						}
+
+						dvsAccumulateEvents(
+							&state->dvs.accumulate, currentPolarityEvent, 1, state->timestamps.wrapOverflow);
 					}
 
 					break;
@@ -3072,6 +3263,24 @@ static void davisCommonEventTranslator(
 			}
 		}
 
+		if (state->scanOnly) {
+			// Nothing to commit while scanning, but the forced commits still
+			// restart the composite events, and every commit moves the time
+			// limit, exactly as done below.
+			if (tsReset || tsBigWrap) {
+				state->aps.ignoreEvents = true;
+				state->imu.ignoreEvents = true;
+			}
+
+			containerGenerationCommitTimestampAdvance(
+				&state->container, state->timestamps.wrapOverflow, state->timestamps.current);
+
+			continue;
+		}
+
+		// Accumulation windows also end while no polarity events arrive.
+		dvsAccumulateTimestamp(&state->dvs.accumulate, state->timestamps.wrapOverflow, state->timestamps.current);
+
 		// Thresholds on which to trigger packet container commit.
 		// tsReset and tsBigWrap are already defined above.
 		// Trigger if any of the global container-wide thresholds are met.
@@ -3218,11 +3427,15 @@ static void davisCommonEventTranslator(
 				// See APS and IMU6 END states for more details on a related issue.
 				state->aps.ignoreEvents = true;
 				state->imu.ignoreEvents = true;
+
+				davisCommonPacketsFreeEmpty(state);
 			}
 
 			containerGenerationExecute(&state->container, emptyContainerCommit, tsReset, state->timestamps.wrapOverflow,
 				state->timestamps.current, &state->dataExchange, transfersRunning, handle->info.deviceID,
 				handle->info.deviceString, &state->deviceLogLevel);
+
+			dvsAccumulateFlush(&state->dvs.accumulate);
 		}
 	}
 }
@@ -282,6 +282,8 @@ bool davisRPiClose(caerDeviceHandle cdh) {
 	davisLog(CAER_LOG_DEBUG, &handle->cHandle, "Shutdown successful.");
 
 	// Free memory.
+	dvsRemapDestroy(&handle->cHandle.state.dvs.remap);
+	dvsAccumulateDestroy(&handle->cHandle.state.dvs.accumulate);
 	free(handle->cHandle.info.deviceString);
 	free(handle);
 
@@ -561,6 +563,12 @@ caerEventPacketContainer davisRPiDataGet(caerDeviceHandle cdh) {
 	return (dataExchangeGet(&handle->cHandle.state.dataExchange, &handle->gpio.threadState));
 }
 
+bool davisRPiDVSRemapSet(caerDeviceHandle cdh, const uint32_t *remapTable) {
+	davisRPiHandle handle = (davisRPiHandle) cdh;
+
+	return (davisCommonDVSRemapSet(&handle->cHandle, remapTable));
+}
+
 #if DAVIS_RPI_BENCHMARK == 1
 static void davisRPiBenchmarkDataTranslator(davisRPiHandle handle, const uint8_t *buffer, size_t bufferSize) {
 	// Return right away if not running anymore. This prevents useless work if many
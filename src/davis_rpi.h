@@ -83,5 +83,6 @@ bool davisRPiDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void
 	void *dataShutdownUserPtr);
 bool davisRPiDataStop(caerDeviceHandle handle);
 caerEventPacketContainer davisRPiDataGet(caerDeviceHandle handle);
+bool davisRPiDVSRemapSet(caerDeviceHandle handle, const uint32_t *remapTable);
 
 #endif /* LIBCAER_SRC_DAVIS_RPI_H_ */
@@ -207,6 +207,25 @@ static caerEventPacketContainer (*dataGetters[CAER_SUPPORTED_DEVICES_NUMBER])(ca
 	[CAER_DEVICE_SAMSUNG_EVK] = &samsungEVKDataGet,
 };
 
+static caerDeviceRawBuffer (*rawDataGetters[CAER_SUPPORTED_DEVICES_NUMBER])(caerDeviceHandle handle) = {
+	[CAER_DEVICE_DAVIS_FX2] = &davisDataGetRaw,
+	[CAER_DEVICE_DAVIS_FX3] = &davisDataGetRaw,
+	[CAER_DEVICE_DAVIS]     = &davisDataGetRaw,
+	[CAER_DEVICE_DVXPLORER] = &dvXplorerDataGetRaw,
+};
+
+static bool (*dvsRemapSetters[CAER_SUPPORTED_DEVICES_NUMBER])(caerDeviceHandle handle, const uint32_t *remapTable) = {
+	[CAER_DEVICE_DAVIS_FX2] = &davisDVSRemapSet,
+	[CAER_DEVICE_DAVIS_FX3] = &davisDVSRemapSet,
+	[CAER_DEVICE_DAVIS]     = &davisDVSRemapSet,
+#if defined(OS_LINUX)
+	[CAER_DEVICE_DAVIS_RPI] = &davisRPiDVSRemapSet,
+#else
+	[CAER_DEVICE_DAVIS_RPI]     = NULL,
+#endif
+	[CAER_DEVICE_DVXPLORER] = &dvXplorerDVSRemapSet,
+};
+
 // Add empty InfoGet for optional devices, such as serial ones.
 #if defined(LIBCAER_HAVE_SERIALDEV) && LIBCAER_HAVE_SERIALDEV == 0
 struct caer_edvs_info caerEDVSInfoGet(caerDeviceHandle handle) {
@@ -404,6 +423,44 @@ caerEventPacketContainer caerDeviceDataGet(caerDeviceHandle handle) {
 	return (dataGetters[handle->deviceType](handle));
 }
 
+caerDeviceRawBuffer caerDeviceDataGetRaw(caerDeviceHandle handle) {
+	// Check if the pointer is valid.
+	if (handle == NULL) {
+		return (NULL);
+	}
+
+	// Check if device type is supported.
+	if (handle->deviceType >= CAER_SUPPORTED_DEVICES_NUMBER) {
+		return (NULL);
+	}
+
+	// Call appropriate function.
+	if (rawDataGetters[handle->deviceType] == NULL) {
+		return (NULL);
+	}
+
+	return (rawDataGetters[handle->deviceType](handle));
+}
+
+bool caerDeviceDVSRemapSet(caerDeviceHandle handle, const uint32_t *remapTable) {
+	// Check if the pointer is valid.
+	if (handle == NULL) {
+		return (false);
+	}
+
+	// Check if device type is supported.
+	if (handle->deviceType >= CAER_SUPPORTED_DEVICES_NUMBER) {
+		return (false);
+	}
+
+	// Call appropriate function.
+	if (dvsRemapSetters[handle->deviceType] == NULL) {
+		return (false);
+	}
+
+	return (dvsRemapSetters[handle->deviceType](handle, remapTable));
+}
+
 bool caerDeviceConfigGet64(caerDeviceHandle handle, int8_t modAddr, uint8_t paramAddr, uint64_t *param) {
 	// Ensure param is zeroed out.
 	*param = 0;
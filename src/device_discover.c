@@ -7,6 +7,7 @@
 #include "dvxplorer.h"
 #include "dynapse.h"
 #include "samsung_evk.h"
+#include "usb_utils.h"
 
 #if defined(LIBCAER_HAVE_SERIALDEV) && LIBCAER_HAVE_SERIALDEV == 1
 #	include "edvs.h"
@@ -36,6 +37,24 @@ static ssize_t (*deviceFinders[CAER_SUPPORTED_DEVICES_NUMBER])(caerDeviceDiscove
 	[CAER_DEVICE_SAMSUNG_EVK] = &samsungEVKFind,
 };
 
+struct device_finder_job {
+	size_t deviceType;
+	ssize_t result;
+	caerDeviceDiscoveryResult discovered;
+	thrd_t thread;
+	bool threadStarted;
+};
+
+static int deviceFinderThread(void *jobPtr) {
+	struct device_finder_job *job = jobPtr;
+
+	thrd_set_name("DeviceDiscover");
+
+	job->result = deviceFinders[job->deviceType](&job->discovered);
+
+	return (EXIT_SUCCESS);
+}
+
 ssize_t caerDeviceDiscover(int16_t deviceType, caerDeviceDiscoveryResult *discoveredDevices) {
 	if (discoveredDevices == NULL) {
 		// Usage error, don't pass a NULL pointer!
@@ -52,9 +71,14 @@ ssize_t caerDeviceDiscover(int16_t deviceType, caerDeviceDiscoveryResult *discov
 
 	if (deviceType == CAER_DEVICE_DISCOVER_ALL) {
 		// Go through all device finder functions that are defined.
-		size_t foundDevices = 0;
+		// Each finder runs in its own thread, as most of the time is spent
+		// waiting on USB control transfers; results are then merged in
+		// device type order, so the output is the same as a sequential search.
+		struct device_finder_job jobs[CAER_SUPPORTED_DEVICES_NUMBER] = {{0}};
 
 		for (size_t i = 0; i < CAER_SUPPORTED_DEVICES_NUMBER; i++) {
+			jobs[i].deviceType = i;
+
 			// Skip CAER_DEVICE_DAVIS: already considered by the specific
 			// FX2 and FX3 DAVIS device search cases.
 			if (i == CAER_DEVICE_DAVIS) {
@@ -67,8 +91,27 @@ ssize_t caerDeviceDiscover(int16_t deviceType, caerDeviceDiscoveryResult *discov
 				continue;
 			}
 
-			caerDeviceDiscoveryResult discovered;
-			ssize_t result = deviceFinders[i](&discovered);
+			if (thrd_create(&jobs[i].thread, &deviceFinderThread, &jobs[i]) == thrd_success) {
+				jobs[i].threadStarted = true;
+			}
+			else {
+				// Fall back to searching on the current thread.
+				jobs[i].result = deviceFinders[i](&jobs[i].discovered);
+			}
+		}
+
+		for (size_t i = 0; i < CAER_SUPPORTED_DEVICES_NUMBER; i++) {
+			if (jobs[i].threadStarted) {
+				thrd_join(jobs[i].thread, NULL);
+			}
+		}
+
+		size_t foundDevices = 0;
+		bool memoryError    = false;
+
+		for (size_t i = 0; i < CAER_SUPPORTED_DEVICES_NUMBER; i++) {
+			ssize_t result                       = jobs[i].result;
+			caerDeviceDiscoveryResult discovered = jobs[i].discovered;
 
 			// Search error!
 			if (result < 0) {
@@ -77,11 +120,17 @@ ssize_t caerDeviceDiscover(int16_t deviceType, caerDeviceDiscoveryResult *discov
 				continue;
 			}
 
-			// No devices of this type found.
+			// No devices of this type found (or not searched for).
 			if (result == 0) {
 				continue;
 			}
 
+			if (memoryError) {
+				// Just free remaining results after a failure.
+				free(discovered);
+				continue;
+			}
+
 			// Found some devices.
 			void *biggerDiscoveredDevices = realloc(
 				*discoveredDevices, (foundDevices + (size_t) result) * sizeof(struct caer_device_discovery_result));
@@ -91,7 +140,8 @@ ssize_t caerDeviceDiscover(int16_t deviceType, caerDeviceDiscoveryResult *discov
 				*discoveredDevices = NULL;
 
 				free(discovered);
-				return (-1);
+				memoryError = true;
+				continue;
 			}
 
 			// Memory allocation successful, get info.
@@ -105,6 +155,10 @@ ssize_t caerDeviceDiscover(int16_t deviceType, caerDeviceDiscoveryResult *discov
 			foundDevices += (size_t) result;
 		}
 
+		if (memoryError) {
+			return (-1);
+		}
+
 		return ((ssize_t) foundDevices);
 	}
 	else {
@@ -117,6 +171,14 @@ ssize_t caerDeviceDiscover(int16_t deviceType, caerDeviceDiscoveryResult *discov
 	}
 }
 
+void caerDeviceDiscoverCacheEnable(bool enable) {
+	usbDiscoveryCacheSetEnabled(enable);
+}
+
+void caerDeviceDiscoverCacheClear(void) {
+	usbDiscoveryCacheClear();
+}
+
 caerDeviceHandle caerDeviceDiscoverOpen(uint16_t deviceID, caerDeviceDiscoveryResult discoveredDevice) {
 	// Cannot pass a NULL pointer, no device!
 	if (discoveredDevice == NULL) {
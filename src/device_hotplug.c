@@ -0,0 +1,372 @@
+#include "libcaer/devices/device_discover.h"
+
+#include "davis.h"
+#include "dvs128.h"
+#include "dvs132s.h"
+#include "dvxplorer.h"
+#include "dynapse.h"
+#include "samsung_evk.h"
+#include "usb_utils.h"
+
+#define HOTPLUG_THREAD_NAME "DeviceHotplug"
+
+// USB devices that support hot-plug notifications, with the function used
+// to get the full information of just the arrived device. Other attached
+// devices, possibly open and in use, are never touched.
+static const struct {
+	uint16_t deviceType;
+	uint16_t devVID;
+	uint16_t devPID;
+	bool (*deviceFinder)(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice);
+} hotplugDevices[] = {
+	{CAER_DEVICE_DVS128, USB_DEFAULT_DEVICE_VID, DVS_DEVICE_PID, &dvs128FindSingle},
+	{CAER_DEVICE_DAVIS_FX2, USB_DEFAULT_DEVICE_VID, DAVIS_FX2_DEVICE_PID, &davisFindSingleFX2},
+	{CAER_DEVICE_DAVIS_FX3, USB_DEFAULT_DEVICE_VID, DAVIS_FX3_DEVICE_PID, &davisFindSingleFX3},
+	{CAER_DEVICE_DYNAPSE, USB_DEFAULT_DEVICE_VID, DYNAPSE_DEVICE_PID, &dynapseFindSingle},
+	{CAER_DEVICE_DVS132S, USB_DEFAULT_DEVICE_VID, DVS132S_DEVICE_PID, &dvs132sFindSingle},
+	{CAER_DEVICE_DVXPLORER, USB_DEFAULT_DEVICE_VID, DVXPLORER_DEVICE_PID, &dvXplorerFindSingle},
+	{CAER_DEVICE_SAMSUNG_EVK, SAMSUNG_EVK_DEVICE_VID, SAMSUNG_EVK_DEVICE_PID, &samsungEVKFindSingle},
+};
+
+#define HOTPLUG_DEVICES_NUMBER (sizeof(hotplugDevices) / sizeof(hotplugDevices[0]))
+
+struct hotplug_event {
+	size_t deviceIndex;
+	libusb_device *device; // Referenced for arrivals, NULL for departures.
+	uint8_t busNumber;
+	uint8_t devAddress;
+	bool arrived;
+};
+
+struct hotplug_known_device {
+	uint8_t busNumber;
+	uint8_t devAddress;
+	struct caer_device_discovery_result info;
+};
+
+static struct {
+	once_flag initOnce;
+	mtx_t lock;
+	bool registered; // LOCK PROTECTED (register/unregister).
+	libusb_context *context;
+	libusb_hotplug_callback_handle callbackHandles[HOTPLUG_DEVICES_NUMBER];
+	thrd_t thread;
+	atomic_bool threadRun;
+	void (*hotplugCallback)(caerDeviceDiscoveryResult device, bool arrived, void *hotplugCallbackPtr);
+	void *hotplugCallbackPtr;
+	// Events from libusb, processed by the hotplug thread.
+	mtx_t eventsLock;
+	struct hotplug_event *events; // LOCK PROTECTED.
+	size_t eventsLength;          // LOCK PROTECTED.
+	// Devices announced to the user. Hotplug thread only.
+	struct hotplug_known_device *knownDevices;
+	size_t knownDevicesLength;
+} hotplugState = {.initOnce = ONCE_FLAG_INIT};
+
+static void hotplugInit(void) {
+	mtx_init(&hotplugState.lock, mtx_plain);
+	mtx_init(&hotplugState.eventsLock, mtx_plain);
+}
+
+static bool discoveryResultUSBAddress(caerDeviceDiscoveryResult result, uint8_t *busNumber, uint8_t *devAddress) {
+	switch (result->deviceType) {
+		case CAER_DEVICE_DVS128:
+			*busNumber  = result->deviceInfo.dvs128Info.deviceUSBBusNumber;
+			*devAddress = result->deviceInfo.dvs128Info.deviceUSBDeviceAddress;
+			break;
+
+		case CAER_DEVICE_DAVIS_FX2:
+		case CAER_DEVICE_DAVIS_FX3:
+		case CAER_DEVICE_DAVIS:
+			*busNumber  = result->deviceInfo.davisInfo.deviceUSBBusNumber;
+			*devAddress = result->deviceInfo.davisInfo.deviceUSBDeviceAddress;
+			break;
+
+		case CAER_DEVICE_DYNAPSE:
+			*busNumber  = result->deviceInfo.dynapseInfo.deviceUSBBusNumber;
+			*devAddress = result->deviceInfo.dynapseInfo.deviceUSBDeviceAddress;
+			break;
+
+		case CAER_DEVICE_DVS132S:
+			*busNumber  = result->deviceInfo.dvs132sInfo.deviceUSBBusNumber;
+			*devAddress = result->deviceInfo.dvs132sInfo.deviceUSBDeviceAddress;
+			break;
+
+		case CAER_DEVICE_DVXPLORER:
+			*busNumber  = result->deviceInfo.dvXplorerInfo.deviceUSBBusNumber;
+			*devAddress = result->deviceInfo.dvXplorerInfo.deviceUSBDeviceAddress;
+			break;
+
+		case CAER_DEVICE_SAMSUNG_EVK:
+			*busNumber  = result->deviceInfo.samsungEVKInfo.deviceUSBBusNumber;
+			*devAddress = result->deviceInfo.samsungEVKInfo.deviceUSBDeviceAddress;
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+static int LIBUSB_CALL hotplugLibUSBCallback(
+	libusb_context *ctx, libusb_device *device, libusb_hotplug_event event, void *userData) {
+	(void) (ctx); // UNUSED.
+
+	// Device information requires control transfers, which cannot be done
+	// from within a libusb hotplug callback. Queue the event for the hotplug
+	// thread to handle instead, keeping arrived devices referenced until then.
+	bool arrived = (event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED);
+
+	struct hotplug_event hotplugEvent = {
+		.deviceIndex = (size_t) userData,
+		.device      = (arrived) ? (libusb_ref_device(device)) : (NULL),
+		.busNumber   = libusb_get_bus_number(device),
+		.devAddress  = libusb_get_device_address(device),
+		.arrived     = arrived,
+	};
+
+	mtx_lock(&hotplugState.eventsLock);
+
+	void *biggerEvents = realloc(hotplugState.events, (hotplugState.eventsLength + 1) * sizeof(struct hotplug_event));
+	if (biggerEvents == NULL) {
+		mtx_unlock(&hotplugState.eventsLock);
+
+		if (hotplugEvent.device != NULL) {
+			libusb_unref_device(hotplugEvent.device);
+		}
+
+		caerLog(CAER_LOG_ERROR, HOTPLUG_THREAD_NAME, "Failed to queue hotplug event, memory allocation failure.");
+		return (0);
+	}
+
+	hotplugState.events                            = biggerEvents;
+	hotplugState.events[hotplugState.eventsLength] = hotplugEvent;
+	hotplugState.eventsLength++;
+
+	mtx_unlock(&hotplugState.eventsLock);
+
+	// Keep callback registered.
+	return (0);
+}
+
+static void hotplugHandleArrival(const struct hotplug_event *event) {
+	struct caer_device_discovery_result discovered = {0};
+
+	if (!hotplugDevices[event->deviceIndex].deviceFinder(event->device, &discovered)) {
+		caerLog(CAER_LOG_ERROR, HOTPLUG_THREAD_NAME,
+			"Failed to get information for arrived device (bus %" PRIu8 ", address %" PRIu8 ").", event->busNumber,
+			event->devAddress);
+		return;
+	}
+
+	uint8_t busNumber  = 0;
+	uint8_t devAddress = 0;
+
+	if (!discoveryResultUSBAddress(&discovered, &busNumber, &devAddress)) {
+		return;
+	}
+
+	void *biggerKnownDevices = realloc(
+		hotplugState.knownDevices, (hotplugState.knownDevicesLength + 1) * sizeof(struct hotplug_known_device));
+	if (biggerKnownDevices == NULL) {
+		caerLog(CAER_LOG_ERROR, HOTPLUG_THREAD_NAME, "Failed to track arrived device, memory allocation failure.");
+		return;
+	}
+
+	hotplugState.knownDevices = biggerKnownDevices;
+
+	struct hotplug_known_device *known = &hotplugState.knownDevices[hotplugState.knownDevicesLength];
+	known->busNumber                   = busNumber;
+	known->devAddress                  = devAddress;
+	known->info                        = discovered;
+	hotplugState.knownDevicesLength++;
+
+	(*hotplugState.hotplugCallback)(&known->info, true, hotplugState.hotplugCallbackPtr);
+}
+
+static void hotplugHandleDeparture(const struct hotplug_event *event) {
+	for (size_t i = 0; i < hotplugState.knownDevicesLength; i++) {
+		struct hotplug_known_device *known = &hotplugState.knownDevices[i];
+
+		if ((known->busNumber != event->busNumber) || (known->devAddress != event->devAddress)) {
+			continue;
+		}
+
+		struct caer_device_discovery_result info = known->info;
+
+		// Remove from known devices, order doesn't matter.
+		hotplugState.knownDevicesLength--;
+		hotplugState.knownDevices[i] = hotplugState.knownDevices[hotplugState.knownDevicesLength];
+
+		(*hotplugState.hotplugCallback)(&info, false, hotplugState.hotplugCallbackPtr);
+		break;
+	}
+}
+
+static void hotplugHandleEvents(void) {
+	mtx_lock(&hotplugState.eventsLock);
+
+	struct hotplug_event *events = hotplugState.events;
+	size_t eventsLength          = hotplugState.eventsLength;
+
+	hotplugState.events       = NULL;
+	hotplugState.eventsLength = 0;
+
+	mtx_unlock(&hotplugState.eventsLock);
+
+	for (size_t i = 0; i < eventsLength; i++) {
+		if (events[i].arrived) {
+			hotplugHandleArrival(&events[i]);
+
+			libusb_unref_device(events[i].device);
+		}
+		else {
+			hotplugHandleDeparture(&events[i]);
+		}
+	}
+
+	free(events);
+}
+
+static int hotplugThreadRun(void *unused) {
+	(void) (unused); // UNUSED.
+
+	thrd_set_name(HOTPLUG_THREAD_NAME);
+
+	// Handle devices already present at registration first.
+	hotplugHandleEvents();
+
+	while (atomic_load_explicit(&hotplugState.threadRun, memory_order_relaxed)) {
+		struct timeval te = {.tv_sec = 0, .tv_usec = 100000};
+
+		libusb_handle_events_timeout(hotplugState.context, &te);
+
+		hotplugHandleEvents();
+	}
+
+	return (EXIT_SUCCESS);
+}
+
+static void hotplugCleanup(size_t registeredCallbacks) {
+	for (size_t i = 0; i < registeredCallbacks; i++) {
+		libusb_hotplug_deregister_callback(hotplugState.context, hotplugState.callbackHandles[i]);
+	}
+
+	// Release devices of arrivals that were never handled.
+	for (size_t i = 0; i < hotplugState.eventsLength; i++) {
+		if (hotplugState.events[i].device != NULL) {
+			libusb_unref_device(hotplugState.events[i].device);
+		}
+	}
+
+	free(hotplugState.events);
+	hotplugState.events       = NULL;
+	hotplugState.eventsLength = 0;
+
+	libusb_exit(hotplugState.context);
+	hotplugState.context = NULL;
+
+	free(hotplugState.knownDevices);
+	hotplugState.knownDevices       = NULL;
+	hotplugState.knownDevicesLength = 0;
+
+	hotplugState.hotplugCallback    = NULL;
+	hotplugState.hotplugCallbackPtr = NULL;
+}
+
+bool caerDeviceHotplugRegister(
+	void (*hotplugCallback)(caerDeviceDiscoveryResult device, bool arrived, void *hotplugCallbackPtr),
+	void *hotplugCallbackPtr) {
+	if (hotplugCallback == NULL) {
+		// Usage error, callback is required.
+		return (false);
+	}
+
+	call_once(&hotplugState.initOnce, &hotplugInit);
+
+	mtx_lock(&hotplugState.lock);
+
+	if (hotplugState.registered) {
+		mtx_unlock(&hotplugState.lock);
+
+		caerLog(CAER_LOG_ERROR, HOTPLUG_THREAD_NAME, "Hotplug callback already registered.");
+		return (false);
+	}
+
+	if (!libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG)) {
+		mtx_unlock(&hotplugState.lock);
+
+		caerLog(CAER_LOG_ERROR, HOTPLUG_THREAD_NAME, "Hotplug notifications not supported on this system.");
+		return (false);
+	}
+
+	int res = libusb_init(&hotplugState.context);
+	if (res != LIBUSB_SUCCESS) {
+		mtx_unlock(&hotplugState.lock);
+
+		caerLog(CAER_LOG_CRITICAL, HOTPLUG_THREAD_NAME, "Failed to initialize libusb context. Error: %d.", res);
+		return (false);
+	}
+
+	hotplugState.hotplugCallback    = hotplugCallback;
+	hotplugState.hotplugCallbackPtr = hotplugCallbackPtr;
+
+	// Already attached devices are reported right away as arrivals too
+	// (LIBUSB_HOTPLUG_ENUMERATE), so the user sees a consistent view.
+	for (size_t i = 0; i < HOTPLUG_DEVICES_NUMBER; i++) {
+		res = libusb_hotplug_register_callback(hotplugState.context,
+			LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT, LIBUSB_HOTPLUG_ENUMERATE,
+			hotplugDevices[i].devVID, hotplugDevices[i].devPID, LIBUSB_HOTPLUG_MATCH_ANY, &hotplugLibUSBCallback,
+			(void *) i, &hotplugState.callbackHandles[i]);
+		if (res != LIBUSB_SUCCESS) {
+			hotplugCleanup(i);
+
+			mtx_unlock(&hotplugState.lock);
+
+			caerLog(CAER_LOG_CRITICAL, HOTPLUG_THREAD_NAME, "Failed to register hotplug callback. Error: %d.", res);
+			return (false);
+		}
+	}
+
+	atomic_store(&hotplugState.threadRun, true);
+
+	if (thrd_create(&hotplugState.thread, &hotplugThreadRun, NULL) != thrd_success) {
+		hotplugCleanup(HOTPLUG_DEVICES_NUMBER);
+
+		mtx_unlock(&hotplugState.lock);
+
+		caerLog(CAER_LOG_CRITICAL, HOTPLUG_THREAD_NAME, "Failed to start hotplug thread.");
+		return (false);
+	}
+
+	hotplugState.registered = true;
+
+	mtx_unlock(&hotplugState.lock);
+
+	return (true);
+}
+
+void caerDeviceHotplugUnregister(void) {
+	call_once(&hotplugState.initOnce, &hotplugInit);
+
+	mtx_lock(&hotplugState.lock);
+
+	if (!hotplugState.registered) {
+		mtx_unlock(&hotplugState.lock);
+		return;
+	}
+
+	atomic_store(&hotplugState.threadRun, false);
+
+	if (thrd_join(hotplugState.thread, NULL) != thrd_success) {
+		caerLog(CAER_LOG_CRITICAL, HOTPLUG_THREAD_NAME, "Failed to join hotplug thread.");
+	}
+
+	hotplugCleanup(HOTPLUG_DEVICES_NUMBER);
+
+	hotplugState.registered = false;
+
+	mtx_unlock(&hotplugState.lock);
+}
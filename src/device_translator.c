@@ -0,0 +1,373 @@
+#include "libcaer/devices/device.h"
+
+#include "davis.h"
+#include "dvxplorer.h"
+
+// Devices that support offline translation of raw data buffers.
+static void *(*translatorOpeners[CAER_SUPPORTED_DEVICES_NUMBER])(caerDeviceHandle handle,
+	dataExchange *translatorDataExchange, containerGeneration *translatorContainer,
+	atomic_uint_fast8_t **translatorLogLevel)
+	= {
+		[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorOpen,
+		[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorOpen,
+		[CAER_DEVICE_DAVIS]     = &davisTranslatorOpen,
+		[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorOpen,
+};
+
+static void (*translatorProcessors[CAER_SUPPORTED_DEVICES_NUMBER])(
+	void *translator, const uint8_t *buffer, size_t bufferSize)
+	= {
+		[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorProcess,
+		[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorProcess,
+		[CAER_DEVICE_DAVIS]     = &davisTranslatorProcess,
+		[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorProcess,
+};
+
+static void (*translatorScanners[CAER_SUPPORTED_DEVICES_NUMBER])(
+	void *translator, const uint8_t *buffer, size_t bufferSize)
+	= {
+		[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorScan,
+		[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorScan,
+		[CAER_DEVICE_DAVIS]     = &davisTranslatorScan,
+		[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorScan,
+};
+
+static size_t (*translatorResyncers[CAER_SUPPORTED_DEVICES_NUMBER])(
+	void *translator, const uint8_t *buffer, size_t bufferSize)
+	= {
+		[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorResync,
+		[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorResync,
+		[CAER_DEVICE_DAVIS]     = &davisTranslatorResync,
+		[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorResync,
+};
+
+static void (*translatorFlushers[CAER_SUPPORTED_DEVICES_NUMBER])(void *translator) = {
+	[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorFlush,
+	[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorFlush,
+	[CAER_DEVICE_DAVIS]     = &davisTranslatorFlush,
+	[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorFlush,
+};
+
+static size_t (*translatorStateSizers[CAER_SUPPORTED_DEVICES_NUMBER])(void *translator) = {
+	[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorStateSize,
+	[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorStateSize,
+	[CAER_DEVICE_DAVIS]     = &davisTranslatorStateSize,
+	[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorStateSize,
+};
+
+static void (*translatorStateGetters[CAER_SUPPORTED_DEVICES_NUMBER])(void *translator, uint8_t *stateBuffer) = {
+	[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorStateGet,
+	[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorStateGet,
+	[CAER_DEVICE_DAVIS]     = &davisTranslatorStateGet,
+	[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorStateGet,
+};
+
+static void (*translatorStateSetters[CAER_SUPPORTED_DEVICES_NUMBER])(void *translator, const uint8_t *stateBuffer) = {
+	[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorStateSet,
+	[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorStateSet,
+	[CAER_DEVICE_DAVIS]     = &davisTranslatorStateSet,
+	[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorStateSet,
+};
+
+static void (*translatorClosers[CAER_SUPPORTED_DEVICES_NUMBER])(void *translator) = {
+	[CAER_DEVICE_DAVIS_FX2] = &davisTranslatorClose,
+	[CAER_DEVICE_DAVIS_FX3] = &davisTranslatorClose,
+	[CAER_DEVICE_DAVIS]     = &davisTranslatorClose,
+	[CAER_DEVICE_DVXPLORER] = &dvXplorerTranslatorClose,
+};
+
+#define TRANSLATOR_QUEUE_INITIAL_SIZE 64
+
+struct caer_device_handle {
+	uint16_t deviceType;
+	// This is compatible with all device handle structures.
+	// The first member is always 'uint16_t deviceType'.
+};
+
+struct caer_device_translator_state {
+	uint16_t deviceType;
+	size_t stateSize;
+	// Device-specific decoding state follows.
+	uint8_t state[];
+};
+
+struct caer_device_translator {
+	uint16_t deviceType;
+	// Private copy of the device handle, with its own decoding state.
+	void *handle;
+	// Data exchange, container generation and log-level of the copy.
+	dataExchange dataExchange;
+	containerGeneration container;
+	atomic_uint_fast8_t *logLevel;
+	// Decoded containers, in order. Grows as needed, nothing is ever dropped.
+	caerEventPacketContainer *queue;
+	size_t queueSize;
+	size_t queueFirst;
+	size_t queueLength;
+};
+
+// Called by the data exchange for every new container: move it right away
+// to the unbounded queue, so the ring-buffer never fills up.
+static void translatorDataIncrease(void *ptr) {
+	caerDeviceTranslator translator = ptr;
+
+	caerEventPacketContainer container = caerRingBufferGet(translator->dataExchange->buffer);
+	if (container == NULL) {
+		return;
+	}
+
+	if (translator->queueLength == translator->queueSize) {
+		size_t newQueueSize = translator->queueSize * 2;
+
+		caerEventPacketContainer *newQueue = malloc(newQueueSize * sizeof(caerEventPacketContainer));
+		if (newQueue == NULL) {
+			caerLog(CAER_LOG_CRITICAL, "Device Translator",
+				"Failed to grow decoded containers queue, dropping event packet container.");
+
+			caerEventPacketContainerFree(container);
+			return;
+		}
+
+		// Unwrap the circular queue into the new memory.
+		for (size_t i = 0; i < translator->queueLength; i++) {
+			newQueue[i] = translator->queue[(translator->queueFirst + i) % translator->queueSize];
+		}
+
+		free(translator->queue);
+
+		translator->queue      = newQueue;
+		translator->queueSize  = newQueueSize;
+		translator->queueFirst = 0;
+	}
+
+	translator->queue[(translator->queueFirst + translator->queueLength) % translator->queueSize] = container;
+	translator->queueLength++;
+}
+
+caerDeviceTranslator caerDeviceTranslatorOpen(caerDeviceHandle handle) {
+	// Check if the pointer is valid.
+	if (handle == NULL) {
+		return (NULL);
+	}
+
+	// Check if device type is supported.
+	if ((handle->deviceType >= CAER_SUPPORTED_DEVICES_NUMBER) || (translatorOpeners[handle->deviceType] == NULL)) {
+		return (NULL);
+	}
+
+	caerDeviceTranslator translator = calloc(1, sizeof(struct caer_device_translator));
+	if (translator == NULL) {
+		return (NULL);
+	}
+
+	translator->deviceType = handle->deviceType;
+
+	translator->queue = malloc(TRANSLATOR_QUEUE_INITIAL_SIZE * sizeof(caerEventPacketContainer));
+	if (translator->queue == NULL) {
+		free(translator);
+		return (NULL);
+	}
+
+	translator->queueSize = TRANSLATOR_QUEUE_INITIAL_SIZE;
+
+	translator->handle = translatorOpeners[handle->deviceType](
+		handle, &translator->dataExchange, &translator->container, &translator->logLevel);
+	if (translator->handle == NULL) {
+		free(translator->queue);
+		free(translator);
+		return (NULL);
+	}
+
+	dataExchangeSetNotify(translator->dataExchange, &translatorDataIncrease, NULL, translator);
+
+	return (translator);
+}
+
+bool caerDeviceTranslatorClose(caerDeviceTranslator *translatorPtr) {
+	// Check if the pointer is valid.
+	if ((translatorPtr == NULL) || (*translatorPtr == NULL)) {
+		return (false);
+	}
+
+	caerDeviceTranslator translator = *translatorPtr;
+
+	// Stop moving containers to the queue, the translator frees what's left.
+	dataExchangeSetNotify(translator->dataExchange, NULL, NULL, NULL);
+
+	translatorClosers[translator->deviceType](translator->handle);
+
+	for (size_t i = 0; i < translator->queueLength; i++) {
+		caerEventPacketContainerFree(translator->queue[(translator->queueFirst + i) % translator->queueSize]);
+	}
+
+	free(translator->queue);
+	free(translator);
+
+	*translatorPtr = NULL;
+
+	return (true);
+}
+
+bool caerDeviceTranslatorConfigSet(caerDeviceTranslator translator, int8_t modAddr, uint8_t paramAddr, uint32_t param) {
+	// Check if the pointer is valid.
+	if (translator == NULL) {
+		return (false);
+	}
+
+	switch (modAddr) {
+		case CAER_HOST_CONFIG_PACKETS:
+			return (containerGenerationConfigSet(translator->container, paramAddr, param));
+			break;
+
+		case CAER_HOST_CONFIG_LOG:
+			switch (paramAddr) {
+				case CAER_HOST_CONFIG_LOG_LEVEL:
+					atomic_store(translator->logLevel, U8T(param));
+					break;
+
+				default:
+					return (false);
+					break;
+			}
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+bool caerDeviceTranslatorConfigGet(
+	caerDeviceTranslator translator, int8_t modAddr, uint8_t paramAddr, uint32_t *param) {
+	// Check if the pointer is valid.
+	if ((translator == NULL) || (param == NULL)) {
+		return (false);
+	}
+
+	// Ensure default value is 0.
+	*param = 0;
+
+	switch (modAddr) {
+		case CAER_HOST_CONFIG_PACKETS:
+			return (containerGenerationConfigGet(translator->container, paramAddr, param));
+			break;
+
+		case CAER_HOST_CONFIG_LOG:
+			switch (paramAddr) {
+				case CAER_HOST_CONFIG_LOG_LEVEL:
+					*param = atomic_load(translator->logLevel);
+					break;
+
+				default:
+					return (false);
+					break;
+			}
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+bool caerDeviceTranslatorProcess(caerDeviceTranslator translator, const uint8_t *buffer, size_t bufferSize) {
+	// Check if the pointers are valid.
+	if ((translator == NULL) || (buffer == NULL)) {
+		return (false);
+	}
+
+	translatorProcessors[translator->deviceType](translator->handle, buffer, bufferSize);
+
+	return (true);
+}
+
+caerEventPacketContainer caerDeviceTranslatorDataGet(caerDeviceTranslator translator) {
+	// Check if the pointer is valid.
+	if ((translator == NULL) || (translator->queueLength == 0)) {
+		return (NULL);
+	}
+
+	caerEventPacketContainer container = translator->queue[translator->queueFirst];
+
+	translator->queueFirst = (translator->queueFirst + 1) % translator->queueSize;
+	translator->queueLength--;
+
+	return (container);
+}
+
+bool caerDeviceTranslatorFlush(caerDeviceTranslator translator) {
+	// Check if the pointer is valid.
+	if (translator == NULL) {
+		return (false);
+	}
+
+	translatorFlushers[translator->deviceType](translator->handle);
+
+	return (true);
+}
+
+bool caerDeviceTranslatorScan(caerDeviceTranslator translator, const uint8_t *buffer, size_t bufferSize) {
+	// Check if the pointers are valid.
+	if ((translator == NULL) || (buffer == NULL)) {
+		return (false);
+	}
+
+	translatorScanners[translator->deviceType](translator->handle, buffer, bufferSize);
+
+	return (true);
+}
+
+size_t caerDeviceTranslatorResync(caerDeviceTranslator translator, const uint8_t *buffer, size_t bufferSize) {
+	// Check if the pointers are valid.
+	if ((translator == NULL) || (buffer == NULL)) {
+		return (0);
+	}
+
+	return (translatorResyncers[translator->deviceType](translator->handle, buffer, bufferSize));
+}
+
+caerDeviceTranslatorState caerDeviceTranslatorStateGet(caerDeviceTranslator translator) {
+	// Check if the pointer is valid.
+	if (translator == NULL) {
+		return (NULL);
+	}
+
+	size_t stateSize = translatorStateSizers[translator->deviceType](translator->handle);
+
+	caerDeviceTranslatorState state = malloc(sizeof(struct caer_device_translator_state) + stateSize);
+	if (state == NULL) {
+		return (NULL);
+	}
+
+	state->deviceType = translator->deviceType;
+	state->stateSize  = stateSize;
+
+	translatorStateGetters[translator->deviceType](translator->handle, state->state);
+
+	return (state);
+}
+
+bool caerDeviceTranslatorStateSet(caerDeviceTranslator translator, caerDeviceTranslatorStateConst state) {
+	// Check if the pointers are valid.
+	if ((translator == NULL) || (state == NULL)) {
+		return (false);
+	}
+
+	// State must come from a translator for the same device and configuration.
+	if ((state->deviceType != translator->deviceType)
+		|| (state->stateSize != translatorStateSizers[translator->deviceType](translator->handle))) {
+		return (false);
+	}
+
+	// Pending events were decoded with the old state, and empty packets may
+	// carry its timestamp overflow: commit and free them first.
+	translatorFlushers[translator->deviceType](translator->handle);
+
+	translatorStateSetters[translator->deviceType](translator->handle, state->state);
+
+	return (true);
+}
@@ -48,6 +48,10 @@ ssize_t dvs128Find(caerDeviceDiscoveryResult *discoveredDevices) {
 		discoveredDevices, &populateDeviceInfo));
 }
 
+bool dvs128FindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice) {
+	return (usbDeviceFindSingle(device, -1, -1, DVS_REQUIRED_FIRMWARE_VERSION, discoveredDevice, &populateDeviceInfo));
+}
+
 static inline void freeAllDataMemory(dvs128State state) {
 	dataExchangeDestroy(&state->dataExchange);
 
@@ -55,14 +59,14 @@ static inline void freeAllDataMemory(dvs128State state) {
 	// already assigned to the current packet container, we
 	// free them separately from it.
 	if (state->currentPackets.polarity != NULL) {
-		free(&state->currentPackets.polarity->packetHeader);
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
 		state->currentPackets.polarity = NULL;
 
 		containerGenerationSetPacket(&state->container, POLARITY_EVENT, NULL);
 	}
 
 	if (state->currentPackets.special != NULL) {
-		free(&state->currentPackets.special->packetHeader);
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
 		state->currentPackets.special = NULL;
 
 		containerGenerationSetPacket(&state->container, SPECIAL_EVENT, NULL);
@@ -96,6 +100,9 @@ caerDeviceHandle dvs128Open(
 	// Packet settings (size (in events) and time interval (in µs)).
 	containerGenerationSettingsInit(&state->container);
 
+	// Host-side region of interest (whole array by default).
+	dvsROISettingsInit(&state->dvs.roi, DVS_ARRAY_SIZE_X, DVS_ARRAY_SIZE_Y);
+
 	// Logging settings (initialize to global log-level).
 	enum caer_log_level globalLogLevel = caerLogLevelGet();
 	atomic_store(&state->deviceLogLevel, globalLogLevel);
@@ -270,6 +277,10 @@ bool dvs128ConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, ui
 			}
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ROI:
+			return (dvsROIConfigSet(&state->dvs.roi, paramAddr, param));
+			break;
+
 		case DVS128_CONFIG_DVS:
 			switch (paramAddr) {
 				case DVS128_CONFIG_DVS_RUN:
@@ -385,6 +396,10 @@ bool dvs128ConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, ui
 			}
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ROI:
+			return (dvsROIConfigGet(&state->dvs.roi, paramAddr, param));
+			break;
+
 		case DVS128_CONFIG_DVS:
 			switch (paramAddr) {
 				case DVS128_CONFIG_DVS_RUN:
@@ -556,6 +571,9 @@ static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytes
 		bytesSent &= ~((size_t) 0x03);
 	}
 
+	// Region of interest settings stay the same for the whole buffer.
+	dvsROIUpdate(&state->dvs.roi);
+
 	for (size_t i = 0; i < bytesSent; i += 4) {
 		// Allocate new packets for next iteration as needed.
 		if (!containerGenerationAllocate(&state->container, DVS_EVENT_TYPES)) {
@@ -712,15 +730,19 @@ static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytes
 					continue; // Skip invalid event.
 				}
 
-				caerPolarityEvent currentEvent = caerPolarityEventPacketGetEvent(
-					state->currentPackets.polarity, state->currentPackets.polarityPosition);
-				state->currentPackets.polarityPosition++;
-
-				caerPolarityEventSetTimestamp(currentEvent, state->timestamps.current);
-				caerPolarityEventSetPolarity(currentEvent, polarity);
-				caerPolarityEventSetY(currentEvent, y);
-				caerPolarityEventSetX(currentEvent, x);
-				caerPolarityEventValidate(currentEvent, state->currentPackets.polarity);
+				// Drop events outside the host-side region of interest. The timestamp
+				// was still updated, so the container commit checks below still apply.
+				if (dvsROIAccept(&state->dvs.roi, x, y)) {
+					caerPolarityEvent currentEvent = caerPolarityEventPacketGetEvent(
+						state->currentPackets.polarity, state->currentPackets.polarityPosition);
+					state->currentPackets.polarityPosition++;
+
+					caerPolarityEventSetTimestamp(currentEvent, state->timestamps.current);
+					caerPolarityEventSetPolarity(currentEvent, polarity);
+					caerPolarityEventSetY(currentEvent, y);
+					caerPolarityEventSetX(currentEvent, x);
+					caerPolarityEventValidate(currentEvent, state->currentPackets.polarity);
+				}
 			}
 		}
 
@@ -6,6 +6,7 @@
 
 #include "container_generation.h"
 #include "data_exchange.h"
+#include "dvs_roi.h"
 #include "usb_utils.h"
 
 #define DVS_DEVICE_NAME "DVS128"
@@ -64,6 +65,8 @@ struct dvs128_state {
 		uint8_t biases[BIAS_NUMBER][BIAS_LENGTH];
 		atomic_bool running;
 		atomic_bool isMaster;
+		// Host-side region of interest.
+		struct dvs_roi roi;
 	} dvs;
 };
 
@@ -80,6 +83,7 @@ struct dvs128_handle {
 typedef struct dvs128_handle *dvs128Handle;
 
 ssize_t dvs128Find(caerDeviceDiscoveryResult *discoveredDevices);
+bool dvs128FindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice);
 
 caerDeviceHandle dvs128Open(
 	uint16_t deviceID, uint8_t busNumberRestrict, uint8_t devAddressRestrict, const char *serialNumberRestrict);
@@ -89,6 +89,11 @@ ssize_t dvs132sFind(caerDeviceDiscoveryResult *discoveredDevices) {
 		DVS132S_REQUIRED_LOGIC_PATCH_LEVEL, DVS132S_REQUIRED_FIRMWARE_VERSION, discoveredDevices, &populateDeviceInfo));
 }
 
+bool dvs132sFindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice) {
+	return (usbDeviceFindSingle(device, DVS132S_REQUIRED_LOGIC_VERSION, DVS132S_REQUIRED_LOGIC_PATCH_LEVEL,
+		DVS132S_REQUIRED_FIRMWARE_VERSION, discoveredDevice, &populateDeviceInfo));
+}
+
 static inline float calculateIMUAccelScale(uint8_t imuAccelScale) {
 	// Accelerometer scale is:
 	// 0 - +- 2 g  - 16384 LSB/g
@@ -122,21 +127,21 @@ static inline void freeAllDataMemory(dvs132sState state) {
 	// already assigned to the current packet container, we
 	// free them separately from it.
 	if (state->currentPackets.polarity != NULL) {
-		free(&state->currentPackets.polarity->packetHeader);
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
 		state->currentPackets.polarity = NULL;
 
 		containerGenerationSetPacket(&state->container, POLARITY_EVENT, NULL);
 	}
 
 	if (state->currentPackets.special != NULL) {
-		free(&state->currentPackets.special->packetHeader);
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
 		state->currentPackets.special = NULL;
 
 		containerGenerationSetPacket(&state->container, SPECIAL_EVENT, NULL);
 	}
 
 	if (state->currentPackets.imu6 != NULL) {
-		free(&state->currentPackets.imu6->packetHeader);
+		caerEventPacketFree(&state->currentPackets.imu6->packetHeader);
 		state->currentPackets.imu6 = NULL;
 
 		containerGenerationSetPacket(&state->container, IMU6_EVENT_PKT_POS, NULL);
@@ -1083,6 +1088,54 @@ static inline bool ensureSpaceForEvents(
 	return (true);
 }
 
+/**
+ * Fast path for runs of group address and pixel group events, see
+ * dvs132sGroupRunDecode(). Returns false if no word could be consumed, in
+ * which case the general translator has to handle the word at '*bufferPos'.
+ * Otherwise '*bufferPos' points to the last consumed word.
+ */
+static inline bool dvsTranslateGroupRun(
+	dvs132sHandle handle, const uint8_t *buffer, size_t bufferSize, size_t *bufferPos) {
+	dvs132sState state = &handle->state;
+
+	if (!ensureSpaceForEvents((caerEventPacketHeader *) &state->currentPackets.polarity,
+			(size_t) state->currentPackets.polarityPosition, DVS132S_GROUP_SIZE, handle)) {
+		return (false);
+	}
+
+	int32_t spaceEvents = caerEventPacketHeaderGetEventCapacity(&state->currentPackets.polarity->packetHeader)
+						  - state->currentPackets.polarityPosition;
+
+	// Stop at the container commit size, so that the size-triggered commit happens
+	// after exactly the same word as it would in the general translator.
+	int32_t stopEvents                       = INT32_MAX;
+	int32_t currentPacketContainerCommitSize = containerGenerationGetMaxPacketSize(&state->container);
+	if (currentPacketContainerCommitSize > 0) {
+		if (state->currentPackets.polarityPosition >= currentPacketContainerCommitSize) {
+			return (false);
+		}
+
+		stopEvents = currentPacketContainerCommitSize - state->currentPackets.polarityPosition;
+	}
+
+	size_t runPos = *bufferPos;
+
+	int32_t runEventsNumber = dvs132sGroupRunDecode(
+		caerPolarityEventPacketGetEvent(state->currentPackets.polarity, state->currentPackets.polarityPosition),
+		spaceEvents, stopEvents, buffer, bufferSize, &runPos, &state->dvs.lastX, &state->dvs.lastY,
+		U16T(state->dvs.sizeX), U16T(state->dvs.sizeY), state->dvs.invertXY, state->timestamps.current);
+
+	if (runPos == *bufferPos) {
+		return (false);
+	}
+
+	polarityGroupCommit(state->currentPackets.polarity, runEventsNumber);
+	state->currentPackets.polarityPosition += runEventsNumber;
+
+	*bufferPos = runPos - 2;
+	return (true);
+}
+
 static void dvs132sEventTranslator(void *vhd, const uint8_t *buffer, size_t bufferSize) {
 	dvs132sHandle handle = vhd;
 	dvs132sState state   = &handle->state;
@@ -1146,6 +1199,10 @@ static void dvs132sEventTranslator(void *vhd, const uint8_t *buffer, size_t buff
 
 			containerGenerationCommitTimestampInit(&state->container, state->timestamps.current);
 		}
+		else if (dvs132sGroupRunStart(event) && dvsTranslateGroupRun(handle, buffer, bufferSize, &bufferPos)) {
+			// Run of group addresses and pixel groups, fully handled by the fast path.
+			// Special, misc and wrap codes, as well as out-of-range addresses, go below.
+		}
 		else {
 			// Look at the code, to determine event and data type.
 			uint8_t code  = U8T((event & 0x7000) >> 12);
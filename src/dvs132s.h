@@ -6,6 +6,7 @@
 
 #include "container_generation.h"
 #include "data_exchange.h"
+#include "dvs132s_group_run.h"
 #include "usb_utils.h"
 
 #define IMU_TYPE_TEMP   0x01
@@ -103,6 +104,7 @@ struct dvs132s_handle {
 typedef struct dvs132s_handle *dvs132sHandle;
 
 ssize_t dvs132sFind(caerDeviceDiscoveryResult *discoveredDevices);
+bool dvs132sFindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice);
 
 caerDeviceHandle dvs132sOpen(
 	uint16_t deviceID, uint8_t busNumberRestrict, uint8_t devAddressRestrict, const char *serialNumberRestrict);
@@ -0,0 +1,127 @@
+#ifndef LIBCAER_SRC_DVS132S_GROUP_RUN_H_
+#define LIBCAER_SRC_DVS132S_GROUP_RUN_H_
+
+#include "polarity_groups.h"
+
+// Fast path for the DVS132S event stream: decode runs of row (Y) and column
+// (X) group addresses and 2x2 pixel group events without going through the
+// general state machine. The action for each word is looked up from its upper
+// four bits (timestamp flag and code); anything else ends the run.
+#define DVS132S_GROUP_RUN_END   0
+#define DVS132S_GROUP_RUN_Y     1
+#define DVS132S_GROUP_RUN_X     2
+#define DVS132S_GROUP_RUN_PIXEL 3
+
+#define DVS132S_GROUP_SIZE 4
+
+static const uint8_t dvs132sGroupRunActions[16] = {
+	DVS132S_GROUP_RUN_END,   // Code 0: special event.
+	DVS132S_GROUP_RUN_Y,     // Code 1: Y group address.
+	DVS132S_GROUP_RUN_X,     // Code 2: X group address.
+	DVS132S_GROUP_RUN_PIXEL, // Code 3: 4-pixel group event presence and polarity.
+	DVS132S_GROUP_RUN_END,   // Code 4-7: unused, misc 8bit, unused, timestamp wrap.
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,   // Timestamp words.
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,
+	DVS132S_GROUP_RUN_END,
+};
+
+// For every 4-bit presence mask, the indexes of the present pixels in
+// increasing order, one per nibble (LSB is first). Unused nibbles are zero.
+// Pixel order is top left, top right, bottom left, bottom right.
+static const uint16_t dvs132sGroupPixels[16] = {
+	0x0000, 0x0000, 0x0001, 0x0010, 0x0002, 0x0020, 0x0021, 0x0210,
+	0x0003, 0x0030, 0x0031, 0x0310, 0x0032, 0x0320, 0x0321, 0x3210,
+};
+
+static inline bool dvs132sGroupRunStart(uint16_t event) {
+	return (dvs132sGroupRunActions[event >> 12] != DVS132S_GROUP_RUN_END);
+}
+
+/**
+ * Decode a run of DVS132S group words, starting at '*bufferPos', into polarity
+ * events with the given timestamp. Decoding stops at the first word that is
+ * not a group word or an in-range group address (those go through the general
+ * translator, which also logs them), at the end of the buffer, before a pixel
+ * group that might not fit into 'spaceEvents' (each group writes four events,
+ * the unused ones zeroed), or after the word that brings the number of
+ * generated events to 'stopEvents' or more. '*bufferPos', '*lastX' and
+ * '*lastY' are updated to reflect all consumed words. The packet header is
+ * not touched, use polarityGroupCommit().
+ *
+ * @return number of generated events.
+ */
+static inline int32_t dvs132sGroupRunDecode(caerPolarityEvent events, int32_t spaceEvents, int32_t stopEvents,
+	const uint8_t *buffer, size_t bufferSize, size_t *bufferPos, uint16_t *lastX, uint16_t *lastY, uint16_t sizeX,
+	uint16_t sizeY, bool invertXY, int32_t timestamp) {
+	const int32_t timestampLE = I32T(htole32(U32T(timestamp)));
+
+	const uint32_t xStep = U32T(1U << POLARITY_X_ADDR_SHIFT);
+	const uint32_t yStep = U32T(1U << POLARITY_Y_ADDR_SHIFT);
+
+	// Data word offsets of the four pixels from the top left one.
+	const uint32_t pixelOffsets[DVS132S_GROUP_SIZE]
+		= {0, (invertXY) ? (yStep) : (xStep), (invertXY) ? (xStep) : (yStep), xStep + yStep};
+
+	size_t pos    = *bufferPos;
+	uint16_t x    = *lastX;
+	uint16_t y    = *lastY;
+	int32_t count = 0;
+
+	uint32_t baseData = (invertXY) ? (polarityGroupBaseData(y, x, false)) : (polarityGroupBaseData(x, y, false));
+
+	while ((pos < bufferSize) && (count < stopEvents)) {
+		uint16_t event = le16toh(*((const uint16_t *) (&buffer[pos])));
+		uint16_t data  = (event & 0x0FFF);
+		uint8_t action = dvs132sGroupRunActions[event >> 12];
+
+		// A pixel group may only start if all four of its events fit.
+		if ((action == DVS132S_GROUP_RUN_PIXEL) && (((size_t) count + DVS132S_GROUP_SIZE) <= (size_t) spaceEvents)) {
+			uint8_t presence        = U8T((data >> 4) & 0x0F);
+			uint8_t pixels          = polarityGroupCounts[presence];
+			uint16_t indexes        = dvs132sGroupPixels[presence];
+			caerPolarityEvent group = &events[count];
+
+			// Always write all four events, without branches, and zero the ones
+			// past the present pixels, so the packet tail stays invalid.
+			for (uint8_t i = 0; i < DVS132S_GROUP_SIZE; i++, indexes = U16T(indexes >> 4)) {
+				uint32_t pixel = indexes & 0x0F;
+				uint32_t keep  = (i < pixels) ? (UINT32_MAX) : (0);
+
+				group[i].data = htole32(
+					(baseData + pixelOffsets[pixel] + (U32T((data >> pixel) & 0x01) << POLARITY_SHIFT)) & keep);
+				group[i].timestamp = I32T(U32T(timestampLE) & keep);
+			}
+
+			count += pixels;
+		}
+		else if ((action == DVS132S_GROUP_RUN_Y) && (data < sizeY)) {
+			y        = data;
+			baseData = (invertXY) ? (polarityGroupBaseData(y, x, false)) : (polarityGroupBaseData(x, y, false));
+		}
+		else if ((action == DVS132S_GROUP_RUN_X) && (data < sizeX)) {
+			x        = data;
+			baseData = (invertXY) ? (polarityGroupBaseData(y, x, false)) : (polarityGroupBaseData(x, y, false));
+		}
+		else {
+			break;
+		}
+
+		pos += 2;
+	}
+
+	*bufferPos = pos;
+	*lastX     = x;
+	*lastY     = y;
+
+	return (count);
+}
+
+#endif /* LIBCAER_SRC_DVS132S_GROUP_RUN_H_ */
@@ -0,0 +1,435 @@
+#ifndef LIBCAER_SRC_DVS_ACCUMULATE_H_
+#define LIBCAER_SRC_DVS_ACCUMULATE_H_
+
+#include "libcaer/libcaer.h"
+
+#include "libcaer/devices/device.h"
+#include "libcaer/events/frame.h"
+#include "libcaer/events/polarity.h"
+
+#include "data_exchange.h"
+#include "timestamps.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Host-side DVS event accumulation into count images or time surfaces.
+// Translators hand every polarity event to dvsAccumulateEvents(), which
+// updates a per-pixel map. If events are not to be delivered (see
+// dvsAccumulateDiscards()), translators write them to scratch memory instead
+// of the packet, so they never reach the packet container. Every time an
+// event or the translator's timestamp (see dvsAccumulateTimestamp()) passes
+// the end of the current window, the map is turned into a frame, in its own
+// packet container, which is held back until the translator commits the
+// packet container with the window's events and calls dvsAccumulateFlush(),
+// so frames always come after the events they summarize. The settings are
+// atomic and snapshotted once per buffer with dvsAccumulateUpdate(), which
+// also (re)allocates the map; the map and window state are only accessed by
+// the translator.
+// Maximum number of frames held back between two packet container commits.
+// More only happens with windows much shorter than the container interval.
+#define DVS_ACCUMULATE_PENDING_FRAMES 32
+
+struct dvs_accumulate {
+	atomic_uint_fast8_t mode;
+	atomic_uint_fast32_t window;
+	atomic_uint_fast32_t decay;
+	atomic_bool deliverEvents;
+	// Array size in output orientation, gives the map index.
+	uint16_t sizeX;
+	uint16_t sizeY;
+	// Snapshot used by the translator.
+	struct {
+		uint8_t mode;
+		int64_t window;
+		double decay;
+		bool deliverEvents;
+		// Mode enabled and map allocated.
+		bool active;
+	} current;
+	// Per-pixel event counts (count image) or last event timestamps,
+	// -1 for none (time surface).
+	uint16_t *counts;
+	int64_t *lastTimestamps;
+	// Current window start, -1 before the first event.
+	int64_t windowStart;
+	// Frame containers waiting for dvsAccumulateFlush().
+	caerEventPacketContainer pendingFrames[DVS_ACCUMULATE_PENDING_FRAMES];
+	size_t pendingFramesNumber;
+	// Frame output, refreshed by dvsAccumulateUpdate().
+	dataExchange dataState;
+	int16_t deviceId;
+	const char *deviceString;
+	uint8_t deviceLogLevel;
+};
+
+typedef struct dvs_accumulate *dvsAccumulate;
+
+static inline void dvsAccumulateSettingsInit(dvsAccumulate acc, uint16_t sizeX, uint16_t sizeY) {
+	acc->sizeX = sizeX;
+	acc->sizeY = sizeY;
+
+	atomic_store(&acc->mode, CAER_DVS_ACCUMULATE_OFF);
+	atomic_store(&acc->window, 10000);
+	atomic_store(&acc->decay, 5000);
+	atomic_store(&acc->deliverEvents, true);
+
+	acc->current.mode          = CAER_DVS_ACCUMULATE_OFF;
+	acc->current.window        = 10000;
+	acc->current.decay         = 5000;
+	acc->current.deliverEvents = true;
+	acc->current.active        = false;
+
+	acc->counts              = NULL;
+	acc->lastTimestamps      = NULL;
+	acc->windowStart         = -1;
+	acc->pendingFramesNumber = 0;
+}
+
+static inline void dvsAccumulateMapFree(dvsAccumulate acc) {
+	free(acc->counts);
+	acc->counts = NULL;
+
+	free(acc->lastTimestamps);
+	acc->lastTimestamps = NULL;
+
+	acc->current.active = false;
+}
+
+static inline void dvsAccumulateDestroy(dvsAccumulate acc) {
+	dvsAccumulateMapFree(acc);
+
+	// Frames not sent out anymore.
+	for (size_t i = 0; i < acc->pendingFramesNumber; i++) {
+		caerEventPacketContainerFree(acc->pendingFrames[i]);
+	}
+
+	acc->pendingFramesNumber = 0;
+}
+
+/**
+ * Initialize 'copy', for an offline translator, with the settings of 'acc'.
+ * Its own map is allocated by the next dvsAccumulateUpdate().
+ */
+static inline void dvsAccumulateCopy(dvsAccumulate copy, dvsAccumulate acc) {
+	dvsAccumulateSettingsInit(copy, acc->sizeX, acc->sizeY);
+
+	atomic_store(&copy->mode, atomic_load(&acc->mode));
+	atomic_store(&copy->window, atomic_load(&acc->window));
+	atomic_store(&copy->decay, atomic_load(&acc->decay));
+	atomic_store(&copy->deliverEvents, atomic_load(&acc->deliverEvents));
+}
+
+// Clear the map and restart windowing at the next event.
+static inline void dvsAccumulateReset(dvsAccumulate acc) {
+	size_t pixels = (size_t) acc->sizeX * acc->sizeY;
+
+	if (acc->counts != NULL) {
+		memset(acc->counts, 0, pixels * sizeof(uint16_t));
+	}
+
+	if (acc->lastTimestamps != NULL) {
+		for (size_t i = 0; i < pixels; i++) {
+			acc->lastTimestamps[i] = -1;
+		}
+	}
+
+	acc->windowStart = -1;
+}
+
+/**
+ * Snapshot the settings for the next buffer, and allocate the map when the
+ * mode changes. Only call from the translator.
+ */
+static inline void dvsAccumulateUpdate(dvsAccumulate acc, dataExchange dataState, int16_t deviceId,
+	const char *deviceString, atomic_uint_fast8_t *deviceLogLevelAtomic) {
+	acc->dataState      = dataState;
+	acc->deviceId       = deviceId;
+	acc->deviceString   = deviceString;
+	acc->deviceLogLevel = atomic_load_explicit(deviceLogLevelAtomic, memory_order_relaxed);
+
+	uint8_t mode   = U8T(atomic_load_explicit(&acc->mode, memory_order_relaxed));
+	int64_t window = I64T(atomic_load_explicit(&acc->window, memory_order_relaxed));
+
+	acc->current.decay         = (double) atomic_load_explicit(&acc->decay, memory_order_relaxed);
+	acc->current.deliverEvents = atomic_load_explicit(&acc->deliverEvents, memory_order_relaxed);
+
+	if ((mode == acc->current.mode) && (window == acc->current.window)) {
+		return;
+	}
+
+	acc->current.mode   = mode;
+	acc->current.window = window;
+
+	// Start over with a fresh map.
+	dvsAccumulateMapFree(acc);
+
+	size_t pixels = (size_t) acc->sizeX * acc->sizeY;
+
+	if (mode == CAER_DVS_ACCUMULATE_COUNT) {
+		acc->counts = malloc(pixels * sizeof(uint16_t));
+		acc->current.active = (acc->counts != NULL);
+	}
+	else if (mode == CAER_DVS_ACCUMULATE_TIME_SURFACE) {
+		acc->lastTimestamps = malloc(pixels * sizeof(int64_t));
+		acc->current.active = (acc->lastTimestamps != NULL);
+	}
+
+	if ((mode != CAER_DVS_ACCUMULATE_OFF) && (!acc->current.active)) {
+		commonLog(CAER_LOG_CRITICAL, deviceString, acc->deviceLogLevel,
+			"Failed to allocate DVS accumulation map, accumulation disabled.");
+	}
+
+	dvsAccumulateReset(acc);
+}
+
+// Turn the map into a frame for the window [windowStart, windowEnd[, to be
+// sent out by dvsAccumulateFlush().
+static inline void dvsAccumulateCommit(dvsAccumulate acc, int64_t windowEnd) {
+	if (acc->pendingFramesNumber == DVS_ACCUMULATE_PENDING_FRAMES) {
+		commonLog(CAER_LOG_NOTICE, acc->deviceString, acc->deviceLogLevel,
+			"Dropped DVS accumulation frame because too many are waiting for the next packet container commit!");
+
+		if (acc->current.mode == CAER_DVS_ACCUMULATE_COUNT) {
+			// Counts start over with every window.
+			memset(acc->counts, 0, (size_t) acc->sizeX * acc->sizeY * sizeof(uint16_t));
+		}
+
+		return;
+	}
+
+	const int32_t sizeX = acc->sizeX;
+	const int32_t sizeY = acc->sizeY;
+
+	// Timestamps are relative to the overflow counter of the window's last microsecond.
+	int32_t tsOverflow = I32T((windowEnd - 1) >> TS_OVERFLOW_SHIFT);
+	int64_t tsBase     = I64T(U64T(tsOverflow) << TS_OVERFLOW_SHIFT);
+	int32_t tsStart    = (acc->windowStart >= tsBase) ? (I32T(acc->windowStart - tsBase)) : (0);
+	int32_t tsEnd      = I32T(windowEnd - 1 - tsBase);
+
+	caerEventPacketContainer container = caerEventPacketContainerAllocate(FRAME_EVENT + 1);
+	if (container == NULL) {
+		commonLog(CAER_LOG_CRITICAL, acc->deviceString, acc->deviceLogLevel,
+			"Failed to allocate DVS accumulation packet container.");
+		return;
+	}
+
+	caerFrameEventPacket packet
+		= caerFrameEventPacketAllocate(1, acc->deviceId, tsOverflow, sizeX, sizeY, GRAYSCALE);
+	if (packet == NULL) {
+		commonLog(CAER_LOG_CRITICAL, acc->deviceString, acc->deviceLogLevel,
+			"Failed to allocate DVS accumulation frame event packet.");
+		caerEventPacketContainerFree(container);
+		return;
+	}
+
+	caerFrameEvent frame = caerFrameEventPacketGetEvent(packet, 0);
+
+	caerFrameEventSetLengthXLengthYChannelNumber(frame, sizeX, sizeY, GRAYSCALE, packet);
+	caerFrameEventSetROIIdentifier(frame, CAER_DVS_ACCUMULATE_FRAME_ROI_ID);
+	caerFrameEventSetTSStartOfFrame(frame, tsStart);
+	caerFrameEventSetTSStartOfExposure(frame, tsStart);
+	caerFrameEventSetTSEndOfExposure(frame, tsEnd);
+	caerFrameEventSetTSEndOfFrame(frame, tsEnd);
+
+	uint16_t *pixels    = caerFrameEventGetPixelArrayUnsafe(frame);
+	size_t pixelsNumber = (size_t) sizeX * (size_t) sizeY;
+
+	if (acc->current.mode == CAER_DVS_ACCUMULATE_COUNT) {
+		for (size_t i = 0; i < pixelsNumber; i++) {
+			pixels[i] = htole16(acc->counts[i]);
+		}
+
+		// Counts start over with every window.
+		memset(acc->counts, 0, pixelsNumber * sizeof(uint16_t));
+	}
+	else {
+		for (size_t i = 0; i < pixelsNumber; i++) {
+			int64_t lastTimestamp = acc->lastTimestamps[i];
+
+			if (lastTimestamp < 0) {
+				continue; // Pixels are zeroed on allocation.
+			}
+
+			double value = (double) UINT16_MAX * exp((double) (lastTimestamp - (windowEnd - 1)) / acc->current.decay);
+
+			pixels[i] = htole16(U16T(lround(value)));
+		}
+	}
+
+	caerFrameEventValidate(frame, packet);
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader, 1);
+
+	caerEventPacketContainerSetEventPacket(container, FRAME_EVENT, (caerEventPacketHeader) packet);
+
+	acc->pendingFrames[acc->pendingFramesNumber++] = container;
+}
+
+/**
+ * Send out the frames of all windows ended so far. Call right after
+ * committing a packet container, which holds the events of those windows.
+ * Only call from the translator.
+ */
+static inline void dvsAccumulateFlush(dvsAccumulate acc) {
+	for (size_t i = 0; i < acc->pendingFramesNumber; i++) {
+		if (!dataExchangePut(acc->dataState, acc->pendingFrames[i])) {
+			commonLog(CAER_LOG_NOTICE, acc->deviceString, acc->deviceLogLevel,
+				"Dropped DVS accumulation frame because ring-buffer full!");
+
+			caerEventPacketContainerFree(acc->pendingFrames[i]);
+		}
+	}
+
+	acc->pendingFramesNumber = 0;
+}
+
+// Move the window up to 'timestamp', turning the window it ends into a frame.
+static inline void dvsAccumulateWindowAdvance(dvsAccumulate acc, int64_t timestamp) {
+	if (timestamp < acc->windowStart) {
+		// Timestamps went back (reset), so did the windows.
+		dvsAccumulateReset(acc);
+	}
+
+	if ((acc->windowStart >= 0) && (timestamp >= (acc->windowStart + acc->current.window))) {
+		int64_t windowEnd = acc->windowStart + acc->current.window;
+
+		dvsAccumulateCommit(acc, windowEnd);
+
+		// Skip over empty windows.
+		acc->windowStart = windowEnd + (((timestamp - windowEnd) / acc->current.window) * acc->current.window);
+	}
+}
+
+/**
+ * Check if polarity events are only accumulated, and not to be written to
+ * the packet. Only call from the translator.
+ */
+static inline bool dvsAccumulateDiscards(const struct dvs_accumulate *acc) {
+	return (acc->current.active && (!acc->current.deliverEvents));
+}
+
+/**
+ * Turn the windows that ended before the translator's current timestamp
+ * into frames, so they are also produced while no polarity events arrive.
+ * Call whenever the timestamp advances, such as after every event.
+ * Only call from the translator.
+ */
+static inline void dvsAccumulateTimestamp(dvsAccumulate acc, int32_t tsOverflow, int32_t timestamp) {
+	if (!acc->current.active) {
+		return;
+	}
+
+	dvsAccumulateWindowAdvance(acc, generateFullTimestamp(tsOverflow, timestamp));
+}
+
+/**
+ * Accumulate 'eventsNumber' polarity events, either just written to a packet
+ * or, if dvsAccumulateDiscards(), to scratch memory.
+ * 'tsOverflow' is the translator's current one, which all events share.
+ * Only call from the translator.
+ */
+static inline void dvsAccumulateEvents(
+	dvsAccumulate acc, caerPolarityEventConst events, int32_t eventsNumber, int32_t tsOverflow) {
+	if (!acc->current.active) {
+		return;
+	}
+
+	for (int32_t i = 0; i < eventsNumber; i++) {
+		caerPolarityEventConst event = &events[i];
+
+		int64_t timestamp = generateFullTimestamp(tsOverflow, caerPolarityEventGetTimestamp(event));
+
+		dvsAccumulateWindowAdvance(acc, timestamp);
+
+		if (acc->windowStart < 0) {
+			acc->windowStart = timestamp;
+		}
+
+		uint16_t x = caerPolarityEventGetX(event);
+		uint16_t y = caerPolarityEventGetY(event);
+
+		// Remapping can move events anywhere.
+		if ((x >= acc->sizeX) || (y >= acc->sizeY)) {
+			continue;
+		}
+
+		size_t index = ((size_t) y * acc->sizeX) + x;
+
+		if (acc->current.mode == CAER_DVS_ACCUMULATE_COUNT) {
+			if (acc->counts[index] != UINT16_MAX) {
+				acc->counts[index]++;
+			}
+		}
+		else {
+			acc->lastTimestamps[index] = timestamp;
+		}
+	}
+}
+
+static inline bool dvsAccumulateConfigSet(dvsAccumulate acc, uint8_t paramAddr, uint32_t param) {
+	switch (paramAddr) {
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE_MODE:
+			if (param > CAER_DVS_ACCUMULATE_TIME_SURFACE) {
+				return (false);
+			}
+
+			atomic_store(&acc->mode, U8T(param));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE_WINDOW:
+			if ((param == 0) || (param > INT32_MAX)) {
+				return (false);
+			}
+
+			atomic_store(&acc->window, param);
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE_DECAY:
+			if (param == 0) {
+				return (false);
+			}
+
+			atomic_store(&acc->decay, param);
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE_DELIVER_EVENTS:
+			atomic_store(&acc->deliverEvents, param);
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+static inline bool dvsAccumulateConfigGet(dvsAccumulate acc, uint8_t paramAddr, uint32_t *param) {
+	switch (paramAddr) {
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE_MODE:
+			*param = U32T(atomic_load(&acc->mode));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE_WINDOW:
+			*param = U32T(atomic_load(&acc->window));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE_DECAY:
+			*param = U32T(atomic_load(&acc->decay));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE_DELIVER_EVENTS:
+			*param = atomic_load(&acc->deliverEvents);
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+#endif /* LIBCAER_SRC_DVS_ACCUMULATE_H_ */
@@ -0,0 +1,93 @@
+#include "libcaer/dvs_remap.h"
+
+#include <math.h>
+
+#define DVS_REMAP_MAX_ADDRESS          32767
+#define DVS_REMAP_UNDISTORT_ITERATIONS 8
+
+// Invert the distortion model iteratively, starting from the distorted
+// normalized point, like OpenCV's undistortPoints() does.
+static void undistortPoint(const struct caer_dvs_remap_distortion *distortion, double *x, double *y) {
+	const double xDistorted = (*x - (double) distortion->cx) / (double) distortion->fx;
+	const double yDistorted = (*y - (double) distortion->cy) / (double) distortion->fy;
+
+	double xUndistorted = xDistorted;
+	double yUndistorted = yDistorted;
+
+	for (size_t i = 0; i < DVS_REMAP_UNDISTORT_ITERATIONS; i++) {
+		const double r2 = (xUndistorted * xUndistorted) + (yUndistorted * yUndistorted);
+
+		const double radial = 1.0
+							  + (r2
+								  * ((double) distortion->k1
+									  + (r2 * ((double) distortion->k2 + (r2 * (double) distortion->k3)))));
+
+		const double deltaX = (2.0 * (double) distortion->p1 * xUndistorted * yUndistorted)
+							  + ((double) distortion->p2 * (r2 + (2.0 * xUndistorted * xUndistorted)));
+		const double deltaY = ((double) distortion->p1 * (r2 + (2.0 * yUndistorted * yUndistorted)))
+							  + (2.0 * (double) distortion->p2 * xUndistorted * yUndistorted);
+
+		xUndistorted = (xDistorted - deltaX) / radial;
+		yUndistorted = (yDistorted - deltaY) / radial;
+	}
+
+	*x = (xUndistorted * (double) distortion->fx) + (double) distortion->cx;
+	*y = (yUndistorted * (double) distortion->fy) + (double) distortion->cy;
+}
+
+bool caerDVSRemapBuild(uint32_t *remapTable, uint16_t sizeX, uint16_t sizeY, uint8_t orientation,
+	const struct caer_dvs_remap_distortion *distortion) {
+	if ((remapTable == NULL) || (sizeX == 0) || (sizeY == 0) || (sizeX > (DVS_REMAP_MAX_ADDRESS + 1))
+		|| (sizeY > (DVS_REMAP_MAX_ADDRESS + 1))) {
+		return (false);
+	}
+
+	if ((distortion != NULL) && ((distortion->fx == 0.0F) || (distortion->fy == 0.0F))) {
+		return (false);
+	}
+
+	// Exchanging X and Y of a non-square array gives addresses outside of it.
+	if ((orientation & CAER_DVS_REMAP_INVERT_XY) && (sizeX != sizeY)) {
+		return (false);
+	}
+
+	for (uint16_t y = 0; y < sizeY; y++) {
+		for (uint16_t x = 0; x < sizeX; x++) {
+			double newX = (double) x;
+			double newY = (double) y;
+
+			if (distortion != NULL) {
+				undistortPoint(distortion, &newX, &newY);
+
+				newX = round(newX);
+				newY = round(newY);
+
+				// Pixels moved outside of the array are dropped.
+				if ((!isfinite(newX)) || (!isfinite(newY)) || (newX < 0) || (newX >= (double) sizeX) || (newY < 0)
+					|| (newY >= (double) sizeY)) {
+					remapTable[(size_t) y * sizeX + x] = CAER_DVS_REMAP_DROP;
+					continue;
+				}
+			}
+
+			uint16_t outX = U16T(newX);
+			uint16_t outY = U16T(newY);
+
+			if (orientation & CAER_DVS_REMAP_FLIP_X) {
+				outX = U16T(sizeX - 1 - outX);
+			}
+
+			if (orientation & CAER_DVS_REMAP_FLIP_Y) {
+				outY = U16T(sizeY - 1 - outY);
+			}
+
+			if (orientation & CAER_DVS_REMAP_INVERT_XY) {
+				SWAP_VAR(uint16_t, outX, outY);
+			}
+
+			remapTable[(size_t) y * sizeX + x] = CAER_DVS_REMAP_ADDRESS(outX, outY);
+		}
+	}
+
+	return (true);
+}
@@ -0,0 +1,233 @@
+#ifndef LIBCAER_SRC_DVS_REMAP_H_
+#define LIBCAER_SRC_DVS_REMAP_H_
+
+#include "libcaer/dvs_remap.h"
+
+#include "libcaer/events/polarity.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Per-pixel DVS address remapping, applied by the translators while writing
+// polarity events. The user-facing table (see libcaer/dvs_remap.h) is
+// converted once into polarity event data words (address bits only, not
+// valid), so remapping an event is a single lookup. Drop entries keep the
+// CAER_DVS_REMAP_DROP value, which is never a valid address.
+// The converted table is indexed by sensor address: the host-side exchange
+// of X and Y is folded into it, so translators skip it when remapping.
+// Tables never change once built, and are reference counted: new ones are
+// handed over through 'pending' and picked up by the translator thread at
+// the start of a buffer with dvsRemapUpdate(), so the table in use is never
+// freed under the translator. 'latest' keeps the last table set, from which
+// offline translators get theirs with dvsRemapCopy() at any time.
+struct dvs_remap_table {
+	atomic_uint_fast32_t references;
+	// Number of entries, zero to disable remapping.
+	size_t size;
+	uint32_t data[];
+};
+
+struct dvs_remap {
+	atomic_uintptr_t pending;
+	// Table in use, only accessed by the translator.
+	struct dvs_remap_table *current;
+	// Last table set, guarded by 'latestLock'.
+	struct dvs_remap_table *latest;
+	atomic_flag latestLock;
+	// Array size in output orientation, of the user-facing table.
+	uint16_t sizeX;
+	uint16_t sizeY;
+	// Whether the translator exchanges X and Y of sensor addresses.
+	bool invertXY;
+	// Sensor array width, gives the converted table index.
+	uint16_t sensorSizeX;
+};
+
+typedef struct dvs_remap *dvsRemap;
+
+static inline void dvsRemapTableRelease(struct dvs_remap_table *table) {
+	if ((table != NULL) && (atomic_fetch_sub(&table->references, 1) == 1)) {
+		free(table);
+	}
+}
+
+static inline void dvsRemapLatestLock(dvsRemap remap) {
+	while (atomic_flag_test_and_set_explicit(&remap->latestLock, memory_order_acquire)) {
+		;
+	}
+}
+
+static inline void dvsRemapLatestUnlock(dvsRemap remap) {
+	atomic_flag_clear_explicit(&remap->latestLock, memory_order_release);
+}
+
+/**
+ * Initialize for an array of 'sizeX' by 'sizeY' pixels in output orientation.
+ * 'invertXY' tells if the translator exchanges X and Y of sensor addresses.
+ */
+static inline void dvsRemapInit(dvsRemap remap, uint16_t sizeX, uint16_t sizeY, bool invertXY) {
+	atomic_store(&remap->pending, (uintptr_t) NULL);
+	remap->current = NULL;
+	remap->latest  = NULL;
+	atomic_flag_clear(&remap->latestLock);
+	remap->sizeX       = sizeX;
+	remap->sizeY       = sizeY;
+	remap->invertXY    = invertXY;
+	remap->sensorSizeX = (invertXY) ? (sizeY) : (sizeX);
+}
+
+static inline void dvsRemapDestroy(dvsRemap remap) {
+	dvsRemapTableRelease((struct dvs_remap_table *) atomic_exchange(&remap->pending, (uintptr_t) NULL));
+
+	dvsRemapTableRelease(remap->current);
+	remap->current = NULL;
+
+	dvsRemapTableRelease(remap->latest);
+	remap->latest = NULL;
+}
+
+/**
+ * Hand a new remapping table over to the translator. NULL disables
+ * remapping. The table is copied.
+ *
+ * @return false on allocation failure or invalid addresses in the table.
+ */
+static inline bool dvsRemapSet(dvsRemap remap, const uint32_t *remapTable) {
+	size_t size = (remapTable == NULL) ? (0) : ((size_t) remap->sizeX * remap->sizeY);
+
+	struct dvs_remap_table *table = malloc(sizeof(struct dvs_remap_table) + (size * sizeof(uint32_t)));
+	if (table == NULL) {
+		return (false);
+	}
+
+	table->size = size;
+
+	for (size_t i = 0; i < size; i++) {
+		uint32_t entry = remapTable[i];
+
+		// Entry 'i' is for output address (x, y), store it at the sensor address.
+		size_t x     = i % remap->sizeX;
+		size_t y     = i / remap->sizeX;
+		size_t index = (remap->invertXY) ? ((x * remap->sensorSizeX) + y) : (i);
+
+		if (entry == CAER_DVS_REMAP_DROP) {
+			table->data[index] = CAER_DVS_REMAP_DROP;
+			continue;
+		}
+
+		uint16_t remapX = CAER_DVS_REMAP_GET_X(entry);
+		uint16_t remapY = CAER_DVS_REMAP_GET_Y(entry);
+
+		if ((remapX > POLARITY_X_ADDR_MASK) || (remapY > POLARITY_Y_ADDR_MASK)) {
+			free(table);
+			return (false);
+		}
+
+		table->data[index] = (U32T(remapX) << POLARITY_X_ADDR_SHIFT) | (U32T(remapY) << POLARITY_Y_ADDR_SHIFT);
+	}
+
+	// One reference for 'pending' (then 'current'), one for 'latest'.
+	atomic_store(&table->references, 2);
+
+	dvsRemapLatestLock(remap);
+	struct dvs_remap_table *oldLatest = remap->latest;
+	remap->latest                     = table;
+	dvsRemapLatestUnlock(remap);
+
+	dvsRemapTableRelease(oldLatest);
+
+	// Replace a table that was not picked up yet.
+	dvsRemapTableRelease((struct dvs_remap_table *) atomic_exchange(&remap->pending, (uintptr_t) table));
+
+	return (true);
+}
+
+/**
+ * Pick up a new table, if any. Only call from the translator.
+ */
+static inline void dvsRemapUpdate(dvsRemap remap) {
+	struct dvs_remap_table *table = (struct dvs_remap_table *) atomic_exchange(&remap->pending, (uintptr_t) NULL);
+	if (table == NULL) {
+		return;
+	}
+
+	dvsRemapTableRelease(remap->current);
+
+	if (table->size == 0) {
+		// Remapping disabled.
+		dvsRemapTableRelease(table);
+		table = NULL;
+	}
+
+	remap->current = table;
+}
+
+/**
+ * Initialize 'copy', for an offline translator, with the last table set on
+ * 'remap'. The table is shared, not copied, so this can run at any time,
+ * also while 'remap' is in use by a running translator.
+ */
+static inline void dvsRemapCopy(dvsRemap copy, dvsRemap remap) {
+	dvsRemapInit(copy, remap->sizeX, remap->sizeY, remap->invertXY);
+
+	dvsRemapLatestLock(remap);
+	struct dvs_remap_table *table = remap->latest;
+	if (table != NULL) {
+		// One reference for 'current', one for 'latest'.
+		atomic_fetch_add(&table->references, 2);
+	}
+	dvsRemapLatestUnlock(remap);
+
+	copy->latest = table;
+
+	if ((table != NULL) && (table->size == 0)) {
+		// Remapping disabled.
+		dvsRemapTableRelease(table);
+		table = NULL;
+	}
+
+	copy->current = table;
+}
+
+/**
+ * Polarity event data word (without polarity and valid mark) for the event
+ * at sensor address (x, y), before any exchange of X and Y, or
+ * CAER_DVS_REMAP_DROP. Only call if remap->current is not NULL.
+ */
+static inline uint32_t dvsRemapLookup(const struct dvs_remap *remap, uint16_t x, uint16_t y) {
+	return (remap->current->data[((size_t) y * remap->sensorSizeX) + x]);
+}
+
+/**
+ * Remapping counterpart of polarityGroupExpand(), for an 8-pixel column
+ * group starting at sensor address (x, y) and going down (bit 'i' is row y + i).
+ * Dropped pixels generate no event; only the generated events are written.
+ * Only call if remap->current is not NULL.
+ *
+ * @return number of generated events.
+ */
+static inline int32_t dvsRemapGroupExpand(caerPolarityEvent events, uint8_t groupMask, const struct dvs_remap *remap,
+	uint16_t x, uint16_t y, bool polarity, int32_t timestamp) {
+	const uint32_t flags      = (U32T(polarity) << POLARITY_SHIFT) | (U32T(1) << VALID_MARK_SHIFT);
+	const int32_t timestampLE = I32T(htole32(U32T(timestamp)));
+	int32_t count             = 0;
+
+	for (uint16_t i = 0; groupMask != 0; i++, groupMask = U8T(groupMask >> 1)) {
+		if ((groupMask & 0x01) == 0) {
+			continue;
+		}
+
+		uint32_t remapData = dvsRemapLookup(remap, x, U16T(y + i));
+
+		if (remapData != CAER_DVS_REMAP_DROP) {
+			events[count].data      = htole32(remapData | flags);
+			events[count].timestamp = timestampLE;
+			count++;
+		}
+	}
+
+	return (count);
+}
+
+#endif /* LIBCAER_SRC_DVS_REMAP_H_ */
@@ -0,0 +1,211 @@
+#ifndef LIBCAER_SRC_DVS_ROI_H_
+#define LIBCAER_SRC_DVS_ROI_H_
+
+#include "libcaer/libcaer.h"
+
+#include "libcaer/devices/device.h"
+
+#include <stdatomic.h>
+
+// Host-side DVS region of interest and spatial decimation, for devices that
+// cannot crop in hardware. The settings are atomic, so they can be changed
+// while data is flowing; translators take a snapshot of them with
+// dvsROIUpdate() once per buffer, and then check every address against it
+// before writing any polarity event.
+struct dvs_roi {
+	atomic_uint_fast16_t startColumn;
+	atomic_uint_fast16_t startRow;
+	atomic_uint_fast16_t endColumn;
+	atomic_uint_fast16_t endRow;
+	atomic_uint_fast16_t decimation;
+	// Array size, for validation.
+	uint16_t sizeX;
+	uint16_t sizeY;
+	// Snapshot used by the translator.
+	struct {
+		uint16_t startColumn;
+		uint16_t startRow;
+		uint16_t lengthX;
+		uint16_t lengthY;
+		uint16_t decimation;
+		bool fullArray;
+	} current;
+};
+
+typedef struct dvs_roi *dvsROI;
+
+static inline void dvsROIUpdate(dvsROI roi) {
+	uint16_t startColumn = U16T(atomic_load_explicit(&roi->startColumn, memory_order_relaxed));
+	uint16_t startRow    = U16T(atomic_load_explicit(&roi->startRow, memory_order_relaxed));
+	uint16_t endColumn   = U16T(atomic_load_explicit(&roi->endColumn, memory_order_relaxed));
+	uint16_t endRow      = U16T(atomic_load_explicit(&roi->endRow, memory_order_relaxed));
+
+	roi->current.startColumn = startColumn;
+	roi->current.startRow    = startRow;
+	// An end before the start selects nothing.
+	roi->current.lengthX    = (endColumn >= startColumn) ? (U16T(endColumn - startColumn + 1)) : (0);
+	roi->current.lengthY    = (endRow >= startRow) ? (U16T(endRow - startRow + 1)) : (0);
+	roi->current.decimation = U16T(atomic_load_explicit(&roi->decimation, memory_order_relaxed));
+
+	roi->current.fullArray = (roi->current.startColumn == 0) && (roi->current.startRow == 0)
+							 && (roi->current.lengthX == roi->sizeX) && (roi->current.lengthY == roi->sizeY)
+							 && (roi->current.decimation == 1);
+}
+
+static inline void dvsROISettingsInit(dvsROI roi, uint16_t sizeX, uint16_t sizeY) {
+	roi->sizeX = sizeX;
+	roi->sizeY = sizeY;
+
+	// Whole array, no decimation.
+	atomic_store(&roi->startColumn, 0);
+	atomic_store(&roi->startRow, 0);
+	atomic_store(&roi->endColumn, U16T(sizeX - 1));
+	atomic_store(&roi->endRow, U16T(sizeY - 1));
+	atomic_store(&roi->decimation, 1);
+
+	dvsROIUpdate(roi);
+}
+
+// Take over the region of interest of 'roi', for an offline translator.
+static inline void dvsROISettingsCopy(dvsROI copy, dvsROI roi) {
+	copy->sizeX = roi->sizeX;
+	copy->sizeY = roi->sizeY;
+
+	atomic_store(&copy->startColumn, atomic_load(&roi->startColumn));
+	atomic_store(&copy->startRow, atomic_load(&roi->startRow));
+	atomic_store(&copy->endColumn, atomic_load(&roi->endColumn));
+	atomic_store(&copy->endRow, atomic_load(&roi->endRow));
+	atomic_store(&copy->decimation, atomic_load(&roi->decimation));
+
+	dvsROIUpdate(copy);
+}
+
+static inline bool dvsROIAcceptColumn(const struct dvs_roi *roi, uint16_t x) {
+	// Unsigned wrap-around makes addresses before the start fail the length check.
+	uint16_t offset = U16T(x - roi->current.startColumn);
+
+	return ((offset < roi->current.lengthX)
+			&& ((roi->current.decimation == 1) || ((offset % roi->current.decimation) == 0)));
+}
+
+static inline bool dvsROIAcceptRow(const struct dvs_roi *roi, uint16_t y) {
+	uint16_t offset = U16T(y - roi->current.startRow);
+
+	return ((offset < roi->current.lengthY)
+			&& ((roi->current.decimation == 1) || ((offset % roi->current.decimation) == 0)));
+}
+
+/**
+ * Check if an event at address (x, y), in output orientation, is inside
+ * the current region of interest and on the decimation grid.
+ */
+static inline bool dvsROIAccept(const struct dvs_roi *roi, uint16_t x, uint16_t y) {
+	return (roi->current.fullArray || (dvsROIAcceptColumn(roi, x) && dvsROIAcceptRow(roi, y)));
+}
+
+/**
+ * Mask of the pixels of an 8-pixel column group, starting at address (x, y)
+ * and going down (bit 'i' is row y + i), that are inside the current region
+ * of interest. AND it with the group event mask before expanding it.
+ */
+static inline uint8_t dvsROIGroupMask(const struct dvs_roi *roi, uint16_t x, uint16_t y) {
+	if (roi->current.fullArray) {
+		return (0xFF);
+	}
+
+	if (!dvsROIAcceptColumn(roi, x)) {
+		return (0x00);
+	}
+
+	uint8_t mask = 0;
+
+	for (uint16_t i = 0; i < 8; i++) {
+		if (dvsROIAcceptRow(roi, U16T(y + i))) {
+			mask = U8T(mask | (1 << i));
+		}
+	}
+
+	return (mask);
+}
+
+static inline bool dvsROIConfigSet(dvsROI roi, uint8_t paramAddr, uint32_t param) {
+	switch (paramAddr) {
+		case CAER_HOST_CONFIG_DVS_ROI_START_COLUMN:
+			if (param >= roi->sizeX) {
+				return (false);
+			}
+
+			atomic_store(&roi->startColumn, U16T(param));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ROI_START_ROW:
+			if (param >= roi->sizeY) {
+				return (false);
+			}
+
+			atomic_store(&roi->startRow, U16T(param));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ROI_END_COLUMN:
+			if (param >= roi->sizeX) {
+				return (false);
+			}
+
+			atomic_store(&roi->endColumn, U16T(param));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ROI_END_ROW:
+			if (param >= roi->sizeY) {
+				return (false);
+			}
+
+			atomic_store(&roi->endRow, U16T(param));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ROI_DECIMATION:
+			if ((param == 0) || (param > UINT16_MAX)) {
+				return (false);
+			}
+
+			atomic_store(&roi->decimation, U16T(param));
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+static inline bool dvsROIConfigGet(dvsROI roi, uint8_t paramAddr, uint32_t *param) {
+	switch (paramAddr) {
+		case CAER_HOST_CONFIG_DVS_ROI_START_COLUMN:
+			*param = U32T(atomic_load(&roi->startColumn));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ROI_START_ROW:
+			*param = U32T(atomic_load(&roi->startRow));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ROI_END_COLUMN:
+			*param = U32T(atomic_load(&roi->endColumn));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ROI_END_ROW:
+			*param = U32T(atomic_load(&roi->endRow));
+			break;
+
+		case CAER_HOST_CONFIG_DVS_ROI_DECIMATION:
+			*param = U32T(atomic_load(&roi->decimation));
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+#endif /* LIBCAER_SRC_DVS_ROI_H_ */
@@ -4,6 +4,8 @@
 
 static void dvXplorerLog(enum caer_log_level logLevel, dvXplorerHandle handle, const char *format, ...)
 	ATTRIBUTE_FORMAT(3);
+static bool dvXplorerDataAllocate(dvXplorerHandle handle);
+static void dvXplorerPacketsFlush(dvXplorerHandle handle);
 static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent);
 static void dvXplorerTSMasterStatusUpdater(void *userDataPtr, int status, uint32_t param);
 static void resetParser(dvXplorerHandle handle, const char *reason);
@@ -91,6 +93,11 @@ ssize_t dvXplorerFind(caerDeviceDiscoveryResult *discoveredDevices) {
 		&populateDeviceInfo));
 }
 
+bool dvXplorerFindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice) {
+	return (usbDeviceFindSingle(device, DVXPLORER_REQUIRED_LOGIC_VERSION, DVXPLORER_REQUIRED_LOGIC_PATCH_LEVEL,
+		DVXPLORER_REQUIRED_FIRMWARE_VERSION, discoveredDevice, &populateDeviceInfo));
+}
+
 static inline float calculateIMUAccelScale(uint8_t imuAccelScale) {
 	// Accelerometer scale is:
 	// 0 - +- 2 g  - 16384 LSB/g
@@ -124,21 +131,21 @@ static inline void freeAllDataMemory(dvXplorerState state) {
 	// already assigned to the current packet container, we
 	// free them separately from it.
 	if (state->currentPackets.polarity != NULL) {
-		free(&state->currentPackets.polarity->packetHeader);
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
 		state->currentPackets.polarity = NULL;
 
 		containerGenerationSetPacket(&state->container, POLARITY_EVENT, NULL);
 	}
 
 	if (state->currentPackets.special != NULL) {
-		free(&state->currentPackets.special->packetHeader);
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
 		state->currentPackets.special = NULL;
 
 		containerGenerationSetPacket(&state->container, SPECIAL_EVENT, NULL);
 	}
 
 	if (state->currentPackets.imu6 != NULL) {
-		free(&state->currentPackets.imu6->packetHeader);
+		caerEventPacketFree(&state->currentPackets.imu6->packetHeader);
 		state->currentPackets.imu6 = NULL;
 
 		containerGenerationSetPacket(&state->container, IMU6_EVENT_PKT_POS, NULL);
@@ -168,6 +175,7 @@ caerDeviceHandle dvXplorerOpen(
 
 	// Initialize state variables to default values (if not zero, taken care of by calloc above).
 	dataExchangeSettingsInit(&state->dataExchange);
+	dataExchangeSetRawCaptureSupported(&state->dataExchange);
 
 	// Packet settings (size (in events) and time interval (in µs)).
 	containerGenerationSettingsInit(&state->container);
@@ -302,6 +310,12 @@ caerDeviceHandle dvXplorerOpen(
 	dvXplorerLog(CAER_LOG_DEBUG, handle, "DVS Size X: %d, Size Y: %d, Invert: %d.", state->dvs.sizeX, state->dvs.sizeY,
 		state->dvs.invertXY);
 
+	// Sizes in output orientation, X and Y are already exchanged. Only the USB
+	// translator exchanges X and Y of sensor addresses.
+	dvsRemapInit(&state->dvs.remap, U16T(handle->info.dvsSizeX), U16T(handle->info.dvsSizeY),
+		state->dvs.invertXY && (!handle->state.isMipiCX3Device));
+	dvsAccumulateSettingsInit(&state->dvs.accumulate, U16T(handle->info.dvsSizeX), U16T(handle->info.dvsSizeY));
+
 	spiConfigReceive(&state->usbState, DVX_IMU, DVX_IMU_ORIENTATION_INFO, &param32);
 	state->imu.flipX = param32 & 0x04;
 	state->imu.flipY = param32 & 0x02;
@@ -382,6 +396,8 @@ bool dvXplorerClose(caerDeviceHandle cdh) {
 	dvXplorerLog(CAER_LOG_DEBUG, handle, "Shutdown successful.");
 
 	// Free memory.
+	dvsRemapDestroy(&state->dvs.remap);
+	dvsAccumulateDestroy(&state->dvs.accumulate);
 	free(handle->info.deviceString);
 	free(handle);
 
@@ -544,6 +560,10 @@ bool dvXplorerConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr,
 			return (containerGenerationConfigSet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE:
+			return (dvsAccumulateConfigSet(&state->dvs.accumulate, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -1460,6 +1480,10 @@ bool dvXplorerConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr,
 			return (containerGenerationConfigGet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ACCUMULATE:
+			return (dvsAccumulateConfigGet(&state->dvs.accumulate, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -2370,16 +2394,8 @@ bool dvXplorerConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr,
 	return (true);
 }
 
-bool dvXplorerDataStart(caerDeviceHandle cdh, void (*dataNotifyIncrease)(void *ptr),
-	void (*dataNotifyDecrease)(void *ptr), void *dataNotifyUserPtr, void (*dataShutdownNotify)(void *ptr),
-	void *dataShutdownUserPtr) {
-	dvXplorerHandle handle = (dvXplorerHandle) cdh;
-	dvXplorerState state   = &handle->state;
-
-	usbSetShutdownCallback(&state->usbState, dataShutdownNotify, dataShutdownUserPtr);
-
-	// Store new data available/not available anymore call-backs.
-	dataExchangeSetNotify(&state->dataExchange, dataNotifyIncrease, dataNotifyDecrease, dataNotifyUserPtr);
+static bool dvXplorerDataAllocate(dvXplorerHandle handle) {
+	dvXplorerState state = &handle->state;
 
 	containerGenerationCommitTimestampReset(&state->container);
 
@@ -2428,6 +2444,24 @@ bool dvXplorerDataStart(caerDeviceHandle cdh, void (*dataNotifyIncrease)(void *p
 	// the first one is observed.
 	state->imu.ignoreEvents = true;
 
+	return (true);
+}
+
+bool dvXplorerDataStart(caerDeviceHandle cdh, void (*dataNotifyIncrease)(void *ptr),
+	void (*dataNotifyDecrease)(void *ptr), void *dataNotifyUserPtr, void (*dataShutdownNotify)(void *ptr),
+	void *dataShutdownUserPtr) {
+	dvXplorerHandle handle = (dvXplorerHandle) cdh;
+	dvXplorerState state   = &handle->state;
+
+	usbSetShutdownCallback(&state->usbState, dataShutdownNotify, dataShutdownUserPtr);
+
+	// Store new data available/not available anymore call-backs.
+	dataExchangeSetNotify(&state->dataExchange, dataNotifyIncrease, dataNotifyDecrease, dataNotifyUserPtr);
+
+	if (!dvXplorerDataAllocate(handle)) {
+		return (false);
+	}
+
 	// Ensure no data is left over from previous runs, if the camera
 	// wasn't shut-down properly. First ensure it is shut down completely.
 	dvXplorerConfigSet(cdh, DVX_DVS, DVX_DVS_RUN, false);
@@ -2530,10 +2564,264 @@ caerEventPacketContainer dvXplorerDataGet(caerDeviceHandle cdh) {
 	return (dataExchangeGet(&state->dataExchange, &state->usbState.dataTransfersRun));
 }
 
+caerDeviceRawBuffer dvXplorerDataGetRaw(caerDeviceHandle cdh) {
+	dvXplorerHandle handle = (dvXplorerHandle) cdh;
+	dvXplorerState state   = &handle->state;
+
+	return (dataExchangeGetRaw(&state->dataExchange, &state->usbState.dataTransfersRun));
+}
+
+bool dvXplorerDVSRemapSet(caerDeviceHandle cdh, const uint32_t *remapTable) {
+	dvXplorerHandle handle = (dvXplorerHandle) cdh;
+	dvXplorerState state   = &handle->state;
+
+	if (!dvsRemapSet(&state->dvs.remap, remapTable)) {
+		dvXplorerLog(CAER_LOG_ERROR, handle, "Failed to set DVS remapping table (invalid address or out of memory).");
+		return (false);
+	}
+
+	return (true);
+}
+
+void *dvXplorerTranslatorOpen(caerDeviceHandle cdh, dataExchange *translatorDataExchange,
+	containerGeneration *translatorContainer, atomic_uint_fast8_t **translatorLogLevel) {
+	dvXplorerHandle handle = (dvXplorerHandle) cdh;
+
+	// Everything not set below starts out zeroed, like on a newly opened device.
+	dvXplorerHandle translator = calloc(1, sizeof(struct dvxplorer_handle));
+	if (translator == NULL) {
+		dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate offline translator.");
+		return (NULL);
+	}
+
+	char *translatorString = malloc(USB_INFO_STRING_SIZE);
+	if (translatorString == NULL) {
+		free(translator);
+
+		dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to generate offline translator information string.");
+		return (NULL);
+	}
+
+	snprintf(translatorString, USB_INFO_STRING_SIZE, "%s (offline)", handle->info.deviceString);
+
+	translator->deviceType        = handle->deviceType;
+	translator->info              = handle->info;
+	translator->info.deviceString = translatorString;
+
+	dvXplorerState state       = &translator->state;
+	dvXplorerState deviceState = &handle->state;
+
+	// There is no device behind a translator: no USB transfers, the data
+	// path is always running, and control transfers fail (no device handle).
+	atomic_store(&state->usbState.dataTransfersRun, TRANS_RUNNING);
+
+	// Only take over the decoding settings from the device, which may still
+	// be running. The decoding state starts out fresh, as on data start.
+	atomic_store(&state->deviceLogLevel, atomic_load(&deviceState->deviceLogLevel));
+
+	dataExchangeSettingsInit(&state->dataExchange);
+	containerGenerationSettingsCopy(&state->container, &deviceState->container);
+
+	state->isMipiCX3Device = deviceState->isMipiCX3Device;
+
+	state->dvs.sizeX         = deviceState->dvs.sizeX;
+	state->dvs.sizeY         = deviceState->dvs.sizeY;
+	state->dvs.flipX         = deviceState->dvs.flipX;
+	state->dvs.flipY         = deviceState->dvs.flipY;
+	state->dvs.invertXY      = deviceState->dvs.invertXY;
+	state->dvs.cropperYStart = deviceState->dvs.cropperYStart;
+	state->dvs.cropperYEnd   = deviceState->dvs.cropperYEnd;
+	state->dvs.dualBinning   = deviceState->dvs.dualBinning;
+
+	// Shares the last remapping table set on the device.
+	dvsRemapCopy(&state->dvs.remap, &deviceState->dvs.remap);
+
+	// Own accumulation map, allocated on first use.
+	dvsAccumulateCopy(&state->dvs.accumulate, &deviceState->dvs.accumulate);
+
+	state->imu.flipX = deviceState->imu.flipX;
+	state->imu.flipY = deviceState->imu.flipY;
+	state->imu.flipZ = deviceState->imu.flipZ;
+
+	state->deviceClocks = deviceState->deviceClocks;
+
+	if (!dvXplorerDataAllocate(translator)) {
+		dvsRemapDestroy(&state->dvs.remap);
+		free(translatorString);
+		free(translator);
+
+		dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to initialize offline translator.");
+		return (NULL);
+	}
+
+	*translatorDataExchange = &state->dataExchange;
+	*translatorContainer    = &state->container;
+	*translatorLogLevel     = &state->deviceLogLevel;
+
+	return (translator);
+}
+
+void dvXplorerTranslatorProcess(void *translatorPtr, const uint8_t *buffer, size_t bufferSize) {
+	dvXplorerHandle translator = translatorPtr;
+
+	if (translator->state.isMipiCX3Device) {
+		mipiCx3EventTranslator(translator, buffer, bufferSize);
+	}
+	else {
+		dvXplorerEventTranslator(translator, buffer, bufferSize);
+	}
+}
+
+void dvXplorerTranslatorScan(void *translatorPtr, const uint8_t *buffer, size_t bufferSize) {
+	dvXplorerHandle translator = translatorPtr;
+
+	// Hand out what was decoded so far, scanning generates no events.
+	dvXplorerPacketsFlush(translator);
+
+	translator->state.scanOnly = true;
+	dvXplorerTranslatorProcess(translator, buffer, bufferSize);
+	translator->state.scanOnly = false;
+}
+
+size_t dvXplorerTranslatorResync(void *translatorPtr, const uint8_t *buffer, size_t bufferSize) {
+	dvXplorerHandle translator = translatorPtr;
+
+	size_t syncPos = bufferSize;
+
+	if (translator->state.isMipiCX3Device) {
+		// Stop right after the next timestamp reference event.
+		for (size_t bufferPos = 0; (bufferPos + 3) < bufferSize; bufferPos += 4) {
+			uint32_t event = le32toh(*((const uint32_t *) (&buffer[bufferPos])));
+
+			if ((event & 0x8C000000) == 0x08000000) {
+				syncPos = bufferPos + 4;
+				break;
+			}
+		}
+	}
+	else {
+		// Stop right after the next timestamp wrap event (code 7).
+		for (size_t bufferPos = 0; (bufferPos + 1) < bufferSize; bufferPos += 2) {
+			uint16_t event = le16toh(*((const uint16_t *) (&buffer[bufferPos])));
+
+			if ((event & 0xF000) == 0x7000) {
+				syncPos = bufferPos + 2;
+				break;
+			}
+		}
+	}
+
+	dvXplorerTranslatorScan(translator, buffer, syncPos);
+
+	return (syncPos);
+}
+
+void dvXplorerTranslatorFlush(void *translatorPtr) {
+	dvXplorerPacketsFlush(translatorPtr);
+}
+
+size_t dvXplorerTranslatorStateSize(void *translatorPtr) {
+	(void) (translatorPtr);
+
+	return (sizeof(struct dvxplorer_translator_state));
+}
+
+void dvXplorerTranslatorStateGet(void *translatorPtr, uint8_t *stateBuffer) {
+	dvXplorerHandle translator = translatorPtr;
+	dvXplorerState state       = &translator->state;
+
+	// Only what the event translators carry from one buffer to the next.
+	// Configuration, packets and data exchange are not part of the snapshot.
+	struct dvxplorer_translator_state saved;
+	memset(&saved, 0, sizeof(saved));
+
+	saved.timestampsWrapOverflow          = state->timestamps.wrapOverflow;
+	saved.timestampsWrapAdd               = state->timestamps.wrapAdd;
+	saved.timestampsLast                  = state->timestamps.last;
+	saved.timestampsCurrent               = state->timestamps.current;
+	saved.timestampsMIPIReference         = state->timestampsMIPI.reference;
+	saved.timestampsMIPIReferenceOverflow = state->timestampsMIPI.referenceOverflow;
+	saved.timestampsMIPILastReference     = state->timestampsMIPI.lastReference;
+	saved.timestampsMIPILastUsedSub       = state->timestampsMIPI.lastUsedSub;
+	saved.timestampsMIPILastUsedReference = state->timestampsMIPI.lastUsedReference;
+	saved.timestampsMIPICurrTimestamp     = state->timestampsMIPI.currTimestamp;
+	saved.timestampsMIPILastTimestamp     = state->timestampsMIPI.lastTimestamp;
+	saved.containerCommitTimestamp        = state->container.currentPacketContainerCommitTimestamp;
+
+	saved.dvsLastX      = state->dvs.lastX;
+	saved.dvsLastYG1    = state->dvs.lastYG1;
+	saved.dvsLastYG2    = state->dvs.lastYG2;
+	saved.dvsLastColumn = state->dvs.lastColumn;
+
+	saved.imuIgnoreEvents = state->imu.ignoreEvents;
+	saved.imuType         = state->imu.type;
+	saved.imuCount        = state->imu.count;
+	saved.imuTmpData      = state->imu.tmpData;
+	saved.imuAccelScale   = state->imu.accelScale;
+	saved.imuGyroScale    = state->imu.gyroScale;
+	saved.imuCurrentEvent = state->imu.currentEvent;
+
+	memcpy(stateBuffer, &saved, sizeof(saved));
+}
+
+void dvXplorerTranslatorStateSet(void *translatorPtr, const uint8_t *stateBuffer) {
+	dvXplorerHandle translator = translatorPtr;
+	dvXplorerState state       = &translator->state;
+
+	// The buffer may not be suitably aligned for the struct.
+	struct dvxplorer_translator_state saved;
+	memcpy(&saved, stateBuffer, sizeof(saved));
+
+	state->timestamps.wrapOverflow                         = saved.timestampsWrapOverflow;
+	state->timestamps.wrapAdd                              = saved.timestampsWrapAdd;
+	state->timestamps.last                                 = saved.timestampsLast;
+	state->timestamps.current                              = saved.timestampsCurrent;
+	state->timestampsMIPI.reference                        = saved.timestampsMIPIReference;
+	state->timestampsMIPI.referenceOverflow                = saved.timestampsMIPIReferenceOverflow;
+	state->timestampsMIPI.lastReference                    = saved.timestampsMIPILastReference;
+	state->timestampsMIPI.lastUsedSub                      = saved.timestampsMIPILastUsedSub;
+	state->timestampsMIPI.lastUsedReference                = saved.timestampsMIPILastUsedReference;
+	state->timestampsMIPI.currTimestamp                    = saved.timestampsMIPICurrTimestamp;
+	state->timestampsMIPI.lastTimestamp                    = saved.timestampsMIPILastTimestamp;
+	state->container.currentPacketContainerCommitTimestamp = saved.containerCommitTimestamp;
+
+	state->dvs.lastX      = saved.dvsLastX;
+	state->dvs.lastYG1    = saved.dvsLastYG1;
+	state->dvs.lastYG2    = saved.dvsLastYG2;
+	state->dvs.lastColumn = saved.dvsLastColumn;
+
+	state->imu.ignoreEvents = saved.imuIgnoreEvents;
+	state->imu.type         = saved.imuType;
+	state->imu.count        = saved.imuCount;
+	state->imu.tmpData      = saved.imuTmpData;
+	state->imu.accelScale   = saved.imuAccelScale;
+	state->imu.gyroScale    = saved.imuGyroScale;
+	state->imu.currentEvent = saved.imuCurrentEvent;
+}
+
+void dvXplorerTranslatorClose(void *translatorPtr) {
+	dvXplorerHandle translator = translatorPtr;
+	dvXplorerState state       = &translator->state;
+
+	dataExchangeBufferEmpty(&state->dataExchange);
+
+	freeAllDataMemory(state);
+
+	dvsRemapDestroy(&state->dvs.remap);
+	dvsAccumulateDestroy(&state->dvs.accumulate);
+	free(translator->info.deviceString);
+	free(translator);
+}
+
 #define TS_WRAP_ADD 0x8000
 
 static inline bool ensureSpaceForEvents(
 	caerEventPacketHeader *packet, size_t position, size_t numEvents, dvXplorerHandle handle) {
+	// No packet while scanning, events are skipped.
+	if (*packet == NULL) {
+		return (false);
+	}
+
 	if ((position + numEvents) <= (size_t) caerEventPacketHeaderGetEventCapacity(*packet)) {
 		return (true);
 	}
@@ -2550,6 +2838,110 @@ static inline bool ensureSpaceForEvents(
 	return (true);
 }
 
+static bool dvXplorerPacketsAllocate(dvXplorerHandle handle) {
+	dvXplorerState state = &handle->state;
+
+	if (!containerGenerationAllocate(&state->container, DVXPLORER_EVENT_TYPES)) {
+		dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
+		return (false);
+	}
+
+	if (state->currentPackets.special == NULL) {
+		state->currentPackets.special = caerSpecialEventPacketAllocate(
+			DVXPLORER_SPECIAL_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
+		if (state->currentPackets.special == NULL) {
+			dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate special event packet.");
+			return (false);
+		}
+	}
+
+	if (state->currentPackets.polarity == NULL) {
+		state->currentPackets.polarity = caerPolarityEventPacketAllocate(
+			DVXPLORER_POLARITY_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
+		if (state->currentPackets.polarity == NULL) {
+			dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate polarity event packet.");
+			return (false);
+		}
+	}
+
+	if (state->currentPackets.imu6 == NULL) {
+		state->currentPackets.imu6 = caerIMU6EventPacketAllocate(
+			DVXPLORER_IMU_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
+		if (state->currentPackets.imu6 == NULL) {
+			dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate IMU6 event packet.");
+			return (false);
+		}
+	}
+
+	return (true);
+}
+
+/**
+ * Commit all events decoded so far, without waiting for any of the usual
+ * container commit triggers. Packets that are left empty are freed, so that
+ * nothing is generated while scanning; they are allocated again as needed.
+ */
+// Free the packets left after a commit, which are all empty. They carry the
+// timestamp overflow from when they were allocated, and must not be reused
+// once it changed (timestamp reset or big wrap).
+static void dvXplorerPacketsFreeEmpty(dvXplorerState state) {
+	if (state->currentPackets.polarity != NULL) {
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
+		state->currentPackets.polarity = NULL;
+	}
+
+	if (state->currentPackets.special != NULL) {
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
+		state->currentPackets.special = NULL;
+	}
+
+	if (state->currentPackets.imu6 != NULL) {
+		caerEventPacketFree(&state->currentPackets.imu6->packetHeader);
+		state->currentPackets.imu6 = NULL;
+	}
+}
+
+static void dvXplorerPacketsFlush(dvXplorerHandle handle) {
+	dvXplorerState state = &handle->state;
+
+	bool emptyContainerCommit = true;
+
+	if (state->currentPackets.polarityPosition > 0) {
+		containerGenerationSetPacket(
+			&state->container, POLARITY_EVENT, (caerEventPacketHeader) state->currentPackets.polarity);
+
+		state->currentPackets.polarity         = NULL;
+		state->currentPackets.polarityPosition = 0;
+		emptyContainerCommit                   = false;
+	}
+
+	if (state->currentPackets.specialPosition > 0) {
+		containerGenerationSetPacket(
+			&state->container, SPECIAL_EVENT, (caerEventPacketHeader) state->currentPackets.special);
+
+		state->currentPackets.special         = NULL;
+		state->currentPackets.specialPosition = 0;
+		emptyContainerCommit                  = false;
+	}
+
+	if (state->currentPackets.imu6Position > 0) {
+		containerGenerationSetPacket(
+			&state->container, IMU6_EVENT_PKT_POS, (caerEventPacketHeader) state->currentPackets.imu6);
+
+		state->currentPackets.imu6         = NULL;
+		state->currentPackets.imu6Position = 0;
+		emptyContainerCommit               = false;
+	}
+
+	containerGenerationExecute(&state->container, emptyContainerCommit, false, state->timestamps.wrapOverflow,
+		state->timestamps.current, &state->dataExchange, &state->usbState.dataTransfersRun, handle->info.deviceID,
+		handle->info.deviceString, &state->deviceLogLevel);
+
+	dvsAccumulateFlush(&state->dvs.accumulate);
+
+	dvXplorerPacketsFreeEmpty(state);
+}
+
 static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bufferSize) {
 	dvXplorerHandle handle = vhd;
 	dvXplorerState state   = &handle->state;
@@ -2562,46 +2954,29 @@ static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bu
 		return;
 	}
 
+	// Raw capture: forward the buffer as-is, decoding happens later, if ever.
+	if (state->dataExchange.rawCaptureRunning) {
+		dataExchangePutRaw(&state->dataExchange, buffer, bufferSize, handle->info.deviceString, &state->deviceLogLevel);
+		return;
+	}
+
 	// Truncate off any extra partial event.
 	if ((bufferSize & 0x01) != 0) {
 		dvXplorerLog(CAER_LOG_ALERT, handle, "%zu bytes received via USB, which is not a multiple of two.", bufferSize);
 		bufferSize &= ~((size_t) 0x01);
 	}
 
+	// Remapping and accumulation settings stay the same for the whole buffer.
+	dvsRemapUpdate(&state->dvs.remap);
+	dvsAccumulateUpdate(&state->dvs.accumulate, &state->dataExchange, I16T(handle->info.deviceID),
+		handle->info.deviceString, &state->deviceLogLevel);
+
 	for (size_t bufferPos = 0; bufferPos < bufferSize; bufferPos += 2) {
-		// Allocate new packets for next iteration as needed.
-		if (!containerGenerationAllocate(&state->container, DVXPLORER_EVENT_TYPES)) {
-			dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
+		// Allocate new packets for next iteration as needed. Scanning uses none.
+		if ((!state->scanOnly) && (!dvXplorerPacketsAllocate(handle))) {
 			return;
 		}
 
-		if (state->currentPackets.special == NULL) {
-			state->currentPackets.special = caerSpecialEventPacketAllocate(
-				DVXPLORER_SPECIAL_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.special == NULL) {
-				dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate special event packet.");
-				return;
-			}
-		}
-
-		if (state->currentPackets.polarity == NULL) {
-			state->currentPackets.polarity = caerPolarityEventPacketAllocate(
-				DVXPLORER_POLARITY_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.polarity == NULL) {
-				dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate polarity event packet.");
-				return;
-			}
-		}
-
-		if (state->currentPackets.imu6 == NULL) {
-			state->currentPackets.imu6 = caerIMU6EventPacketAllocate(
-				DVXPLORER_IMU_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.imu6 == NULL) {
-				dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate IMU6 event packet.");
-				return;
-			}
-		}
-
 		bool tsReset   = false;
 		bool tsBigWrap = false;
 
@@ -2715,8 +3090,6 @@ static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bu
 								// Timestamp at event-stream insertion point.
 								caerIMU6EventSetTimestamp(&state->imu.currentEvent, state->timestamps.current);
 
-								caerIMU6EventValidate(&state->imu.currentEvent, state->currentPackets.imu6);
-
 								// IMU6 and APS operate on an internal event and copy that to the actual output
 								// packet here, in the END state, for a reason: if a packetContainer, with all its
 								// packets, is committed due to hitting any of the triggers that are not TS reset
@@ -2729,6 +3102,8 @@ static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bu
 								// the whole event is ready and cannot be broken/corrupted in any way anymore.
 								if (ensureSpaceForEvents((caerEventPacketHeader *) &state->currentPackets.imu6,
 										(size_t) state->currentPackets.imu6Position, 1, handle)) {
+									caerIMU6EventValidate(&state->imu.currentEvent, state->currentPackets.imu6);
+
 									caerIMU6Event imuCurrentEvent = caerIMU6EventPacketGetEvent(
 										state->currentPackets.imu6, state->currentPackets.imu6Position);
 									memcpy(imuCurrentEvent, &state->imu.currentEvent, sizeof(struct caer_imu6_event));
@@ -2824,6 +3199,9 @@ static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bu
 					bool polarity  = ((data & 0x0100) == 0);
 					uint16_t lastY = (code == 3) ? (state->dvs.lastYG1) : (state->dvs.lastYG2);
 
+					// Events that are only accumulated are not written to the packet.
+					bool discardEvents = dvsAccumulateDiscards(&state->dvs.accumulate);
+
 					for (uint16_t i = 0, mask = 0x0001; i < 8; i++, mask <<= 1) {
 						// Check if event present first.
 						if ((data & mask) == 0) {
@@ -2843,21 +3221,48 @@ static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bu
 							}
 						}
 
-						if (state->dvs.invertXY) {
+						// Remapping replaces the address, or drops the event. Its table
+						// is indexed by sensor address, the orientation is folded in.
+						uint32_t remapData = 0;
+
+						if (state->dvs.remap.current != NULL) {
+							remapData = dvsRemapLookup(&state->dvs.remap, xAddr, yAddr);
+
+							if (remapData == CAER_DVS_REMAP_DROP) {
+								continue;
+							}
+						}
+						else if (state->dvs.invertXY) {
 							SWAP_VAR(uint16_t, xAddr, yAddr);
 						}
 
 						// Received event!
-						caerPolarityEvent currentPolarityEvent = caerPolarityEventPacketGetEvent(
-							state->currentPackets.polarity, state->currentPackets.polarityPosition);
+						struct caer_polarity_event discardedEvent = {0, 0};
+						caerPolarityEvent currentPolarityEvent    = &discardedEvent;
+
+						if (!discardEvents) {
+							currentPolarityEvent = caerPolarityEventPacketGetEvent(
+								state->currentPackets.polarity, state->currentPackets.polarityPosition);
+						}
 
 						// Timestamp at event-stream insertion point.
 						caerPolarityEventSetTimestamp(currentPolarityEvent, state->timestamps.current);
+						if (state->dvs.remap.current != NULL) {
+							currentPolarityEvent->data = htole32(remapData);
+						}
+						else {
+							caerPolarityEventSetX(currentPolarityEvent, xAddr);
+							caerPolarityEventSetY(currentPolarityEvent, yAddr);
+						}
 						caerPolarityEventSetPolarity(currentPolarityEvent, polarity);
-						caerPolarityEventSetX(currentPolarityEvent, xAddr);
-						caerPolarityEventSetY(currentPolarityEvent, yAddr);
-						caerPolarityEventValidate(currentPolarityEvent, state->currentPackets.polarity);
-						state->currentPackets.polarityPosition++;
+
+						if (!discardEvents) {
+							caerPolarityEventValidate(currentPolarityEvent, state->currentPackets.polarity);
+							state->currentPackets.polarityPosition++;
+						}
+
+						dvsAccumulateEvents(
+							&state->dvs.accumulate, currentPolarityEvent, 1, state->timestamps.wrapOverflow);
 					}
 
 					break;
@@ -3086,6 +3491,23 @@ static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bu
 			}
 		}
 
+		if (state->scanOnly) {
+			// Nothing to commit while scanning, but the forced commits still
+			// restart the composite events, and every commit moves the time
+			// limit, exactly as done below.
+			if (tsReset || tsBigWrap) {
+				state->imu.ignoreEvents = true;
+			}
+
+			containerGenerationCommitTimestampAdvance(
+				&state->container, state->timestamps.wrapOverflow, state->timestamps.current);
+
+			continue;
+		}
+
+		// Accumulation windows also end while no polarity events arrive.
+		dvsAccumulateTimestamp(&state->dvs.accumulate, state->timestamps.wrapOverflow, state->timestamps.current);
+
 		// Thresholds on which to trigger packet container commit.
 		// tsReset and tsBigWrap are already defined above.
 		// Trigger if any of the global container-wide thresholds are met.
@@ -3141,11 +3563,15 @@ static void dvXplorerEventTranslator(void *vhd, const uint8_t *buffer, size_t bu
 				// be incomplete, incorrect and miss vital initialization data.
 				// See IMU6 END states for more details on a related issue.
 				state->imu.ignoreEvents = true;
+
+				dvXplorerPacketsFreeEmpty(state);
 			}
 
 			containerGenerationExecute(&state->container, emptyContainerCommit, tsReset, state->timestamps.wrapOverflow,
 				state->timestamps.current, &state->dataExchange, &state->usbState.dataTransfersRun,
 				handle->info.deviceID, handle->info.deviceString, &state->deviceLogLevel);
+
+			dvsAccumulateFlush(&state->dvs.accumulate);
 		}
 	}
 }
@@ -3188,6 +3614,12 @@ static void mipiCx3EventTranslator(void *vhd, const uint8_t *buffer, const size_
 		return;
 	}
 
+	// Raw capture: forward the buffer as-is, decoding happens later, if ever.
+	if (state->dataExchange.rawCaptureRunning) {
+		dataExchangePutRaw(&state->dataExchange, buffer, bufferSize, handle->info.deviceString, &state->deviceLogLevel);
+		return;
+	}
+
 	// Discard buffers with incorrect lengths.
 	if ((bufferSize & 0x03) != 0) {
 		dvXplorerLog(
@@ -3195,6 +3627,11 @@ static void mipiCx3EventTranslator(void *vhd, const uint8_t *buffer, const size_
 		return;
 	}
 
+	// Remapping and accumulation settings stay the same for the whole buffer.
+	dvsRemapUpdate(&state->dvs.remap);
+	dvsAccumulateUpdate(&state->dvs.accumulate, &state->dataExchange, I16T(handle->info.deviceID),
+		handle->info.deviceString, &state->deviceLogLevel);
+
 	for (size_t bufferPos = 0; bufferPos < bufferSize; bufferPos += 4) {
 		const uint32_t event = le32toh(*((const uint32_t *) (&buffer[bufferPos])));
 
@@ -3203,39 +3640,11 @@ static void mipiCx3EventTranslator(void *vhd, const uint8_t *buffer, const size_
 			continue;
 		}
 
-		// Allocate new packets for next iteration as needed.
-		if (!containerGenerationAllocate(&state->container, DVXPLORER_EVENT_TYPES)) {
-			dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
+		// Allocate new packets for next iteration as needed. Scanning uses none.
+		if ((!state->scanOnly) && (!dvXplorerPacketsAllocate(handle))) {
 			return;
 		}
 
-		if (state->currentPackets.special == NULL) {
-			state->currentPackets.special = caerSpecialEventPacketAllocate(
-				DVXPLORER_SPECIAL_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.special == NULL) {
-				dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate special event packet.");
-				return;
-			}
-		}
-
-		if (state->currentPackets.polarity == NULL) {
-			state->currentPackets.polarity = caerPolarityEventPacketAllocate(
-				DVXPLORER_POLARITY_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.polarity == NULL) {
-				dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate polarity event packet.");
-				return;
-			}
-		}
-
-		if (state->currentPackets.imu6 == NULL) {
-			state->currentPackets.imu6 = caerIMU6EventPacketAllocate(
-				DVXPLORER_IMU_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.imu6 == NULL) {
-				dvXplorerLog(CAER_LOG_CRITICAL, handle, "Failed to allocate IMU6 event packet.");
-				return;
-			}
-		}
-
 		bool tsReset   = false;
 		bool tsBigWrap = false;
 
@@ -3279,47 +3688,50 @@ static void mipiCx3EventTranslator(void *vhd, const uint8_t *buffer, const size_
 
 			uint8_t group1Events = (event >> 0) & 0x00FF;
 			bool group1Polarity  = (event >> 16) & 0x01;
+			uint8_t group2Events = (event >> 8) & 0x00FF;
+			bool group2Polarity  = (event >> 17) & 0x01;
 
-			for (uint8_t i = 0, mask = 0x01; i < 8; i++, mask <<= 1) {
-				// Check if event present first.
-				if ((group1Events & mask) == 0) {
-					continue;
-				}
+			// Expand both groups at once through the lookup table. All events in
+			// a group share X, polarity and timestamp, Y increases with the bit index.
+			// Events that are only accumulated are not written to the packet.
+			struct caer_polarity_event discardedEvents[16];
+			bool discardEvents = dvsAccumulateDiscards(&state->dvs.accumulate);
 
-				// Received event!
-				caerPolarityEvent currentPolarityEvent = caerPolarityEventPacketGetEvent(
-					state->currentPackets.polarity, state->currentPackets.polarityPosition);
+			caerPolarityEvent groupEvents = discardedEvents;
 
-				// Timestamp at event-stream insertion point.
-				caerPolarityEventSetTimestamp(currentPolarityEvent, state->timestamps.current);
-				caerPolarityEventSetPolarity(currentPolarityEvent, group1Polarity);
-				caerPolarityEventSetX(currentPolarityEvent, U16T(state->dvs.lastColumn));
-				caerPolarityEventSetY(currentPolarityEvent, U16T(group1Address + i));
-				caerPolarityEventValidate(currentPolarityEvent, state->currentPackets.polarity);
-				state->currentPackets.polarityPosition++;
+			if (!discardEvents) {
+				groupEvents = caerPolarityEventPacketGetEvent(
+					state->currentPackets.polarity, state->currentPackets.polarityPosition);
 			}
 
-			uint8_t group2Events = (event >> 8) & 0x00FF;
-			bool group2Polarity  = (event >> 17) & 0x01;
+			int32_t groupEventsNumber = 0;
 
-			for (uint8_t i = 0, mask = 0x01; i < 8; i++, mask <<= 1) {
-				// Check if event present first.
-				if ((group2Events & mask) == 0) {
-					continue;
-				}
+			if (state->dvs.remap.current == NULL) {
+				groupEventsNumber = polarityGroupExpand(groupEvents, group1Events,
+					polarityGroupBaseData(U16T(state->dvs.lastColumn), U16T(group1Address), group1Polarity),
+					POLARITY_Y_ADDR_SHIFT, state->timestamps.current);
 
-				// Received event!
-				caerPolarityEvent currentPolarityEvent = caerPolarityEventPacketGetEvent(
-					state->currentPackets.polarity, state->currentPackets.polarityPosition);
+				groupEventsNumber += polarityGroupExpand(&groupEvents[groupEventsNumber], group2Events,
+					polarityGroupBaseData(U16T(state->dvs.lastColumn), U16T(group2Address), group2Polarity),
+					POLARITY_Y_ADDR_SHIFT, state->timestamps.current);
+			}
+			else {
+				// Remapped addresses are not contiguous, go pixel by pixel.
+				groupEventsNumber = dvsRemapGroupExpand(groupEvents, group1Events, &state->dvs.remap,
+					U16T(state->dvs.lastColumn), U16T(group1Address), group1Polarity, state->timestamps.current);
+
+				groupEventsNumber += dvsRemapGroupExpand(&groupEvents[groupEventsNumber], group2Events,
+					&state->dvs.remap, U16T(state->dvs.lastColumn), U16T(group2Address), group2Polarity,
+					state->timestamps.current);
+			}
 
-				// Timestamp at event-stream insertion point.
-				caerPolarityEventSetTimestamp(currentPolarityEvent, state->timestamps.current);
-				caerPolarityEventSetPolarity(currentPolarityEvent, group2Polarity);
-				caerPolarityEventSetX(currentPolarityEvent, U16T(state->dvs.lastColumn));
-				caerPolarityEventSetY(currentPolarityEvent, U16T(group2Address + i));
-				caerPolarityEventValidate(currentPolarityEvent, state->currentPackets.polarity);
-				state->currentPackets.polarityPosition++;
+			if (!discardEvents) {
+				polarityGroupCommit(state->currentPackets.polarity, groupEventsNumber);
+				state->currentPackets.polarityPosition += groupEventsNumber;
 			}
+
+			dvsAccumulateEvents(
+				&state->dvs.accumulate, groupEvents, groupEventsNumber, state->timestamps.wrapOverflow);
 		}
 		else {
 			// COLUMN event.
@@ -3427,6 +3839,18 @@ static void mipiCx3EventTranslator(void *vhd, const uint8_t *buffer, const size_
 			}
 		}
 
+		if (state->scanOnly) {
+			// Nothing to commit while scanning, but every commit moves the
+			// time limit, exactly as done below.
+			containerGenerationCommitTimestampAdvance(
+				&state->container, state->timestamps.wrapOverflow, state->timestamps.current);
+
+			continue;
+		}
+
+		// Accumulation windows also end while no polarity events arrive.
+		dvsAccumulateTimestamp(&state->dvs.accumulate, state->timestamps.wrapOverflow, state->timestamps.current);
+
 		// Thresholds on which to trigger packet container commit.
 		// tsReset and tsBigWrap are already defined above.
 		// Trigger if any of the global container-wide thresholds are met.
@@ -3473,9 +3897,15 @@ static void mipiCx3EventTranslator(void *vhd, const uint8_t *buffer, const size_
 				emptyContainerCommit               = false;
 			}
 
+			if (tsReset || tsBigWrap) {
+				dvXplorerPacketsFreeEmpty(state);
+			}
+
 			containerGenerationExecute(&state->container, emptyContainerCommit, tsReset, state->timestamps.wrapOverflow,
 				state->timestamps.current, &state->dataExchange, &state->usbState.dataTransfersRun,
 				handle->info.deviceID, handle->info.deviceString, &state->deviceLogLevel);
+
+			dvsAccumulateFlush(&state->dvs.accumulate);
 		}
 	}
 }
@@ -3668,8 +4098,6 @@ static void debugTranslator(dvXplorerHandle handle, const uint8_t *buffer, size_
 		// Timestamp at event-stream insertion point.
 		caerIMU6EventSetTimestamp(&state->imu.currentEvent, state->timestamps.current);
 
-		caerIMU6EventValidate(&state->imu.currentEvent, state->currentPackets.imu6);
-
 		// IMU6 and APS operate on an internal event and copy that to the actual output
 		// packet here, in the END state, for a reason: if a packetContainer, with all its
 		// packets, is committed due to hitting any of the triggers that are not TS reset
@@ -3682,6 +4110,8 @@ static void debugTranslator(dvXplorerHandle handle, const uint8_t *buffer, size_
 		// the whole event is ready and cannot be broken/corrupted in any way anymore.
 		if (ensureSpaceForEvents((caerEventPacketHeader *) &state->currentPackets.imu6,
 				(size_t) state->currentPackets.imu6Position, 1, handle)) {
+			caerIMU6EventValidate(&state->imu.currentEvent, state->currentPackets.imu6);
+
 			caerIMU6Event imuCurrentEvent
 				= caerIMU6EventPacketGetEvent(state->currentPackets.imu6, state->currentPackets.imu6Position);
 			memcpy(imuCurrentEvent, &state->imu.currentEvent, sizeof(struct caer_imu6_event));
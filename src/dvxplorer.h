@@ -6,6 +6,9 @@
 
 #include "container_generation.h"
 #include "data_exchange.h"
+#include "dvs_accumulate.h"
+#include "dvs_remap.h"
+#include "polarity_groups.h"
 #include "usb_utils.h"
 
 #define IMU_TYPE_TEMP   0x01
@@ -115,6 +118,8 @@ struct dvxplorer_state {
 	atomic_uint_fast8_t deviceLogLevel;
 	// Data Acquisition Thread -> Mainloop Exchange
 	struct data_exchange dataExchange;
+	// Offline translator scan: only follow the decoding state, generate no events.
+	bool scanOnly;
 	// USB Device State
 	struct usb_state usbState;
 	// Timestamp fields
@@ -142,6 +147,10 @@ struct dvxplorer_state {
 		uint16_t cropperYStart;
 		uint16_t cropperYEnd;
 		bool dualBinning;
+		// Per-pixel address remapping, in output orientation.
+		struct dvs_remap remap;
+		// Accumulation into count images or time surfaces, in output orientation.
+		struct dvs_accumulate accumulate;
 		// MIPI CX3.
 		int16_t lastColumn;
 	} dvs;
@@ -200,7 +209,35 @@ struct dvxplorer_handle {
 
 typedef struct dvxplorer_handle *dvXplorerHandle;
 
+// Offline translator decoding state snapshot: plain data only.
+struct dvxplorer_translator_state {
+	int32_t timestampsWrapOverflow;
+	int32_t timestampsWrapAdd;
+	int32_t timestampsLast;
+	int32_t timestampsCurrent;
+	int64_t timestampsMIPIReference;
+	int64_t timestampsMIPIReferenceOverflow;
+	int32_t timestampsMIPILastReference;
+	int32_t timestampsMIPILastUsedSub;
+	int64_t timestampsMIPILastUsedReference;
+	int64_t timestampsMIPICurrTimestamp;
+	int64_t timestampsMIPILastTimestamp;
+	int64_t containerCommitTimestamp;
+	uint16_t dvsLastX;
+	uint16_t dvsLastYG1;
+	uint16_t dvsLastYG2;
+	int16_t dvsLastColumn;
+	bool imuIgnoreEvents;
+	uint8_t imuType;
+	uint8_t imuCount;
+	uint8_t imuTmpData;
+	float imuAccelScale;
+	float imuGyroScale;
+	struct caer_imu6_event imuCurrentEvent;
+};
+
 ssize_t dvXplorerFind(caerDeviceDiscoveryResult *discoveredDevices);
+bool dvXplorerFindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice);
 
 caerDeviceHandle dvXplorerOpen(
 	uint16_t deviceID, uint8_t busNumberRestrict, uint8_t devAddressRestrict, const char *serialNumberRestrict);
@@ -217,5 +254,18 @@ bool dvXplorerDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void
 	void *dataShutdownUserPtr);
 bool dvXplorerDataStop(caerDeviceHandle handle);
 caerEventPacketContainer dvXplorerDataGet(caerDeviceHandle handle);
+caerDeviceRawBuffer dvXplorerDataGetRaw(caerDeviceHandle handle);
+bool dvXplorerDVSRemapSet(caerDeviceHandle handle, const uint32_t *remapTable);
+
+void *dvXplorerTranslatorOpen(caerDeviceHandle handle, dataExchange *translatorDataExchange,
+	containerGeneration *translatorContainer, atomic_uint_fast8_t **translatorLogLevel);
+void dvXplorerTranslatorProcess(void *translator, const uint8_t *buffer, size_t bufferSize);
+void dvXplorerTranslatorScan(void *translator, const uint8_t *buffer, size_t bufferSize);
+size_t dvXplorerTranslatorResync(void *translator, const uint8_t *buffer, size_t bufferSize);
+void dvXplorerTranslatorFlush(void *translator);
+size_t dvXplorerTranslatorStateSize(void *translator);
+void dvXplorerTranslatorStateGet(void *translator, uint8_t *stateBuffer);
+void dvXplorerTranslatorStateSet(void *translator, const uint8_t *stateBuffer);
+void dvXplorerTranslatorClose(void *translator);
 
 #endif /* LIBCAER_SRC_DVXPLORER_H_ */
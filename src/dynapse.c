@@ -4,6 +4,7 @@
 
 static void dynapseLog(enum caer_log_level logLevel, dynapseHandle handle, const char *format, ...) ATTRIBUTE_FORMAT(3);
 static bool sendUSBCommandVerifyMultiple(dynapseHandle handle, uint8_t *config, size_t configNum);
+static bool verifyUSBCommandMultiple(dynapseHandle handle);
 static void dynapseEventTranslator(void *vdh, const uint8_t *buffer, size_t bytesSent);
 static void setSilentBiases(caerDeviceHandle cdh, uint8_t chipId);
 static void setLowPowerBiases(caerDeviceHandle cdh, uint8_t chipId);
@@ -226,6 +227,11 @@ ssize_t dynapseFind(caerDeviceDiscoveryResult *discoveredDevices) {
 		DYNAPSE_REQUIRED_FIRMWARE_VERSION, discoveredDevices, &populateDeviceInfo));
 }
 
+bool dynapseFindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice) {
+	return (usbDeviceFindSingle(device, DYNAPSE_REQUIRED_LOGIC_VERSION, -1, DYNAPSE_REQUIRED_FIRMWARE_VERSION,
+		discoveredDevice, &populateDeviceInfo));
+}
+
 static bool sendUSBCommandVerifyMultiple(dynapseHandle handle, uint8_t *config, size_t configNum) {
 	dynapseState state = &handle->state;
 
@@ -235,6 +241,12 @@ static bool sendUSBCommandVerifyMultiple(dynapseHandle handle, uint8_t *config,
 		return (false);
 	}
 
+	return (verifyUSBCommandMultiple(handle));
+}
+
+static bool verifyUSBCommandMultiple(dynapseHandle handle) {
+	dynapseState state = &handle->state;
+
 	uint8_t check[2] = {0};
 	bool result
 		= usbControlTransferIn(&state->usbState, VENDOR_REQUEST_FPGA_CONFIG_AER_MULTIPLE, 0, 0, check, sizeof(check));
@@ -253,14 +265,14 @@ static inline void freeAllDataMemory(dynapseState state) {
 	// already assigned to the current packet container, we
 	// free them separately from it.
 	if (state->currentPackets.spike != NULL) {
-		free(&state->currentPackets.spike->packetHeader);
+		caerEventPacketFree(&state->currentPackets.spike->packetHeader);
 		state->currentPackets.spike = NULL;
 
 		containerGenerationSetPacket(&state->container, DYNAPSE_SPIKE_EVENT_POS, NULL);
 	}
 
 	if (state->currentPackets.special != NULL) {
-		free(&state->currentPackets.special->packetHeader);
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
 		state->currentPackets.special = NULL;
 
 		containerGenerationSetPacket(&state->container, SPECIAL_EVENT, NULL);
@@ -294,6 +306,10 @@ caerDeviceHandle dynapseOpen(
 	// Packet settings (size (in events) and time interval (in µs)).
 	containerGenerationSettingsInit(&state->container);
 
+	// Bulk uploads.
+	atomic_store(&state->pipeline.depth, DYNAPSE_PIPELINE_DEFAULT_DEPTH);
+	atomic_store(&state->pipeline.buffer, (uintptr_t) NULL);
+
 	// Logging settings (initialize to global log-level).
 	enum caer_log_level globalLogLevel = caerLogLevelGet();
 	atomic_store(&state->deviceLogLevel, globalLogLevel);
@@ -388,6 +404,7 @@ bool dynapseClose(caerDeviceHandle cdh) {
 	dynapseLog(CAER_LOG_DEBUG, handle, "Shutdown successful.");
 
 	// Free memory.
+	free((struct dynapse_staging_buffer *) atomic_load(&state->pipeline.buffer));
 	free(handle->info.deviceString);
 	free(handle);
 
@@ -751,7 +768,15 @@ bool dynapseConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 
 	switch (modAddr) {
 		case CAER_HOST_CONFIG_USB:
-			return (usbConfigSet(&state->usbState, paramAddr, param));
+			switch (paramAddr) {
+				case CAER_HOST_CONFIG_USB_DYNAPSE_PIPELINE:
+					atomic_store(&state->pipeline.depth, (param == 0) ? (1) : (param));
+					break;
+
+				default:
+					return (usbConfigSet(&state->usbState, paramAddr, param));
+					break;
+			}
 			break;
 
 		case CAER_HOST_CONFIG_DATAEXCHANGE:
@@ -1096,7 +1121,15 @@ bool dynapseConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 
 	switch (modAddr) {
 		case CAER_HOST_CONFIG_USB:
-			return (usbConfigGet(&state->usbState, paramAddr, param));
+			switch (paramAddr) {
+				case CAER_HOST_CONFIG_USB_DYNAPSE_PIPELINE:
+					*param = U32T(atomic_load(&state->pipeline.depth));
+					break;
+
+				default:
+					return (usbConfigGet(&state->usbState, paramAddr, param));
+					break;
+			}
 			break;
 
 		case CAER_HOST_CONFIG_DATAEXCHANGE:
@@ -1616,32 +1649,144 @@ static void dynapseEventTranslator(void *vhd, const uint8_t *buffer, size_t byte
 	}
 }
 
-bool caerDynapseSendDataToUSB(caerDeviceHandle cdh, const uint32_t *pointer, size_t numConfig) {
-	dynapseHandle handle = (dynapseHandle) cdh;
+static inline void chipContentMessage(uint8_t *spiConfig, uint32_t bits) {
+	spiConfig[0] = DYNAPSE_CONFIG_CHIP;
+	spiConfig[1] = DYNAPSE_CONFIG_CHIP_CONTENT;
+	spiConfig[2] = U8T((bits >> 24) & 0x0FF);
+	spiConfig[3] = U8T((bits >> 16) & 0x0FF);
+	spiConfig[4] = U8T((bits >> 8) & 0x0FF);
+	spiConfig[5] = U8T((bits >> 0) & 0x0FF);
+}
 
-	// Check if the pointer is valid.
-	if (handle == NULL) {
-		return (false);
+// Staging buffer to build bulk upload messages in. Only one uploader can hold
+// it at a time, concurrent uploads just allocate their own and the biggest is
+// kept. The USB transfers still copy each chunk into their own buffer.
+struct dynapse_staging_buffer {
+	size_t size;
+	uint8_t data[];
+};
+
+static struct dynapse_staging_buffer *stagingBufferAcquire(dynapseState state, size_t numConfig) {
+	size_t size = numConfig * SPI_CONFIG_MSG_SIZE;
+
+	struct dynapse_staging_buffer *buffer
+		= (struct dynapse_staging_buffer *) atomic_exchange(&state->pipeline.buffer, (uintptr_t) NULL);
+
+	if ((buffer != NULL) && (buffer->size >= size)) {
+		return (buffer);
 	}
 
-	// Check if device type is supported.
-	if (handle->deviceType != CAER_DEVICE_DYNAPSE) {
-		return (false);
+	free(buffer);
+
+	buffer = malloc(sizeof(struct dynapse_staging_buffer) + size);
+	if (buffer == NULL) {
+		return (NULL);
 	}
 
-	// Allocate memory for configuration parameters.
-	uint8_t *spiMultiConfig = calloc(numConfig, SPI_CONFIG_MSG_SIZE);
-	if (spiMultiConfig == NULL) {
-		return (false);
+	buffer->size = size;
+
+	return (buffer);
+}
+
+static void stagingBufferRelease(dynapseState state, struct dynapse_staging_buffer *buffer) {
+	struct dynapse_staging_buffer *other
+		= (struct dynapse_staging_buffer *) atomic_exchange(&state->pipeline.buffer, (uintptr_t) buffer);
+
+	// Another upload released its buffer in the meantime, keep the bigger one.
+	if ((other != NULL) && (other->size > buffer->size)) {
+		other = (struct dynapse_staging_buffer *) atomic_exchange(&state->pipeline.buffer, (uintptr_t) other);
 	}
 
-	for (size_t i = 0; i < numConfig; i++) {
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 0] = DYNAPSE_CONFIG_CHIP;
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 1] = DYNAPSE_CONFIG_CHIP_CONTENT;
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 2] = U8T((pointer[i] >> 24) & 0x0FF);
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 3] = U8T((pointer[i] >> 16) & 0x0FF);
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 4] = U8T((pointer[i] >> 8) & 0x0FF);
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 5] = U8T((pointer[i] >> 0) & 0x0FF);
+	free(other);
+}
+
+struct dynapse_pipeline_transfers {
+	atomic_uint_fast32_t inFlight;
+	atomic_bool failed;
+};
+
+static void pipelineTransferCallback(void *pipelineTransfersPtr, int status) {
+	struct dynapse_pipeline_transfers *transfers = pipelineTransfersPtr;
+
+	// Any failed chunk fails the whole upload.
+	if (status != LIBUSB_TRANSFER_COMPLETED) {
+		atomic_store(&transfers->failed, true);
+	}
+
+	atomic_fetch_sub(&transfers->inFlight, 1);
+}
+
+// Wait until at most 'maxInFlight' transfers are left. Completions are handled
+// by the USB thread, so sleep until it has handled some events.
+static void pipelineTransfersWait(
+	dynapseState state, struct dynapse_pipeline_transfers *transfers, uint_fast32_t maxInFlight) {
+	libusb_context *context = state->usbState.deviceContext;
+
+	libusb_lock_event_waiters(context);
+
+	while (atomic_load(&transfers->inFlight) > maxInFlight) {
+		// The timeout only bounds the wait, the USB thread wakes us up.
+		struct timeval waitForEventTimeout = {.tv_sec = 0, .tv_usec = 10000};
+		libusb_wait_for_event(context, &waitForEventTimeout);
+	}
+
+	libusb_unlock_event_waiters(context);
+}
+
+// Send SPI config messages with the given vendor request, in chunks of at most
+// SPI_CONFIG_MAX, keeping up to 'depth' control transfers in flight. Returns
+// once all transfers are done, false if any of them failed. Chunks are queued
+// on the control endpoint, so the device gets them in order.
+static bool sendMultiplePipelined(
+	dynapseHandle handle, uint8_t bRequest, uint8_t *spiMultiConfig, size_t numConfig, uint32_t depth) {
+	dynapseState state = &handle->state;
+
+	struct dynapse_pipeline_transfers transfers = {ATOMIC_VAR_INIT(0), ATOMIC_VAR_INIT(false)};
+
+	size_t idxConfig = 0;
+
+	while ((numConfig > 0) && (!atomic_load(&transfers.failed))) {
+		size_t configNum  = (numConfig > SPI_CONFIG_MAX) ? (SPI_CONFIG_MAX) : (numConfig);
+		size_t configSize = configNum * SPI_CONFIG_MSG_SIZE;
+
+		pipelineTransfersWait(state, &transfers, depth - 1);
+
+		// A chunk failed while waiting, don't send any more.
+		if (atomic_load(&transfers.failed)) {
+			break;
+		}
+
+		atomic_fetch_add(&transfers.inFlight, 1);
+
+		if (!usbControlTransferOutAsync(&state->usbState, bRequest, U16T(configNum), 0, spiMultiConfig + idxConfig,
+				configSize, &pipelineTransferCallback, &transfers)) {
+			atomic_fetch_sub(&transfers.inFlight, 1);
+			atomic_store(&transfers.failed, true);
+			break;
+		}
+
+		numConfig -= configNum;
+		idxConfig += configSize;
+	}
+
+	// The callbacks reference 'transfers', wait for all of them.
+	pipelineTransfersWait(state, &transfers, 0);
+
+	return (!atomic_load(&transfers.failed));
+}
+
+// Send prepared chip content messages, in chunks of at most SPI_CONFIG_MAX.
+// With pipelining enabled, the upload is verified once at the end.
+static bool sendChipContentMultiple(dynapseHandle handle, uint8_t *spiMultiConfig, size_t numConfig) {
+	uint32_t depth = U32T(atomic_load(&handle->state.pipeline.depth));
+
+	if (depth > 1) {
+		if (!sendMultiplePipelined(handle, VENDOR_REQUEST_FPGA_CONFIG_AER_MULTIPLE, spiMultiConfig, numConfig, depth)) {
+			dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to send chip config, USB transfer failed.");
+			return (false);
+		}
+
+		return (verifyUSBCommandMultiple(handle));
 	}
 
 	size_t idxConfig = 0;
@@ -1651,7 +1796,6 @@ bool caerDynapseSendDataToUSB(caerDeviceHandle cdh, const uint32_t *pointer, siz
 		size_t configSize = configNum * SPI_CONFIG_MSG_SIZE;
 
 		if (!sendUSBCommandVerifyMultiple(handle, spiMultiConfig + idxConfig, configNum)) {
-			free(spiMultiConfig);
 			return (false);
 		}
 
@@ -1659,10 +1803,41 @@ bool caerDynapseSendDataToUSB(caerDeviceHandle cdh, const uint32_t *pointer, siz
 		idxConfig += configSize;
 	}
 
-	free(spiMultiConfig);
 	return (true);
 }
 
+bool caerDynapseSendDataToUSB(caerDeviceHandle cdh, const uint32_t *pointer, size_t numConfig) {
+	dynapseHandle handle = (dynapseHandle) cdh;
+
+	// Check if the pointer is valid.
+	if (handle == NULL) {
+		return (false);
+	}
+
+	// Check if device type is supported.
+	if (handle->deviceType != CAER_DEVICE_DYNAPSE) {
+		return (false);
+	}
+
+	if (numConfig == 0) {
+		return (true);
+	}
+
+	struct dynapse_staging_buffer *staging = stagingBufferAcquire(&handle->state, numConfig);
+	if (staging == NULL) {
+		return (false);
+	}
+
+	for (size_t i = 0; i < numConfig; i++) {
+		chipContentMessage(staging->data + (i * SPI_CONFIG_MSG_SIZE), pointer[i]);
+	}
+
+	bool retVal = sendChipContentMultiple(handle, staging->data, numConfig);
+
+	stagingBufferRelease(&handle->state, staging);
+	return (retVal);
+}
+
 bool caerDynapseWriteSramWords(caerDeviceHandle cdh, const uint16_t *data, uint32_t baseAddr, size_t numWords) {
 	dynapseHandle handle = (dynapseHandle) cdh;
 
@@ -1699,12 +1874,14 @@ bool caerDynapseWriteSramWords(caerDeviceHandle cdh, const uint16_t *data, uint3
 
 	size_t numConfig = numWords / 2;
 
-	// We need malloc because allocating dynamically sized arrays on the stack is not allowed.
-	uint8_t *spiMultiConfig = calloc(numConfig, SPI_CONFIG_MSG_SIZE);
-	if (spiMultiConfig == NULL) {
+	// Build the messages in the staging buffer, allocating dynamically sized arrays on the stack is not allowed.
+	struct dynapse_staging_buffer *staging = stagingBufferAcquire(state, numConfig);
+	if (staging == NULL) {
 		return (false);
 	}
 
+	uint8_t *spiMultiConfig = staging->data;
+
 	for (size_t i = 0; i < numConfig; i++) {
 		// Data word configuration.
 		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 0] = DYNAPSE_CONFIG_SRAM;
@@ -1724,29 +1901,17 @@ bool caerDynapseWriteSramWords(caerDeviceHandle cdh, const uint16_t *data, uint3
 	// Then we enable burst mode for faster writing.
 	spiConfigSend(&state->usbState, DYNAPSE_CONFIG_SRAM, DYNAPSE_CONFIG_SRAM_BURSTMODE, 1);
 
-	size_t idxConfig = 0;
-
-	while (numConfig > 0) {
-		size_t configNum  = (numConfig > SPI_CONFIG_MAX) ? (SPI_CONFIG_MAX) : (numConfig);
-		size_t configSize = configNum * SPI_CONFIG_MSG_SIZE;
-
-		if (!usbControlTransferOut(&state->usbState, VENDOR_REQUEST_FPGA_CONFIG_MULTIPLE, U16T(configNum), 0,
-				spiMultiConfig + idxConfig, configSize)) {
-			dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to send SRAM burst data, USB transfer failed.");
-
-			free(spiMultiConfig);
-			return (false);
-		}
-
-		numConfig -= configNum;
-		idxConfig += configSize;
+	bool retVal = sendMultiplePipelined(handle, VENDOR_REQUEST_FPGA_CONFIG_MULTIPLE, spiMultiConfig, numConfig,
+		U32T(atomic_load(&state->pipeline.depth)));
+	if (!retVal) {
+		dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to send SRAM burst data, USB transfer failed.");
 	}
 
 	// Disable burst mode again or things will go wrong when accessing the SRAM in the future.
 	spiConfigSend(&state->usbState, DYNAPSE_CONFIG_SRAM, DYNAPSE_CONFIG_SRAM_BURSTMODE, 0);
 
-	free(spiMultiConfig);
-	return (true);
+	stagingBufferRelease(state, staging);
+	return (retVal);
 }
 
 bool caerDynapseWriteCam(
@@ -1794,6 +1959,84 @@ bool caerDynapseWriteSramN(caerDeviceHandle cdh, uint16_t neuronAddr, uint8_t sr
 	return (caerDeviceConfigSet(cdh, DYNAPSE_CONFIG_CHIP, DYNAPSE_CONFIG_CHIP_CONTENT, sramBits));
 }
 
+bool caerDynapseWriteCamMultiple(caerDeviceHandle cdh, const struct caer_dynapse_cam *cams, size_t camsNumber) {
+	dynapseHandle handle = (dynapseHandle) cdh;
+
+	// Check if the pointer is valid.
+	if (handle == NULL) {
+		return (false);
+	}
+
+	// Check if device type is supported.
+	if (handle->deviceType != CAER_DEVICE_DYNAPSE) {
+		return (false);
+	}
+
+	if (camsNumber == 0) {
+		return (true);
+	}
+
+	if (cams == NULL) {
+		return (false);
+	}
+
+	// Build all messages at once, they are then sent in bulk, instead of one USB
+	// transfer per CAM like caerDynapseWriteCam() does.
+	struct dynapse_staging_buffer *staging = stagingBufferAcquire(&handle->state, camsNumber);
+	if (staging == NULL) {
+		return (false);
+	}
+
+	for (size_t i = 0; i < camsNumber; i++) {
+		chipContentMessage(staging->data + (i * SPI_CONFIG_MSG_SIZE),
+			caerDynapseGenerateCamBits(cams[i].inputNeuronAddr, cams[i].neuronAddr, cams[i].camId, cams[i].synapseType));
+	}
+
+	bool retVal = sendChipContentMultiple(handle, staging->data, camsNumber);
+
+	stagingBufferRelease(&handle->state, staging);
+	return (retVal);
+}
+
+bool caerDynapseWriteSramMultiple(caerDeviceHandle cdh, const struct caer_dynapse_sram *srams, size_t sramsNumber) {
+	dynapseHandle handle = (dynapseHandle) cdh;
+
+	// Check if the pointer is valid.
+	if (handle == NULL) {
+		return (false);
+	}
+
+	// Check if device type is supported.
+	if (handle->deviceType != CAER_DEVICE_DYNAPSE) {
+		return (false);
+	}
+
+	if (sramsNumber == 0) {
+		return (true);
+	}
+
+	if (srams == NULL) {
+		return (false);
+	}
+
+	// Same as for CAMs above, all messages are sent in bulk.
+	struct dynapse_staging_buffer *staging = stagingBufferAcquire(&handle->state, sramsNumber);
+	if (staging == NULL) {
+		return (false);
+	}
+
+	for (size_t i = 0; i < sramsNumber; i++) {
+		chipContentMessage(staging->data + (i * SPI_CONFIG_MSG_SIZE),
+			caerDynapseGenerateSramBits(srams[i].neuronAddr, srams[i].sramId, srams[i].virtualCoreId, srams[i].sx,
+				srams[i].dx, srams[i].sy, srams[i].dy, srams[i].destinationCore));
+	}
+
+	bool retVal = sendChipContentMultiple(handle, staging->data, sramsNumber);
+
+	stagingBufferRelease(&handle->state, staging);
+	return (retVal);
+}
+
 bool caerDynapseWritePoissonSpikeRate(caerDeviceHandle cdh, uint16_t neuronAddr, float rateHz) {
 	dynapseHandle handle = (dynapseHandle) cdh;
 
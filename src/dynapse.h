@@ -27,6 +27,8 @@
 #define SPI_CONFIG_MSG_SIZE 6
 #define SPI_CONFIG_MAX      85
 
+#define DYNAPSE_PIPELINE_DEFAULT_DEPTH 8
+
 #define DYNAPSE_FX2_USB_CLOCK_FREQ 30
 
 // Chip ID 0 cannot be used for USB output, so we have to shift it by
@@ -52,6 +54,13 @@ struct dynapse_state {
 		caerSpecialEventPacket special;
 		int32_t specialPosition;
 	} currentPackets;
+	// Bulk configuration upload state
+	struct {
+		// Maximum number of USB transfers in flight.
+		atomic_uint_fast32_t depth;
+		// Staging buffer, reused between uploads. Taken by the uploader while in use.
+		atomic_uintptr_t buffer;
+	} pipeline;
 };
 
 typedef struct dynapse_state *dynapseState;
@@ -67,6 +76,7 @@ struct dynapse_handle {
 typedef struct dynapse_handle *dynapseHandle;
 
 ssize_t dynapseFind(caerDeviceDiscoveryResult *discoveredDevices);
+bool dynapseFindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice);
 
 caerDeviceHandle dynapseOpen(
 	uint16_t deviceID, uint8_t busNumberRestrict, uint8_t devAddressRestrict, const char *serialNumberRestrict);
@@ -13,7 +13,7 @@ static void edvsLog(enum caer_log_level logLevel, edvsHandle handle, const char
 static bool serialThreadStart(edvsHandle handle);
 static void serialThreadStop(edvsHandle handle);
 static int serialThreadRun(void *handlePtr);
-static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent);
+static size_t edvsEventTranslator(edvsHandle handle, const uint8_t *buffer, size_t bytesSent);
 static bool edvsSendBiases(edvsState state, int biasID);
 
 static void edvsLog(enum caer_log_level logLevel, edvsHandle handle, const char *format, ...) {
@@ -138,6 +138,23 @@ static inline bool serialPortWrite(edvsState state, const char *cmd) {
 	return (retVal);
 }
 
+static inline bool edvsSetTimestampFormat(edvsState state, uint32_t format) {
+	if ((format < EDVS_TIMESTAMP_FORMAT_DELTA) || (format > EDVS_TIMESTAMP_FORMAT_32BIT)) {
+		return (false);
+	}
+
+	char cmdEventFormat[8];
+	snprintf(cmdEventFormat, 8, "!E%" PRIu32 "\n", format);
+
+	if (!serialPortWrite(state, cmdEventFormat)) {
+		return (false);
+	}
+
+	atomic_store(&state->dvs.timestampFormat, U8T(format));
+
+	return (true);
+}
+
 static inline void freeAllDataMemory(edvsState state) {
 	dataExchangeDestroy(&state->dataExchange);
 
@@ -145,14 +162,14 @@ static inline void freeAllDataMemory(edvsState state) {
 	// already assigned to the current packet container, we
 	// free them separately from it.
 	if (state->currentPackets.polarity != NULL) {
-		free(&state->currentPackets.polarity->packetHeader);
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
 		state->currentPackets.polarity = NULL;
 
 		containerGenerationSetPacket(&state->container, POLARITY_EVENT, NULL);
 	}
 
 	if (state->currentPackets.special != NULL) {
-		free(&state->currentPackets.special->packetHeader);
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
 		state->currentPackets.special = NULL;
 
 		containerGenerationSetPacket(&state->container, SPECIAL_EVENT, NULL);
@@ -185,6 +202,9 @@ caerDeviceHandle edvsOpen(uint16_t deviceID, const char *serialPortName, uint32_
 	// Packet settings (size (in events) and time interval (in µs)).
 	containerGenerationSettingsInit(&state->container);
 
+	// Host-side region of interest (whole array by default).
+	dvsROISettingsInit(&state->dvs.roi, EDVS_ARRAY_SIZE_X, EDVS_ARRAY_SIZE_Y);
+
 	// Logging settings (initialize to global log-level).
 	enum caer_log_level globalLogLevel = caerLogLevelGet();
 	atomic_store(&state->deviceLogLevel, globalLogLevel);
@@ -349,8 +369,7 @@ caerDeviceHandle edvsOpen(uint16_t deviceID, const char *serialPortName, uint32_
 		return (NULL);
 	}
 
-	const char *cmdEventFormat = "!E2\n";
-	if (!serialPortWrite(state, cmdEventFormat)) {
+	if (!edvsSetTimestampFormat(state, EDVS_TIMESTAMP_FORMAT_16BIT)) {
 		edvsLog(CAER_LOG_ERROR, handle, "Failed to send event format command.");
 
 		sp_close(state->serialState.serialPort);
@@ -363,8 +382,11 @@ caerDeviceHandle edvsOpen(uint16_t deviceID, const char *serialPortName, uint32_
 		return (NULL);
 	}
 
-	// Setup serial port communication.
+	// Setup serial port communication. Wait for at least 16 events
+	// (with 16 bit timestamps) or 10 ms before decoding.
 	atomic_store(&state->serialState.serialReadSize, 1024);
+	atomic_store(&state->serialState.serialReadMinSize, 64);
+	atomic_store(&state->serialState.serialReadTimeout, 10);
 
 	// Populate info variables based on data from device.
 	handle->info.deviceID       = I16T(deviceID);
@@ -453,6 +475,19 @@ bool edvsConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 					atomic_store(&state->serialState.serialReadSize, param);
 					break;
 
+				case CAER_HOST_CONFIG_SERIAL_READ_MIN_SIZE:
+					atomic_store(&state->serialState.serialReadMinSize, param);
+					break;
+
+				case CAER_HOST_CONFIG_SERIAL_READ_TIMEOUT:
+					// A zero timeout would block forever and never check for shutdown.
+					if (param == 0) {
+						return (false);
+					}
+
+					atomic_store(&state->serialState.serialReadTimeout, param);
+					break;
+
 				default:
 					return (false);
 					break;
@@ -479,6 +514,10 @@ bool edvsConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 			}
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ROI:
+			return (dvsROIConfigSet(&state->dvs.roi, paramAddr, param));
+			break;
+
 		case EDVS_CONFIG_DVS:
 			switch (paramAddr) {
 				case EDVS_CONFIG_DVS_RUN:
@@ -506,6 +545,10 @@ bool edvsConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 					}
 					break;
 
+				case EDVS_CONFIG_DVS_TIMESTAMP_FORMAT:
+					return (edvsSetTimestampFormat(state, param));
+					break;
+
 				default:
 					return (false);
 					break;
@@ -555,6 +598,14 @@ bool edvsConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 					*param = U32T(atomic_load(&state->serialState.serialReadSize));
 					break;
 
+				case CAER_HOST_CONFIG_SERIAL_READ_MIN_SIZE:
+					*param = U32T(atomic_load(&state->serialState.serialReadMinSize));
+					break;
+
+				case CAER_HOST_CONFIG_SERIAL_READ_TIMEOUT:
+					*param = U32T(atomic_load(&state->serialState.serialReadTimeout));
+					break;
+
 				default:
 					return (false);
 					break;
@@ -581,6 +632,10 @@ bool edvsConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 			}
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ROI:
+			return (dvsROIConfigGet(&state->dvs.roi, paramAddr, param));
+			break;
+
 		case EDVS_CONFIG_DVS:
 			switch (paramAddr) {
 				case EDVS_CONFIG_DVS_RUN:
@@ -592,6 +647,10 @@ bool edvsConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 					*param = false;
 					break;
 
+				case EDVS_CONFIG_DVS_TIMESTAMP_FORMAT:
+					*param = atomic_load(&state->dvs.timestampFormat);
+					break;
+
 				default:
 					return (false);
 					break;
@@ -672,27 +731,58 @@ static int serialThreadRun(void *handlePtr) {
 
 	edvsLog(CAER_LOG_DEBUG, handle, "Serial communication thread running.");
 
-	// Handle serial port reading (wait on data, 10 ms timeout).
+	// Read buffer, holds at most one incomplete event left over from
+	// the previous read, followed by the newly read data.
+	uint8_t *dataBuffer     = NULL;
+	size_t dataBufferSize   = 0;
+	size_t dataBufferLength = 0;
+
+	// Handle serial port reading: block until the minimum batch size is
+	// reached or the timeout expires, then take whatever else is already
+	// there, up to the read size, and decode it all in one go.
 	while (atomic_load_explicit(&state->serialState.serialThreadState, memory_order_relaxed) == THR_RUNNING) {
-		size_t readSize = atomic_load_explicit(&state->serialState.serialReadSize, memory_order_relaxed);
+		size_t readSize    = atomic_load_explicit(&state->serialState.serialReadSize, memory_order_relaxed);
+		size_t readMinSize = atomic_load_explicit(&state->serialState.serialReadMinSize, memory_order_relaxed);
+		unsigned int readTimeout
+			= (unsigned int) atomic_load_explicit(&state->serialState.serialReadTimeout, memory_order_relaxed);
 
-		// Wait for at least 16 full events to be present in the buffer.
-		int bytesAvailable = 0;
+		if (readSize < EDVS_EVENT_MAX_SIZE) {
+			readSize = EDVS_EVENT_MAX_SIZE;
+		}
 
-		while ((bytesAvailable < (16 * EDVS_EVENT_SIZE))
-			   && atomic_load_explicit(&state->serialState.serialThreadState, memory_order_relaxed) == THR_RUNNING) {
-			bytesAvailable = sp_input_waiting(state->serialState.serialPort);
+		if (readMinSize > readSize) {
+			readMinSize = readSize;
 		}
 
-		if ((size_t) bytesAvailable < readSize) {
-			readSize = (size_t) bytesAvailable;
+		if (readMinSize == 0) {
+			readMinSize = 1;
 		}
 
-		// Ensure read size is a multiple of event size.
-		readSize &= (size_t) ~0x03;
+		if (dataBufferSize < (EDVS_EVENT_MAX_SIZE + readSize)) {
+			uint8_t *newDataBuffer = realloc(dataBuffer, EDVS_EVENT_MAX_SIZE + readSize);
+			if (newDataBuffer == NULL) {
+				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate serial read buffer.");
+
+				if (state->serialState.serialShutdownCallback != NULL) {
+					state->serialState.serialShutdownCallback(state->serialState.serialShutdownCallbackPtr);
+				}
+				break;
+			}
+
+			dataBuffer     = newDataBuffer;
+			dataBufferSize = EDVS_EVENT_MAX_SIZE + readSize;
+		}
+
+		int bytesRead = sp_blocking_read(
+			state->serialState.serialPort, dataBuffer + dataBufferLength, readMinSize, readTimeout);
+
+		if ((bytesRead >= 0) && ((size_t) bytesRead == readMinSize) && (readSize > readMinSize)) {
+			int moreBytesRead = sp_nonblocking_read(
+				state->serialState.serialPort, dataBuffer + dataBufferLength + bytesRead, readSize - readMinSize);
+
+			bytesRead = (moreBytesRead < 0) ? (moreBytesRead) : (bytesRead + moreBytesRead);
+		}
 
-		uint8_t dataBuffer[readSize];
-		int bytesRead = sp_blocking_read(state->serialState.serialPort, dataBuffer, readSize, 10);
 		if (bytesRead < 0) {
 			// ERROR: call exceptional shut-down callback and exit.
 			if (state->serialState.serialShutdownCallback != NULL) {
@@ -701,12 +791,22 @@ static int serialThreadRun(void *handlePtr) {
 			break;
 		}
 
-		if (bytesRead >= EDVS_EVENT_SIZE) {
-			// Read something (at least 1 possible event), process it and try again.
-			edvsEventTranslator(handle, dataBuffer, (size_t) bytesRead);
+		if (bytesRead == 0) {
+			// Nothing new, timeout expired. Check for shutdown and try again.
+			continue;
 		}
+
+		dataBufferLength += (size_t) bytesRead;
+
+		size_t bytesUsed = edvsEventTranslator(handle, dataBuffer, dataBufferLength);
+
+		// Keep an incomplete event at the end for the next read.
+		memmove(dataBuffer, dataBuffer + bytesUsed, dataBufferLength - bytesUsed);
+		dataBufferLength -= bytesUsed;
 	}
 
+	free(dataBuffer);
+
 	// Ensure threadRun is false on termination.
 	atomic_store(&state->serialState.serialThreadState, THR_EXITED);
 
@@ -805,96 +905,331 @@ caerEventPacketContainer edvsDataGet(caerDeviceHandle cdh) {
 	return (dataExchangeGet(&state->dataExchange, &state->serialState.serialThreadState));
 }
 
-#define TS_WRAP_ADD   0x10000
 #define HIGH_BIT_MASK 0x80
 #define LOW_BITS_MASK 0x7F
 
-static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent) {
-	edvsHandle handle = vhd;
-	edvsState state   = &handle->state;
+// Returned by edvsEventDecodeTimestamp() instead of an event size.
+#define EDVS_EVENT_INCOMPLETE 0
+#define EDVS_EVENT_INVALID    SIZE_MAX
+
+/**
+ * Decode the timestamp of the event starting at 'event' (Y address byte),
+ * with 'available' bytes of data present.
+ * Returns the size of the whole event in bytes, EDVS_EVENT_INCOMPLETE if
+ * more data is needed, or EDVS_EVENT_INVALID if the data cannot be an event.
+ */
+static inline size_t edvsEventDecodeTimestamp(
+	uint8_t format, const uint8_t *event, size_t available, uint32_t *timestamp) {
+	if (format == EDVS_TIMESTAMP_FORMAT_DELTA) {
+		// 1 to 4 bytes of 7 bits each, most significant first.
+		// The last byte is marked by its high bit being set.
+		uint32_t delta = 0;
+
+		for (size_t i = 2; i < EDVS_EVENT_MAX_SIZE; i++) {
+			if (i >= available) {
+				return (EDVS_EVENT_INCOMPLETE);
+			}
 
-	// Return right away if not running anymore. This prevents useless work if many
-	// buffers are still waiting when shut down, as well as incorrect event sequences
-	// if a TS_RESET is stuck on ring-buffer commit further down, and detects shut-down;
-	// then any subsequent buffers should also detect shut-down and not be handled.
-	if (atomic_load(&state->serialState.serialThreadState) != THR_RUNNING) {
-		return;
+			delta = (delta << 7) | (event[i] & LOW_BITS_MASK);
+
+			if ((event[i] & HIGH_BIT_MASK) == HIGH_BIT_MASK) {
+				*timestamp = delta;
+				return (i + 1);
+			}
+		}
+
+		return (EDVS_EVENT_INVALID);
 	}
 
-	size_t i = 0;
-	while (i < bytesSent) {
-		uint8_t yByte = buffer[i];
+	// Absolute timestamps, the format is also their size in bytes (big-endian).
+	size_t eventSize = 2 + (size_t) format;
 
-		if ((yByte & HIGH_BIT_MASK) != HIGH_BIT_MASK) {
-			edvsLog(
-				CAER_LOG_NOTICE, handle, "Data not aligned, skipping to next data byte (%zu of %zu).", i, bytesSent);
-			i++;
-			continue;
+	if (eventSize > available) {
+		return (EDVS_EVENT_INCOMPLETE);
+	}
+
+	uint32_t absolute = 0;
+
+	for (size_t i = 2; i < eventSize; i++) {
+		absolute = (absolute << 8) | event[i];
+	}
+
+	*timestamp = absolute;
+	return (eventSize);
+}
+
+static inline void edvsTimestampBigWrap(edvsState state) {
+	// Increment TSOverflow counter.
+	state->timestamps.wrapOverflow++;
+
+	caerSpecialEvent currentEvent
+		= caerSpecialEventPacketGetEvent(state->currentPackets.special, state->currentPackets.specialPosition++);
+	caerSpecialEventSetTimestamp(currentEvent, INT32_MAX);
+	caerSpecialEventSetType(currentEvent, TIMESTAMP_WRAP);
+	caerSpecialEventValidate(currentEvent, state->currentPackets.special);
+}
+
+/**
+ * Expand an event timestamp to the current 32 bit timestamp.
+ * Returns true on a big wrap, in which case the event is dropped
+ * and the packets must be committed, to separate before wrap from
+ * after cleanly.
+ */
+static inline bool edvsUpdateTimestamp(edvsHandle handle, uint8_t format, uint32_t timestamp) {
+	edvsState state = &handle->state;
+
+	if (format == EDVS_TIMESTAMP_FORMAT_DELTA) {
+		int64_t nextTimestamp = I64T(state->timestamps.current) + timestamp;
+
+		// Timestamp big wrap.
+		if (nextTimestamp > INT32_MAX) {
+			state->timestamps.last    = 0;
+			state->timestamps.current = I32T(nextTimestamp - INT32_MAX - 1);
+
+			edvsTimestampBigWrap(state);
+			return (true);
 		}
 
-		if ((i + 3) >= bytesSent) {
-			// Cannot fetch next event data, we're done with this buffer.
-			return;
+		state->timestamps.last    = state->timestamps.current;
+		state->timestamps.current = I32T(nextTimestamp);
+	}
+	else {
+		// At most 31 bits fit into the current timestamp, wrapOverflow tracks the rest.
+		uint32_t timestampBits = (format == EDVS_TIMESTAMP_FORMAT_32BIT) ? (31) : (8U * format);
+		int64_t wrapStep       = I64T(1) << timestampBits;
+
+		timestamp &= U32T(wrapStep - 1);
+
+		bool tsWrap = (timestamp < state->timestamps.lastRaw);
+
+		// Timestamp big wrap.
+		if (tsWrap && (state->timestamps.wrapAdd == (INT32_MAX - (wrapStep - 1)))) {
+			// Reset wrapAdd to zero at this point, so we can again
+			// start detecting overruns of the 32bit value.
+			state->timestamps.wrapAdd = 0;
+
+			state->timestamps.lastRaw = 0;
+
+			state->timestamps.last    = 0;
+			state->timestamps.current = 0;
+
+			edvsTimestampBigWrap(state);
+			return (true);
 		}
 
-		// Allocate new packets for next iteration as needed.
-		if (!containerGenerationAllocate(&state->container, EDVS_EVENT_TYPES)) {
-			edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
-			return;
+		if (tsWrap) {
+			// Timestamp normal wrap (every ~65 ms for 16 bit, ~16 s for 24 bit).
+			state->timestamps.wrapAdd += I32T(wrapStep);
+
+			state->timestamps.lastRaw = 0;
 		}
+		else {
+			// Not a wrap, set this to track wrapping.
+			state->timestamps.lastRaw = timestamp;
+		}
+
+		// Expand to 32 bits. (Tick is 1µs already.)
+		state->timestamps.last    = state->timestamps.current;
+		state->timestamps.current = state->timestamps.wrapAdd + I32T(timestamp);
+	}
+
+	containerGenerationCommitTimestampInit(&state->container, state->timestamps.current);
+
+	// Check monotonicity of timestamps.
+	checkMonotonicTimestamp(
+		state->timestamps.current, state->timestamps.last, handle->info.deviceString, &handle->state.deviceLogLevel);
+
+	return (false);
+}
 
+/**
+ * Make sure the current packets exist and have room for 'maxEvents' more
+ * polarity events and one special event, so that a whole block of data can
+ * be decoded without further checks.
+ */
+static bool edvsPreparePackets(edvsHandle handle, size_t maxEvents) {
+	edvsState state = &handle->state;
+
+	// Allocate new packets for next iteration as needed.
+	if (!containerGenerationAllocate(&state->container, EDVS_EVENT_TYPES)) {
+		edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
+		return (false);
+	}
+
+	if (state->currentPackets.polarity == NULL) {
+		state->currentPackets.polarity = caerPolarityEventPacketAllocate(
+			EDVS_POLARITY_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
 		if (state->currentPackets.polarity == NULL) {
-			state->currentPackets.polarity = caerPolarityEventPacketAllocate(
-				EDVS_POLARITY_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.polarity == NULL) {
-				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate polarity event packet.");
-				return;
-			}
+			edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate polarity event packet.");
+			return (false);
 		}
-		else if (state->currentPackets.polarityPosition
-				 >= caerEventPacketHeaderGetEventCapacity((caerEventPacketHeader) state->currentPackets.polarity)) {
-			// If not committed, let's check if any of the packets has reached its maximum
-			// capacity limit. If yes, we grow them to accomodate new events.
-			caerPolarityEventPacket grownPacket = (caerPolarityEventPacket) caerEventPacketGrow(
-				(caerEventPacketHeader) state->currentPackets.polarity, state->currentPackets.polarityPosition * 2);
-			if (grownPacket == NULL) {
-				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to grow polarity event packet.");
-				return;
-			}
+	}
 
-			state->currentPackets.polarity = grownPacket;
+	size_t polarityCapacity
+		= (size_t) caerEventPacketHeaderGetEventCapacity((caerEventPacketHeader) state->currentPackets.polarity);
+	size_t polarityNeeded = (size_t) state->currentPackets.polarityPosition + maxEvents;
+
+	if (polarityNeeded > polarityCapacity) {
+		// If not committed, let's check if any of the packets has reached its maximum
+		// capacity limit. If yes, we grow them to accomodate new events.
+		size_t polarityGrowth = (polarityNeeded > (polarityCapacity * 2)) ? (polarityNeeded) : (polarityCapacity * 2);
+
+		caerPolarityEventPacket grownPacket = (caerPolarityEventPacket) caerEventPacketGrow(
+			(caerEventPacketHeader) state->currentPackets.polarity, I32T(polarityGrowth));
+		if (grownPacket == NULL) {
+			edvsLog(CAER_LOG_CRITICAL, handle, "Failed to grow polarity event packet.");
+			return (false);
 		}
 
+		state->currentPackets.polarity = grownPacket;
+	}
+
+	if (state->currentPackets.special == NULL) {
+		state->currentPackets.special = caerSpecialEventPacketAllocate(
+			EDVS_SPECIAL_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
 		if (state->currentPackets.special == NULL) {
-			state->currentPackets.special = caerSpecialEventPacketAllocate(
-				EDVS_SPECIAL_DEFAULT_SIZE, I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
-			if (state->currentPackets.special == NULL) {
-				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate special event packet.");
-				return;
-			}
+			edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate special event packet.");
+			return (false);
+		}
+	}
+	else if (state->currentPackets.specialPosition
+			 >= caerEventPacketHeaderGetEventCapacity((caerEventPacketHeader) state->currentPackets.special)) {
+		// A block adds at most one special event (big wrap), as that always commits.
+		caerSpecialEventPacket grownPacket = (caerSpecialEventPacket) caerEventPacketGrow(
+			(caerEventPacketHeader) state->currentPackets.special, state->currentPackets.specialPosition * 2);
+		if (grownPacket == NULL) {
+			edvsLog(CAER_LOG_CRITICAL, handle, "Failed to grow special event packet.");
+			return (false);
 		}
-		else if (state->currentPackets.specialPosition
-				 >= caerEventPacketHeaderGetEventCapacity((caerEventPacketHeader) state->currentPackets.special)) {
-			// If not committed, let's check if any of the packets has reached its maximum
-			// capacity limit. If yes, we grow them to accomodate new events.
-			caerSpecialEventPacket grownPacket = (caerSpecialEventPacket) caerEventPacketGrow(
-				(caerEventPacketHeader) state->currentPackets.special, state->currentPackets.specialPosition * 2);
-			if (grownPacket == NULL) {
-				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to grow special event packet.");
-				return;
+
+		state->currentPackets.special = grownPacket;
+	}
+
+	return (true);
+}
+
+/**
+ * Commit the current packets if any of the packet container thresholds
+ * are met. Returns true if that happened, the current packets are then
+ * gone and need to be prepared again.
+ */
+static bool edvsCommitPackets(edvsHandle handle, bool tsReset, bool tsBigWrap) {
+	edvsState state = &handle->state;
+
+	// Thresholds on which to trigger packet container commit.
+	// Trigger if any of the global container-wide thresholds are met.
+	int32_t currentPacketContainerCommitSize = containerGenerationGetMaxPacketSize(&state->container);
+	bool containerSizeCommit                 = (currentPacketContainerCommitSize > 0)
+							   && ((state->currentPackets.polarityPosition >= currentPacketContainerCommitSize)
+								   || (state->currentPackets.specialPosition >= currentPacketContainerCommitSize));
+
+	bool containerTimeCommit = containerGenerationIsCommitTimestampElapsed(
+		&state->container, state->timestamps.wrapOverflow, state->timestamps.current);
+
+	// NOTE: with the current EDVS architecture, currentTimestamp always comes together
+	// with an event, so the very first event that matches this threshold will be
+	// also part of the committed packet container. This doesn't break any of the invariants.
+
+	// Commit packet containers to the ring-buffer, so they can be processed by the
+	// main-loop, when any of the required conditions are met.
+	if (!(tsReset || tsBigWrap || containerSizeCommit || containerTimeCommit)) {
+		return (false);
+	}
+
+	// One or more of the commit triggers are hit. Set the packet container up to contain
+	// any non-empty packets. Empty packets are not forwarded to save memory.
+	bool emptyContainerCommit = true;
+
+	if (state->currentPackets.polarityPosition > 0) {
+		containerGenerationSetPacket(
+			&state->container, POLARITY_EVENT, (caerEventPacketHeader) state->currentPackets.polarity);
+
+		state->currentPackets.polarity         = NULL;
+		state->currentPackets.polarityPosition = 0;
+		emptyContainerCommit                   = false;
+	}
+
+	if (state->currentPackets.specialPosition > 0) {
+		containerGenerationSetPacket(
+			&state->container, SPECIAL_EVENT, (caerEventPacketHeader) state->currentPackets.special);
+
+		state->currentPackets.special         = NULL;
+		state->currentPackets.specialPosition = 0;
+		emptyContainerCommit                  = false;
+	}
+
+	if (tsReset || tsBigWrap) {
+		// Empty packets still carry the old timestamp overflow, drop them so they
+		// are allocated again with the new one.
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
+		state->currentPackets.polarity = NULL;
+
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
+		state->currentPackets.special = NULL;
+	}
+
+	containerGenerationExecute(&state->container, emptyContainerCommit, tsReset, state->timestamps.wrapOverflow,
+		state->timestamps.current, &state->dataExchange, &state->serialState.serialThreadState, handle->info.deviceID,
+		handle->info.deviceString, &handle->state.deviceLogLevel);
+
+	return (true);
+}
+
+/**
+ * Decode as many events as possible from 'buffer'. Misaligned data is
+ * skipped once up to the next Y address byte, then whole aligned runs of
+ * events are decoded in a tight loop, with packet space reserved up-front.
+ * Returns the number of bytes used; the rest is an incomplete event that
+ * must be passed in again, at the start of the next buffer.
+ */
+static size_t edvsEventTranslator(edvsHandle handle, const uint8_t *buffer, size_t bytesSent) {
+	edvsState state = &handle->state;
+
+	// Return right away if not running anymore. This prevents useless work if many
+	// buffers are still waiting when shut down, as well as incorrect event sequences
+	// if a TS_RESET is stuck on ring-buffer commit further down, and detects shut-down;
+	// then any subsequent buffers should also detect shut-down and not be handled.
+	if (atomic_load(&state->serialState.serialThreadState) != THR_RUNNING) {
+		return (bytesSent);
+	}
+
+	uint8_t format = U8T(atomic_load_explicit(&state->dvs.timestampFormat, memory_order_relaxed));
+	if (format != state->timestamps.format) {
+		// Timestamp width changed, wrap detection has to start over.
+		state->timestamps.format  = format;
+		state->timestamps.lastRaw = 0;
+	}
+
+	// Region of interest settings stay the same for the whole buffer.
+	dvsROIUpdate(&state->dvs.roi);
+
+	// Smallest possible event: Y and X address, plus one or more timestamp bytes.
+	const size_t minEventSize = (format == EDVS_TIMESTAMP_FORMAT_DELTA) ? (3) : (2 + (size_t) format);
+
+	size_t i = 0;
+
+	while (i < bytesSent) {
+		// Resynchronize on the next Y address byte, which has the high bit set.
+		if ((buffer[i] & HIGH_BIT_MASK) != HIGH_BIT_MASK) {
+			size_t skipStart = i;
+
+			while ((i < bytesSent) && ((buffer[i] & HIGH_BIT_MASK) != HIGH_BIT_MASK)) {
+				i++;
 			}
 
-			state->currentPackets.special = grownPacket;
+			edvsLog(CAER_LOG_NOTICE, handle, "Data not aligned, skipped %zu bytes (%zu of %zu).", i - skipStart,
+				skipStart, bytesSent);
+			continue;
 		}
 
-		bool tsReset   = false;
-		bool tsBigWrap = false;
-
-		uint8_t xByte   = buffer[i + 1];
-		uint8_t ts1Byte = buffer[i + 2];
-		uint8_t ts2Byte = buffer[i + 3];
+		if ((bytesSent - i) < minEventSize) {
+			// Cannot fetch next event data, keep it for the next buffer.
+			break;
+		}
 
-		uint16_t shortTS = U16T((ts1Byte << 8) | ts2Byte);
+		if (!edvsPreparePackets(handle, (bytesSent - i) / minEventSize)) {
+			return (bytesSent);
+		}
 
 		// Timestamp reset.
 		if (atomic_load(&state->dvs.tsReset)) {
@@ -906,138 +1241,62 @@ static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSe
 
 			state->timestamps.wrapOverflow = 0;
 			state->timestamps.wrapAdd      = 0;
-			state->timestamps.lastShort    = 0;
+			state->timestamps.lastRaw      = 0;
 			state->timestamps.last         = 0;
 			state->timestamps.current      = 0;
 			containerGenerationCommitTimestampReset(&state->container);
 			containerGenerationCommitTimestampInit(&state->container, state->timestamps.current);
 
-			// Defer timestamp reset event to later, so we commit it
-			// alone, in its own packet.
 			// Commit packets when doing a reset to clearly separate them.
-			tsReset = true;
+			edvsCommitPackets(handle, true, false);
+			continue;
 		}
-		else {
-			bool tsWrap = (shortTS < state->timestamps.lastShort);
-
-			// Timestamp big wrap.
-			if (tsWrap && (state->timestamps.wrapAdd == (INT32_MAX - (TS_WRAP_ADD - 1)))) {
-				// Reset wrapAdd to zero at this point, so we can again
-				// start detecting overruns of the 32bit value.
-				state->timestamps.wrapAdd = 0;
 
-				state->timestamps.lastShort = 0;
+		// Decode the aligned run of events, until misaligned data, the end of
+		// the buffer or a packet container commit (new packets needed).
+		bool committed = false;
 
-				state->timestamps.last    = 0;
-				state->timestamps.current = 0;
+		while ((!committed) && (i < bytesSent) && ((buffer[i] & HIGH_BIT_MASK) == HIGH_BIT_MASK)) {
+			uint32_t timestamp = 0;
+			size_t eventSize   = edvsEventDecodeTimestamp(format, &buffer[i], bytesSent - i, &timestamp);
 
-				// Increment TSOverflow counter.
-				state->timestamps.wrapOverflow++;
-
-				caerSpecialEvent currentEvent = caerSpecialEventPacketGetEvent(
-					state->currentPackets.special, state->currentPackets.specialPosition++);
-				caerSpecialEventSetTimestamp(currentEvent, INT32_MAX);
-				caerSpecialEventSetType(currentEvent, TIMESTAMP_WRAP);
-				caerSpecialEventValidate(currentEvent, state->currentPackets.special);
-
-				// Commit packets to separate before wrap from after cleanly.
-				tsBigWrap = true;
+			if (eventSize == EDVS_EVENT_INCOMPLETE) {
+				// Cannot fetch next event data, keep it for the next buffer.
+				return (i);
 			}
-			else {
-				if (tsWrap) {
-					// Timestamp normal wrap (every ~65 ms).
-					state->timestamps.wrapAdd += TS_WRAP_ADD;
 
-					state->timestamps.lastShort = 0;
-				}
-				else {
-					// Not a wrap, set this to track wrapping.
-					state->timestamps.lastShort = shortTS;
-				}
-
-				// Expand to 32 bits. (Tick is 1µs already.)
-				state->timestamps.last    = state->timestamps.current;
-				state->timestamps.current = state->timestamps.wrapAdd + shortTS;
-				containerGenerationCommitTimestampInit(&state->container, state->timestamps.current);
-
-				// Check monotonicity of timestamps.
-				checkMonotonicTimestamp(state->timestamps.current, state->timestamps.last, handle->info.deviceString,
-					&handle->state.deviceLogLevel);
-
-				uint8_t x     = (xByte & LOW_BITS_MASK);
-				uint8_t y     = (yByte & LOW_BITS_MASK);
-				bool polarity = !(xByte & HIGH_BIT_MASK);
-
-				// Check range conformity.
-				if ((x < EDVS_ARRAY_SIZE_X) && (y < EDVS_ARRAY_SIZE_Y)) {
-					caerPolarityEvent currentEvent = caerPolarityEventPacketGetEvent(
-						state->currentPackets.polarity, state->currentPackets.polarityPosition++);
-					caerPolarityEventSetTimestamp(currentEvent, state->timestamps.current);
-					caerPolarityEventSetPolarity(currentEvent, polarity);
-					caerPolarityEventSetY(currentEvent, y);
-					caerPolarityEventSetX(currentEvent, x);
-					caerPolarityEventValidate(currentEvent, state->currentPackets.polarity);
-				}
-				else {
-					if (x >= EDVS_ARRAY_SIZE_X) {
-						edvsLog(CAER_LOG_ALERT, handle, "X address out of range (0-%d): %" PRIu16 ".",
-							EDVS_ARRAY_SIZE_X - 1, x);
-					}
-					if (y >= EDVS_ARRAY_SIZE_Y) {
-						edvsLog(CAER_LOG_ALERT, handle, "Y address out of range (0-%d): %" PRIu16 ".",
-							EDVS_ARRAY_SIZE_Y - 1, y);
-					}
-				}
+			if (eventSize == EDVS_EVENT_INVALID) {
+				edvsLog(CAER_LOG_NOTICE, handle, "Delta timestamp too long, skipping to next data byte (%zu of %zu).",
+					i, bytesSent);
+				i++;
+				break;
 			}
-		}
 
-		// Thresholds on which to trigger packet container commit.
-		// tsReset and tsBigWrap are already defined above.
-		// Trigger if any of the global container-wide thresholds are met.
-		int32_t currentPacketContainerCommitSize = containerGenerationGetMaxPacketSize(&state->container);
-		bool containerSizeCommit                 = (currentPacketContainerCommitSize > 0)
-								   && ((state->currentPackets.polarityPosition >= currentPacketContainerCommitSize)
-									   || (state->currentPackets.specialPosition >= currentPacketContainerCommitSize));
-
-		bool containerTimeCommit = containerGenerationIsCommitTimestampElapsed(
-			&state->container, state->timestamps.wrapOverflow, state->timestamps.current);
-
-		// NOTE: with the current EDVS architecture, currentTimestamp always comes together
-		// with an event, so the very first event that matches this threshold will be
-		// also part of the committed packet container. This doesn't break any of the invariants.
-
-		// Commit packet containers to the ring-buffer, so they can be processed by the
-		// main-loop, when any of the required conditions are met.
-		if (tsReset || tsBigWrap || containerSizeCommit || containerTimeCommit) {
-			// One or more of the commit triggers are hit. Set the packet container up to contain
-			// any non-empty packets. Empty packets are not forwarded to save memory.
-			bool emptyContainerCommit = true;
-
-			if (state->currentPackets.polarityPosition > 0) {
-				containerGenerationSetPacket(
-					&state->container, POLARITY_EVENT, (caerEventPacketHeader) state->currentPackets.polarity);
-
-				state->currentPackets.polarity         = NULL;
-				state->currentPackets.polarityPosition = 0;
-				emptyContainerCommit                   = false;
+			bool tsBigWrap = edvsUpdateTimestamp(handle, format, timestamp);
+
+			uint8_t yByte = buffer[i];
+			uint8_t xByte = buffer[i + 1];
+
+			// 7 bit addresses, always inside the 128x128 array. Drop events outside
+			// the host-side region of interest.
+			if ((!tsBigWrap)
+				&& dvsROIAccept(&state->dvs.roi, U16T(xByte & LOW_BITS_MASK), U16T(yByte & LOW_BITS_MASK))) {
+				caerPolarityEvent currentEvent = caerPolarityEventPacketGetEvent(
+					state->currentPackets.polarity, state->currentPackets.polarityPosition++);
+				caerPolarityEventSetTimestamp(currentEvent, state->timestamps.current);
+				caerPolarityEventSetPolarity(currentEvent, !(xByte & HIGH_BIT_MASK));
+				caerPolarityEventSetY(currentEvent, (yByte & LOW_BITS_MASK));
+				caerPolarityEventSetX(currentEvent, (xByte & LOW_BITS_MASK));
+				caerPolarityEventValidate(currentEvent, state->currentPackets.polarity);
 			}
 
-			if (state->currentPackets.specialPosition > 0) {
-				containerGenerationSetPacket(
-					&state->container, SPECIAL_EVENT, (caerEventPacketHeader) state->currentPackets.special);
-
-				state->currentPackets.special         = NULL;
-				state->currentPackets.specialPosition = 0;
-				emptyContainerCommit                  = false;
-			}
+			i += eventSize;
 
-			containerGenerationExecute(&state->container, emptyContainerCommit, tsReset, state->timestamps.wrapOverflow,
-				state->timestamps.current, &state->dataExchange, &state->serialState.serialThreadState,
-				handle->info.deviceID, handle->info.deviceString, &handle->state.deviceLogLevel);
+			committed = edvsCommitPackets(handle, false, tsBigWrap);
 		}
-
-		i += 4;
 	}
+
+	return (i);
 }
 
 static bool edvsSendBiases(edvsState state, int biasID) {
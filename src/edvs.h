@@ -6,6 +6,7 @@
 
 #include "container_generation.h"
 #include "data_exchange.h"
+#include "dvs_roi.h"
 
 #include <libserialport.h>
 #include <stdatomic.h>
@@ -20,8 +21,8 @@
 #define EDVS_ARRAY_SIZE_X 128
 #define EDVS_ARRAY_SIZE_Y 128
 
-#define EDVS_EVENT_TYPES 2
-#define EDVS_EVENT_SIZE  4
+#define EDVS_EVENT_TYPES    2
+#define EDVS_EVENT_MAX_SIZE 6 // Y and X address, up to 4 timestamp bytes.
 
 #define EDVS_POLARITY_DEFAULT_SIZE 4096
 #define EDVS_SPECIAL_DEFAULT_SIZE  128
@@ -38,6 +39,8 @@ struct serial_state {
 	atomic_uint_fast32_t serialThreadState;
 	// Serial Data Transfers
 	atomic_uint_fast32_t serialReadSize;
+	atomic_uint_fast32_t serialReadMinSize;
+	atomic_uint_fast32_t serialReadTimeout;
 	// Serial Data Transfers shutdown callback
 	void (*serialShutdownCallback)(void *serialShutdownCallbackPtr);
 	void *serialShutdownCallbackPtr;
@@ -56,7 +59,8 @@ struct edvs_state {
 		int32_t wrapAdd;
 		int32_t last;
 		int32_t current;
-		uint16_t lastShort; // For wrap detection.
+		uint32_t lastRaw; // For wrap detection.
+		uint8_t format;   // Format the wrap detection state refers to.
 	} timestamps;
 	// Packet Container state
 	struct container_generation container;
@@ -73,6 +77,9 @@ struct edvs_state {
 		uint8_t biases[BIAS_NUMBER][BIAS_LENGTH];
 		atomic_bool running;
 		atomic_bool tsReset;
+		atomic_uint_fast8_t timestampFormat;
+		// Host-side region of interest.
+		struct dvs_roi roi;
 	} dvs;
 };
 
@@ -0,0 +1,87 @@
+#include "libcaer/events/common.h"
+
+// SSE2 is part of the x86-64 baseline and NEON of AArch64, so no runtime
+// dispatch is needed; everything else uses the scalar loop only.
+// Both vector paths rely on the event data being in host byte order.
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#	if defined(__SSE2__)
+#		include <emmintrin.h>
+#		define EVENT_PACKET_CLEAN_SSE2 1
+#	elif defined(__ARM_NEON)
+#		include <arm_neon.h>
+#		define EVENT_PACKET_CLEAN_NEON 1
+#	endif
+#endif
+
+#define EVENT_SIZE 8
+
+// Number of valid events for each two bit validity mask.
+static const uint8_t validCount[4] = {0, 1, 1, 2};
+
+#if defined(EVENT_PACKET_CLEAN_SSE2)
+// Compact two events: both are always stored, and the destination only
+// advances past the valid ones, so invalid events get overwritten later,
+// or zeroed by the caller. If only the second event is valid, it is
+// moved down first. Returns the number of valid events.
+static inline size_t compactPair(const uint8_t *src, uint8_t *dest) {
+	const __m128i in = _mm_loadu_si128((const __m128i *) src);
+
+	// The valid mark is the lowest bit of each 64 bit lane, move it up
+	// to the sign bit to collect both into a mask.
+	const int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_slli_epi64(in, 63)));
+
+	const __m128i moveDown = _mm_set1_epi64x(-I64T(mask == 0x02));
+	const __m128i out
+		= _mm_or_si128(_mm_and_si128(moveDown, _mm_srli_si128(in, EVENT_SIZE)), _mm_andnot_si128(moveDown, in));
+
+	_mm_storeu_si128((__m128i *) dest, out);
+
+	return (validCount[mask]);
+}
+#elif defined(EVENT_PACKET_CLEAN_NEON)
+static inline size_t compactPair(const uint8_t *src, uint8_t *dest) {
+	const uint64x2_t in = vld1q_u64((const uint64_t *) src);
+
+	const uint64_t mask
+		= (vgetq_lane_u64(in, 0) & VALID_MARK_MASK) | ((vgetq_lane_u64(in, 1) & VALID_MARK_MASK) << 1);
+
+	const uint64x2_t moveDown = vdupq_n_u64(-U64T(mask == 0x02));
+	const uint64x2_t out      = vbslq_u64(moveDown, vextq_u64(in, vdupq_n_u64(0), 1), in);
+
+	vst1q_u64((uint64_t *) dest, out);
+
+	return (validCount[mask]);
+}
+#endif
+
+void caerEventPacketCompact8(caerEventPacketHeader packet) {
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(packet);
+
+	uint8_t *events = ((uint8_t *) packet) + CAER_EVENT_PACKET_HEADER_SIZE;
+	size_t i        = 0;
+
+	// Leading valid events are already in place.
+	while ((i < (size_t) eventNumber) && caerGenericEventIsValid(events + (i * EVENT_SIZE))) {
+		i++;
+	}
+
+	uint8_t *dest = events + (i * EVENT_SIZE);
+
+#if defined(EVENT_PACKET_CLEAN_SSE2) || defined(EVENT_PACKET_CLEAN_NEON)
+	// The 16 byte stores never go past the pair just read, so they
+	// stay inside the packet and only overwrite data already used.
+	for (; (i + 2) <= (size_t) eventNumber; i += 2) {
+		dest += compactPair(events + (i * EVENT_SIZE), dest) * EVENT_SIZE;
+	}
+#endif
+
+	// Remaining events, or all without SIMD: always copy, and only advance
+	// past valid events, to avoid unpredictable branches.
+	for (; i < (size_t) eventNumber; i++) {
+		const uint8_t *src = events + (i * EVENT_SIZE);
+		bool valid         = caerGenericEventIsValid(src);
+
+		memmove(dest, src, EVENT_SIZE);
+		dest += (valid) ? (EVENT_SIZE) : (0);
+	}
+}
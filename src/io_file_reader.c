@@ -0,0 +1,413 @@
+#include "libcaer/io/file_reader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#	include <io.h>
+#else
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+#define FILE_READER_NAME "File Reader"
+
+#define FILE_READER_VERSION_PREFIX "#!AER-DAT3."
+#define FILE_READER_END_OF_HEADER  "#!END-HEADER\r\n"
+
+// Sidecar index file: this header, followed by the index entries,
+// all fields little-endian.
+#define FILE_READER_INDEX_MAGIC        "CAERIDX1"
+#define FILE_READER_INDEX_MAGIC_LENGTH 8
+
+PACKED_STRUCT(struct file_reader_index_header {
+	char magic[FILE_READER_INDEX_MAGIC_LENGTH];
+	uint64_t fileSize;
+	int64_t fileModificationTime;
+	uint64_t entriesNumber;
+});
+
+struct caer_file_reader {
+	// Memory-mapped file.
+	const uint8_t *data;
+	size_t dataSize;
+	int64_t modificationTime;
+	int8_t version;
+	// Packet index.
+	size_t packetsNumber;
+	struct caer_file_reader_index_entry *index;
+	// Running maximum of the packets' last timestamps, monotonic, for seeking.
+	int64_t *lastTimestampMax;
+};
+
+static bool mapFile(caerFileReader reader, const char *fileName) {
+#if defined(_WIN32)
+	// Binary mode, or the CRT translates CR-LF and stops at the first 0x1A.
+	int fd = open(fileName, O_RDONLY | O_BINARY);
+#else
+	int fd = open(fileName, O_RDONLY);
+#endif
+	if (fd < 0) {
+		caerLog(CAER_LOG_ERROR, FILE_READER_NAME, "Failed to open file '%s'. Error: %d.", fileName, errno);
+		return (false);
+	}
+
+	struct stat fileStat;
+	if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0)) {
+		caerLog(CAER_LOG_ERROR, FILE_READER_NAME, "Failed to get size of file '%s', or file empty.", fileName);
+		close(fd);
+		return (false);
+	}
+
+	reader->dataSize         = (size_t) fileStat.st_size;
+	reader->modificationTime = (int64_t) fileStat.st_mtime;
+
+#if defined(_WIN32)
+	// No mmap(), read the whole file into memory instead.
+	uint8_t *data = malloc(reader->dataSize);
+	if ((data == NULL) || (read(fd, data, (unsigned int) reader->dataSize) != (int) reader->dataSize)) {
+		free(data);
+		data = NULL;
+	}
+#else
+	void *data = mmap(NULL, reader->dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		data = NULL;
+	}
+#endif
+
+	close(fd);
+
+	if (data == NULL) {
+		caerLog(CAER_LOG_ERROR, FILE_READER_NAME, "Failed to map file '%s'. Error: %d.", fileName, errno);
+		return (false);
+	}
+
+	reader->data = data;
+
+	return (true);
+}
+
+static void unmapFile(caerFileReader reader) {
+#if defined(_WIN32)
+	free((void *) (uintptr_t) reader->data);
+#else
+	munmap((void *) (uintptr_t) reader->data, reader->dataSize);
+#endif
+}
+
+// Parse the text header, return the offset of the first packet, zero on error.
+static size_t parseFileHeader(caerFileReader reader) {
+	const size_t prefixLength = strlen(FILE_READER_VERSION_PREFIX);
+
+	if ((reader->dataSize <= prefixLength)
+		|| (memcmp(reader->data, FILE_READER_VERSION_PREFIX, prefixLength) != 0)
+		|| (reader->data[prefixLength] < '0') || (reader->data[prefixLength] > '9')) {
+		caerLog(CAER_LOG_ERROR, FILE_READER_NAME, "Not an AEDAT 3.x file.");
+		return (0);
+	}
+
+	reader->version = (int8_t) (reader->data[prefixLength] - '0');
+
+	// All header lines start with '#', the last one is the end of header marker.
+	const size_t endLength = strlen(FILE_READER_END_OF_HEADER);
+	size_t lineStart       = 0;
+
+	while ((lineStart < reader->dataSize) && (reader->data[lineStart] == '#')) {
+		const uint8_t *lineEnd = memchr(reader->data + lineStart, '\n', reader->dataSize - lineStart);
+		if (lineEnd == NULL) {
+			break;
+		}
+
+		size_t nextLine = (size_t) (lineEnd - reader->data) + 1;
+
+		if (((nextLine - lineStart) == endLength)
+			&& (memcmp(reader->data + lineStart, FILE_READER_END_OF_HEADER, endLength) == 0)) {
+			return (nextLine);
+		}
+
+		lineStart = nextLine;
+	}
+
+	caerLog(CAER_LOG_ERROR, FILE_READER_NAME, "AEDAT 3.x file header is not terminated.");
+	return (0);
+}
+
+static int64_t packetEventTimestamp64(caerEventPacketHeaderConst packet, int32_t n) {
+	const uint8_t *event = (const uint8_t *) packet + CAER_EVENT_PACKET_HEADER_SIZE
+						   + ((size_t) n * (size_t) caerEventPacketHeaderGetEventSize(packet));
+
+	// The mapping is not aligned, so copy the timestamp out.
+	uint32_t timestamp;
+	memcpy(&timestamp, event + caerEventPacketHeaderGetEventTSOffset(packet), sizeof(timestamp));
+
+	return (I64T((U64T(caerEventPacketHeaderGetEventTSOverflow(packet)) << TS_OVERFLOW_SHIFT)
+				 | U64T(I32T(le32toh(timestamp)))));
+}
+
+static bool addIndexEntry(caerFileReader reader, size_t *indexCapacity, uint64_t offset, int64_t first, int64_t last) {
+	if (reader->packetsNumber == *indexCapacity) {
+		size_t newCapacity = (*indexCapacity == 0) ? (1024) : (*indexCapacity * 2);
+
+		struct caer_file_reader_index_entry *newIndex
+			= realloc(reader->index, newCapacity * sizeof(struct caer_file_reader_index_entry));
+		if (newIndex == NULL) {
+			return (false);
+		}
+
+		reader->index  = newIndex;
+		*indexCapacity = newCapacity;
+	}
+
+	reader->index[reader->packetsNumber].offset         = offset;
+	reader->index[reader->packetsNumber].firstTimestamp = first;
+	reader->index[reader->packetsNumber].lastTimestamp  = last;
+	reader->packetsNumber++;
+
+	return (true);
+}
+
+static bool buildIndex(caerFileReader reader, size_t dataStart) {
+	size_t indexCapacity = 0;
+	size_t offset        = dataStart;
+
+	while ((reader->dataSize - offset) >= CAER_EVENT_PACKET_HEADER_SIZE) {
+		caerEventPacketHeaderConst packet = (caerEventPacketHeaderConst) (reader->data + offset);
+
+		int32_t eventSize     = caerEventPacketHeaderGetEventSize(packet);
+		int32_t eventTSOffset = caerEventPacketHeaderGetEventTSOffset(packet);
+		int32_t eventCapacity = caerEventPacketHeaderGetEventCapacity(packet);
+		int32_t eventNumber   = caerEventPacketHeaderGetEventNumber(packet);
+
+		if ((eventSize <= 0) || (eventTSOffset < 0) || (eventNumber < 0) || (eventCapacity < eventNumber)
+			|| (((size_t) eventTSOffset + sizeof(int32_t)) > (size_t) eventSize)) {
+			caerLog(CAER_LOG_ERROR, FILE_READER_NAME,
+				"Invalid packet header at offset %zu, ignoring rest of file.", offset);
+			break;
+		}
+
+		uint64_t packetSize = CAER_EVENT_PACKET_HEADER_SIZE + (U64T(eventCapacity) * U64T(eventSize));
+
+		if (packetSize > (reader->dataSize - offset)) {
+			caerLog(CAER_LOG_WARNING, FILE_READER_NAME, "Truncated packet at offset %zu, ignoring it.", offset);
+			break;
+		}
+
+		if (eventNumber > 0) {
+			// Compressed packets have the last timestamp in their second word, see polarityCompressed.h.
+			int32_t lastEvent = eventNumber - 1;
+			if ((caerEventPacketHeaderGetEventType(packet) == POLARITY_COMPRESSED_EVENT) && (eventNumber >= 2)) {
+				lastEvent = 1;
+			}
+
+			if (!addIndexEntry(reader, &indexCapacity, offset, packetEventTimestamp64(packet, 0),
+					packetEventTimestamp64(packet, lastEvent))) {
+				caerLog(CAER_LOG_CRITICAL, FILE_READER_NAME, "Failed to allocate memory for packet index.");
+				return (false);
+			}
+		}
+
+		offset += (size_t) packetSize;
+	}
+
+	return (true);
+}
+
+static bool loadIndex(caerFileReader reader, const char *indexFileName) {
+	FILE *indexFile = fopen(indexFileName, "rb");
+	if (indexFile == NULL) {
+		return (false);
+	}
+
+	struct file_reader_index_header header;
+
+	if ((fread(&header, sizeof(header), 1, indexFile) != 1)
+		|| (memcmp(header.magic, FILE_READER_INDEX_MAGIC, FILE_READER_INDEX_MAGIC_LENGTH) != 0)
+		|| (le64toh(header.fileSize) != reader->dataSize)
+		|| (I64T(le64toh(U64T(header.fileModificationTime))) != reader->modificationTime)) {
+		// Not an index, or for another version of the file.
+		fclose(indexFile);
+		return (false);
+	}
+
+	size_t entriesNumber = (size_t) le64toh(header.entriesNumber);
+
+	// Every packet has at least one event, so this bounds the entries number.
+	if (entriesNumber > (reader->dataSize / (CAER_EVENT_PACKET_HEADER_SIZE + 1))) {
+		fclose(indexFile);
+		return (false);
+	}
+
+	struct caer_file_reader_index_entry *index = malloc(entriesNumber * sizeof(struct caer_file_reader_index_entry));
+	if ((index == NULL) || (fread(index, sizeof(struct caer_file_reader_index_entry), entriesNumber, indexFile)
+							   != entriesNumber)) {
+		free(index);
+		fclose(indexFile);
+		return (false);
+	}
+
+	fclose(indexFile);
+
+	for (size_t i = 0; i < entriesNumber; i++) {
+		index[i].offset         = le64toh(index[i].offset);
+		index[i].firstTimestamp = I64T(le64toh(U64T(index[i].firstTimestamp)));
+		index[i].lastTimestamp  = I64T(le64toh(U64T(index[i].lastTimestamp)));
+
+		// Entries must point to packets fully inside the file.
+		if ((index[i].offset > (reader->dataSize - CAER_EVENT_PACKET_HEADER_SIZE))
+			|| (U64T(caerEventPacketGetSize((caerEventPacketHeaderConst) (reader->data + index[i].offset)))
+				> (reader->dataSize - index[i].offset))) {
+			free(index);
+			return (false);
+		}
+	}
+
+	reader->index         = index;
+	reader->packetsNumber = entriesNumber;
+
+	return (true);
+}
+
+static void saveIndex(caerFileReader reader, const char *indexFileName) {
+	FILE *indexFile = fopen(indexFileName, "wb");
+	if (indexFile == NULL) {
+		caerLog(CAER_LOG_WARNING, FILE_READER_NAME, "Failed to create index file '%s'. Error: %d.", indexFileName,
+			errno);
+		return;
+	}
+
+	struct file_reader_index_header header;
+	memcpy(header.magic, FILE_READER_INDEX_MAGIC, FILE_READER_INDEX_MAGIC_LENGTH);
+	header.fileSize             = htole64(U64T(reader->dataSize));
+	header.fileModificationTime = I64T(htole64(U64T(reader->modificationTime)));
+	header.entriesNumber        = htole64(U64T(reader->packetsNumber));
+
+	bool success = (fwrite(&header, sizeof(header), 1, indexFile) == 1);
+
+	for (size_t i = 0; success && (i < reader->packetsNumber); i++) {
+		struct caer_file_reader_index_entry entry;
+		entry.offset         = htole64(reader->index[i].offset);
+		entry.firstTimestamp = I64T(htole64(U64T(reader->index[i].firstTimestamp)));
+		entry.lastTimestamp  = I64T(htole64(U64T(reader->index[i].lastTimestamp)));
+
+		success = (fwrite(&entry, sizeof(entry), 1, indexFile) == 1);
+	}
+
+	if ((fclose(indexFile) != 0) || (!success)) {
+		caerLog(CAER_LOG_WARNING, FILE_READER_NAME, "Failed to write index file '%s'.", indexFileName);
+		remove(indexFileName);
+	}
+}
+
+caerFileReader caerFileReaderOpen(const char *fileName, const char *indexFileName) {
+	if (fileName == NULL) {
+		return (NULL);
+	}
+
+	caerFileReader reader = calloc(1, sizeof(struct caer_file_reader));
+	if (reader == NULL) {
+		caerLog(CAER_LOG_CRITICAL, FILE_READER_NAME, "Failed to allocate memory for file reader.");
+		return (NULL);
+	}
+
+	if (!mapFile(reader, fileName)) {
+		free(reader);
+		return (NULL);
+	}
+
+	size_t dataStart = parseFileHeader(reader);
+	if (dataStart == 0) {
+		unmapFile(reader);
+		free(reader);
+		return (NULL);
+	}
+
+	if ((indexFileName == NULL) || (!loadIndex(reader, indexFileName))) {
+		if (!buildIndex(reader, dataStart)) {
+			caerFileReaderClose(reader);
+			return (NULL);
+		}
+
+		if (indexFileName != NULL) {
+			saveIndex(reader, indexFileName);
+		}
+	}
+
+	if (reader->packetsNumber > 0) {
+		reader->lastTimestampMax = malloc(reader->packetsNumber * sizeof(int64_t));
+		if (reader->lastTimestampMax == NULL) {
+			caerLog(CAER_LOG_CRITICAL, FILE_READER_NAME, "Failed to allocate memory for packet index.");
+			caerFileReaderClose(reader);
+			return (NULL);
+		}
+
+		int64_t lastTimestampMax = INT64_MIN;
+
+		for (size_t i = 0; i < reader->packetsNumber; i++) {
+			if (reader->index[i].lastTimestamp > lastTimestampMax) {
+				lastTimestampMax = reader->index[i].lastTimestamp;
+			}
+
+			reader->lastTimestampMax[i] = lastTimestampMax;
+		}
+	}
+
+	return (reader);
+}
+
+void caerFileReaderClose(caerFileReader reader) {
+	if (reader == NULL) {
+		return;
+	}
+
+	unmapFile(reader);
+
+	free(reader->index);
+	free(reader->lastTimestampMax);
+	free(reader);
+}
+
+int8_t caerFileReaderGetVersion(caerFileReader reader) {
+	return (reader->version);
+}
+
+size_t caerFileReaderGetPacketsNumber(caerFileReader reader) {
+	return (reader->packetsNumber);
+}
+
+caerEventPacketHeaderConst caerFileReaderGetPacket(caerFileReader reader, size_t index) {
+	if (index >= reader->packetsNumber) {
+		return (NULL);
+	}
+
+	return ((caerEventPacketHeaderConst) (reader->data + reader->index[index].offset));
+}
+
+const struct caer_file_reader_index_entry *caerFileReaderGetIndexEntry(caerFileReader reader, size_t index) {
+	if (index >= reader->packetsNumber) {
+		return (NULL);
+	}
+
+	return (&reader->index[index]);
+}
+
+size_t caerFileReaderSeekTimestamp(caerFileReader reader, int64_t timestamp) {
+	// First packet whose running maximum of last timestamps reaches the timestamp.
+	size_t low  = 0;
+	size_t high = reader->packetsNumber;
+
+	while (low < high) {
+		size_t middle = low + ((high - low) / 2);
+
+		if (reader->lastTimestampMax[middle] < timestamp) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	return (low);
+}
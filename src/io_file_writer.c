@@ -0,0 +1,419 @@
+#include "libcaer/io/file_writer.h"
+
+#include "libcaer/events/polarityColumns.h"
+#include "libcaer/network.h"
+#include "libcaer/ringbuffer.h"
+
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined(HAVE_PTHREADS)
+#	include "c11threads_posix.h"
+#endif
+
+#if defined(_WIN32)
+#	include <io.h>
+
+struct iovec {
+	void *iov_base;
+	size_t iov_len;
+};
+#else
+#	include <sys/uio.h>
+#	include <unistd.h>
+#endif
+
+#define FILE_WRITER_NAME "File Writer"
+
+// Maximum number of I/O vectors per writev() call, each packet needs two
+// (header and events).
+#if defined(IOV_MAX) && (IOV_MAX < 1024)
+#	define FILE_WRITER_MAX_IOV IOV_MAX
+#else
+#	define FILE_WRITER_MAX_IOV 1024
+#endif
+
+#define FILE_WRITER_MAX_PACKETS (FILE_WRITER_MAX_IOV / 2)
+
+// Maximum number of queued containers gathered into one batch by the
+// background thread.
+#define FILE_WRITER_MAX_CONTAINERS 64
+
+struct file_writer_element {
+	caerEventPacketContainerConst container;
+	void (*containerDone)(void *containerDonePtr);
+	void *containerDonePtr;
+};
+
+struct caer_file_writer {
+	int fileDescriptor;
+	// Set on the first failed write, all later writes are refused.
+	atomic_bool failed;
+	// Background writer, 'queue' is NULL in synchronous mode.
+	caerRingBuffer queue;
+	thrd_t thread;
+	atomic_bool running;
+	// Statistics, updated by the writing thread.
+	atomic_uint_fast64_t bytesWritten;
+	atomic_uint_fast64_t packetsWritten;
+	atomic_uint_fast64_t eventsWritten;
+	// Current batch, only accessed by the writing thread.
+	int iovNumber;
+	struct iovec iov[FILE_WRITER_MAX_IOV];
+	size_t packetsNumber;
+	uint64_t batchEvents;
+	// Headers as written to the file, the capacity equals the number of events.
+	struct caer_event_packet_header headers[FILE_WRITER_MAX_PACKETS];
+	// Packets converted from polarity columns, freed after writing.
+	caerEventPacketHeader converted[FILE_WRITER_MAX_PACKETS];
+	size_t convertedNumber;
+	// Containers in the batch, released after writing.
+	struct file_writer_element containers[FILE_WRITER_MAX_CONTAINERS];
+	size_t containersNumber;
+};
+
+static int fileWriterThread(void *writerPtr);
+static void freeContainerDone(void *containerDonePtr);
+
+// Write all I/O vectors, handling partial writes. Modifies 'iov'.
+static bool writeVectorsFully(int fileDescriptor, struct iovec *iov, int iovNumber) {
+	while (iovNumber > 0) {
+#if defined(_WIN32)
+		int result = _write(fileDescriptor, iov->iov_base, (unsigned int) iov->iov_len);
+#else
+		ssize_t result = writev(fileDescriptor, iov, iovNumber);
+#endif
+		if (result < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			return (false);
+		}
+
+		size_t written = (size_t) result;
+
+		// Skip fully written vectors, then adjust the partially written one.
+		while ((iovNumber > 0) && (written >= iov->iov_len)) {
+			written -= iov->iov_len;
+			iov++;
+			iovNumber--;
+		}
+
+		if (iovNumber > 0) {
+			iov->iov_base = (uint8_t *) iov->iov_base + written;
+			iov->iov_len -= written;
+		}
+	}
+
+	return (true);
+}
+
+static void batchFlush(caerFileWriter writer) {
+	if (writer->iovNumber > 0) {
+		uint64_t bytes = 0;
+		for (int i = 0; i < writer->iovNumber; i++) {
+			bytes += writer->iov[i].iov_len;
+		}
+
+		if (!atomic_load(&writer->failed)) {
+			if (writeVectorsFully(writer->fileDescriptor, writer->iov, writer->iovNumber)) {
+				atomic_fetch_add(&writer->bytesWritten, bytes);
+				atomic_fetch_add(&writer->packetsWritten, writer->packetsNumber);
+				atomic_fetch_add(&writer->eventsWritten, writer->batchEvents);
+			}
+			else {
+				caerLog(CAER_LOG_ERROR, FILE_WRITER_NAME, "Failed to write to file. Error: %d.", errno);
+				atomic_store(&writer->failed, true);
+			}
+		}
+	}
+
+	writer->iovNumber     = 0;
+	writer->packetsNumber = 0;
+	writer->batchEvents   = 0;
+
+	for (size_t i = 0; i < writer->convertedNumber; i++) {
+		caerEventPacketFree(writer->converted[i]);
+	}
+
+	writer->convertedNumber = 0;
+}
+
+// Add all non-empty packets of a container to the batch, flushing
+// when full. The container itself is not released here.
+static void batchAddContainer(caerFileWriter writer, caerEventPacketContainerConst container) {
+	for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(container); i++) {
+		caerEventPacketHeaderConst packet = caerEventPacketContainerGetEventPacketConst(container, i);
+		if ((packet == NULL) || (caerEventPacketHeaderGetEventNumber(packet) <= 0)) {
+			continue;
+		}
+
+		if (writer->packetsNumber == FILE_WRITER_MAX_PACKETS) {
+			batchFlush(writer);
+		}
+
+		if (caerEventPacketHeaderGetEventType(packet) == POLARITY_COLUMNS_EVENT) {
+			caerEventPacketHeader polarity = (caerEventPacketHeader) caerPolarityEventPacketFromPolarityColumns(
+				(caerPolarityColumnsEventPacketConst) packet);
+			if (polarity == NULL) {
+				caerLog(CAER_LOG_ERROR, FILE_WRITER_NAME, "Failed to convert polarity columns event packet.");
+				atomic_store(&writer->failed, true);
+				continue;
+			}
+
+			writer->converted[writer->convertedNumber++] = polarity;
+			packet                                       = polarity;
+		}
+
+		int32_t eventNumber = caerEventPacketHeaderGetEventNumber(packet);
+
+		struct caer_event_packet_header *header = &writer->headers[writer->packetsNumber];
+
+		memcpy(header, packet, CAER_EVENT_PACKET_HEADER_SIZE);
+		caerEventPacketHeaderSetEventCapacity(header, eventNumber);
+
+		writer->iov[writer->iovNumber].iov_base = header;
+		writer->iov[writer->iovNumber].iov_len  = CAER_EVENT_PACKET_HEADER_SIZE;
+		writer->iovNumber++;
+
+		// writev() never modifies the data, iovec just has no const variant.
+		writer->iov[writer->iovNumber].iov_base
+			= (void *) (uintptr_t) ((const uint8_t *) packet + CAER_EVENT_PACKET_HEADER_SIZE);
+		writer->iov[writer->iovNumber].iov_len  = (size_t) caerEventPacketGetDataSizeEvents(packet);
+		writer->iovNumber++;
+
+		writer->packetsNumber++;
+		writer->batchEvents += (uint64_t) eventNumber;
+	}
+}
+
+static void batchRelease(caerFileWriter writer) {
+	batchFlush(writer);
+
+	for (size_t i = 0; i < writer->containersNumber; i++) {
+		struct file_writer_element *element = &writer->containers[i];
+
+		if (element->containerDone != NULL) {
+			(*element->containerDone)(element->containerDonePtr);
+		}
+	}
+
+	writer->containersNumber = 0;
+}
+
+static bool writeFileHeader(caerFileWriter writer, int16_t sourceID, const char *sourceDescription) {
+	char header[1024];
+	int headerLength = snprintf(header, sizeof(header), "#!AER-DAT" AEDAT3_FILE_VERSION "\r\n#Format: RAW\r\n");
+
+	if (sourceDescription != NULL) {
+		headerLength += snprintf(header + headerLength, sizeof(header) - (size_t) headerLength,
+			"#Source %" PRIi16 ": %.512s\r\n", sourceID, sourceDescription);
+	}
+
+	time_t currentTimeEpoch = time(NULL);
+	struct tm currentTime;
+
+#if defined(_WIN32)
+	localtime_s(&currentTime, &currentTimeEpoch);
+#else
+	localtime_r(&currentTimeEpoch, &currentTime);
+#endif
+
+	char startTime[64];
+	strftime(startTime, sizeof(startTime), "#Start-Time: %Y-%m-%d %H:%M:%S (TZ%z)\r\n", &currentTime);
+
+	headerLength += snprintf(header + headerLength, sizeof(header) - (size_t) headerLength, "%s#!END-HEADER\r\n",
+		startTime);
+
+	struct iovec headerVector = {.iov_base = header, .iov_len = (size_t) headerLength};
+
+	if (!writeVectorsFully(writer->fileDescriptor, &headerVector, 1)) {
+		caerLog(CAER_LOG_ERROR, FILE_WRITER_NAME, "Failed to write file header. Error: %d.", errno);
+		return (false);
+	}
+
+	atomic_store(&writer->bytesWritten, (uint64_t) headerLength);
+
+	return (true);
+}
+
+caerFileWriter caerFileWriterOpen(int fileDescriptor, int16_t sourceID, const char *sourceDescription, size_t queueSize) {
+	if (fileDescriptor < 0) {
+		return (NULL);
+	}
+
+	caerFileWriter writer = calloc(1, sizeof(struct caer_file_writer));
+	if (writer == NULL) {
+		caerLog(CAER_LOG_CRITICAL, FILE_WRITER_NAME, "Failed to allocate memory for file writer.");
+		return (NULL);
+	}
+
+	writer->fileDescriptor = fileDescriptor;
+
+	atomic_store(&writer->failed, false);
+	atomic_store(&writer->bytesWritten, 0);
+	atomic_store(&writer->packetsWritten, 0);
+	atomic_store(&writer->eventsWritten, 0);
+
+	if (!writeFileHeader(writer, sourceID, sourceDescription)) {
+		free(writer);
+		return (NULL);
+	}
+
+	if (queueSize > 0) {
+		// Round up to the next power of two, as required by the ring-buffer.
+		size_t ringSize = 1;
+		while (ringSize < queueSize) {
+			ringSize <<= 1;
+		}
+
+		writer->queue = caerRingBufferInit(ringSize);
+		if (writer->queue == NULL) {
+			caerLog(CAER_LOG_CRITICAL, FILE_WRITER_NAME, "Failed to allocate file writer queue.");
+			free(writer);
+			return (NULL);
+		}
+
+		atomic_store(&writer->running, true);
+
+		if (thrd_create(&writer->thread, &fileWriterThread, writer) != thrd_success) {
+			caerLog(CAER_LOG_CRITICAL, FILE_WRITER_NAME, "Failed to start file writer thread.");
+			caerRingBufferFree(writer->queue);
+			free(writer);
+			return (NULL);
+		}
+	}
+
+	return (writer);
+}
+
+bool caerFileWriterClose(caerFileWriter writer) {
+	if (writer == NULL) {
+		return (false);
+	}
+
+	if (writer->queue != NULL) {
+		// The thread empties the queue before exiting.
+		atomic_store(&writer->running, false);
+
+		thrd_join(writer->thread, NULL);
+
+		caerRingBufferFree(writer->queue);
+	}
+
+	bool success = !atomic_load(&writer->failed);
+
+	free(writer);
+
+	return (success);
+}
+
+bool caerFileWriterWrite(caerFileWriter writer, caerEventPacketContainer container) {
+	return (caerFileWriterWriteNotify(writer, container, &freeContainerDone, container));
+}
+
+bool caerFileWriterWriteNotify(caerFileWriter writer, caerEventPacketContainerConst container,
+	void (*containerDone)(void *containerDonePtr), void *containerDonePtr) {
+	if ((writer == NULL) || (container == NULL) || atomic_load(&writer->failed)) {
+		return (false);
+	}
+
+	if (writer->queue == NULL) {
+		// Synchronous mode, write right away. If that fails, the container
+		// is not released, it stays with the caller.
+		batchAddContainer(writer, container);
+		batchFlush(writer);
+
+		if (atomic_load(&writer->failed)) {
+			return (false);
+		}
+
+		if (containerDone != NULL) {
+			(*containerDone)(containerDonePtr);
+		}
+
+		return (true);
+	}
+
+	struct file_writer_element *element = malloc(sizeof(struct file_writer_element));
+	if (element == NULL) {
+		caerLog(CAER_LOG_CRITICAL, FILE_WRITER_NAME, "Failed to allocate memory for file writer queue element.");
+		return (false);
+	}
+
+	*element = (struct file_writer_element){container, containerDone, containerDonePtr};
+
+	struct timespec queueFullSleep = {.tv_sec = 0, .tv_nsec = 100000};
+
+	while (!caerRingBufferPut(writer->queue, element)) {
+		// A failed writer refuses all writes, don't wait on it.
+		if (atomic_load(&writer->failed)) {
+			free(element);
+			return (false);
+		}
+
+		// Queue full, sleep for 100µs and retry.
+		thrd_sleep(&queueFullSleep, NULL);
+	}
+
+	return (true);
+}
+
+struct caer_file_writer_statistics caerFileWriterStatisticsGet(caerFileWriter writer) {
+	struct caer_file_writer_statistics statistics = {0, 0, 0};
+
+	if (writer == NULL) {
+		return (statistics);
+	}
+
+	statistics.bytesWritten   = atomic_load(&writer->bytesWritten);
+	statistics.packetsWritten = atomic_load(&writer->packetsWritten);
+	statistics.eventsWritten  = atomic_load(&writer->eventsWritten);
+
+	return (statistics);
+}
+
+static int fileWriterThread(void *writerPtr) {
+	caerFileWriter writer = writerPtr;
+
+	thrd_set_name(FILE_WRITER_NAME);
+
+	struct timespec queueEmptySleep = {.tv_sec = 0, .tv_nsec = 100000};
+
+	while (true) {
+		// Check before emptying the queue, so nothing added before close is missed.
+		bool running = atomic_load(&writer->running);
+
+		// Gather as many queued containers as possible into one batch.
+		struct file_writer_element *element;
+
+		while ((writer->containersNumber < FILE_WRITER_MAX_CONTAINERS)
+			   && ((element = caerRingBufferGet(writer->queue)) != NULL)) {
+			writer->containers[writer->containersNumber++] = *element;
+			free(element);
+
+			batchAddContainer(writer, writer->containers[writer->containersNumber - 1].container);
+		}
+
+		if (writer->containersNumber > 0) {
+			batchRelease(writer);
+			continue;
+		}
+
+		if (!running) {
+			break;
+		}
+
+		// Queue empty, sleep for 100µs to avoid busy loop.
+		thrd_sleep(&queueEmptySleep, NULL);
+	}
+
+	return (EXIT_SUCCESS);
+}
+
+static void freeContainerDone(void *containerDonePtr) {
+	caerEventPacketContainerFree(containerDonePtr);
+}
@@ -0,0 +1,773 @@
+#if defined(__linux__)
+// For recvmmsg().
+#	define _GNU_SOURCE 1
+#endif
+
+#include "libcaer/io/network_client.h"
+
+#include "libcaer/network.h"
+
+#include "network_utils.h"
+
+#include <poll.h>
+#include <sys/uio.h>
+#include <time.h>
+
+#define NETWORK_CLIENT_NAME "Network Client"
+
+#define NETWORK_CLIENT_TCP_BUFFER_SIZE (256 * 1024)
+
+// Maximum number of UDP datagrams received per recvmmsg() call.
+#define NETWORK_CLIENT_MAX_DATAGRAMS 32
+
+#define NETWORK_CLIENT_MAX_DATAGRAM_SIZE 65536
+
+#define NETWORK_CLIENT_UDP_RECEIVE_BUFFER_SIZE (4 * 1024 * 1024)
+
+// Datagrams arriving ahead of a missing one are held back, as it may just be
+// reordered, for at most this many sequence numbers and this long.
+#define NETWORK_CLIENT_REORDER_WINDOW     16
+#define NETWORK_CLIENT_REORDER_TIMEOUT_MS 10
+
+// Refuse packets bigger than this, their header must be corrupted.
+#define NETWORK_CLIENT_MAX_PACKET_SIZE (256 * 1024 * 1024)
+
+// Maximum number of packet buffers kept for reuse.
+#define NETWORK_CLIENT_POOL_SIZE 64
+
+struct network_client_pool_entry {
+	caerEventPacketHeader packet;
+	size_t size;
+};
+
+struct network_client_reorder_slot {
+	bool held;
+	size_t length;
+};
+
+struct caer_network_client {
+	bool isTCP;
+	int socketDescriptor;
+	uint16_t port;
+	bool connected;
+	int16_t sourceID;
+	// TCP: network header at the start of the stream.
+	uint8_t streamHeader[AEDAT3_NETWORK_HEADER_LENGTH];
+	size_t streamHeaderFill;
+	// UDP: next expected sequence number, and highest one received.
+	bool sequenceStarted;
+	int64_t sequenceNext;
+	int64_t sequenceHighest;
+	// UDP: datagrams held back, one slot per sequence number modulo the
+	// window, with the time since when the oldest one is waiting.
+	struct network_client_reorder_slot reorder[NETWORK_CLIENT_REORDER_WINDOW];
+	size_t reorderNumber;
+	struct timespec reorderStart;
+	uint8_t *reorderBuffer;
+	// Packet being reassembled: first its header, then the whole packet.
+	struct caer_event_packet_header packetHeader;
+	size_t packetHeaderFill;
+	caerEventPacketHeader packet;
+	size_t packetSize;
+	size_t packetFill;
+	// Complete packets not yet handed out, in arrival order.
+	caerEventPacketHeader *packets;
+	size_t packetsNumber;
+	size_t packetsCapacity;
+	// Packet buffers for reuse.
+	struct network_client_pool_entry pool[NETWORK_CLIENT_POOL_SIZE];
+	size_t poolNumber;
+	struct caer_network_client_statistics statistics;
+	// Receive buffer: TCP one big buffer, UDP one slot per datagram.
+	uint8_t *buffer;
+};
+
+// Get a buffer of at least 'size' bytes, the best fitting one from the pool,
+// as long as it is not more than twice as big, else newly allocated.
+static caerEventPacketHeader poolGet(caerNetworkClient client, size_t size) {
+	size_t best = NETWORK_CLIENT_POOL_SIZE;
+
+	for (size_t i = 0; i < client->poolNumber; i++) {
+		if ((client->pool[i].size >= size) && (client->pool[i].size <= (size * 2))
+			&& ((best == NETWORK_CLIENT_POOL_SIZE) || (client->pool[i].size < client->pool[best].size))) {
+			best = i;
+		}
+	}
+
+	if (best == NETWORK_CLIENT_POOL_SIZE) {
+		return (caerMalloc(size));
+	}
+
+	caerEventPacketHeader packet = client->pool[best].packet;
+
+	client->pool[best] = client->pool[client->poolNumber - 1];
+	client->poolNumber--;
+
+	return (packet);
+}
+
+// Keep a packet's memory for reuse. Its size is known from its header,
+// which is a lower bound if the buffer came from the pool itself.
+static void poolPut(caerNetworkClient client, caerEventPacketHeader packet) {
+	if (client->poolNumber == NETWORK_CLIENT_POOL_SIZE) {
+		caerFree(packet);
+		return;
+	}
+
+	client->pool[client->poolNumber].packet = packet;
+	client->pool[client->poolNumber].size   = (size_t) caerEventPacketGetSize(packet);
+	client->poolNumber++;
+}
+
+static bool packetHeaderValid(caerEventPacketHeaderConst header) {
+	int32_t eventSize     = caerEventPacketHeaderGetEventSize(header);
+	int32_t eventTSOffset = caerEventPacketHeaderGetEventTSOffset(header);
+	int32_t eventCapacity = caerEventPacketHeaderGetEventCapacity(header);
+	int32_t eventNumber   = caerEventPacketHeaderGetEventNumber(header);
+	int32_t eventValid    = caerEventPacketHeaderGetEventValid(header);
+
+	return ((eventSize > 0) && (eventTSOffset >= 0) && (eventCapacity > 0) && (eventNumber >= 0)
+			&& (eventValid >= 0) && (eventCapacity >= eventNumber) && (eventNumber >= eventValid)
+			&& (((size_t) eventTSOffset + sizeof(int32_t)) <= (size_t) eventSize)
+			&& ((U64T(eventCapacity) * U64T(eventSize)) <= NETWORK_CLIENT_MAX_PACKET_SIZE));
+}
+
+static bool networkHeaderValid(const struct aedat3_network_header *networkHeader, bool isTCP) {
+	int8_t formatNumber = networkHeader->formatNumber;
+
+	if (!isTCP) {
+		formatNumber = (int8_t) (formatNumber & ~AEDAT3_NETWORK_FORMAT_UDP_CONTINUATION);
+	}
+
+	return ((networkHeader->magicNumber == AEDAT3_NETWORK_MAGIC_NUMBER)
+			&& (networkHeader->versionNumber == AEDAT3_NETWORK_VERSION) && (formatNumber == 0));
+}
+
+static bool packetInProgress(caerNetworkClient client) {
+	return ((client->packet != NULL) || (client->packetHeaderFill > 0));
+}
+
+// Discard the packet being reassembled, it is incomplete or invalid.
+static void packetAbort(caerNetworkClient client) {
+	if (!packetInProgress(client)) {
+		return;
+	}
+
+	if (client->packet != NULL) {
+		poolPut(client, client->packet);
+	}
+
+	client->packet           = NULL;
+	client->packetHeaderFill = 0;
+	client->statistics.packetsDropped++;
+}
+
+static bool packetComplete(caerNetworkClient client) {
+	caerEventPacketHeader packet = client->packet;
+	client->packet               = NULL;
+
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(packet);
+
+	// Empty packets carry no information.
+	if (eventNumber == 0) {
+		poolPut(client, packet);
+		return (true);
+	}
+
+	if (client->packetsNumber == client->packetsCapacity) {
+		size_t newCapacity = (client->packetsCapacity == 0) ? (64) : (client->packetsCapacity * 2);
+
+		caerEventPacketHeader *newPackets = realloc(client->packets, newCapacity * sizeof(caerEventPacketHeader));
+		if (newPackets == NULL) {
+			caerLog(CAER_LOG_CRITICAL, NETWORK_CLIENT_NAME, "Failed to allocate memory for received packets.");
+			poolPut(client, packet);
+			client->statistics.packetsDropped++;
+			return (false);
+		}
+
+		client->packets         = newPackets;
+		client->packetsCapacity = newCapacity;
+	}
+
+	client->packets[client->packetsNumber++] = packet;
+
+	client->statistics.packetsReceived++;
+	client->statistics.eventsReceived += (uint64_t) eventNumber;
+
+	return (true);
+}
+
+// Feed event packet data. Returns false if it is not a valid packet stream.
+static bool packetsConsume(caerNetworkClient client, const uint8_t *data, size_t length) {
+	while (length > 0) {
+		size_t copy;
+
+		if (client->packet == NULL) {
+			copy = CAER_EVENT_PACKET_HEADER_SIZE - client->packetHeaderFill;
+			if (copy > length) {
+				copy = length;
+			}
+
+			memcpy((uint8_t *) &client->packetHeader + client->packetHeaderFill, data, copy);
+			client->packetHeaderFill += copy;
+
+			if (client->packetHeaderFill == CAER_EVENT_PACKET_HEADER_SIZE) {
+				if (!packetHeaderValid(&client->packetHeader)) {
+					return (false);
+				}
+
+				client->packetSize = (size_t) caerEventPacketGetSize(&client->packetHeader);
+
+				client->packet = poolGet(client, client->packetSize);
+				if (client->packet == NULL) {
+					caerLog(CAER_LOG_CRITICAL, NETWORK_CLIENT_NAME, "Failed to allocate memory for event packet.");
+					return (false);
+				}
+
+				memcpy(client->packet, &client->packetHeader, CAER_EVENT_PACKET_HEADER_SIZE);
+				client->packetFill       = CAER_EVENT_PACKET_HEADER_SIZE;
+				client->packetHeaderFill = 0;
+			}
+		}
+		else {
+			copy = client->packetSize - client->packetFill;
+			if (copy > length) {
+				copy = length;
+			}
+
+			memcpy((uint8_t *) client->packet + client->packetFill, data, copy);
+			client->packetFill += copy;
+		}
+
+		if ((client->packet != NULL) && (client->packetFill == client->packetSize)) {
+			if (!packetComplete(client)) {
+				return (false);
+			}
+		}
+
+		data += copy;
+		length -= copy;
+	}
+
+	return (true);
+}
+
+// TCP: network header once, then a continuous stream of packets.
+static bool streamHandle(caerNetworkClient client, const uint8_t *data, size_t length) {
+	client->statistics.bytesReceived += length;
+	client->statistics.messagesReceived++;
+
+	if (client->streamHeaderFill < AEDAT3_NETWORK_HEADER_LENGTH) {
+		size_t copy = AEDAT3_NETWORK_HEADER_LENGTH - client->streamHeaderFill;
+		if (copy > length) {
+			copy = length;
+		}
+
+		memcpy(client->streamHeader + client->streamHeaderFill, data, copy);
+		client->streamHeaderFill += copy;
+
+		data += copy;
+		length -= copy;
+
+		if (client->streamHeaderFill < AEDAT3_NETWORK_HEADER_LENGTH) {
+			return (true);
+		}
+
+		struct aedat3_network_header networkHeader = caerParseNetworkHeader(client->streamHeader);
+		if (!networkHeaderValid(&networkHeader, true)) {
+			caerLog(CAER_LOG_ERROR, NETWORK_CLIENT_NAME, "Invalid network header, not an AEDAT 3.x stream.");
+			return (false);
+		}
+
+		client->sourceID = networkHeader.sourceID;
+	}
+
+	if (!packetsConsume(client, data, length)) {
+		caerLog(CAER_LOG_ERROR, NETWORK_CLIENT_NAME, "Invalid event packet in stream.");
+		packetAbort(client);
+		return (false);
+	}
+
+	return (true);
+}
+
+// UDP: process a datagram in sequence. Packets can span multiple datagrams,
+// but always start at the beginning of one.
+static void datagramConsume(caerNetworkClient client, const uint8_t *data, size_t length) {
+	struct aedat3_network_header networkHeader = caerParseNetworkHeader(data);
+
+	if ((networkHeader.formatNumber & AEDAT3_NETWORK_FORMAT_UDP_CONTINUATION) == 0) {
+		// Starts a new packet, the previous one must be complete.
+		packetAbort(client);
+	}
+	else if (!packetInProgress(client)) {
+		// Rest of a packet whose start was lost.
+		return;
+	}
+
+	if (!packetsConsume(client, data + AEDAT3_NETWORK_HEADER_LENGTH, length - AEDAT3_NETWORK_HEADER_LENGTH)) {
+		packetAbort(client);
+	}
+}
+
+static inline size_t reorderSlot(int64_t sequenceNumber) {
+	return ((size_t) (U64T(sequenceNumber) % NETWORK_CLIENT_REORDER_WINDOW));
+}
+
+// Move on to the next sequence number: process its datagram if it is held,
+// else it is lost, and with it whatever packet was in progress.
+static void sequenceAdvance(caerNetworkClient client) {
+	size_t slot = reorderSlot(client->sequenceNext);
+
+	if (client->reorder[slot].held) {
+		client->reorder[slot].held = false;
+		client->reorderNumber--;
+
+		datagramConsume(
+			client, client->reorderBuffer + (slot * NETWORK_CLIENT_MAX_DATAGRAM_SIZE), client->reorder[slot].length);
+	}
+	else {
+		client->statistics.messagesLost++;
+		packetAbort(client);
+	}
+
+	client->sequenceNext++;
+}
+
+static int reorderRemainingMs(caerNetworkClient client) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	int64_t waitedUs = (I64T(now.tv_sec - client->reorderStart.tv_sec) * 1000000)
+					   + ((now.tv_nsec - client->reorderStart.tv_nsec) / 1000);
+	if (waitedUs >= (NETWORK_CLIENT_REORDER_TIMEOUT_MS * 1000)) {
+		return (0);
+	}
+
+	// Round up, so that waiting for the remaining time is enough.
+	return ((int) (((NETWORK_CLIENT_REORDER_TIMEOUT_MS * 1000) - waitedUs + 999) / 1000));
+}
+
+// Give up on the missing datagrams once the held ones waited long enough.
+// Returns true if that happened.
+static bool reorderExpire(caerNetworkClient client) {
+	if ((client->reorderNumber == 0) || (reorderRemainingMs(client) > 0)) {
+		return (false);
+	}
+
+	while (client->reorderNumber > 0) {
+		sequenceAdvance(client);
+	}
+
+	return (true);
+}
+
+// UDP: each datagram has its own network header and sequence number.
+// Datagrams are processed in sequence, those arriving ahead of a missing
+// one are held back until it arrives, or it is given up on as lost.
+static void datagramHandle(caerNetworkClient client, const uint8_t *data, size_t length) {
+	client->statistics.bytesReceived += length;
+	client->statistics.messagesReceived++;
+
+	if ((length < AEDAT3_NETWORK_HEADER_LENGTH) || (length > NETWORK_CLIENT_MAX_DATAGRAM_SIZE)) {
+		return;
+	}
+
+	struct aedat3_network_header networkHeader = caerParseNetworkHeader(data);
+	if (!networkHeaderValid(&networkHeader, false)) {
+		return;
+	}
+
+	client->sourceID = networkHeader.sourceID;
+
+	int64_t sequenceNumber = networkHeader.sequenceNumber;
+
+	if (!client->sequenceStarted) {
+		client->sequenceStarted = true;
+		client->sequenceNext    = sequenceNumber;
+		client->sequenceHighest = sequenceNumber;
+	}
+
+	if (sequenceNumber < client->sequenceNext) {
+		// Duplicate, or arrived after it was given up on.
+		client->statistics.messagesLate++;
+		return;
+	}
+
+	if ((sequenceNumber - client->sequenceNext) >= NETWORK_CLIENT_REORDER_WINDOW) {
+		// Too far ahead to keep waiting, give up on the oldest missing datagrams.
+		while ((client->reorderNumber > 0)
+			   && ((sequenceNumber - client->sequenceNext) >= NETWORK_CLIENT_REORDER_WINDOW)) {
+			sequenceAdvance(client);
+		}
+
+		if ((sequenceNumber - client->sequenceNext) >= NETWORK_CLIENT_REORDER_WINDOW) {
+			// Nothing held anymore, all datagrams up to this one are lost.
+			client->statistics.messagesLost += U64T(sequenceNumber - client->sequenceNext);
+			client->sequenceNext = sequenceNumber;
+
+			packetAbort(client);
+		}
+	}
+
+	if (sequenceNumber == client->sequenceNext) {
+		if (sequenceNumber < client->sequenceHighest) {
+			client->statistics.messagesReordered++;
+		}
+
+		datagramConsume(client, data, length);
+		client->sequenceNext++;
+
+		// Then all held datagrams that follow it directly.
+		while ((client->reorderNumber > 0) && client->reorder[reorderSlot(client->sequenceNext)].held) {
+			sequenceAdvance(client);
+		}
+	}
+	else {
+		size_t slot = reorderSlot(sequenceNumber);
+
+		if (client->reorder[slot].held) {
+			// Duplicate of a held datagram.
+			client->statistics.messagesLate++;
+			return;
+		}
+
+		if (sequenceNumber < client->sequenceHighest) {
+			client->statistics.messagesReordered++;
+		}
+
+		if (client->reorderNumber == 0) {
+			clock_gettime(CLOCK_MONOTONIC, &client->reorderStart);
+		}
+
+		memcpy(client->reorderBuffer + (slot * NETWORK_CLIENT_MAX_DATAGRAM_SIZE), data, length);
+		client->reorder[slot].held   = true;
+		client->reorder[slot].length = length;
+		client->reorderNumber++;
+	}
+
+	if (sequenceNumber > client->sequenceHighest) {
+		client->sequenceHighest = sequenceNumber;
+	}
+}
+
+// Wait for data and receive all that is available.
+// Returns false if nothing was received.
+static bool dataReceive(caerNetworkClient client, int timeoutMs) {
+	if (!client->connected) {
+		return (false);
+	}
+
+	struct pollfd pollDescriptor = {.fd = client->socketDescriptor, .events = POLLIN, .revents = 0};
+
+	if (poll(&pollDescriptor, 1, timeoutMs) <= 0) {
+		// Timeout, or interrupted.
+		return (false);
+	}
+
+	if (client->isTCP) {
+		ssize_t result = recv(client->socketDescriptor, client->buffer, NETWORK_CLIENT_TCP_BUFFER_SIZE, 0);
+
+		if (result <= 0) {
+			if ((result < 0) && (errnoWouldBlock() || (errno == EINTR))) {
+				return (false);
+			}
+
+			if (result < 0) {
+				caerLog(CAER_LOG_ERROR, NETWORK_CLIENT_NAME, "Failed to receive data. Error: %d.", errno);
+			}
+			else {
+				caerLog(CAER_LOG_DEBUG, NETWORK_CLIENT_NAME, "Server closed the connection.");
+			}
+
+			packetAbort(client);
+			client->connected = false;
+			return (false);
+		}
+
+		if (!streamHandle(client, client->buffer, (size_t) result)) {
+			client->connected = false;
+		}
+
+		return (true);
+	}
+
+#if defined(__linux__)
+	struct mmsghdr messages[NETWORK_CLIENT_MAX_DATAGRAMS];
+	struct iovec iov[NETWORK_CLIENT_MAX_DATAGRAMS];
+	memset(messages, 0, sizeof(messages));
+
+	for (size_t i = 0; i < NETWORK_CLIENT_MAX_DATAGRAMS; i++) {
+		iov[i].iov_base = client->buffer + (i * NETWORK_CLIENT_MAX_DATAGRAM_SIZE);
+		iov[i].iov_len  = NETWORK_CLIENT_MAX_DATAGRAM_SIZE;
+
+		messages[i].msg_hdr.msg_iov    = &iov[i];
+		messages[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	int result = recvmmsg(client->socketDescriptor, messages, NETWORK_CLIENT_MAX_DATAGRAMS, MSG_DONTWAIT, NULL);
+#else
+	ssize_t length = recv(client->socketDescriptor, client->buffer, NETWORK_CLIENT_MAX_DATAGRAM_SIZE, MSG_DONTWAIT);
+	int result     = (length < 0) ? (-1) : (1);
+#endif
+
+	if (result < 0) {
+		if (errnoWouldBlock() || (errno == EINTR) || (errno == ECONNREFUSED)) {
+			return (false);
+		}
+
+		caerLog(CAER_LOG_ERROR, NETWORK_CLIENT_NAME, "Failed to receive datagrams. Error: %d.", errno);
+		client->connected = false;
+		return (false);
+	}
+
+	for (size_t i = 0; i < (size_t) result; i++) {
+#if defined(__linux__)
+		size_t length = messages[i].msg_len;
+#endif
+
+		datagramHandle(client, client->buffer + (i * NETWORK_CLIENT_MAX_DATAGRAM_SIZE), (size_t) length);
+	}
+
+	return (true);
+}
+
+// Build a container from the oldest complete packets, up to, but not
+// including, the first packet of an event type already in it. Unless
+// 'force' is set, only if there is such a packet, as else more packets
+// for this container may still arrive.
+static caerEventPacketContainer containerBuild(caerNetworkClient client, bool force) {
+	size_t packetsNumber = 0;
+
+	for (; packetsNumber < client->packetsNumber; packetsNumber++) {
+		int16_t eventType = caerEventPacketHeaderGetEventType(client->packets[packetsNumber]);
+		bool repeated     = false;
+
+		for (size_t i = 0; i < packetsNumber; i++) {
+			if (caerEventPacketHeaderGetEventType(client->packets[i]) == eventType) {
+				repeated = true;
+				break;
+			}
+		}
+
+		if (repeated) {
+			break;
+		}
+	}
+
+	if ((packetsNumber == 0) || ((packetsNumber == client->packetsNumber) && (!force))) {
+		return (NULL);
+	}
+
+	caerEventPacketContainer container = caerEventPacketContainerAllocate((int32_t) packetsNumber);
+	if (container == NULL) {
+		return (NULL);
+	}
+
+	for (size_t i = 0; i < packetsNumber; i++) {
+		caerEventPacketContainerSetEventPacket(container, (int32_t) i, client->packets[i]);
+	}
+
+	client->packetsNumber -= packetsNumber;
+	memmove(client->packets, client->packets + packetsNumber, client->packetsNumber * sizeof(caerEventPacketHeader));
+
+	return (container);
+}
+
+static caerNetworkClient clientAllocate(bool isTCP) {
+	caerNetworkClient client = calloc(1, sizeof(struct caer_network_client));
+	if (client == NULL) {
+		caerLog(CAER_LOG_CRITICAL, NETWORK_CLIENT_NAME, "Failed to allocate memory for network client.");
+		return (NULL);
+	}
+
+	client->buffer = malloc((isTCP) ? (NETWORK_CLIENT_TCP_BUFFER_SIZE)
+									: (NETWORK_CLIENT_MAX_DATAGRAMS * NETWORK_CLIENT_MAX_DATAGRAM_SIZE));
+	if (client->buffer == NULL) {
+		caerLog(CAER_LOG_CRITICAL, NETWORK_CLIENT_NAME, "Failed to allocate memory for network client buffer.");
+		free(client);
+		return (NULL);
+	}
+
+	if (!isTCP) {
+		client->reorderBuffer = malloc(NETWORK_CLIENT_REORDER_WINDOW * NETWORK_CLIENT_MAX_DATAGRAM_SIZE);
+		if (client->reorderBuffer == NULL) {
+			caerLog(CAER_LOG_CRITICAL, NETWORK_CLIENT_NAME, "Failed to allocate memory for network client buffer.");
+			free(client->buffer);
+			free(client);
+			return (NULL);
+		}
+	}
+
+	client->isTCP     = isTCP;
+	client->connected = true;
+	client->sourceID  = -1;
+
+	return (client);
+}
+
+caerNetworkClient caerNetworkClientOpenTCP(const char *remoteAddress, uint16_t remotePort) {
+	if ((remoteAddress == NULL) || (remotePort == 0)) {
+		return (NULL);
+	}
+
+	caerNetworkClient client = clientAllocate(true);
+	if (client == NULL) {
+		return (NULL);
+	}
+
+	client->port = remotePort;
+
+	client->socketDescriptor = networkSocketOpen(remoteAddress, remotePort, SOCK_STREAM, false, NETWORK_CLIENT_NAME);
+	if (client->socketDescriptor < 0) {
+		free(client->buffer);
+		free(client);
+		return (NULL);
+	}
+
+	return (client);
+}
+
+caerNetworkClient caerNetworkClientOpenUDP(const char *localAddress, uint16_t localPort) {
+	caerNetworkClient client = clientAllocate(false);
+	if (client == NULL) {
+		return (NULL);
+	}
+
+	client->socketDescriptor = networkSocketOpen(localAddress, localPort, SOCK_DGRAM, true, NETWORK_CLIENT_NAME);
+	if (client->socketDescriptor < 0) {
+		free(client->reorderBuffer);
+		free(client->buffer);
+		free(client);
+		return (NULL);
+	}
+
+	// Queue up more datagrams, so short delays in receiving do not lose data.
+	int receiveBufferSize = NETWORK_CLIENT_UDP_RECEIVE_BUFFER_SIZE;
+	setsockopt(client->socketDescriptor, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize));
+
+	// Get the real port, in case any free port was requested.
+	client->port = networkSocketGetLocalPort(client->socketDescriptor);
+
+	return (client);
+}
+
+void caerNetworkClientClose(caerNetworkClient client) {
+	if (client == NULL) {
+		return;
+	}
+
+	close(client->socketDescriptor);
+
+	caerFree(client->packet);
+
+	for (size_t i = 0; i < client->packetsNumber; i++) {
+		caerFree(client->packets[i]);
+	}
+
+	for (size_t i = 0; i < client->poolNumber; i++) {
+		caerFree(client->pool[i].packet);
+	}
+
+	free(client->packets);
+	free(client->reorderBuffer);
+	free(client->buffer);
+	free(client);
+}
+
+uint16_t caerNetworkClientGetPort(caerNetworkClient client) {
+	return (client->port);
+}
+
+int16_t caerNetworkClientGetSourceID(caerNetworkClient client) {
+	return (client->sourceID);
+}
+
+bool caerNetworkClientIsConnected(caerNetworkClient client) {
+	return (client->connected);
+}
+
+caerEventPacketContainer caerNetworkClientReceive(caerNetworkClient client, int32_t timeoutMs) {
+	if (client == NULL) {
+		return (NULL);
+	}
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+	if (timeoutMs > 0) {
+		deadline.tv_sec += timeoutMs / 1000;
+		deadline.tv_nsec += (timeoutMs % 1000) * 1000000L;
+
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+	}
+
+	caerEventPacketContainer container;
+
+	while ((container = containerBuild(client, false)) == NULL) {
+		// Only wait if there is nothing to hand out yet.
+		int waitMs = 0;
+
+		if (client->packetsNumber == 0) {
+			if (timeoutMs < 0) {
+				waitMs = -1;
+			}
+			else {
+				struct timespec now;
+				clock_gettime(CLOCK_MONOTONIC, &now);
+
+				int64_t remainingMs = (I64T(deadline.tv_sec - now.tv_sec) * 1000)
+									  + ((deadline.tv_nsec - now.tv_nsec) / 1000000L);
+
+				waitMs = (remainingMs > 0) ? ((int) remainingMs) : (0);
+			}
+		}
+
+		// Don't wait past the time held datagrams are given up on.
+		if (client->reorderNumber > 0) {
+			int reorderMs = reorderRemainingMs(client);
+
+			if ((waitMs < 0) || (waitMs > reorderMs)) {
+				waitMs = reorderMs;
+			}
+		}
+
+		bool received = dataReceive(client, waitMs);
+
+		if ((!reorderExpire(client)) && (!received)) {
+			// Nothing more arrived, hand out whatever is there.
+			return (containerBuild(client, true));
+		}
+	}
+
+	return (container);
+}
+
+void caerNetworkClientRecycle(caerNetworkClient client, caerEventPacketContainer container) {
+	if (container == NULL) {
+		return;
+	}
+
+	for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(container); i++) {
+		caerEventPacketHeader packet = caerEventPacketContainerGetEventPacket(container, i);
+
+		if (packet != NULL) {
+			poolPut(client, packet);
+		}
+	}
+
+	caerFree(container);
+}
+
+struct caer_network_client_statistics caerNetworkClientStatisticsGet(caerNetworkClient client) {
+	struct caer_network_client_statistics statistics = {0, 0, 0, 0, 0, 0, 0, 0};
+
+	if (client == NULL) {
+		return (statistics);
+	}
+
+	return (client->statistics);
+}
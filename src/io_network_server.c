@@ -0,0 +1,1010 @@
+#if defined(__linux__)
+// For sendmmsg() and MSG_ZEROCOPY.
+#	define _GNU_SOURCE 1
+#endif
+
+#include "libcaer/io/network_server.h"
+
+#include "libcaer/events/polarityColumns.h"
+#include "libcaer/network.h"
+
+#include "network_utils.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <time.h>
+
+#if defined(__linux__)
+#	include <linux/errqueue.h>
+#endif
+
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#	define NETWORK_SERVER_HAVE_ZEROCOPY 1
+#endif
+
+#define NETWORK_SERVER_NAME "Network Server"
+
+// Maximum number of I/O vectors per sendmsg() call, each packet needs two
+// (header and events).
+#if defined(IOV_MAX) && (IOV_MAX < 1024)
+#	define NETWORK_SERVER_MAX_IOV IOV_MAX
+#else
+#	define NETWORK_SERVER_MAX_IOV 1024
+#endif
+
+#define NETWORK_SERVER_MAX_PACKETS (NETWORK_SERVER_MAX_IOV / 2)
+
+// Maximum number of UDP datagrams sent per sendmmsg() call.
+#define NETWORK_SERVER_MAX_DATAGRAMS 64
+
+// UDP datagram limit: 65535 - 20 IP header - 8 UDP header.
+#define NETWORK_SERVER_MAX_DATAGRAM_SIZE 65507
+
+#define NETWORK_SERVER_UDP_SEND_BUFFER_SIZE (4 * 1024 * 1024)
+
+// Smaller batches are copied: tracking their MSG_ZEROCOPY completions
+// costs more than the copy saves.
+#define NETWORK_SERVER_ZEROCOPY_MIN_SIZE (64 * 1024)
+
+#define NETWORK_SERVER_CLIENT_BUFFER_SIZE (4 * 1024 * 1024)
+
+// Clients that do not accept any data for this long are disconnected.
+#define NETWORK_SERVER_CLIENT_STALL_TIMEOUT_MS 5000
+
+// Packets of a send call, kept until the kernel is done with their memory.
+struct network_server_packet {
+	// Header as sent, the capacity equals the number of events.
+	struct caer_event_packet_header header;
+	// Packet converted from polarity columns, if any.
+	caerEventPacketHeader converted;
+};
+
+struct network_server_send {
+	void (*containerDone)(void *containerDonePtr);
+	void *containerDonePtr;
+	// The send call itself, plus the clients with MSG_ZEROCOPY sends of it
+	// that the kernel has not completed yet.
+	size_t references;
+	size_t packetsNumber;
+	size_t packetsCapacity;
+	struct network_server_packet *packets;
+};
+
+struct network_server_zerocopy_reference {
+	// Value of the client's 'zeroCopySends' after its last send of 'send'.
+	uint32_t sendsEnd;
+	struct network_server_send *send;
+};
+
+struct network_server_client {
+	int socketDescriptor;
+	bool zeroCopy;
+	// MSG_ZEROCOPY send calls done and completed by the kernel.
+	uint32_t zeroCopySends;
+	uint32_t zeroCopyCompleted;
+	// Sends whose memory the kernel may still use, oldest first.
+	struct network_server_zerocopy_reference *zeroCopyReferences;
+	size_t zeroCopyReferencesNumber;
+	size_t zeroCopyReferencesCapacity;
+	// Data the socket did not accept yet, sent before anything new.
+	uint8_t *pending;
+	size_t pendingStart;
+	size_t pendingLength;
+	size_t pendingCapacity;
+	// Set while the socket accepts no data at all.
+	bool stalled;
+	int64_t stallStart;
+};
+
+// Network header, packet header (only if the datagram starts a packet), events.
+struct network_server_datagram {
+	struct aedat3_network_header header;
+	struct iovec iov[3];
+	int iovNumber;
+	size_t length;
+};
+
+struct caer_network_server {
+	bool isTCP;
+	// TCP: listening socket. UDP: socket connected to the remote address.
+	int socketDescriptor;
+	uint16_t port;
+	int16_t sourceID;
+	// TCP clients.
+	bool zeroCopy;
+	size_t clientBufferSize;
+	size_t clientsMax;
+	size_t clientsNumber;
+	struct network_server_client *clients;
+	// UDP datagrams not yet sent, pointing into the current batch.
+	size_t datagramPayloadSize;
+	int64_t sequenceNumber;
+	size_t datagramsNumber;
+	struct network_server_datagram datagrams[NETWORK_SERVER_MAX_DATAGRAMS];
+	// Set when sending UDP datagrams fails.
+	bool failed;
+	struct caer_network_server_statistics statistics;
+	// Current send call, and a finished one kept for reuse.
+	struct network_server_send *send;
+	struct network_server_send *sendSpare;
+	bool sendZeroCopy;
+	// Current batch.
+	int iovNumber;
+	struct iovec iov[NETWORK_SERVER_MAX_IOV];
+	// Copy of 'iov' per client, as partial sends modify it.
+	struct iovec iovClient[NETWORK_SERVER_MAX_IOV];
+	size_t packetsNumber;
+	uint64_t batchEvents;
+	size_t batchBytes;
+};
+
+static struct aedat3_network_header networkHeaderMake(int64_t sequenceNumber, int8_t formatNumber, int16_t sourceID) {
+	struct aedat3_network_header networkHeader;
+
+	networkHeader.magicNumber    = I64T(htole64(U64T(AEDAT3_NETWORK_MAGIC_NUMBER)));
+	networkHeader.sequenceNumber = I64T(htole64(U64T(sequenceNumber)));
+	networkHeader.versionNumber  = AEDAT3_NETWORK_VERSION;
+	networkHeader.formatNumber   = formatNumber;
+	networkHeader.sourceID       = I16T(htole16(U16T(sourceID)));
+
+	return (networkHeader);
+}
+
+static int64_t monotonicMilliseconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((I64T(now.tv_sec) * 1000) + (now.tv_nsec / 1000000));
+}
+
+// Send I/O vectors until all are sent or the socket is full, handling partial
+// sends. Advances 'iov' and 'iovNumber' past the sent data.
+static bool sendVectors(
+	int socketDescriptor, struct iovec **iov, int *iovNumber, int flags, uint32_t *sendCalls, size_t *bytesSent) {
+	while (*iovNumber > 0) {
+		struct msghdr message;
+		memset(&message, 0, sizeof(message));
+
+		message.msg_iov    = *iov;
+		message.msg_iovlen = (size_t) *iovNumber;
+
+		ssize_t result = sendmsg(socketDescriptor, &message, flags);
+		if (result < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			// Socket full, or no memory left to track MSG_ZEROCOPY completions.
+			if (errnoWouldBlock() || (errno == ENOBUFS)) {
+				return (true);
+			}
+
+			return (false);
+		}
+
+		(*sendCalls)++;
+		*bytesSent += (size_t) result;
+
+		size_t sent = (size_t) result;
+
+		// Skip fully sent vectors, then adjust the partially sent one.
+		while ((*iovNumber > 0) && (sent >= (*iov)->iov_len)) {
+			sent -= (*iov)->iov_len;
+			(*iov)++;
+			(*iovNumber)--;
+		}
+
+		if (*iovNumber > 0) {
+			(*iov)->iov_base = (uint8_t *) (*iov)->iov_base + sent;
+			(*iov)->iov_len -= sent;
+		}
+	}
+
+	return (true);
+}
+
+// Drop one reference to a send call. On the last one, its packets are not
+// used anymore: free the converted ones and notify the caller.
+static void sendRelease(caerNetworkServer server, struct network_server_send *send) {
+	send->references--;
+
+	if (send->references > 0) {
+		return;
+	}
+
+	for (size_t i = 0; i < send->packetsNumber; i++) {
+		if (send->packets[i].converted != NULL) {
+			caerEventPacketFree(send->packets[i].converted);
+		}
+	}
+
+	send->packetsNumber = 0;
+
+	if (send->containerDone != NULL) {
+		(*send->containerDone)(send->containerDonePtr);
+	}
+
+	// Keep one around, so send calls usually need no allocation.
+	if (server->sendSpare == NULL) {
+		server->sendSpare = send;
+	}
+	else {
+		free(send->packets);
+		free(send);
+	}
+}
+
+// Prepare storage for the packets of a send call.
+static bool sendBegin(caerNetworkServer server, caerEventPacketContainerConst container,
+	void (*containerDone)(void *containerDonePtr), void *containerDonePtr) {
+	struct network_server_send *send = server->sendSpare;
+	server->sendSpare                = NULL;
+
+	if (send == NULL) {
+		send = calloc(1, sizeof(struct network_server_send));
+		if (send == NULL) {
+			caerLog(CAER_LOG_CRITICAL, NETWORK_SERVER_NAME, "Failed to allocate memory for send.");
+			return (false);
+		}
+	}
+
+	size_t packetsNumber = (size_t) caerEventPacketContainerGetEventPacketsNumber(container);
+
+	if (packetsNumber > send->packetsCapacity) {
+		void *biggerPackets = realloc(send->packets, packetsNumber * sizeof(struct network_server_packet));
+		if (biggerPackets == NULL) {
+			server->sendSpare = send;
+
+			caerLog(CAER_LOG_CRITICAL, NETWORK_SERVER_NAME, "Failed to allocate memory for send.");
+			return (false);
+		}
+
+		send->packets         = biggerPackets;
+		send->packetsCapacity = packetsNumber;
+	}
+
+	send->containerDone    = containerDone;
+	send->containerDonePtr = containerDonePtr;
+	send->references       = 1;
+	send->packetsNumber    = 0;
+
+	server->send = send;
+
+	return (true);
+}
+
+// With MSG_ZEROCOPY, the kernel keeps using the sent memory after sendmsg()
+// returns, until it reports completion on the socket's error queue. Collect
+// the completions available now, without waiting, and release the sends
+// that are done.
+static bool clientZeroCopyReap(caerNetworkServer server, struct network_server_client *client) {
+#if defined(NETWORK_SERVER_HAVE_ZEROCOPY)
+	while (client->zeroCopyCompleted != client->zeroCopySends) {
+		char control[128];
+		struct msghdr message;
+		memset(&message, 0, sizeof(message));
+
+		message.msg_control    = control;
+		message.msg_controllen = sizeof(control);
+
+		if (recvmsg(client->socketDescriptor, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			if (errnoWouldBlock()) {
+				break;
+			}
+
+			return (false);
+		}
+
+		for (struct cmsghdr *controlMessage = CMSG_FIRSTHDR(&message); controlMessage != NULL;
+			 controlMessage                 = CMSG_NXTHDR(&message, controlMessage)) {
+			if (((controlMessage->cmsg_level == IPPROTO_IP) && (controlMessage->cmsg_type == IP_RECVERR))
+				|| ((controlMessage->cmsg_level == IPPROTO_IPV6) && (controlMessage->cmsg_type == IPV6_RECVERR))) {
+				struct sock_extended_err extendedError;
+				memcpy(&extendedError, CMSG_DATA(controlMessage), sizeof(extendedError));
+
+				if ((extendedError.ee_errno == 0) && (extendedError.ee_origin == SO_EE_ORIGIN_ZEROCOPY)) {
+					// TCP completes sends in order, as ranges [ee_info, ee_data] of send calls.
+					client->zeroCopyCompleted = extendedError.ee_data + 1;
+				}
+			}
+		}
+	}
+
+	size_t released = 0;
+
+	while ((released < client->zeroCopyReferencesNumber)
+		   && (I32T(client->zeroCopyCompleted - client->zeroCopyReferences[released].sendsEnd) >= 0)) {
+		sendRelease(server, client->zeroCopyReferences[released].send);
+		released++;
+	}
+
+	if (released > 0) {
+		client->zeroCopyReferencesNumber -= released;
+		memmove(client->zeroCopyReferences, client->zeroCopyReferences + released,
+			client->zeroCopyReferencesNumber * sizeof(struct network_server_zerocopy_reference));
+	}
+#else
+	(void) (server); // UNUSED.
+	(void) (client); // UNUSED.
+#endif
+
+	return (true);
+}
+
+// Make space to reference one more send, before sending with MSG_ZEROCOPY.
+static bool clientZeroCopyReserve(struct network_server_client *client) {
+	if (client->zeroCopyReferencesNumber < client->zeroCopyReferencesCapacity) {
+		return (true);
+	}
+
+	size_t newCapacity = (client->zeroCopyReferencesCapacity == 0) ? (8) : (client->zeroCopyReferencesCapacity * 2);
+
+	void *biggerReferences
+		= realloc(client->zeroCopyReferences, newCapacity * sizeof(struct network_server_zerocopy_reference));
+	if (biggerReferences == NULL) {
+		return (false);
+	}
+
+	client->zeroCopyReferences         = biggerReferences;
+	client->zeroCopyReferencesCapacity = newCapacity;
+
+	return (true);
+}
+
+// The current send's memory is in use until all MSG_ZEROCOPY sends done
+// so far on this client complete. Space must have been reserved.
+static void clientZeroCopyReference(caerNetworkServer server, struct network_server_client *client) {
+	size_t last = client->zeroCopyReferencesNumber;
+
+	if ((last > 0) && (client->zeroCopyReferences[last - 1].send == server->send)) {
+		client->zeroCopyReferences[last - 1].sendsEnd = client->zeroCopySends;
+		return;
+	}
+
+	client->zeroCopyReferences[last].sendsEnd = client->zeroCopySends;
+	client->zeroCopyReferences[last].send     = server->send;
+	client->zeroCopyReferencesNumber++;
+
+	server->send->references++;
+}
+
+// Copy data to the end of the client's pending buffer.
+static bool clientPendingAppend(
+	caerNetworkServer server, struct network_server_client *client, const struct iovec *iov, int iovNumber) {
+	size_t length = 0;
+
+	for (int i = 0; i < iovNumber; i++) {
+		length += iov[i].iov_len;
+	}
+
+	// Move the data still pending to the front, to reuse the space.
+	if (client->pendingStart > 0) {
+		memmove(client->pending, client->pending + client->pendingStart, client->pendingLength);
+		client->pendingStart = 0;
+	}
+
+	size_t needed = client->pendingLength + length;
+
+	if (needed > client->pendingCapacity) {
+		size_t newCapacity = (client->pendingCapacity == 0) ? (needed) : (client->pendingCapacity * 2);
+
+		if (newCapacity > server->clientBufferSize) {
+			newCapacity = server->clientBufferSize;
+		}
+
+		if (newCapacity < needed) {
+			newCapacity = needed;
+		}
+
+		void *biggerPending = realloc(client->pending, newCapacity);
+		if (biggerPending == NULL) {
+			return (false);
+		}
+
+		client->pending         = biggerPending;
+		client->pendingCapacity = newCapacity;
+	}
+
+	for (int i = 0; i < iovNumber; i++) {
+		memcpy(client->pending + client->pendingLength, iov[i].iov_base, iov[i].iov_len);
+		client->pendingLength += iov[i].iov_len;
+	}
+
+	return (true);
+}
+
+// Send as much of the client's pending data as its socket accepts.
+static bool clientPendingSend(caerNetworkServer server, struct network_server_client *client) {
+	bool progress = false;
+
+	while (client->pendingLength > 0) {
+		ssize_t result = send(
+			client->socketDescriptor, client->pending + client->pendingStart, client->pendingLength, MSG_NOSIGNAL);
+		if (result < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			if (errnoWouldBlock() || (errno == ENOBUFS)) {
+				break;
+			}
+
+			return (false);
+		}
+
+		server->statistics.bytesSent += (uint64_t) result;
+		server->statistics.messagesSent++;
+
+		client->pendingStart += (size_t) result;
+		client->pendingLength -= (size_t) result;
+		progress = true;
+	}
+
+	if (client->pendingLength == 0) {
+		client->pendingStart = 0;
+	}
+
+	// A client whose socket accepts nothing for too long is gone or stuck.
+	if (progress || (client->pendingLength == 0)) {
+		client->stalled = false;
+	}
+	else if (!client->stalled) {
+		client->stalled    = true;
+		client->stallStart = monotonicMilliseconds();
+	}
+	else if ((monotonicMilliseconds() - client->stallStart) >= NETWORK_SERVER_CLIENT_STALL_TIMEOUT_MS) {
+		errno = ETIMEDOUT;
+		return (false);
+	}
+
+	return (true);
+}
+
+// Send the current batch to a client. Returns false if the client failed.
+static bool clientSendBatch(caerNetworkServer server, struct network_server_client *client, bool *accepted) {
+	// Buffered data goes out first, to keep the stream in order.
+	if (!clientPendingSend(server, client)) {
+		return (false);
+	}
+
+	memcpy(server->iovClient, server->iov, (size_t) server->iovNumber * sizeof(struct iovec));
+
+	struct iovec *iov = server->iovClient;
+	int iovNumber     = server->iovNumber;
+	size_t bytesSent  = 0;
+
+	if (client->pendingLength == 0) {
+		int flags          = MSG_NOSIGNAL;
+		uint32_t sendCalls = 0;
+
+		bool zeroCopy = (server->sendZeroCopy && client->zeroCopy
+						 && (server->batchBytes >= NETWORK_SERVER_ZEROCOPY_MIN_SIZE) && clientZeroCopyReserve(client));
+
+#if defined(NETWORK_SERVER_HAVE_ZEROCOPY)
+		if (zeroCopy) {
+			flags |= MSG_ZEROCOPY;
+		}
+#endif
+
+		bool success = sendVectors(client->socketDescriptor, &iov, &iovNumber, flags, &sendCalls, &bytesSent);
+
+		server->statistics.bytesSent += bytesSent;
+		server->statistics.messagesSent += sendCalls;
+
+		// Also on failure, the kernel may still be using the data.
+		if (zeroCopy && (sendCalls > 0)) {
+			client->zeroCopySends += sendCalls;
+			clientZeroCopyReference(server, client);
+		}
+
+		if (!success) {
+			return (false);
+		}
+	}
+
+	if (iovNumber > 0) {
+		if (bytesSent == 0) {
+			// Nothing sent: buffer the whole batch, or drop it if the client
+			// is too far behind. Dropping whole packets keeps the stream valid.
+			if (((client->pendingLength + server->batchBytes) > server->clientBufferSize)
+				|| (!clientPendingAppend(server, client, iov, iovNumber))) {
+				server->statistics.packetsDropped += server->packetsNumber;
+				return (true);
+			}
+		}
+		else if (!clientPendingAppend(server, client, iov, iovNumber)) {
+			// The rest of a partially sent packet cannot be dropped.
+			errno = ENOMEM;
+			return (false);
+		}
+	}
+
+	*accepted = true;
+
+	return (true);
+}
+
+static void clientRemove(caerNetworkServer server, size_t index) {
+	struct network_server_client *client = &server->clients[index];
+
+	close(client->socketDescriptor);
+
+	// Outstanding MSG_ZEROCOPY sends only concern this closed connection now,
+	// so their memory can be released right away.
+	for (size_t i = 0; i < client->zeroCopyReferencesNumber; i++) {
+		sendRelease(server, client->zeroCopyReferences[i].send);
+	}
+
+	free(client->zeroCopyReferences);
+	free(client->pending);
+
+	server->clients[index] = server->clients[server->clientsNumber - 1];
+	server->clientsNumber--;
+}
+
+// On close, let clients receive their pending data and the kernel complete
+// the MSG_ZEROCOPY sends, waiting as long as the clients make progress.
+static void clientsFinish(caerNetworkServer server) {
+	for (size_t i = server->clientsNumber; i > 0; i--) {
+		struct network_server_client *client = &server->clients[i - 1];
+
+		bool success = clientPendingSend(server, client) && clientZeroCopyReap(server, client);
+
+		while (success && ((client->pendingLength > 0) || (client->zeroCopyReferencesNumber > 0))) {
+			// Completions are signaled as errors, which poll() always reports.
+			struct pollfd pollDescriptor = {.fd = client->socketDescriptor,
+				.events                         = (client->pendingLength > 0) ? (POLLOUT) : (0),
+				.revents                        = 0};
+
+			if (poll(&pollDescriptor, 1, NETWORK_SERVER_CLIENT_STALL_TIMEOUT_MS) == 0) {
+				break;
+			}
+
+			success = clientPendingSend(server, client) && clientZeroCopyReap(server, client);
+		}
+
+		clientRemove(server, i - 1);
+	}
+}
+
+static void clientsAccept(caerNetworkServer server) {
+	while (true) {
+		int clientSocket = accept(server->socketDescriptor, NULL, NULL);
+		if (clientSocket < 0) {
+			if ((errno == EINTR) || (errno == ECONNABORTED)) {
+				continue;
+			}
+
+			if (!errnoWouldBlock()) {
+				caerLog(CAER_LOG_ERROR, NETWORK_SERVER_NAME, "Failed to accept new client. Error: %d.", errno);
+			}
+
+			return;
+		}
+
+		if (server->clientsNumber == server->clientsMax) {
+			caerLog(CAER_LOG_INFO, NETWORK_SERVER_NAME, "Maximum number of clients reached, refusing new client.");
+			close(clientSocket);
+			continue;
+		}
+
+		// Not all systems pass on the listening socket's O_NONBLOCK. Sends
+		// never wait for clients, data they cannot take yet is buffered.
+		int flags = fcntl(clientSocket, F_GETFL, 0);
+		if ((flags < 0) || (fcntl(clientSocket, F_SETFL, flags | O_NONBLOCK) != 0)) {
+			close(clientSocket);
+			continue;
+		}
+
+#if defined(SO_NOSIGPIPE)
+		int noSigPipe = 1;
+		setsockopt(clientSocket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+		struct network_server_client client;
+		memset(&client, 0, sizeof(client));
+
+		client.socketDescriptor = clientSocket;
+
+#if defined(NETWORK_SERVER_HAVE_ZEROCOPY)
+		if (server->zeroCopy) {
+			int zeroCopy    = 1;
+			client.zeroCopy = (setsockopt(clientSocket, SOL_SOCKET, SO_ZEROCOPY, &zeroCopy, sizeof(zeroCopy)) == 0);
+		}
+#endif
+
+		// Each client gets the network header once, at the start of the stream.
+		struct aedat3_network_header networkHeader = networkHeaderMake(0, 0, server->sourceID);
+		struct iovec headerVector = {.iov_base = &networkHeader, .iov_len = AEDAT3_NETWORK_HEADER_LENGTH};
+
+		if ((!clientPendingAppend(server, &client, &headerVector, 1)) || (!clientPendingSend(server, &client))) {
+			free(client.pending);
+			close(clientSocket);
+			continue;
+		}
+
+		server->clients[server->clientsNumber++] = client;
+
+		caerLog(CAER_LOG_DEBUG, NETWORK_SERVER_NAME, "New client connected, %zu clients.", server->clientsNumber);
+	}
+}
+
+static bool datagramsFlush(caerNetworkServer server) {
+	size_t sent = 0;
+
+#if defined(__linux__)
+	struct mmsghdr messages[NETWORK_SERVER_MAX_DATAGRAMS];
+	memset(messages, 0, server->datagramsNumber * sizeof(struct mmsghdr));
+
+	for (size_t i = 0; i < server->datagramsNumber; i++) {
+		messages[i].msg_hdr.msg_iov    = server->datagrams[i].iov;
+		messages[i].msg_hdr.msg_iovlen = (size_t) server->datagrams[i].iovNumber;
+	}
+#endif
+
+	while (sent < server->datagramsNumber) {
+#if defined(__linux__)
+		int result = sendmmsg(
+			server->socketDescriptor, messages + sent, (unsigned int) (server->datagramsNumber - sent), MSG_NOSIGNAL);
+#else
+		struct msghdr message;
+		memset(&message, 0, sizeof(message));
+
+		message.msg_iov    = server->datagrams[sent].iov;
+		message.msg_iovlen = server->datagrams[sent].iovNumber;
+
+		int result = (sendmsg(server->socketDescriptor, &message, MSG_NOSIGNAL) < 0) ? (-1) : (1);
+#endif
+		if (result < 0) {
+			// Nobody listening on the remote side is reported as ECONNREFUSED
+			// on the next send, that is not an error for us: retry.
+			if ((errno == EINTR) || (errno == ECONNREFUSED)) {
+				continue;
+			}
+
+			caerLog(CAER_LOG_ERROR, NETWORK_SERVER_NAME, "Failed to send UDP datagrams. Error: %d.", errno);
+			server->datagramsNumber = 0;
+			return (false);
+		}
+
+		for (size_t i = sent; i < (sent + (size_t) result); i++) {
+			server->statistics.bytesSent += server->datagrams[i].length;
+		}
+
+		server->statistics.messagesSent += (uint64_t) result;
+		sent += (size_t) result;
+	}
+
+	server->datagramsNumber = 0;
+
+	return (true);
+}
+
+static void datagramsAddPacket(caerNetworkServer server, struct caer_event_packet_header *header, const uint8_t *events,
+	size_t eventsSize) {
+	size_t packetSize = CAER_EVENT_PACKET_HEADER_SIZE + eventsSize;
+
+	for (size_t offset = 0; offset < packetSize; offset += server->datagramPayloadSize) {
+		if (server->datagramsNumber == NETWORK_SERVER_MAX_DATAGRAMS) {
+			if (!datagramsFlush(server)) {
+				server->failed = true;
+			}
+		}
+
+		struct network_server_datagram *datagram = &server->datagrams[server->datagramsNumber++];
+
+		size_t chunkSize = packetSize - offset;
+		if (chunkSize > server->datagramPayloadSize) {
+			chunkSize = server->datagramPayloadSize;
+		}
+
+		datagram->header = networkHeaderMake(server->sequenceNumber++,
+			(offset == 0) ? (0) : (AEDAT3_NETWORK_FORMAT_UDP_CONTINUATION), server->sourceID);
+		datagram->length = AEDAT3_NETWORK_HEADER_LENGTH + chunkSize;
+
+		datagram->iov[0].iov_base = &datagram->header;
+		datagram->iov[0].iov_len  = AEDAT3_NETWORK_HEADER_LENGTH;
+
+		// sendmsg() never modifies the data, iovec just has no const variant.
+		if (offset == 0) {
+			datagram->iov[1].iov_base = header;
+			datagram->iov[1].iov_len  = CAER_EVENT_PACKET_HEADER_SIZE;
+			datagram->iov[2].iov_base = (void *) (uintptr_t) events;
+			datagram->iov[2].iov_len  = chunkSize - CAER_EVENT_PACKET_HEADER_SIZE;
+			datagram->iovNumber       = 3;
+		}
+		else {
+			datagram->iov[1].iov_base = (void *) (uintptr_t) (events + (offset - CAER_EVENT_PACKET_HEADER_SIZE));
+			datagram->iov[1].iov_len  = chunkSize;
+			datagram->iovNumber       = 2;
+		}
+	}
+}
+
+static void batchFlush(caerNetworkServer server) {
+	if (server->packetsNumber > 0) {
+		bool sent = false;
+
+		if (server->isTCP) {
+			// Send to all clients in turn, dropping any that fail.
+			for (size_t i = server->clientsNumber; i > 0; i--) {
+				if (!clientSendBatch(server, &server->clients[i - 1], &sent)) {
+					caerLog(CAER_LOG_DEBUG, NETWORK_SERVER_NAME, "Client disconnected. Error: %d.", errno);
+					clientRemove(server, i - 1);
+				}
+			}
+		}
+		else {
+			if (datagramsFlush(server)) {
+				sent = !server->failed;
+			}
+			else {
+				server->failed = true;
+			}
+		}
+
+		if (sent) {
+			server->statistics.packetsSent += server->packetsNumber;
+			server->statistics.eventsSent += server->batchEvents;
+		}
+	}
+
+	server->iovNumber     = 0;
+	server->packetsNumber = 0;
+	server->batchEvents   = 0;
+	server->batchBytes    = 0;
+}
+
+static void batchAddContainer(caerNetworkServer server, caerEventPacketContainerConst container) {
+	for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(container); i++) {
+		caerEventPacketHeaderConst packet = caerEventPacketContainerGetEventPacketConst(container, i);
+		if ((packet == NULL) || (caerEventPacketHeaderGetEventNumber(packet) <= 0)) {
+			continue;
+		}
+
+		if (server->packetsNumber == NETWORK_SERVER_MAX_PACKETS) {
+			batchFlush(server);
+		}
+
+		struct network_server_packet *sendPacket = &server->send->packets[server->send->packetsNumber];
+		sendPacket->converted                    = NULL;
+
+		if (caerEventPacketHeaderGetEventType(packet) == POLARITY_COLUMNS_EVENT) {
+			caerEventPacketHeader polarity = (caerEventPacketHeader) caerPolarityEventPacketFromPolarityColumns(
+				(caerPolarityColumnsEventPacketConst) packet);
+			if (polarity == NULL) {
+				caerLog(CAER_LOG_ERROR, NETWORK_SERVER_NAME, "Failed to convert polarity columns event packet.");
+				continue;
+			}
+
+			sendPacket->converted = polarity;
+			packet                = polarity;
+		}
+
+		server->send->packetsNumber++;
+
+		int32_t eventNumber = caerEventPacketHeaderGetEventNumber(packet);
+
+		struct caer_event_packet_header *header = &sendPacket->header;
+
+		memcpy(header, packet, CAER_EVENT_PACKET_HEADER_SIZE);
+		caerEventPacketHeaderSetEventCapacity(header, eventNumber);
+
+		const uint8_t *events = (const uint8_t *) packet + CAER_EVENT_PACKET_HEADER_SIZE;
+		size_t eventsSize     = (size_t) caerEventPacketGetDataSizeEvents(packet);
+
+		if (server->isTCP) {
+			server->iov[server->iovNumber].iov_base = header;
+			server->iov[server->iovNumber].iov_len  = CAER_EVENT_PACKET_HEADER_SIZE;
+			server->iovNumber++;
+
+			// sendmsg() never modifies the data, iovec just has no const variant.
+			server->iov[server->iovNumber].iov_base = (void *) (uintptr_t) events;
+			server->iov[server->iovNumber].iov_len  = eventsSize;
+			server->iovNumber++;
+		}
+		else {
+			datagramsAddPacket(server, header, events, eventsSize);
+		}
+
+		server->packetsNumber++;
+		server->batchEvents += (uint64_t) eventNumber;
+		server->batchBytes += CAER_EVENT_PACKET_HEADER_SIZE + eventsSize;
+	}
+}
+
+caerNetworkServer caerNetworkServerOpenTCP(const char *localAddress, uint16_t localPort, int16_t sourceID,
+	size_t maxClients, size_t clientBufferSize, bool zeroCopy) {
+	if (maxClients == 0) {
+		return (NULL);
+	}
+
+	caerNetworkServer server = calloc(1, sizeof(struct caer_network_server));
+	if (server == NULL) {
+		caerLog(CAER_LOG_CRITICAL, NETWORK_SERVER_NAME, "Failed to allocate memory for network server.");
+		return (NULL);
+	}
+
+	server->clients = calloc(maxClients, sizeof(struct network_server_client));
+	if (server->clients == NULL) {
+		caerLog(CAER_LOG_CRITICAL, NETWORK_SERVER_NAME, "Failed to allocate memory for network server clients.");
+		free(server);
+		return (NULL);
+	}
+
+	server->isTCP            = true;
+	server->sourceID         = sourceID;
+	server->clientsMax       = maxClients;
+	server->clientBufferSize = (clientBufferSize == 0) ? (NETWORK_SERVER_CLIENT_BUFFER_SIZE) : (clientBufferSize);
+#if defined(NETWORK_SERVER_HAVE_ZEROCOPY)
+	server->zeroCopy = zeroCopy;
+#else
+	(void) (zeroCopy); // UNUSED.
+#endif
+
+	server->socketDescriptor = networkSocketOpen(localAddress, localPort, SOCK_STREAM, true, NETWORK_SERVER_NAME);
+	if (server->socketDescriptor < 0) {
+		free(server->clients);
+		free(server);
+		return (NULL);
+	}
+
+	// Clients are accepted without blocking, during sends.
+	if ((listen(server->socketDescriptor, 16) != 0)
+		|| (fcntl(server->socketDescriptor, F_SETFL, fcntl(server->socketDescriptor, F_GETFL, 0) | O_NONBLOCK) != 0)) {
+		caerLog(CAER_LOG_ERROR, NETWORK_SERVER_NAME, "Failed to listen on TCP socket. Error: %d.", errno);
+		close(server->socketDescriptor);
+		free(server->clients);
+		free(server);
+		return (NULL);
+	}
+
+	// Get the real port, in case any free port was requested.
+	server->port = networkSocketGetLocalPort(server->socketDescriptor);
+
+	return (server);
+}
+
+caerNetworkServer caerNetworkServerOpenUDP(
+	const char *remoteAddress, uint16_t remotePort, int16_t sourceID, size_t maxDatagramSize) {
+	if (maxDatagramSize == 0) {
+		maxDatagramSize = AEDAT3_MAX_UDP_SIZE + AEDAT3_NETWORK_HEADER_LENGTH;
+	}
+
+	// Must at least fit the network and packet headers, and some events.
+	if ((remoteAddress == NULL) || (remotePort == 0)
+		|| (maxDatagramSize <= (AEDAT3_NETWORK_HEADER_LENGTH + CAER_EVENT_PACKET_HEADER_SIZE))
+		|| (maxDatagramSize > NETWORK_SERVER_MAX_DATAGRAM_SIZE)) {
+		return (NULL);
+	}
+
+	caerNetworkServer server = calloc(1, sizeof(struct caer_network_server));
+	if (server == NULL) {
+		caerLog(CAER_LOG_CRITICAL, NETWORK_SERVER_NAME, "Failed to allocate memory for network server.");
+		return (NULL);
+	}
+
+	server->isTCP               = false;
+	server->port                = remotePort;
+	server->sourceID            = sourceID;
+	server->datagramPayloadSize = maxDatagramSize - AEDAT3_NETWORK_HEADER_LENGTH;
+
+	server->socketDescriptor = networkSocketOpen(remoteAddress, remotePort, SOCK_DGRAM, false, NETWORK_SERVER_NAME);
+	if (server->socketDescriptor < 0) {
+		free(server);
+		return (NULL);
+	}
+
+	// Allow sending to broadcast addresses, and queue up more datagrams.
+	int broadcast      = 1;
+	int sendBufferSize = NETWORK_SERVER_UDP_SEND_BUFFER_SIZE;
+	setsockopt(server->socketDescriptor, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast));
+	setsockopt(server->socketDescriptor, SOL_SOCKET, SO_SNDBUF, &sendBufferSize, sizeof(sendBufferSize));
+
+	return (server);
+}
+
+void caerNetworkServerClose(caerNetworkServer server) {
+	if (server == NULL) {
+		return;
+	}
+
+	clientsFinish(server);
+
+	close(server->socketDescriptor);
+
+	if (server->sendSpare != NULL) {
+		free(server->sendSpare->packets);
+		free(server->sendSpare);
+	}
+
+	free(server->clients);
+	free(server);
+}
+
+uint16_t caerNetworkServerGetPort(caerNetworkServer server) {
+	return (server->port);
+}
+
+size_t caerNetworkServerGetClientsNumber(caerNetworkServer server) {
+	return (server->clientsNumber);
+}
+
+static bool networkServerSend(caerNetworkServer server, caerEventPacketContainerConst container, bool zeroCopy,
+	void (*containerDone)(void *containerDonePtr), void *containerDonePtr) {
+	if (server->isTCP) {
+		clientsAccept(server);
+
+		// Release earlier sends the kernel is done with.
+		for (size_t i = server->clientsNumber; i > 0; i--) {
+			if (!clientZeroCopyReap(server, &server->clients[i - 1])) {
+				caerLog(CAER_LOG_DEBUG, NETWORK_SERVER_NAME, "Client disconnected. Error: %d.", errno);
+				clientRemove(server, i - 1);
+			}
+		}
+
+		if (server->clientsNumber == 0) {
+			if (containerDone != NULL) {
+				(*containerDone)(containerDonePtr);
+			}
+
+			return (true);
+		}
+	}
+
+	if (!sendBegin(server, container, containerDone, containerDonePtr)) {
+		return (false);
+	}
+
+	server->sendZeroCopy = zeroCopy;
+	server->failed       = false;
+
+	batchAddContainer(server, container);
+	batchFlush(server);
+
+	bool success = !server->failed;
+
+	// On failure the caller keeps the container, and UDP never sends zero-copy.
+	if (!success) {
+		server->send->containerDone = NULL;
+	}
+
+	sendRelease(server, server->send);
+	server->send = NULL;
+
+	return (success);
+}
+
+bool caerNetworkServerSend(caerNetworkServer server, caerEventPacketContainerConst container) {
+	if ((server == NULL) || (container == NULL)) {
+		return (false);
+	}
+
+	// The packets are only valid during this call, so they cannot be sent zero-copy.
+	return (networkServerSend(server, container, false, NULL, NULL));
+}
+
+bool caerNetworkServerSendNotify(caerNetworkServer server, caerEventPacketContainerConst container,
+	void (*containerDone)(void *containerDonePtr), void *containerDonePtr) {
+	if ((server == NULL) || (container == NULL)) {
+		return (false);
+	}
+
+	return (networkServerSend(server, container, true, containerDone, containerDonePtr));
+}
+
+struct caer_network_server_statistics caerNetworkServerStatisticsGet(caerNetworkServer server) {
+	struct caer_network_server_statistics statistics = {0, 0, 0, 0, 0};
+
+	if (server == NULL) {
+		return (statistics);
+	}
+
+	return (server->statistics);
+}
@@ -0,0 +1,131 @@
+#ifndef LIBCAER_SRC_NETWORK_UTILS_H_
+#define LIBCAER_SRC_NETWORK_UTILS_H_
+
+#include "libcaer/libcaer.h"
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if !defined(MSG_NOSIGNAL)
+// Use SO_NOSIGPIPE on the socket instead (macOS).
+#	define MSG_NOSIGNAL 0
+#endif
+
+// EAGAIN and EWOULDBLOCK are the same on most, but not all, systems.
+static inline bool errnoWouldBlock(void) {
+#if defined(EWOULDBLOCK) && (EWOULDBLOCK != EAGAIN)
+	return ((errno == EAGAIN) || (errno == EWOULDBLOCK));
+#else
+	return (errno == EAGAIN);
+#endif
+}
+
+/**
+ * Resolve the address and create a socket of the given type, then either
+ * bind it to the address (local side) or connect it to the address
+ * (remote side). The first working address is used.
+ *
+ * @param address IP address or host name. Can be NULL when binding,
+ *                to use all local addresses.
+ * @param port port number. Can be zero when binding, to use any free port.
+ * @param socketType SOCK_STREAM or SOCK_DGRAM.
+ * @param bindLocal true to bind, false to connect.
+ * @param subSystem name to use for log messages.
+ *
+ * @return the socket, -1 on error.
+ */
+static inline int networkSocketOpen(
+	const char *address, uint16_t port, int socketType, bool bindLocal, const char *subSystem) {
+	char portString[8];
+	snprintf(portString, sizeof(portString), "%" PRIu16, port);
+
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+
+	hints.ai_family   = AF_UNSPEC;
+	hints.ai_socktype = socketType;
+	hints.ai_flags    = (bindLocal) ? (AI_PASSIVE) : (0);
+
+	struct addrinfo *addresses = NULL;
+
+	int result = getaddrinfo(address, portString, &hints, &addresses);
+	if (result != 0) {
+		caerLog(CAER_LOG_ERROR, subSystem, "Failed to resolve address '%s'. Error: %s.",
+			(address == NULL) ? ("any") : (address), gai_strerror(result));
+		return (-1);
+	}
+
+	int socketDescriptor = -1;
+
+	for (struct addrinfo *addr = addresses; addr != NULL; addr = addr->ai_next) {
+		socketDescriptor = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+		if (socketDescriptor < 0) {
+			continue;
+		}
+
+#if defined(SO_NOSIGPIPE)
+		int noSigPipe = 1;
+		setsockopt(socketDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+		if (bindLocal) {
+			int reuseAddress = 1;
+			setsockopt(socketDescriptor, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+
+			if (bind(socketDescriptor, addr->ai_addr, addr->ai_addrlen) == 0) {
+				break;
+			}
+		}
+		else {
+			if (connect(socketDescriptor, addr->ai_addr, addr->ai_addrlen) == 0) {
+				break;
+			}
+		}
+
+		close(socketDescriptor);
+		socketDescriptor = -1;
+	}
+
+	freeaddrinfo(addresses);
+
+	if (socketDescriptor < 0) {
+		caerLog(CAER_LOG_ERROR, subSystem, "Failed to %s %s socket to '%s', port %" PRIu16 ". Error: %d.",
+			(bindLocal) ? ("bind") : ("connect"), (socketType == SOCK_STREAM) ? ("TCP") : ("UDP"),
+			(address == NULL) ? ("any") : (address), port, errno);
+	}
+
+	return (socketDescriptor);
+}
+
+/**
+ * Get the local port a socket is bound to, such as when binding
+ * to port zero (any free port).
+ *
+ * @param socketDescriptor a bound socket.
+ *
+ * @return the port number, zero on error.
+ */
+static inline uint16_t networkSocketGetLocalPort(int socketDescriptor) {
+	struct sockaddr_storage boundAddress;
+	socklen_t boundAddressLength = sizeof(boundAddress);
+
+	if (getsockname(socketDescriptor, (struct sockaddr *) &boundAddress, &boundAddressLength) != 0) {
+		return (0);
+	}
+
+	if (boundAddress.ss_family == AF_INET) {
+		return (ntohs(((struct sockaddr_in *) &boundAddress)->sin_port));
+	}
+
+	if (boundAddress.ss_family == AF_INET6) {
+		return (ntohs(((struct sockaddr_in6 *) &boundAddress)->sin6_port));
+	}
+
+	return (0);
+}
+
+#endif /* LIBCAER_SRC_NETWORK_UTILS_H_ */
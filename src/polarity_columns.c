@@ -0,0 +1,259 @@
+#include "libcaer/events/polarityColumns.h"
+
+// SSE2 is part of the x86-64 baseline and NEON of AArch64, so no runtime
+// dispatch is needed; everything else uses the scalar loops only.
+// Both vector paths rely on the event data being in host byte order.
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#	if defined(__SSE2__)
+#		include <emmintrin.h>
+#		define POLARITY_COLUMNS_SSE2 1
+#	elif defined(__ARM_NEON)
+#		include <arm_neon.h>
+#		define POLARITY_COLUMNS_NEON 1
+#	endif
+#endif
+
+// Events are converted in blocks of this many, when all of them are valid.
+#define POLARITY_COLUMNS_BLOCK 8
+
+#if defined(POLARITY_COLUMNS_SSE2)
+// Split eight polarity events into the four columns. Addresses are at
+// most 15 bit, so the signed saturating packs never saturate.
+static inline void splitBlock(const struct caer_polarity_event *events, int32_t *timestamps, uint16_t *xAddr,
+	uint16_t *yAddr, uint8_t *polarities) {
+	const __m128i addrMask = _mm_set1_epi32(POLARITY_X_ADDR_MASK);
+	const __m128i polMask  = _mm_set1_epi32(POLARITY_MASK);
+
+	const __m128i in0 = _mm_loadu_si128((const __m128i *) &events[0]);
+	const __m128i in1 = _mm_loadu_si128((const __m128i *) &events[2]);
+	const __m128i in2 = _mm_loadu_si128((const __m128i *) &events[4]);
+	const __m128i in3 = _mm_loadu_si128((const __m128i *) &events[6]);
+
+	// Even 32 bit words are the data, odd ones the timestamps.
+	const __m128i data0 = _mm_castps_si128(
+		_mm_shuffle_ps(_mm_castsi128_ps(in0), _mm_castsi128_ps(in1), _MM_SHUFFLE(2, 0, 2, 0)));
+	const __m128i data1 = _mm_castps_si128(
+		_mm_shuffle_ps(_mm_castsi128_ps(in2), _mm_castsi128_ps(in3), _MM_SHUFFLE(2, 0, 2, 0)));
+	const __m128i ts0 = _mm_castps_si128(
+		_mm_shuffle_ps(_mm_castsi128_ps(in0), _mm_castsi128_ps(in1), _MM_SHUFFLE(3, 1, 3, 1)));
+	const __m128i ts1 = _mm_castps_si128(
+		_mm_shuffle_ps(_mm_castsi128_ps(in2), _mm_castsi128_ps(in3), _MM_SHUFFLE(3, 1, 3, 1)));
+
+	_mm_storeu_si128((__m128i *) &timestamps[0], ts0);
+	_mm_storeu_si128((__m128i *) &timestamps[4], ts1);
+
+	const __m128i x = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(data0, POLARITY_X_ADDR_SHIFT), addrMask),
+		_mm_and_si128(_mm_srli_epi32(data1, POLARITY_X_ADDR_SHIFT), addrMask));
+	const __m128i y = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(data0, POLARITY_Y_ADDR_SHIFT), addrMask),
+		_mm_and_si128(_mm_srli_epi32(data1, POLARITY_Y_ADDR_SHIFT), addrMask));
+	const __m128i p = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(data0, POLARITY_SHIFT), polMask),
+		_mm_and_si128(_mm_srli_epi32(data1, POLARITY_SHIFT), polMask));
+
+	_mm_storeu_si128((__m128i *) xAddr, x);
+	_mm_storeu_si128((__m128i *) yAddr, y);
+	_mm_storel_epi64((__m128i *) polarities, _mm_packus_epi16(p, p));
+}
+
+// Merge eight events from the four columns into polarity events, all valid.
+static inline void mergeBlock(const int32_t *timestamps, const uint16_t *xAddr, const uint16_t *yAddr,
+	const uint8_t *polarities, struct caer_polarity_event *events) {
+	const __m128i zero  = _mm_setzero_si128();
+	const __m128i valid = _mm_set1_epi32(1 << VALID_MARK_SHIFT);
+
+	const __m128i x = _mm_loadu_si128((const __m128i *) xAddr);
+	const __m128i y = _mm_loadu_si128((const __m128i *) yAddr);
+	const __m128i p = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) polarities), zero);
+
+	const __m128i data0 = _mm_or_si128(
+		_mm_or_si128(_mm_slli_epi32(_mm_unpacklo_epi16(x, zero), POLARITY_X_ADDR_SHIFT),
+			_mm_slli_epi32(_mm_unpacklo_epi16(y, zero), POLARITY_Y_ADDR_SHIFT)),
+		_mm_or_si128(_mm_slli_epi32(_mm_unpacklo_epi16(p, zero), POLARITY_SHIFT), valid));
+	const __m128i data1 = _mm_or_si128(
+		_mm_or_si128(_mm_slli_epi32(_mm_unpackhi_epi16(x, zero), POLARITY_X_ADDR_SHIFT),
+			_mm_slli_epi32(_mm_unpackhi_epi16(y, zero), POLARITY_Y_ADDR_SHIFT)),
+		_mm_or_si128(_mm_slli_epi32(_mm_unpackhi_epi16(p, zero), POLARITY_SHIFT), valid));
+
+	const __m128i ts0 = _mm_loadu_si128((const __m128i *) &timestamps[0]);
+	const __m128i ts1 = _mm_loadu_si128((const __m128i *) &timestamps[4]);
+
+	_mm_storeu_si128((__m128i *) &events[0], _mm_unpacklo_epi32(data0, ts0));
+	_mm_storeu_si128((__m128i *) &events[2], _mm_unpackhi_epi32(data0, ts0));
+	_mm_storeu_si128((__m128i *) &events[4], _mm_unpacklo_epi32(data1, ts1));
+	_mm_storeu_si128((__m128i *) &events[6], _mm_unpackhi_epi32(data1, ts1));
+}
+#elif defined(POLARITY_COLUMNS_NEON)
+static inline void splitBlock(const struct caer_polarity_event *events, int32_t *timestamps, uint16_t *xAddr,
+	uint16_t *yAddr, uint8_t *polarities) {
+	const uint32x4_t addrMask = vdupq_n_u32(POLARITY_X_ADDR_MASK);
+	const uint32x4_t polMask  = vdupq_n_u32(POLARITY_MASK);
+
+	// De-interleave: val[0] is the data, val[1] the timestamps.
+	const uint32x4x2_t in0 = vld2q_u32((const uint32_t *) &events[0]);
+	const uint32x4x2_t in1 = vld2q_u32((const uint32_t *) &events[4]);
+
+	vst1q_u32((uint32_t *) &timestamps[0], in0.val[1]);
+	vst1q_u32((uint32_t *) &timestamps[4], in1.val[1]);
+
+	const uint16x8_t x
+		= vcombine_u16(vmovn_u32(vandq_u32(vshrq_n_u32(in0.val[0], POLARITY_X_ADDR_SHIFT), addrMask)),
+			vmovn_u32(vandq_u32(vshrq_n_u32(in1.val[0], POLARITY_X_ADDR_SHIFT), addrMask)));
+	const uint16x8_t y
+		= vcombine_u16(vmovn_u32(vandq_u32(vshrq_n_u32(in0.val[0], POLARITY_Y_ADDR_SHIFT), addrMask)),
+			vmovn_u32(vandq_u32(vshrq_n_u32(in1.val[0], POLARITY_Y_ADDR_SHIFT), addrMask)));
+	const uint16x8_t p = vcombine_u16(vmovn_u32(vandq_u32(vshrq_n_u32(in0.val[0], POLARITY_SHIFT), polMask)),
+		vmovn_u32(vandq_u32(vshrq_n_u32(in1.val[0], POLARITY_SHIFT), polMask)));
+
+	vst1q_u16(xAddr, x);
+	vst1q_u16(yAddr, y);
+	vst1_u8(polarities, vmovn_u16(p));
+}
+
+static inline void mergeBlock(const int32_t *timestamps, const uint16_t *xAddr, const uint16_t *yAddr,
+	const uint8_t *polarities, struct caer_polarity_event *events) {
+	const uint32x4_t valid = vdupq_n_u32(1 << VALID_MARK_SHIFT);
+
+	const uint16x8_t x = vld1q_u16(xAddr);
+	const uint16x8_t y = vld1q_u16(yAddr);
+	const uint16x8_t p = vmovl_u8(vld1_u8(polarities));
+
+	uint32x4x2_t out0;
+	uint32x4x2_t out1;
+
+	out0.val[0] = vorrq_u32(vorrq_u32(vshlq_n_u32(vmovl_u16(vget_low_u16(x)), POLARITY_X_ADDR_SHIFT),
+								vshlq_n_u32(vmovl_u16(vget_low_u16(y)), POLARITY_Y_ADDR_SHIFT)),
+		vorrq_u32(vshlq_n_u32(vmovl_u16(vget_low_u16(p)), POLARITY_SHIFT), valid));
+	out1.val[0] = vorrq_u32(vorrq_u32(vshlq_n_u32(vmovl_u16(vget_high_u16(x)), POLARITY_X_ADDR_SHIFT),
+								vshlq_n_u32(vmovl_u16(vget_high_u16(y)), POLARITY_Y_ADDR_SHIFT)),
+		vorrq_u32(vshlq_n_u32(vmovl_u16(vget_high_u16(p)), POLARITY_SHIFT), valid));
+
+	out0.val[1] = vld1q_u32((const uint32_t *) &timestamps[0]);
+	out1.val[1] = vld1q_u32((const uint32_t *) &timestamps[4]);
+
+	// Interleave data and timestamps again.
+	vst2q_u32((uint32_t *) &events[0], out0);
+	vst2q_u32((uint32_t *) &events[4], out1);
+}
+#endif
+
+// Split one polarity event into the four columns, if valid.
+static inline int32_t splitEvent(
+	caerPolarityEventConst event, int32_t *timestamp, uint16_t *xAddr, uint16_t *yAddr, uint8_t *polarity) {
+	if (!caerPolarityEventIsValid(event)) {
+		return (0);
+	}
+
+	*timestamp = event->timestamp;
+	*xAddr     = htole16(caerPolarityEventGetX(event));
+	*yAddr     = htole16(caerPolarityEventGetY(event));
+	*polarity  = caerPolarityEventGetPolarity(event);
+
+	return (1);
+}
+
+caerPolarityColumnsEventPacket caerPolarityColumnsEventPacketFromPolarity(caerPolarityEventPacketConst packet) {
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(&packet->packetHeader);
+	int32_t eventValid  = caerEventPacketHeaderGetEventValid(&packet->packetHeader);
+
+	if (eventValid == 0) {
+		return (NULL);
+	}
+
+	caerPolarityColumnsEventPacket columns = caerPolarityColumnsEventPacketAllocate(eventValid,
+		caerEventPacketHeaderGetEventSource(&packet->packetHeader),
+		caerEventPacketHeaderGetEventTSOverflow(&packet->packetHeader));
+	if (columns == NULL) {
+		return (NULL);
+	}
+
+	int32_t *timestamps = caerPolarityColumnsEventPacketGetTimestamps(columns);
+	uint16_t *xAddr     = caerPolarityColumnsEventPacketGetX(columns);
+	uint16_t *yAddr     = caerPolarityColumnsEventPacketGetY(columns);
+	uint8_t *polarities = caerPolarityColumnsEventPacketGetPolarities(columns);
+
+	int32_t in  = 0;
+	int32_t out = 0;
+
+#if defined(POLARITY_COLUMNS_SSE2) || defined(POLARITY_COLUMNS_NEON)
+	// Blocks of only valid events go through the vector path. Invalid events
+	// are rare (filters), so blocks containing any are done one by one.
+	const int32_t blocksEnd = eventNumber - (eventNumber % POLARITY_COLUMNS_BLOCK);
+
+	for (; in < blocksEnd; in += POLARITY_COLUMNS_BLOCK) {
+		bool allValid = true;
+
+		for (int32_t i = 0; i < POLARITY_COLUMNS_BLOCK; i++) {
+			allValid = allValid && caerPolarityEventIsValid(&packet->events[in + i]);
+		}
+
+		if (allValid) {
+			splitBlock(&packet->events[in], &timestamps[out], &xAddr[out], &yAddr[out], &polarities[out]);
+			out += POLARITY_COLUMNS_BLOCK;
+		}
+		else {
+			for (int32_t i = 0; i < POLARITY_COLUMNS_BLOCK; i++) {
+				out += splitEvent(
+					&packet->events[in + i], &timestamps[out], &xAddr[out], &yAddr[out], &polarities[out]);
+			}
+		}
+	}
+#endif
+
+	for (; in < eventNumber; in++) {
+		out += splitEvent(&packet->events[in], &timestamps[out], &xAddr[out], &yAddr[out], &polarities[out]);
+	}
+
+	return (columns);
+}
+
+caerPolarityEventPacket caerPolarityEventPacketFromPolarityColumns(caerPolarityColumnsEventPacketConst packet) {
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(&packet->packetHeader);
+
+	if (eventNumber == 0) {
+		return (NULL);
+	}
+
+	caerPolarityEventPacket events = caerPolarityEventPacketAllocate(eventNumber,
+		caerEventPacketHeaderGetEventSource(&packet->packetHeader),
+		caerEventPacketHeaderGetEventTSOverflow(&packet->packetHeader));
+	if (events == NULL) {
+		return (NULL);
+	}
+
+	const int32_t *timestamps = caerPolarityColumnsEventPacketGetTimestampsConst(packet);
+	const uint16_t *xAddr     = caerPolarityColumnsEventPacketGetXConst(packet);
+	const uint16_t *yAddr     = caerPolarityColumnsEventPacketGetYConst(packet);
+	const uint8_t *polarities = caerPolarityColumnsEventPacketGetPolaritiesConst(packet);
+
+	int32_t i = 0;
+
+#if defined(POLARITY_COLUMNS_SSE2) || defined(POLARITY_COLUMNS_NEON)
+	const int32_t blocksEnd = eventNumber - (eventNumber % POLARITY_COLUMNS_BLOCK);
+
+	for (; i < blocksEnd; i += POLARITY_COLUMNS_BLOCK) {
+		mergeBlock(&timestamps[i], &xAddr[i], &yAddr[i], &polarities[i], &events->events[i]);
+	}
+#endif
+
+	for (; i < eventNumber; i++) {
+		caerPolarityEvent event = &events->events[i];
+
+		event->data = htole32((U32T(le16toh(xAddr[i]) & POLARITY_X_ADDR_MASK) << POLARITY_X_ADDR_SHIFT)
+							  | (U32T(le16toh(yAddr[i]) & POLARITY_Y_ADDR_MASK) << POLARITY_Y_ADDR_SHIFT)
+							  | (U32T(polarities[i] & POLARITY_MASK) << POLARITY_SHIFT) | (U32T(1) << VALID_MARK_SHIFT));
+		event->timestamp = timestamps[i];
+	}
+
+	// All events are valid.
+	caerEventPacketHeaderSetEventNumber(&events->packetHeader, eventNumber);
+	caerEventPacketHeaderSetEventValid(&events->packetHeader, eventNumber);
+
+	return (events);
+}
@@ -0,0 +1,666 @@
+#include "libcaer/events/polarityCompressed.h"
+
+// SSE2 is part of the x86-64 baseline and NEON of AArch64, so no runtime
+// dispatch is needed; everything else uses the scalar loops only.
+// Both vector paths rely on the event data being in host byte order.
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#	if defined(__SSE2__)
+#		include <emmintrin.h>
+#		define POLARITY_COMPRESSED_SSE2 1
+#	elif defined(__ARM_NEON)
+#		include <arm_neon.h>
+#		define POLARITY_COMPRESSED_NEON 1
+#	endif
+#endif
+
+// Events are converted in blocks of this many, when all of them are valid.
+#define POLARITY_COMPRESSED_BLOCK 4
+
+// Size of the compressed packet's own header, after the common one.
+#define POLARITY_COMPRESSED_HEADER_SIZE \
+	(sizeof(struct caer_polarity_compressed_event_packet) - CAER_EVENT_PACKET_HEADER_SIZE)
+
+// Differences of 32 bit timestamps need 33 bits when zig-zag encoded, plus
+// one for the run flag, so at most 5 bytes as LEB128 variable-length integer.
+#define VARINT_MAX_SIZE 5
+
+struct compress_state {
+	uint8_t *addrPosition;
+	uint64_t addrBuffer;
+	uint32_t addrBufferBits;
+	uint32_t addrBits;
+	uint8_t *tsPosition;
+	bool runLength;
+	int32_t tsPrevious;
+	int32_t tsRun;
+	int32_t tsRunCount;
+};
+
+static inline uint8_t bitsNeeded(uint32_t value) {
+	uint8_t bits = 0;
+
+	while (value != 0) {
+		bits++;
+		value >>= 1;
+	}
+
+	return (bits);
+}
+
+static inline uint64_t zigZagEncode(int64_t value) {
+	return ((value < 0) ? ((U64T(-value) << 1) - 1) : (U64T(value) << 1));
+}
+
+static inline int64_t zigZagDecode(uint64_t value) {
+	return (((value & 0x01) != 0) ? (-I64T(value >> 1) - 1) : (I64T(value >> 1)));
+}
+
+static inline void varintPut(struct compress_state *state, uint64_t value) {
+	while (value >= 0x80) {
+		*state->tsPosition++ = (uint8_t) (value | 0x80);
+		value >>= 7;
+	}
+
+	*state->tsPosition++ = (uint8_t) value;
+}
+
+// Returns the position after the value, or NULL if it is incomplete or too long.
+static inline const uint8_t *varintGet(const uint8_t *position, const uint8_t *end, uint64_t *value) {
+	// Small values, like most timestamp differences, take a single byte.
+	if ((position != end) && (*position < 0x80)) {
+		*value = *position;
+		return (position + 1);
+	}
+
+	uint64_t result = 0;
+
+	for (uint32_t shift = 0; shift < (7 * VARINT_MAX_SIZE); shift += 7) {
+		if (position == end) {
+			return (NULL);
+		}
+
+		uint8_t byte = *position++;
+		result |= U64T(byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0) {
+			*value = result;
+			return (position);
+		}
+	}
+
+	return (NULL);
+}
+
+// Append one packed address to the bit stream, written out 32 bits at a time.
+static inline void addressPut(struct compress_state *state, uint32_t address) {
+	state->addrBuffer |= U64T(address) << state->addrBufferBits;
+	state->addrBufferBits += state->addrBits;
+
+	if (state->addrBufferBits >= 32) {
+		uint32_t word = htole32((uint32_t) state->addrBuffer);
+		memcpy(state->addrPosition, &word, sizeof(word));
+
+		state->addrPosition += sizeof(word);
+		state->addrBuffer >>= 32;
+		state->addrBufferBits -= 32;
+	}
+}
+
+static inline void addressFlush(struct compress_state *state) {
+	while (state->addrBufferBits > 0) {
+		*state->addrPosition++ = (uint8_t) state->addrBuffer;
+		state->addrBuffer >>= 8;
+		state->addrBufferBits = (state->addrBufferBits > 8) ? (state->addrBufferBits - 8) : (0);
+	}
+}
+
+static inline void timestampRunFlush(struct compress_state *state) {
+	uint64_t delta = zigZagEncode(I64T(state->tsRun) - I64T(state->tsPrevious));
+
+	if (state->tsRunCount > 1) {
+		varintPut(state, (delta << 1) | 0x01);
+		varintPut(state, U64T(state->tsRunCount - 2));
+	}
+	else {
+		varintPut(state, delta << 1);
+	}
+
+	state->tsPrevious = state->tsRun;
+}
+
+static inline void timestampPut(struct compress_state *state, int32_t timestamp) {
+	if (!state->runLength) {
+		varintPut(state, zigZagEncode(I64T(timestamp) - I64T(state->tsPrevious)));
+		state->tsPrevious = timestamp;
+		return;
+	}
+
+	if ((state->tsRunCount > 0) && (timestamp == state->tsRun)) {
+		state->tsRunCount++;
+		return;
+	}
+
+	if (state->tsRunCount > 0) {
+		timestampRunFlush(state);
+	}
+
+	state->tsRun      = timestamp;
+	state->tsRunCount = 1;
+}
+
+static inline void timestampFlush(struct compress_state *state) {
+	if (state->runLength && (state->tsRunCount > 0)) {
+		timestampRunFlush(state);
+		state->tsRunCount = 0;
+	}
+}
+
+static inline uint32_t addressPack(caerPolarityEventConst event, uint8_t xAddrBits, uint8_t yAddrBits) {
+	uint32_t polarity = (caerPolarityEventGetPolarity(event)) ? (1) : (0);
+
+	return (U32T(caerPolarityEventGetX(event)) | (U32T(caerPolarityEventGetY(event)) << xAddrBits)
+			| (polarity << (xAddrBits + yAddrBits)));
+}
+
+static inline uint32_t addressUnpack(uint32_t address, uint8_t xAddrBits, uint8_t yAddrBits) {
+	uint32_t xAddr    = address & ((U32T(1) << xAddrBits) - 1);
+	uint32_t yAddr    = (address >> xAddrBits) & ((U32T(1) << yAddrBits) - 1);
+	uint32_t polarity = (address >> (xAddrBits + yAddrBits)) & POLARITY_MASK;
+
+	return (htole32((xAddr << POLARITY_X_ADDR_SHIFT) | (yAddr << POLARITY_Y_ADDR_SHIFT) | (polarity << POLARITY_SHIFT)
+					| (U32T(1) << VALID_MARK_SHIFT)));
+}
+
+#if defined(POLARITY_COMPRESSED_SSE2)
+// Track the largest valid X and Y addresses of four events. Addresses are
+// at most 15 bit, so the 16 bit maximum works on the 32 bit lanes too.
+static inline void scanBlock(const struct caer_polarity_event *events, __m128i *maxX, __m128i *maxY) {
+	const __m128i addrMask = _mm_set1_epi32(POLARITY_X_ADDR_MASK);
+	const __m128i one      = _mm_set1_epi32(1);
+
+	const __m128i in0 = _mm_loadu_si128((const __m128i *) &events[0]);
+	const __m128i in1 = _mm_loadu_si128((const __m128i *) &events[2]);
+
+	const __m128i data = _mm_castps_si128(
+		_mm_shuffle_ps(_mm_castsi128_ps(in0), _mm_castsi128_ps(in1), _MM_SHUFFLE(2, 0, 2, 0)));
+	const __m128i valid = _mm_cmpeq_epi32(_mm_and_si128(data, one), one);
+
+	*maxX = _mm_max_epi16(
+		*maxX, _mm_and_si128(_mm_and_si128(_mm_srli_epi32(data, POLARITY_X_ADDR_SHIFT), addrMask), valid));
+	*maxY = _mm_max_epi16(
+		*maxY, _mm_and_si128(_mm_and_si128(_mm_srli_epi32(data, POLARITY_Y_ADDR_SHIFT), addrMask), valid));
+}
+
+static inline uint32_t scanReduce(__m128i max) {
+	uint32_t lanes[4];
+	_mm_storeu_si128((__m128i *) lanes, max);
+
+	uint32_t result = lanes[0];
+
+	for (size_t i = 1; i < 4; i++) {
+		if (lanes[i] > result) {
+			result = lanes[i];
+		}
+	}
+
+	return (result);
+}
+
+// Pack the addresses of four valid events.
+static inline void packBlock(
+	const struct caer_polarity_event *events, uint8_t xAddrBits, uint8_t yAddrBits, uint32_t *addresses) {
+	const __m128i addrMask = _mm_set1_epi32(POLARITY_X_ADDR_MASK);
+	const __m128i polMask  = _mm_set1_epi32(POLARITY_MASK);
+
+	const __m128i in0 = _mm_loadu_si128((const __m128i *) &events[0]);
+	const __m128i in1 = _mm_loadu_si128((const __m128i *) &events[2]);
+
+	const __m128i data = _mm_castps_si128(
+		_mm_shuffle_ps(_mm_castsi128_ps(in0), _mm_castsi128_ps(in1), _MM_SHUFFLE(2, 0, 2, 0)));
+
+	const __m128i x = _mm_and_si128(_mm_srli_epi32(data, POLARITY_X_ADDR_SHIFT), addrMask);
+	const __m128i y = _mm_and_si128(_mm_srli_epi32(data, POLARITY_Y_ADDR_SHIFT), addrMask);
+	const __m128i p = _mm_and_si128(_mm_srli_epi32(data, POLARITY_SHIFT), polMask);
+
+	const __m128i packed = _mm_or_si128(_mm_or_si128(x, _mm_sll_epi32(y, _mm_cvtsi32_si128(xAddrBits))),
+		_mm_sll_epi32(p, _mm_cvtsi32_si128(xAddrBits + yAddrBits)));
+
+	_mm_storeu_si128((__m128i *) addresses, packed);
+}
+
+// Unpack four addresses into the events, whose timestamps are already set.
+static inline void unpackBlock(
+	const uint32_t *addresses, uint8_t xAddrBits, uint8_t yAddrBits, struct caer_polarity_event *events) {
+	const __m128i valid = _mm_set1_epi32(1 << VALID_MARK_SHIFT);
+	const __m128i xMask = _mm_set1_epi32((1 << xAddrBits) - 1);
+	const __m128i yMask = _mm_set1_epi32((1 << yAddrBits) - 1);
+	const __m128i pMask = _mm_set1_epi32(POLARITY_MASK);
+
+	// Insert the lanes one by one: a vector load right after the scalar stores
+	// that filled the array would stall on store forwarding.
+	const __m128i packed
+		= _mm_set_epi32(I32T(addresses[3]), I32T(addresses[2]), I32T(addresses[1]), I32T(addresses[0]));
+
+	const __m128i x = _mm_and_si128(packed, xMask);
+	const __m128i y = _mm_and_si128(_mm_srl_epi32(packed, _mm_cvtsi32_si128(xAddrBits)), yMask);
+	const __m128i p = _mm_and_si128(_mm_srl_epi32(packed, _mm_cvtsi32_si128(xAddrBits + yAddrBits)), pMask);
+
+	const __m128i data = _mm_or_si128(
+		_mm_or_si128(_mm_slli_epi32(x, POLARITY_X_ADDR_SHIFT), _mm_slli_epi32(y, POLARITY_Y_ADDR_SHIFT)),
+		_mm_or_si128(_mm_slli_epi32(p, POLARITY_SHIFT), valid));
+
+	const __m128i in0 = _mm_loadu_si128((const __m128i *) &events[0]);
+	const __m128i in1 = _mm_loadu_si128((const __m128i *) &events[2]);
+
+	const __m128i ts = _mm_castps_si128(
+		_mm_shuffle_ps(_mm_castsi128_ps(in0), _mm_castsi128_ps(in1), _MM_SHUFFLE(3, 1, 3, 1)));
+
+	_mm_storeu_si128((__m128i *) &events[0], _mm_unpacklo_epi32(data, ts));
+	_mm_storeu_si128((__m128i *) &events[2], _mm_unpackhi_epi32(data, ts));
+}
+#elif defined(POLARITY_COMPRESSED_NEON)
+static inline void scanBlock(const struct caer_polarity_event *events, uint32x4_t *maxX, uint32x4_t *maxY) {
+	const uint32x4_t addrMask = vdupq_n_u32(POLARITY_X_ADDR_MASK);
+	const uint32x4_t one      = vdupq_n_u32(1);
+
+	// De-interleave: val[0] is the data, val[1] the timestamps.
+	const uint32x4x2_t in = vld2q_u32((const uint32_t *) events);
+
+	const uint32x4_t valid = vceqq_u32(vandq_u32(in.val[0], one), one);
+
+	*maxX = vmaxq_u32(*maxX, vandq_u32(vandq_u32(vshrq_n_u32(in.val[0], POLARITY_X_ADDR_SHIFT), addrMask), valid));
+	*maxY = vmaxq_u32(*maxY, vandq_u32(vandq_u32(vshrq_n_u32(in.val[0], POLARITY_Y_ADDR_SHIFT), addrMask), valid));
+}
+
+static inline uint32_t scanReduce(uint32x4_t max) {
+	uint32_t lanes[4];
+	vst1q_u32(lanes, max);
+
+	uint32_t result = lanes[0];
+
+	for (size_t i = 1; i < 4; i++) {
+		if (lanes[i] > result) {
+			result = lanes[i];
+		}
+	}
+
+	return (result);
+}
+
+static inline void packBlock(
+	const struct caer_polarity_event *events, uint8_t xAddrBits, uint8_t yAddrBits, uint32_t *addresses) {
+	const uint32x4_t addrMask = vdupq_n_u32(POLARITY_X_ADDR_MASK);
+	const uint32x4_t polMask  = vdupq_n_u32(POLARITY_MASK);
+
+	const uint32x4x2_t in = vld2q_u32((const uint32_t *) events);
+
+	const uint32x4_t x = vandq_u32(vshrq_n_u32(in.val[0], POLARITY_X_ADDR_SHIFT), addrMask);
+	const uint32x4_t y = vandq_u32(vshrq_n_u32(in.val[0], POLARITY_Y_ADDR_SHIFT), addrMask);
+	const uint32x4_t p = vandq_u32(vshrq_n_u32(in.val[0], POLARITY_SHIFT), polMask);
+
+	// Positive counts shift left.
+	const uint32x4_t packed = vorrq_u32(vorrq_u32(x, vshlq_u32(y, vdupq_n_s32(xAddrBits))),
+		vshlq_u32(p, vdupq_n_s32(xAddrBits + yAddrBits)));
+
+	vst1q_u32(addresses, packed);
+}
+
+static inline void unpackBlock(
+	const uint32_t *addresses, uint8_t xAddrBits, uint8_t yAddrBits, struct caer_polarity_event *events) {
+	const uint32x4_t valid = vdupq_n_u32(1 << VALID_MARK_SHIFT);
+	const uint32x4_t xMask = vdupq_n_u32((U32T(1) << xAddrBits) - 1);
+	const uint32x4_t yMask = vdupq_n_u32((U32T(1) << yAddrBits) - 1);
+	const uint32x4_t pMask = vdupq_n_u32(POLARITY_MASK);
+
+	// Insert the lanes one by one, see the SSE2 version.
+	uint32x4_t packed = vdupq_n_u32(addresses[0]);
+	packed            = vsetq_lane_u32(addresses[1], packed, 1);
+	packed            = vsetq_lane_u32(addresses[2], packed, 2);
+	packed            = vsetq_lane_u32(addresses[3], packed, 3);
+
+	// Negative counts shift right.
+	const uint32x4_t x = vandq_u32(packed, xMask);
+	const uint32x4_t y = vandq_u32(vshlq_u32(packed, vdupq_n_s32(-xAddrBits)), yMask);
+	const uint32x4_t p = vandq_u32(vshlq_u32(packed, vdupq_n_s32(-(xAddrBits + yAddrBits))), pMask);
+
+	uint32x4x2_t out = vld2q_u32((const uint32_t *) events);
+
+	out.val[0] = vorrq_u32(vorrq_u32(vshlq_n_u32(x, POLARITY_X_ADDR_SHIFT), vshlq_n_u32(y, POLARITY_Y_ADDR_SHIFT)),
+		vorrq_u32(vshlq_n_u32(p, POLARITY_SHIFT), valid));
+
+	// Interleave data and timestamps again.
+	vst2q_u32((uint32_t *) events, out);
+}
+#endif
+
+caerPolarityCompressedEventPacket caerPolarityCompressedEventPacketFromPolarity(
+	caerPolarityEventPacketConst packet, bool runLength) {
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(&packet->packetHeader);
+	int32_t eventValid  = caerEventPacketHeaderGetEventValid(&packet->packetHeader);
+
+	if (eventValid == 0) {
+		return (NULL);
+	}
+
+	// First pass: find the address ranges, to know how many bits they need.
+	uint32_t maxX = 0;
+	uint32_t maxY = 0;
+	int32_t in    = 0;
+
+#if defined(POLARITY_COMPRESSED_SSE2) || defined(POLARITY_COMPRESSED_NEON)
+	const int32_t blocksEnd = eventNumber - (eventNumber % POLARITY_COMPRESSED_BLOCK);
+
+#	if defined(POLARITY_COMPRESSED_SSE2)
+	__m128i maxXVector = _mm_setzero_si128();
+	__m128i maxYVector = _mm_setzero_si128();
+#	else
+	uint32x4_t maxXVector = vdupq_n_u32(0);
+	uint32x4_t maxYVector = vdupq_n_u32(0);
+#	endif
+
+	for (; in < blocksEnd; in += POLARITY_COMPRESSED_BLOCK) {
+		scanBlock(&packet->events[in], &maxXVector, &maxYVector);
+	}
+
+	maxX = scanReduce(maxXVector);
+	maxY = scanReduce(maxYVector);
+#endif
+
+	for (; in < eventNumber; in++) {
+		caerPolarityEventConst event = &packet->events[in];
+
+		if (caerPolarityEventIsValid(event)) {
+			if (caerPolarityEventGetX(event) > maxX) {
+				maxX = caerPolarityEventGetX(event);
+			}
+
+			if (caerPolarityEventGetY(event) > maxY) {
+				maxY = caerPolarityEventGetY(event);
+			}
+		}
+	}
+
+	int32_t firstValid = 0;
+	while (!caerPolarityEventIsValid(&packet->events[firstValid])) {
+		firstValid++;
+	}
+
+	int32_t lastValid = eventNumber - 1;
+	while (!caerPolarityEventIsValid(&packet->events[lastValid])) {
+		lastValid--;
+	}
+
+	uint8_t xAddrBits = bitsNeeded(maxX);
+	uint8_t yAddrBits = bitsNeeded(maxY);
+
+	struct compress_state state;
+	memset(&state, 0, sizeof(state));
+
+	state.addrBits  = U32T(xAddrBits + yAddrBits + 1);
+	state.runLength = runLength;
+
+	size_t addrBytes = (((size_t) eventValid * state.addrBits) + 7) / 8;
+
+	// Allocate for the worst case, and shrink afterwards.
+	size_t maxBytes = POLARITY_COMPRESSED_HEADER_SIZE + addrBytes + ((size_t) eventValid * VARINT_MAX_SIZE);
+	size_t maxWords = (maxBytes + POLARITY_COMPRESSED_EVENT_SIZE - 1) / POLARITY_COMPRESSED_EVENT_SIZE;
+
+	if (maxWords > INT32_MAX) {
+		return (NULL);
+	}
+
+	caerPolarityCompressedEventPacket compressed = (caerPolarityCompressedEventPacket) caerEventPacketAllocate(
+		I32T(maxWords), caerEventPacketHeaderGetEventSource(&packet->packetHeader),
+		caerEventPacketHeaderGetEventTSOverflow(&packet->packetHeader), POLARITY_COMPRESSED_EVENT,
+		POLARITY_COMPRESSED_EVENT_SIZE, 0);
+	if (compressed == NULL) {
+		return (NULL);
+	}
+
+	compressed->firstTimestamp = packet->events[firstValid].timestamp;
+	compressed->lastTimestamp  = packet->events[lastValid].timestamp;
+	compressed->eventsNumber   = I32T(htole32(U32T(eventValid)));
+	compressed->xAddrBits      = xAddrBits;
+	compressed->yAddrBits      = yAddrBits;
+	compressed->flags          = (runLength) ? (POLARITY_COMPRESSED_RUN_LENGTH) : (0);
+
+	state.addrPosition = compressed->data;
+	state.tsPosition   = compressed->data + addrBytes;
+	state.tsPrevious   = caerPolarityEventGetTimestamp(&packet->events[firstValid]);
+
+	// Second pass: write addresses and timestamps.
+	in = 0;
+
+#if defined(POLARITY_COMPRESSED_SSE2) || defined(POLARITY_COMPRESSED_NEON)
+	// Blocks of only valid events go through the vector path. Invalid events
+	// are rare (filters), so blocks containing any are done one by one.
+	for (; in < blocksEnd; in += POLARITY_COMPRESSED_BLOCK) {
+		bool allValid = true;
+
+		for (int32_t i = 0; i < POLARITY_COMPRESSED_BLOCK; i++) {
+			allValid = allValid && caerPolarityEventIsValid(&packet->events[in + i]);
+		}
+
+		if (allValid) {
+			uint32_t addresses[POLARITY_COMPRESSED_BLOCK];
+			packBlock(&packet->events[in], xAddrBits, yAddrBits, addresses);
+
+			for (int32_t i = 0; i < POLARITY_COMPRESSED_BLOCK; i++) {
+				addressPut(&state, addresses[i]);
+				timestampPut(&state, caerPolarityEventGetTimestamp(&packet->events[in + i]));
+			}
+		}
+		else {
+			for (int32_t i = 0; i < POLARITY_COMPRESSED_BLOCK; i++) {
+				caerPolarityEventConst event = &packet->events[in + i];
+
+				if (caerPolarityEventIsValid(event)) {
+					addressPut(&state, addressPack(event, xAddrBits, yAddrBits));
+					timestampPut(&state, caerPolarityEventGetTimestamp(event));
+				}
+			}
+		}
+	}
+#endif
+
+	for (; in < eventNumber; in++) {
+		caerPolarityEventConst event = &packet->events[in];
+
+		if (caerPolarityEventIsValid(event)) {
+			addressPut(&state, addressPack(event, xAddrBits, yAddrBits));
+			timestampPut(&state, caerPolarityEventGetTimestamp(event));
+		}
+	}
+
+	addressFlush(&state);
+	timestampFlush(&state);
+
+	// Give back the unused memory. The padding is already zero.
+	size_t usedBytes = (size_t) (state.tsPosition - compressed->data) + POLARITY_COMPRESSED_HEADER_SIZE;
+	int32_t usedWords
+		= I32T((usedBytes + POLARITY_COMPRESSED_EVENT_SIZE - 1) / POLARITY_COMPRESSED_EVENT_SIZE);
+
+	caerPolarityCompressedEventPacket shrunk = caerRealloc(
+		compressed, CAER_EVENT_PACKET_HEADER_SIZE + ((size_t) usedWords * POLARITY_COMPRESSED_EVENT_SIZE));
+	if (shrunk == NULL) {
+		// Keep the bigger packet, the trailing zeros are ignored when decompressing.
+		usedWords = I32T(maxWords);
+	}
+	else {
+		compressed = shrunk;
+	}
+
+	// Packets are always full.
+	caerEventPacketHeaderSetEventCapacity(&compressed->packetHeader, usedWords);
+	caerEventPacketHeaderSetEventNumber(&compressed->packetHeader, usedWords);
+	caerEventPacketHeaderSetEventValid(&compressed->packetHeader, usedWords);
+
+	return (compressed);
+}
+
+static bool timestampsDecompress(caerPolarityCompressedEventPacketConst packet, const uint8_t *position,
+	const uint8_t *end, int32_t eventNumber, caerPolarityEventPacket events) {
+	int64_t tsPrevious = I32T(le32toh(U32T(packet->firstTimestamp)));
+
+	if ((packet->flags & POLARITY_COMPRESSED_RUN_LENGTH) == 0) {
+		// One difference per event.
+		for (int32_t i = 0; i < eventNumber; i++) {
+			uint64_t value;
+			position = varintGet(position, end, &value);
+			if (position == NULL) {
+				return (false);
+			}
+
+			int64_t timestamp = tsPrevious + zigZagDecode(value);
+			if ((timestamp < 0) || (timestamp > INT32_MAX)) {
+				return (false);
+			}
+
+			events->events[i].timestamp = I32T(htole32(U32T(timestamp)));
+			tsPrevious                  = timestamp;
+		}
+
+		return (true);
+	}
+
+	int32_t i = 0;
+
+	while (i < eventNumber) {
+		uint64_t value;
+		position = varintGet(position, end, &value);
+		if (position == NULL) {
+			return (false);
+		}
+
+		int32_t runCount = 1;
+
+		if ((value & 0x01) != 0) {
+			uint64_t runExtra;
+			if ((eventNumber - i) < 2) {
+				return (false);
+			}
+
+			position = varintGet(position, end, &runExtra);
+			if ((position == NULL) || (runExtra > U64T(eventNumber - i - 2))) {
+				return (false);
+			}
+
+			runCount = I32T(runExtra) + 2;
+		}
+
+		int64_t timestamp = tsPrevious + zigZagDecode(value >> 1);
+		if ((timestamp < 0) || (timestamp > INT32_MAX)) {
+			return (false);
+		}
+
+		int32_t timestampLE = I32T(htole32(U32T(timestamp)));
+
+		for (int32_t j = 0; j < runCount; j++) {
+			events->events[i + j].timestamp = timestampLE;
+		}
+
+		i += runCount;
+		tsPrevious = timestamp;
+	}
+
+	return (true);
+}
+
+// Get the packed address of event n. The stream is followed by the timestamps,
+// so reading whole 64 bit words is possible almost up to the end.
+static inline uint32_t addressGet(const uint8_t *data, size_t dataSize, uint64_t bitPosition, uint64_t mask) {
+	size_t bytePosition = (size_t) (bitPosition / 8);
+	uint64_t word       = 0;
+
+	if ((bytePosition + sizeof(word)) <= dataSize) {
+		memcpy(&word, data + bytePosition, sizeof(word));
+		word = le64toh(word);
+	}
+	else {
+		for (size_t i = 0; (bytePosition + i) < dataSize; i++) {
+			word |= U64T(data[bytePosition + i]) << (8 * i);
+		}
+	}
+
+	return ((uint32_t) ((word >> (bitPosition % 8)) & mask));
+}
+
+caerPolarityEventPacket caerPolarityEventPacketFromPolarityCompressed(caerPolarityCompressedEventPacketConst packet) {
+	if (packet == NULL) {
+		return (NULL);
+	}
+
+	int32_t packetWords = caerEventPacketHeaderGetEventNumber(&packet->packetHeader);
+
+	if ((caerEventPacketHeaderGetEventSize(&packet->packetHeader) != POLARITY_COMPRESSED_EVENT_SIZE)
+		|| (packetWords < 0)
+		|| (((size_t) packetWords * POLARITY_COMPRESSED_EVENT_SIZE) < POLARITY_COMPRESSED_HEADER_SIZE)) {
+		return (NULL);
+	}
+
+	size_t packetBytes = (size_t) packetWords * POLARITY_COMPRESSED_EVENT_SIZE;
+
+	int32_t eventNumber = caerPolarityCompressedEventPacketGetEventsNumber(packet);
+	uint8_t xAddrBits   = packet->xAddrBits;
+	uint8_t yAddrBits   = packet->yAddrBits;
+
+	if ((eventNumber <= 0) || (xAddrBits > 15) || (yAddrBits > 15)
+		|| ((packet->flags & ~POLARITY_COMPRESSED_RUN_LENGTH) != 0)) {
+		return (NULL);
+	}
+
+	uint32_t addrBits = U32T(xAddrBits + yAddrBits + 1);
+	size_t dataSize   = packetBytes - POLARITY_COMPRESSED_HEADER_SIZE;
+	size_t addrBytes  = (((size_t) eventNumber * addrBits) + 7) / 8;
+
+	if (addrBytes > dataSize) {
+		return (NULL);
+	}
+
+	caerPolarityEventPacket events = caerPolarityEventPacketAllocate(eventNumber,
+		caerEventPacketHeaderGetEventSource(&packet->packetHeader),
+		caerEventPacketHeaderGetEventTSOverflow(&packet->packetHeader));
+	if (events == NULL) {
+		return (NULL);
+	}
+
+	// Timestamps first, the vector path below fills in the rest around them.
+	if (!timestampsDecompress(packet, packet->data + addrBytes, packet->data + dataSize, eventNumber, events)) {
+		caerLog(CAER_LOG_ERROR, "Polarity Compressed", "Corrupted timestamps in compressed polarity packet.");
+		caerEventPacketFree(&events->packetHeader);
+		return (NULL);
+	}
+
+	const uint64_t addrMask = (U64T(1) << addrBits) - 1;
+
+	int32_t i = 0;
+
+#if defined(POLARITY_COMPRESSED_SSE2) || defined(POLARITY_COMPRESSED_NEON)
+	const int32_t blocksEnd = eventNumber - (eventNumber % POLARITY_COMPRESSED_BLOCK);
+
+	for (; i < blocksEnd; i += POLARITY_COMPRESSED_BLOCK) {
+		uint32_t addresses[POLARITY_COMPRESSED_BLOCK];
+
+		for (int32_t j = 0; j < POLARITY_COMPRESSED_BLOCK; j++) {
+			addresses[j] = addressGet(packet->data, dataSize, U64T(i + j) * addrBits, addrMask);
+		}
+
+		unpackBlock(addresses, xAddrBits, yAddrBits, &events->events[i]);
+	}
+#endif
+
+	for (; i < eventNumber; i++) {
+		events->events[i].data
+			= addressUnpack(addressGet(packet->data, dataSize, U64T(i) * addrBits, addrMask), xAddrBits, yAddrBits);
+	}
+
+	// All events are valid.
+	caerEventPacketHeaderSetEventNumber(&events->packetHeader, eventNumber);
+	caerEventPacketHeaderSetEventValid(&events->packetHeader, eventNumber);
+
+	return (events);
+}
@@ -0,0 +1,224 @@
+#ifndef LIBCAER_SRC_POLARITY_GROUPS_H_
+#define LIBCAER_SRC_POLARITY_GROUPS_H_
+
+#include "libcaer/events/polarity.h"
+
+// Vectorized expansion of 8-pixel event groups (one bit per pixel) into
+// polarity events, as sent by the DVXplorer MIPI CX3 and Samsung EVK.
+// SSE2 is part of the x86-64 baseline and NEON of AArch64, so no runtime
+// dispatch is needed; everything else uses the scalar fallback.
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#	if defined(__SSE2__)
+#		include <emmintrin.h>
+#		define POLARITY_GROUPS_SSE2 1
+#	elif defined(__ARM_NEON)
+#		include <arm_neon.h>
+#		define POLARITY_GROUPS_NEON 1
+#	endif
+#endif
+
+#define POLARITY_GROUP_SIZE 8
+
+// For every 8-bit group mask, the positions of the set bits in increasing
+// order, one per byte (LSB is first). Unused bytes are zero.
+static const uint64_t polarityGroupOffsets[256] = {
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000100ULL,
+	0x0000000000000002ULL, 0x0000000000000200ULL, 0x0000000000000201ULL, 0x0000000000020100ULL,
+	0x0000000000000003ULL, 0x0000000000000300ULL, 0x0000000000000301ULL, 0x0000000000030100ULL,
+	0x0000000000000302ULL, 0x0000000000030200ULL, 0x0000000000030201ULL, 0x0000000003020100ULL,
+	0x0000000000000004ULL, 0x0000000000000400ULL, 0x0000000000000401ULL, 0x0000000000040100ULL,
+	0x0000000000000402ULL, 0x0000000000040200ULL, 0x0000000000040201ULL, 0x0000000004020100ULL,
+	0x0000000000000403ULL, 0x0000000000040300ULL, 0x0000000000040301ULL, 0x0000000004030100ULL,
+	0x0000000000040302ULL, 0x0000000004030200ULL, 0x0000000004030201ULL, 0x0000000403020100ULL,
+	0x0000000000000005ULL, 0x0000000000000500ULL, 0x0000000000000501ULL, 0x0000000000050100ULL,
+	0x0000000000000502ULL, 0x0000000000050200ULL, 0x0000000000050201ULL, 0x0000000005020100ULL,
+	0x0000000000000503ULL, 0x0000000000050300ULL, 0x0000000000050301ULL, 0x0000000005030100ULL,
+	0x0000000000050302ULL, 0x0000000005030200ULL, 0x0000000005030201ULL, 0x0000000503020100ULL,
+	0x0000000000000504ULL, 0x0000000000050400ULL, 0x0000000000050401ULL, 0x0000000005040100ULL,
+	0x0000000000050402ULL, 0x0000000005040200ULL, 0x0000000005040201ULL, 0x0000000504020100ULL,
+	0x0000000000050403ULL, 0x0000000005040300ULL, 0x0000000005040301ULL, 0x0000000504030100ULL,
+	0x0000000005040302ULL, 0x0000000504030200ULL, 0x0000000504030201ULL, 0x0000050403020100ULL,
+	0x0000000000000006ULL, 0x0000000000000600ULL, 0x0000000000000601ULL, 0x0000000000060100ULL,
+	0x0000000000000602ULL, 0x0000000000060200ULL, 0x0000000000060201ULL, 0x0000000006020100ULL,
+	0x0000000000000603ULL, 0x0000000000060300ULL, 0x0000000000060301ULL, 0x0000000006030100ULL,
+	0x0000000000060302ULL, 0x0000000006030200ULL, 0x0000000006030201ULL, 0x0000000603020100ULL,
+	0x0000000000000604ULL, 0x0000000000060400ULL, 0x0000000000060401ULL, 0x0000000006040100ULL,
+	0x0000000000060402ULL, 0x0000000006040200ULL, 0x0000000006040201ULL, 0x0000000604020100ULL,
+	0x0000000000060403ULL, 0x0000000006040300ULL, 0x0000000006040301ULL, 0x0000000604030100ULL,
+	0x0000000006040302ULL, 0x0000000604030200ULL, 0x0000000604030201ULL, 0x0000060403020100ULL,
+	0x0000000000000605ULL, 0x0000000000060500ULL, 0x0000000000060501ULL, 0x0000000006050100ULL,
+	0x0000000000060502ULL, 0x0000000006050200ULL, 0x0000000006050201ULL, 0x0000000605020100ULL,
+	0x0000000000060503ULL, 0x0000000006050300ULL, 0x0000000006050301ULL, 0x0000000605030100ULL,
+	0x0000000006050302ULL, 0x0000000605030200ULL, 0x0000000605030201ULL, 0x0000060503020100ULL,
+	0x0000000000060504ULL, 0x0000000006050400ULL, 0x0000000006050401ULL, 0x0000000605040100ULL,
+	0x0000000006050402ULL, 0x0000000605040200ULL, 0x0000000605040201ULL, 0x0000060504020100ULL,
+	0x0000000006050403ULL, 0x0000000605040300ULL, 0x0000000605040301ULL, 0x0000060504030100ULL,
+	0x0000000605040302ULL, 0x0000060504030200ULL, 0x0000060504030201ULL, 0x0006050403020100ULL,
+	0x0000000000000007ULL, 0x0000000000000700ULL, 0x0000000000000701ULL, 0x0000000000070100ULL,
+	0x0000000000000702ULL, 0x0000000000070200ULL, 0x0000000000070201ULL, 0x0000000007020100ULL,
+	0x0000000000000703ULL, 0x0000000000070300ULL, 0x0000000000070301ULL, 0x0000000007030100ULL,
+	0x0000000000070302ULL, 0x0000000007030200ULL, 0x0000000007030201ULL, 0x0000000703020100ULL,
+	0x0000000000000704ULL, 0x0000000000070400ULL, 0x0000000000070401ULL, 0x0000000007040100ULL,
+	0x0000000000070402ULL, 0x0000000007040200ULL, 0x0000000007040201ULL, 0x0000000704020100ULL,
+	0x0000000000070403ULL, 0x0000000007040300ULL, 0x0000000007040301ULL, 0x0000000704030100ULL,
+	0x0000000007040302ULL, 0x0000000704030200ULL, 0x0000000704030201ULL, 0x0000070403020100ULL,
+	0x0000000000000705ULL, 0x0000000000070500ULL, 0x0000000000070501ULL, 0x0000000007050100ULL,
+	0x0000000000070502ULL, 0x0000000007050200ULL, 0x0000000007050201ULL, 0x0000000705020100ULL,
+	0x0000000000070503ULL, 0x0000000007050300ULL, 0x0000000007050301ULL, 0x0000000705030100ULL,
+	0x0000000007050302ULL, 0x0000000705030200ULL, 0x0000000705030201ULL, 0x0000070503020100ULL,
+	0x0000000000070504ULL, 0x0000000007050400ULL, 0x0000000007050401ULL, 0x0000000705040100ULL,
+	0x0000000007050402ULL, 0x0000000705040200ULL, 0x0000000705040201ULL, 0x0000070504020100ULL,
+	0x0000000007050403ULL, 0x0000000705040300ULL, 0x0000000705040301ULL, 0x0000070504030100ULL,
+	0x0000000705040302ULL, 0x0000070504030200ULL, 0x0000070504030201ULL, 0x0007050403020100ULL,
+	0x0000000000000706ULL, 0x0000000000070600ULL, 0x0000000000070601ULL, 0x0000000007060100ULL,
+	0x0000000000070602ULL, 0x0000000007060200ULL, 0x0000000007060201ULL, 0x0000000706020100ULL,
+	0x0000000000070603ULL, 0x0000000007060300ULL, 0x0000000007060301ULL, 0x0000000706030100ULL,
+	0x0000000007060302ULL, 0x0000000706030200ULL, 0x0000000706030201ULL, 0x0000070603020100ULL,
+	0x0000000000070604ULL, 0x0000000007060400ULL, 0x0000000007060401ULL, 0x0000000706040100ULL,
+	0x0000000007060402ULL, 0x0000000706040200ULL, 0x0000000706040201ULL, 0x0000070604020100ULL,
+	0x0000000007060403ULL, 0x0000000706040300ULL, 0x0000000706040301ULL, 0x0000070604030100ULL,
+	0x0000000706040302ULL, 0x0000070604030200ULL, 0x0000070604030201ULL, 0x0007060403020100ULL,
+	0x0000000000070605ULL, 0x0000000007060500ULL, 0x0000000007060501ULL, 0x0000000706050100ULL,
+	0x0000000007060502ULL, 0x0000000706050200ULL, 0x0000000706050201ULL, 0x0000070605020100ULL,
+	0x0000000007060503ULL, 0x0000000706050300ULL, 0x0000000706050301ULL, 0x0000070605030100ULL,
+	0x0000000706050302ULL, 0x0000070605030200ULL, 0x0000070605030201ULL, 0x0007060503020100ULL,
+	0x0000000007060504ULL, 0x0000000706050400ULL, 0x0000000706050401ULL, 0x0000070605040100ULL,
+	0x0000000706050402ULL, 0x0000070605040200ULL, 0x0000070605040201ULL, 0x0007060504020100ULL,
+	0x0000000706050403ULL, 0x0000070605040300ULL, 0x0000070605040301ULL, 0x0007060504030100ULL,
+	0x0000070605040302ULL, 0x0007060504030200ULL, 0x0007060504030201ULL, 0x0706050403020100ULL,
+};
+
+// For every 8-bit group mask, the number of set bits.
+static const uint8_t polarityGroupCounts[256] = {
+	0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+	1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
+	1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
+	2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+	1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
+	2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+	2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+	3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
+	1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
+	2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+	2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+	3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
+	2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
+	3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
+	3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
+	4, 5, 5, 6, 5, 6, 6, 7, 5, 6, 6, 7, 6, 7, 7, 8,
+};
+
+/**
+ * Build the data word (host-endian) of a valid polarity event.
+ */
+static inline uint32_t polarityGroupBaseData(uint16_t x, uint16_t y, bool polarity) {
+	return (U32T(U32T(x & POLARITY_X_ADDR_MASK) << POLARITY_X_ADDR_SHIFT)
+			| U32T(U32T(y & POLARITY_Y_ADDR_MASK) << POLARITY_Y_ADDR_SHIFT)
+			| U32T(U32T(polarity) << POLARITY_SHIFT) | U32T(1U << VALID_MARK_SHIFT));
+}
+
+/**
+ * Expand an 8-pixel group into polarity events. For each set bit 'i' in
+ * 'groupMask', an event with data 'baseData + (i << addrShift)' and the
+ * given timestamp is written, in increasing bit order.
+ * Always writes POLARITY_GROUP_SIZE events, the ones past the returned count
+ * are zeroed (invalid), so there must be space for POLARITY_GROUP_SIZE events
+ * at 'events'. The packet header is not touched, use polarityGroupCommit().
+ *
+ * @return number of generated events.
+ */
+static inline int32_t polarityGroupExpand(
+	caerPolarityEvent events, uint8_t groupMask, uint32_t baseData, uint32_t addrShift, int32_t timestamp) {
+	const int32_t count = polarityGroupCounts[groupMask];
+
+	if (count == 0) {
+		return (0);
+	}
+
+#if defined(POLARITY_GROUPS_SSE2)
+	const __m128i zero  = _mm_setzero_si128();
+	const __m128i shift = _mm_cvtsi32_si128((int) addrShift);
+	const __m128i base  = _mm_set1_epi32((int) baseData);
+	const __m128i ts    = _mm_set1_epi32(timestamp);
+	const __m128i cnt   = _mm_set1_epi32(count);
+
+	// Widen the 8 byte offsets to two vectors of four 32-bit lanes.
+	const __m128i offsets8  = _mm_loadl_epi64((const __m128i *) &polarityGroupOffsets[groupMask]);
+	const __m128i offsets16 = _mm_unpacklo_epi8(offsets8, zero);
+	const __m128i offsetsLo = _mm_unpacklo_epi16(offsets16, zero);
+	const __m128i offsetsHi = _mm_unpackhi_epi16(offsets16, zero);
+
+	// Lanes at or past 'count' are not events: zero them.
+	const __m128i validLo = _mm_cmplt_epi32(_mm_setr_epi32(0, 1, 2, 3), cnt);
+	const __m128i validHi = _mm_cmplt_epi32(_mm_setr_epi32(4, 5, 6, 7), cnt);
+
+	const __m128i dataLo = _mm_and_si128(_mm_add_epi32(base, _mm_sll_epi32(offsetsLo, shift)), validLo);
+	const __m128i dataHi = _mm_and_si128(_mm_add_epi32(base, _mm_sll_epi32(offsetsHi, shift)), validHi);
+	const __m128i tsLo   = _mm_and_si128(ts, validLo);
+	const __m128i tsHi   = _mm_and_si128(ts, validHi);
+
+	// Interleave data and timestamp: each 128-bit store writes two events.
+	uint8_t *out = (uint8_t *) events;
+	_mm_storeu_si128((__m128i *) (void *) (out + 0), _mm_unpacklo_epi32(dataLo, tsLo));
+	_mm_storeu_si128((__m128i *) (void *) (out + 16), _mm_unpackhi_epi32(dataLo, tsLo));
+	_mm_storeu_si128((__m128i *) (void *) (out + 32), _mm_unpacklo_epi32(dataHi, tsHi));
+	_mm_storeu_si128((__m128i *) (void *) (out + 48), _mm_unpackhi_epi32(dataHi, tsHi));
+#elif defined(POLARITY_GROUPS_NEON)
+	static const uint32_t lanesLo[4] = {0, 1, 2, 3};
+	static const uint32_t lanesHi[4] = {4, 5, 6, 7};
+
+	const int32x4_t shift = vdupq_n_s32((int32_t) addrShift);
+	const uint32x4_t base = vdupq_n_u32(baseData);
+	const uint32x4_t ts   = vdupq_n_u32(U32T(timestamp));
+	const uint32x4_t cnt  = vdupq_n_u32(U32T(count));
+
+	// Widen the 8 byte offsets to two vectors of four 32-bit lanes.
+	const uint16x8_t offsets16 = vmovl_u8(vcreate_u8(polarityGroupOffsets[groupMask]));
+	const uint32x4_t offsetsLo = vmovl_u16(vget_low_u16(offsets16));
+	const uint32x4_t offsetsHi = vmovl_u16(vget_high_u16(offsets16));
+
+	// Lanes at or past 'count' are not events: zero them.
+	const uint32x4_t validLo = vcltq_u32(vld1q_u32(lanesLo), cnt);
+	const uint32x4_t validHi = vcltq_u32(vld1q_u32(lanesHi), cnt);
+
+	uint32x4x2_t lo, hi;
+	lo.val[0] = vandq_u32(vaddq_u32(base, vshlq_u32(offsetsLo, shift)), validLo);
+	lo.val[1] = vandq_u32(ts, validLo);
+	hi.val[0] = vandq_u32(vaddq_u32(base, vshlq_u32(offsetsHi, shift)), validHi);
+	hi.val[1] = vandq_u32(ts, validHi);
+
+	// Interleaving store: data and timestamp alternate, four events each.
+	uint8_t *out = (uint8_t *) events;
+	vst2q_u32((uint32_t *) (void *) (out + 0), lo);
+	vst2q_u32((uint32_t *) (void *) (out + 32), hi);
+#else
+	const uint64_t offsets = polarityGroupOffsets[groupMask];
+
+	for (int32_t i = 0; i < POLARITY_GROUP_SIZE; i++) {
+		if (i < count) {
+			uint32_t offset = U32T((offsets >> (8 * i)) & 0xFF);
+
+			events[i].data      = htole32(baseData + (offset << addrShift));
+			events[i].timestamp = I32T(htole32(U32T(timestamp)));
+		}
+		else {
+			events[i].data      = 0;
+			events[i].timestamp = 0;
+		}
+	}
+#endif
+
+	return (count);
+}
+
+/**
+ * Account for events written by polarityGroupExpand() in the packet header.
+ */
+static inline void polarityGroupCommit(caerPolarityEventPacket packet, int32_t count) {
+	caerEventPacketHeaderSetEventNumber(
+		&packet->packetHeader, caerEventPacketHeaderGetEventNumber(&packet->packetHeader) + count);
+	caerEventPacketHeaderSetEventValid(
+		&packet->packetHeader, caerEventPacketHeaderGetEventValid(&packet->packetHeader) + count);
+}
+
+#endif /* LIBCAER_SRC_POLARITY_GROUPS_H_ */
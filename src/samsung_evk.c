@@ -57,6 +57,10 @@ ssize_t samsungEVKFind(caerDeviceDiscoveryResult *discoveredDevices) {
 		SAMSUNG_EVK_DEVICE_VID, SAMSUNG_EVK_DEVICE_PID, -1, -1, -1, discoveredDevices, &populateDeviceInfo));
 }
 
+bool samsungEVKFindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice) {
+	return (usbDeviceFindSingle(device, -1, -1, -1, discoveredDevice, &populateDeviceInfo));
+}
+
 static inline void freeAllDataMemory(samsungEVKState state) {
 	dataExchangeDestroy(&state->dataExchange);
 
@@ -64,14 +68,14 @@ static inline void freeAllDataMemory(samsungEVKState state) {
 	// already assigned to the current packet container, we
 	// free them separately from it.
 	if (state->currentPackets.polarity != NULL) {
-		free(&state->currentPackets.polarity->packetHeader);
+		caerEventPacketFree(&state->currentPackets.polarity->packetHeader);
 		state->currentPackets.polarity = NULL;
 
 		containerGenerationSetPacket(&state->container, POLARITY_EVENT, NULL);
 	}
 
 	if (state->currentPackets.special != NULL) {
-		free(&state->currentPackets.special->packetHeader);
+		caerEventPacketFree(&state->currentPackets.special->packetHeader);
 		state->currentPackets.special = NULL;
 
 		containerGenerationSetPacket(&state->container, SPECIAL_EVENT, NULL);
@@ -179,6 +183,9 @@ caerDeviceHandle samsungEVKOpen(
 	handle->info.deviceID     = I16T(deviceID);
 	handle->info.deviceString = usbInfoString;
 
+	// Host-side region of interest (whole array by default).
+	dvsROISettingsInit(&state->dvs.roi, U16T(handle->info.dvsSizeX), U16T(handle->info.dvsSizeY));
+
 	// Send initialization commands.
 	usbControlTransferOut(&state->usbState, VENDOR_REQUEST_RESET, 0, 0, NULL, 0); // Reset FPGA.
 	usbControlTransferOut(&state->usbState, VENDOR_REQUEST_RESET, 1, 0, NULL, 0); // Reset FX3 FIFO SM.
@@ -419,6 +426,10 @@ bool samsungEVKConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr
 			}
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ROI:
+			return (dvsROIConfigSet(&state->dvs.roi, paramAddr, param));
+			break;
+
 		case SAMSUNG_EVK_DVS:
 			switch (paramAddr) {
 				case SAMSUNG_EVK_DVS_MODE: {
@@ -1130,6 +1141,10 @@ bool samsungEVKConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr
 			}
 			break;
 
+		case CAER_HOST_CONFIG_DVS_ROI:
+			return (dvsROIConfigGet(&state->dvs.roi, paramAddr, param));
+			break;
+
 		case SAMSUNG_EVK_DVS:
 			switch (paramAddr) {
 				case SAMSUNG_EVK_DVS_MODE: {
@@ -1966,6 +1981,9 @@ static void samsungEVKEventTranslator(void *vhd, const uint8_t *buffer, const si
 		return;
 	}
 
+	// Region of interest settings stay the same for the whole buffer.
+	dvsROIUpdate(&state->dvs.roi);
+
 	for (size_t bufferPos = 0; bufferPos < bufferSize; bufferPos += 4) {
 		// Allocate new packets for next iteration as needed.
 		if (!containerGenerationAllocate(&state->container, SAMSUNG_EVK_EVENT_TYPES)) {
@@ -2034,49 +2052,29 @@ static void samsungEVKEventTranslator(void *vhd, const uint8_t *buffer, const si
 				continue;
 			}
 
-			uint8_t group1Events = (event >> 0) & 0x00FF;
+			// Pixels outside the host-side region of interest are masked out before expansion.
+			uint8_t group1Events = ((event >> 0) & 0x00FF)
+								 & dvsROIGroupMask(&state->dvs.roi, U16T(state->dvs.lastColumn), U16T(group1Address));
 			bool group1Polarity  = (((event >> 16) & 0x01) == 0); // ON polarity is 0 here.
-
-			for (uint8_t i = 0, mask = 0x01; i < 8; i++, mask = U8T(mask << 1)) {
-				// Check if event present first.
-				if ((group1Events & mask) == 0) {
-					continue;
-				}
-
-				// Received event!
-				caerPolarityEvent currentPolarityEvent = caerPolarityEventPacketGetEvent(
-					state->currentPackets.polarity, state->currentPackets.polarityPosition);
-
-				// Timestamp at event-stream insertion point.
-				caerPolarityEventSetTimestamp(currentPolarityEvent, state->timestamps.current);
-				caerPolarityEventSetPolarity(currentPolarityEvent, group1Polarity);
-				caerPolarityEventSetX(currentPolarityEvent, U16T(state->dvs.lastColumn));
-				caerPolarityEventSetY(currentPolarityEvent, U16T(group1Address + i));
-				caerPolarityEventValidate(currentPolarityEvent, state->currentPackets.polarity);
-				state->currentPackets.polarityPosition++;
-			}
-
-			uint8_t group2Events = (event >> 8) & 0x00FF;
+			uint8_t group2Events = ((event >> 8) & 0x00FF)
+								 & dvsROIGroupMask(&state->dvs.roi, U16T(state->dvs.lastColumn), U16T(group2Address));
 			bool group2Polarity  = (((event >> 17) & 0x01) == 0); // ON polarity is 0 here.
 
-			for (uint8_t i = 0, mask = 0x01; i < 8; i++, mask = U8T(mask << 1)) {
-				// Check if event present first.
-				if ((group2Events & mask) == 0) {
-					continue;
-				}
+			// Expand both groups at once through the lookup table. All events in
+			// a group share X, polarity and timestamp, Y increases with the bit index.
+			caerPolarityEvent groupEvents = caerPolarityEventPacketGetEvent(
+				state->currentPackets.polarity, state->currentPackets.polarityPosition);
 
-				// Received event!
-				caerPolarityEvent currentPolarityEvent = caerPolarityEventPacketGetEvent(
-					state->currentPackets.polarity, state->currentPackets.polarityPosition);
+			int32_t groupEventsNumber = polarityGroupExpand(groupEvents, group1Events,
+				polarityGroupBaseData(U16T(state->dvs.lastColumn), U16T(group1Address), group1Polarity),
+				POLARITY_Y_ADDR_SHIFT, state->timestamps.current);
 
-				// Timestamp at event-stream insertion point.
-				caerPolarityEventSetTimestamp(currentPolarityEvent, state->timestamps.current);
-				caerPolarityEventSetPolarity(currentPolarityEvent, group2Polarity);
-				caerPolarityEventSetX(currentPolarityEvent, U16T(state->dvs.lastColumn));
-				caerPolarityEventSetY(currentPolarityEvent, U16T(group2Address + i));
-				caerPolarityEventValidate(currentPolarityEvent, state->currentPackets.polarity);
-				state->currentPackets.polarityPosition++;
-			}
+			groupEventsNumber += polarityGroupExpand(&groupEvents[groupEventsNumber], group2Events,
+				polarityGroupBaseData(U16T(state->dvs.lastColumn), U16T(group2Address), group2Polarity),
+				POLARITY_Y_ADDR_SHIFT, state->timestamps.current);
+
+			polarityGroupCommit(state->currentPackets.polarity, groupEventsNumber);
+			state->currentPackets.polarityPosition += groupEventsNumber;
 		}
 		else {
 			// COLUMN event.
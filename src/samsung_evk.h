@@ -6,6 +6,8 @@
 
 #include "container_generation.h"
 #include "data_exchange.h"
+#include "dvs_roi.h"
+#include "polarity_groups.h"
 #include "usb_utils.h"
 
 #define SAMSUNG_EVK_EVENT_TYPES 2
@@ -129,6 +131,8 @@ struct samsung_evk_state {
 		int16_t lastColumn;
 		uint16_t cropperYStart;
 		uint16_t cropperYEnd;
+		// Host-side region of interest, on top of the cropper (adds decimation).
+		struct dvs_roi roi;
 	} dvs;
 	// Packet Container state
 	struct container_generation container;
@@ -155,6 +159,7 @@ struct samsung_evk_handle {
 typedef struct samsung_evk_handle *samsungEVKHandle;
 
 ssize_t samsungEVKFind(caerDeviceDiscoveryResult *discoveredDevices);
+bool samsungEVKFindSingle(libusb_device *device, caerDeviceDiscoveryResult discoveredDevice);
 
 caerDeviceHandle samsungEVKOpen(
 	uint16_t deviceID, uint8_t busNumberRestrict, uint8_t devAddressRestrict, const char *serialNumberRestrict);
@@ -78,6 +78,330 @@ static void LIBUSB_CALL libusbUSBLog(libusb_context *ctx, enum libusb_log_level
 	}
 }
 
+// Discovery cache, see usbDiscoveryCacheSetEnabled().
+#define USB_DISCOVERY_CACHE_MAX_PORTS 8
+
+struct usb_discovery_cache_entry {
+	uint16_t devVID;
+	uint16_t devPID;
+	uint16_t bcdDevice;
+	uint8_t busNumber;
+	uint8_t devAddress;
+	uint8_t portNumbers[USB_DISCOVERY_CACHE_MAX_PORTS];
+	int portNumbersLength;
+	struct caer_device_discovery_result result;
+};
+
+static struct {
+	once_flag initOnce;
+	mtx_t lock;
+	bool enabled;                             // LOCK PROTECTED.
+	struct usb_discovery_cache_entry *entries; // LOCK PROTECTED.
+	size_t entriesLength;                     // LOCK PROTECTED.
+} usbDiscoveryCache = {.initOnce = ONCE_FLAG_INIT};
+
+static void usbDiscoveryCacheInit(void) {
+	mtx_init(&usbDiscoveryCache.lock, mtx_plain);
+}
+
+void usbDiscoveryCacheSetEnabled(bool enabled) {
+	call_once(&usbDiscoveryCache.initOnce, &usbDiscoveryCacheInit);
+
+	mtx_lock(&usbDiscoveryCache.lock);
+
+	usbDiscoveryCache.enabled = enabled;
+
+	if (!enabled) {
+		// Drop all content when disabling, so re-enabling starts fresh.
+		free(usbDiscoveryCache.entries);
+		usbDiscoveryCache.entries       = NULL;
+		usbDiscoveryCache.entriesLength = 0;
+	}
+
+	mtx_unlock(&usbDiscoveryCache.lock);
+}
+
+void usbDiscoveryCacheClear(void) {
+	call_once(&usbDiscoveryCache.initOnce, &usbDiscoveryCacheInit);
+
+	mtx_lock(&usbDiscoveryCache.lock);
+
+	free(usbDiscoveryCache.entries);
+	usbDiscoveryCache.entries       = NULL;
+	usbDiscoveryCache.entriesLength = 0;
+
+	mtx_unlock(&usbDiscoveryCache.lock);
+}
+
+static inline bool usbDiscoveryCacheEntryMatches(
+	const struct usb_discovery_cache_entry *entry, const struct usb_discovery_cache_entry *key) {
+	return ((entry->devVID == key->devVID) && (entry->devPID == key->devPID) && (entry->bcdDevice == key->bcdDevice)
+			&& (entry->busNumber == key->busNumber) && (entry->devAddress == key->devAddress)
+			&& (entry->portNumbersLength == key->portNumbersLength)
+			&& (memcmp(entry->portNumbers, key->portNumbers, (size_t) key->portNumbersLength) == 0));
+}
+
+// Must be called with the cache lock held.
+static struct usb_discovery_cache_entry *usbDiscoveryCacheFind(const struct usb_discovery_cache_entry *key) {
+	for (size_t i = 0; i < usbDiscoveryCache.entriesLength; i++) {
+		if (usbDiscoveryCacheEntryMatches(&usbDiscoveryCache.entries[i], key)) {
+			return (&usbDiscoveryCache.entries[i]);
+		}
+	}
+
+	return (NULL);
+}
+
+static bool usbDiscoveryCacheGet(const struct usb_discovery_cache_entry *key, caerDeviceDiscoveryResult result) {
+	call_once(&usbDiscoveryCache.initOnce, &usbDiscoveryCacheInit);
+
+	mtx_lock(&usbDiscoveryCache.lock);
+
+	bool found = false;
+
+	if (usbDiscoveryCache.enabled) {
+		const struct usb_discovery_cache_entry *entry = usbDiscoveryCacheFind(key);
+
+		if (entry != NULL) {
+			*result = entry->result;
+			found   = true;
+		}
+	}
+
+	mtx_unlock(&usbDiscoveryCache.lock);
+
+	return (found);
+}
+
+static void usbDiscoveryCachePut(const struct usb_discovery_cache_entry *key, caerDeviceDiscoveryResult result) {
+	// Only remember devices that could be fully queried. Devices that failed
+	// to open (busy, permissions) are re-checked on every discovery.
+	if (result->deviceErrorOpen) {
+		return;
+	}
+
+	call_once(&usbDiscoveryCache.initOnce, &usbDiscoveryCacheInit);
+
+	mtx_lock(&usbDiscoveryCache.lock);
+
+	if (usbDiscoveryCache.enabled) {
+		struct usb_discovery_cache_entry *entry = usbDiscoveryCacheFind(key);
+
+		if (entry == NULL) {
+			void *biggerEntries = realloc(usbDiscoveryCache.entries,
+				(usbDiscoveryCache.entriesLength + 1) * sizeof(struct usb_discovery_cache_entry));
+
+			if (biggerEntries != NULL) {
+				usbDiscoveryCache.entries = biggerEntries;
+				entry                     = &usbDiscoveryCache.entries[usbDiscoveryCache.entriesLength];
+				usbDiscoveryCache.entriesLength++;
+			}
+		}
+
+		// On memory allocation failure, the device is simply not cached.
+		if (entry != NULL) {
+			*entry        = *key;
+			entry->result = *result;
+		}
+	}
+
+	mtx_unlock(&usbDiscoveryCache.lock);
+}
+
+struct usb_find_job {
+	libusb_device *device;
+	struct libusb_device_descriptor devDesc;
+	int32_t requiredLogicVersion;
+	int32_t minimumLogicPatch;
+	int32_t requiredFirmwareVersion;
+	void (*deviceInfoFunc)(caerDeviceDiscoveryResult result, struct usb_info *usbInfo, libusb_device_handle *devHandle);
+	caerDeviceDiscoveryResult result;
+	struct usb_discovery_cache_entry cacheKey;
+	bool cacheHit;
+	thrd_t thread;
+	bool threadStarted;
+};
+
+static void usbDiscoveryCachePrune(
+	uint16_t devVID, uint16_t devPID, const struct usb_find_job *jobs, size_t jobsLength) {
+	call_once(&usbDiscoveryCache.initOnce, &usbDiscoveryCacheInit);
+
+	mtx_lock(&usbDiscoveryCache.lock);
+
+	// Remove entries for this VID/PID that are not attached anymore.
+	size_t keep = 0;
+
+	for (size_t i = 0; i < usbDiscoveryCache.entriesLength; i++) {
+		const struct usb_discovery_cache_entry *entry = &usbDiscoveryCache.entries[i];
+
+		bool stillPresent = ((entry->devVID != devVID) || (entry->devPID != devPID));
+
+		for (size_t j = 0; (!stillPresent) && (j < jobsLength); j++) {
+			stillPresent = usbDiscoveryCacheEntryMatches(entry, &jobs[j].cacheKey);
+		}
+
+		if (stillPresent) {
+			usbDiscoveryCache.entries[keep++] = *entry;
+		}
+	}
+
+	usbDiscoveryCache.entriesLength = keep;
+
+	mtx_unlock(&usbDiscoveryCache.lock);
+}
+
+static void usbDeviceFindInfo(struct usb_find_job *job) {
+	struct usb_info currUSBInfo = {0};
+
+	// Get USB bus number and device address from descriptors.
+	currUSBInfo.busNumber  = job->cacheKey.busNumber;
+	currUSBInfo.devAddress = job->cacheKey.devAddress;
+
+	// Unknown serial number.
+	// Generate a repeatable serial number valid for this session using bus and device addresses.
+	uint16_t serialNumberNotAvailable = U16T(U16T(currUSBInfo.busNumber) << 8) | U16T(currUSBInfo.devAddress);
+	snprintf(currUSBInfo.serialNumber, sizeof(currUSBInfo.serialNumber), "TMP%05" PRIu16, serialNumberNotAvailable);
+
+	// Verify device firmware version before opening, so that firmwareVersion
+	// is always defined, even on open errors.
+	bool firmwareVersionOK = true;
+
+	if (job->requiredFirmwareVersion >= 0) {
+		uint8_t firmwareVersion = U8T(job->devDesc.bcdDevice & 0x00FF);
+
+		if (firmwareVersion != U8T(job->requiredFirmwareVersion)) {
+			firmwareVersionOK        = false;
+			currUSBInfo.errorVersion = true;
+		}
+
+		currUSBInfo.firmwareVersion = I16T(firmwareVersion);
+	}
+
+	libusb_device_handle *devHandle = NULL;
+
+	if (libusb_open(job->device, &devHandle) != LIBUSB_SUCCESS) {
+		currUSBInfo.errorOpen = true;
+		(*job->deviceInfoFunc)(job->result, &currUSBInfo, NULL);
+
+		return;
+	}
+
+	if (job->devDesc.iSerialNumber != 0) {
+		// Get serial number.
+		char serialNumber[MAX_SERIAL_NUMBER_LENGTH + 1] = {0};
+		int getStringDescResult                         = libusb_get_string_descriptor_ascii(
+            devHandle, job->devDesc.iSerialNumber, (unsigned char *) serialNumber, MAX_SERIAL_NUMBER_LENGTH + 1);
+
+		// Check serial number success and length.
+		if ((getStringDescResult < 0) || (getStringDescResult > MAX_SERIAL_NUMBER_LENGTH)) {
+			libusb_close(devHandle);
+
+			currUSBInfo.errorOpen = true;
+			(*job->deviceInfoFunc)(job->result, &currUSBInfo, NULL);
+
+			return;
+		}
+
+		// Copy serial number characters.
+		if (getStringDescResult > 0) {
+			memcpy(currUSBInfo.serialNumber, serialNumber, (size_t) getStringDescResult);
+			currUSBInfo.serialNumber[getStringDescResult] = 0x00;
+		}
+	}
+
+	// Verify device logic version.
+	bool logicVersionOK = true;
+
+	if (job->requiredLogicVersion >= 0) {
+		// Communication with device open, get logic version information.
+		uint32_t param32 = 0;
+
+		// Get logic version from generic SYSINFO module.
+		if (!startupSPIConfigReceive(devHandle, 6, 0, &param32)) {
+			libusb_close(devHandle);
+
+			currUSBInfo.errorOpen = true;
+			(*job->deviceInfoFunc)(job->result, &currUSBInfo, NULL);
+
+			return;
+		}
+
+		// Verify device logic version.
+		if (param32 != U32T(job->requiredLogicVersion)) {
+			logicVersionOK = false;
+		}
+
+		currUSBInfo.logicVersion = I16T(param32);
+	}
+
+	// Verify device logic minimum patch level.
+	bool logicPatchOK = true;
+
+	if (job->minimumLogicPatch >= 0) {
+		// Communication with device open, get logic patch level information.
+		uint32_t param32 = 0;
+
+		// Get logic patch level from generic SYSINFO module.
+		if (!startupSPIConfigReceive(devHandle, 6, 7, &param32)) {
+			libusb_close(devHandle);
+
+			currUSBInfo.errorOpen = true;
+			(*job->deviceInfoFunc)(job->result, &currUSBInfo, NULL);
+
+			return;
+		}
+
+		// Verify device logic minimum patch level.
+		if (param32 < U32T(job->minimumLogicPatch)) {
+			logicPatchOK = false;
+		}
+	}
+
+	// If any of the version checks failed, stop.
+	if (!firmwareVersionOK || !logicVersionOK || !logicPatchOK) {
+		currUSBInfo.errorVersion = true;
+	}
+
+	// Get additional per-device information.
+	(*job->deviceInfoFunc)(job->result, &currUSBInfo, devHandle);
+
+	libusb_close(devHandle);
+}
+
+static void usbFindJobSetup(struct usb_find_job *job, libusb_device *device,
+	const struct libusb_device_descriptor *devDesc, int32_t requiredLogicVersion, int32_t minimumLogicPatch,
+	int32_t requiredFirmwareVersion, caerDeviceDiscoveryResult result,
+	void (*deviceInfoFunc)(
+		caerDeviceDiscoveryResult result, struct usb_info *usbInfo, libusb_device_handle *devHandle)) {
+	job->device                  = device;
+	job->devDesc                 = *devDesc;
+	job->requiredLogicVersion    = requiredLogicVersion;
+	job->minimumLogicPatch       = minimumLogicPatch;
+	job->requiredFirmwareVersion = requiredFirmwareVersion;
+	job->deviceInfoFunc          = deviceInfoFunc;
+	job->result                  = result;
+
+	job->cacheKey.devVID     = devDesc->idVendor;
+	job->cacheKey.devPID     = devDesc->idProduct;
+	job->cacheKey.bcdDevice  = devDesc->bcdDevice;
+	job->cacheKey.busNumber  = libusb_get_bus_number(device);
+	job->cacheKey.devAddress = libusb_get_device_address(device);
+
+	int portNumbersLength
+		= libusb_get_port_numbers(device, job->cacheKey.portNumbers, USB_DISCOVERY_CACHE_MAX_PORTS);
+	job->cacheKey.portNumbersLength = (portNumbersLength > 0) ? (portNumbersLength) : (0);
+
+	job->cacheHit = usbDiscoveryCacheGet(&job->cacheKey, job->result);
+}
+
+static int usbDeviceFindThread(void *jobPtr) {
+	thrd_set_name("USBDiscovery");
+
+	usbDeviceFindInfo(jobPtr);
+
+	return (EXIT_SUCCESS);
+}
+
 ssize_t usbDeviceFind(uint16_t devVID, uint16_t devPID, int32_t requiredLogicVersion, int32_t minimumLogicPatch,
 	int32_t requiredFirmwareVersion, caerDeviceDiscoveryResult *foundUSBDevices,
 	void (*deviceInfoFunc)(
@@ -132,6 +456,8 @@ ssize_t usbDeviceFind(uint16_t devVID, uint16_t devPID, int32_t requiredLogicVer
 		libusb_free_device_list(devicesList, true);
 		libusb_exit(NULL);
 
+		usbDiscoveryCachePrune(devVID, devPID, NULL, 0);
+
 		return (0);
 	}
 
@@ -145,6 +471,17 @@ ssize_t usbDeviceFind(uint16_t devVID, uint16_t devPID, int32_t requiredLogicVer
 		return (-1);
 	}
 
+	struct usb_find_job *jobs = calloc(matches, sizeof(struct usb_find_job));
+	if (jobs == NULL) {
+		free(*foundUSBDevices);
+		*foundUSBDevices = NULL;
+
+		libusb_free_device_list(devicesList, true);
+		libusb_exit(NULL);
+
+		return (-1);
+	}
+
 	matches = 0; // Use as counter again.
 
 	for (size_t i = 0; i < (size_t) result; i++) {
@@ -156,135 +493,72 @@ ssize_t usbDeviceFind(uint16_t devVID, uint16_t devPID, int32_t requiredLogicVer
 
 		// Check if this is the device we want (VID/PID).
 		if ((devDesc.idVendor == devVID) && (devDesc.idProduct == devPID)) {
-			struct usb_info currUSBInfo = {0};
-
-			// Get USB bus number and device address from descriptors.
-			currUSBInfo.busNumber  = libusb_get_bus_number(devicesList[i]);
-			currUSBInfo.devAddress = libusb_get_device_address(devicesList[i]);
-
-			// Unknown serial number.
-			// Generate a repeatable serial number valid for this session using bus and device addresses.
-			uint16_t serialNumberNotAvailable = U16T(U16T(currUSBInfo.busNumber) << 8) | U16T(currUSBInfo.devAddress);
-			snprintf(
-				currUSBInfo.serialNumber, sizeof(currUSBInfo.serialNumber), "TMP%05" PRIu16, serialNumberNotAvailable);
-
-			// Verify device firmware version before opening, so that firmwareVersion
-			// is always defined, even on open errors.
-			bool firmwareVersionOK = true;
-
-			if (requiredFirmwareVersion >= 0) {
-				uint8_t firmwareVersion = U8T(devDesc.bcdDevice & 0x00FF);
-
-				if (firmwareVersion != U8T(requiredFirmwareVersion)) {
-					firmwareVersionOK        = false;
-					currUSBInfo.errorVersion = true;
-				}
-
-				currUSBInfo.firmwareVersion = I16T(firmwareVersion);
-			}
-
-			libusb_device_handle *devHandle = NULL;
-
-			if (libusb_open(devicesList[i], &devHandle) != LIBUSB_SUCCESS) {
-				currUSBInfo.errorOpen = true;
-				(*deviceInfoFunc)(&(*foundUSBDevices)[matches], &currUSBInfo, NULL);
-
-				matches++;
-				continue;
-			}
-
-			if (devDesc.iSerialNumber != 0) {
-				// Get serial number.
-				char serialNumber[MAX_SERIAL_NUMBER_LENGTH + 1] = {0};
-				int getStringDescResult                         = libusb_get_string_descriptor_ascii(
-                    devHandle, devDesc.iSerialNumber, (unsigned char *) serialNumber, MAX_SERIAL_NUMBER_LENGTH + 1);
-
-				// Check serial number success and length.
-				if ((getStringDescResult < 0) || (getStringDescResult > MAX_SERIAL_NUMBER_LENGTH)) {
-					libusb_close(devHandle);
-
-					currUSBInfo.errorOpen = true;
-					(*deviceInfoFunc)(&(*foundUSBDevices)[matches], &currUSBInfo, NULL);
-
-					matches++;
-					continue;
-				}
-
-				// Copy serial number characters.
-				if (getStringDescResult > 0) {
-					memcpy(currUSBInfo.serialNumber, serialNumber, (size_t) getStringDescResult);
-					currUSBInfo.serialNumber[getStringDescResult] = 0x00;
-				}
-			}
-
-			// Verify device logic version.
-			bool logicVersionOK = true;
-
-			if (requiredLogicVersion >= 0) {
-				// Communication with device open, get logic version information.
-				uint32_t param32 = 0;
+			usbFindJobSetup(&jobs[matches], devicesList[i], &devDesc, requiredLogicVersion, minimumLogicPatch,
+				requiredFirmwareVersion, &(*foundUSBDevices)[matches], deviceInfoFunc);
 
-				// Get logic version from generic SYSINFO module.
-				if (!startupSPIConfigReceive(devHandle, 6, 0, &param32)) {
-					libusb_close(devHandle);
+			matches++;
+		}
+	}
 
-					currUSBInfo.errorOpen = true;
-					(*deviceInfoFunc)(&(*foundUSBDevices)[matches], &currUSBInfo, NULL);
+	// Opening a device and reading its serial number and versions requires
+	// several control transfer round-trips, so do that for all devices in
+	// parallel, one thread per device. If a thread cannot be started, just
+	// do the work on the current thread instead.
+	for (size_t i = 0; i < matches; i++) {
+		if (jobs[i].cacheHit) {
+			continue;
+		}
 
-					matches++;
-					continue;
-				}
+		if (thrd_create(&jobs[i].thread, &usbDeviceFindThread, &jobs[i]) == thrd_success) {
+			jobs[i].threadStarted = true;
+		}
+		else {
+			usbDeviceFindInfo(&jobs[i]);
+		}
+	}
 
-				// Verify device logic version.
-				if (param32 != U32T(requiredLogicVersion)) {
-					logicVersionOK = false;
-				}
+	for (size_t i = 0; i < matches; i++) {
+		if (jobs[i].threadStarted) {
+			thrd_join(jobs[i].thread, NULL);
+		}
 
-				currUSBInfo.logicVersion = I16T(param32);
-			}
+		if (!jobs[i].cacheHit) {
+			usbDiscoveryCachePut(&jobs[i].cacheKey, jobs[i].result);
+		}
+	}
 
-			// Verify device logic minimum patch level.
-			bool logicPatchOK = true;
+	usbDiscoveryCachePrune(devVID, devPID, jobs, matches);
 
-			if (minimumLogicPatch >= 0) {
-				// Communication with device open, get logic patch level information.
-				uint32_t param32 = 0;
+	free(jobs);
 
-				// Get logic patch level from generic SYSINFO module.
-				if (!startupSPIConfigReceive(devHandle, 6, 7, &param32)) {
-					libusb_close(devHandle);
+	libusb_free_device_list(devicesList, true);
+	libusb_exit(NULL);
 
-					currUSBInfo.errorOpen = true;
-					(*deviceInfoFunc)(&(*foundUSBDevices)[matches], &currUSBInfo, NULL);
+	return ((ssize_t) matches);
+}
 
-					matches++;
-					continue;
-				}
+bool usbDeviceFindSingle(libusb_device *device, int32_t requiredLogicVersion, int32_t minimumLogicPatch,
+	int32_t requiredFirmwareVersion, caerDeviceDiscoveryResult foundUSBDevice,
+	void (*deviceInfoFunc)(
+		caerDeviceDiscoveryResult result, struct usb_info *usbInfo, libusb_device_handle *devHandle)) {
+	struct libusb_device_descriptor devDesc;
 
-				// Verify device logic minimum patch level.
-				if (param32 < U32T(minimumLogicPatch)) {
-					logicPatchOK = false;
-				}
-			}
+	if (libusb_get_device_descriptor(device, &devDesc) != LIBUSB_SUCCESS) {
+		return (false);
+	}
 
-			// If any of the version checks failed, stop.
-			if (!firmwareVersionOK || !logicVersionOK || !logicPatchOK) {
-				currUSBInfo.errorVersion = true;
-			}
+	struct usb_find_job job = {0};
 
-			// Get additional per-device information.
-			(*deviceInfoFunc)(&(*foundUSBDevices)[matches], &currUSBInfo, devHandle);
+	usbFindJobSetup(&job, device, &devDesc, requiredLogicVersion, minimumLogicPatch, requiredFirmwareVersion,
+		foundUSBDevice, deviceInfoFunc);
 
-			libusb_close(devHandle);
+	if (!job.cacheHit) {
+		usbDeviceFindInfo(&job);
 
-			matches++;
-		}
+		usbDiscoveryCachePut(&job.cacheKey, job.result);
 	}
 
-	libusb_free_device_list(devicesList, true);
-	libusb_exit(NULL);
-
-	return ((ssize_t) matches);
+	return (true);
 }
 
 bool usbDeviceOpen(usbState state, uint16_t devVID, uint16_t devPID, uint8_t busNumber, uint8_t devAddress,
@@ -1059,6 +1333,11 @@ static bool usbControlTransferAsync(usbState state, uint8_t bRequest, uint16_t w
 		return (false);
 	}
 
+	// No device to talk to, such as for offline translators.
+	if (state->deviceHandle == NULL) {
+		return (false);
+	}
+
 	struct libusb_transfer *controlTransfer = libusb_alloc_transfer(0);
 	if (controlTransfer == NULL) {
 		return (false);
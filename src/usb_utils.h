@@ -71,6 +71,16 @@ ssize_t usbDeviceFind(uint16_t devVID, uint16_t devPID, int32_t requiredLogicVer
 	void (*deviceInfoFunc)(
 		caerDeviceDiscoveryResult result, struct usb_info *usbInfo, libusb_device_handle *devHandle));
 
+// Query a single, already known USB device only (no bus scan), filling in
+// 'foundUSBDevice'. Returns false if its descriptor cannot be read.
+bool usbDeviceFindSingle(libusb_device *device, int32_t requiredLogicVersion, int32_t minimumLogicPatch,
+	int32_t requiredFirmwareVersion, caerDeviceDiscoveryResult foundUSBDevice,
+	void (*deviceInfoFunc)(
+		caerDeviceDiscoveryResult result, struct usb_info *usbInfo, libusb_device_handle *devHandle));
+
+void usbDiscoveryCacheSetEnabled(bool enabled);
+void usbDiscoveryCacheClear(void);
+
 bool usbDeviceOpen(usbState state, uint16_t devVID, uint16_t devPID, uint8_t busNumber, uint8_t devAddress,
 	const char *serialNumber, int32_t requiredLogicVersion, int32_t minimumLogicPatch, int32_t requiredFirmwareVersion,
 	caerDeviceDiscoveryResult deviceInfo,